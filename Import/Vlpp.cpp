@@ -2685,9 +2685,8 @@ namespace vl
 }
 
 /***********************************************************************
-THREADING.CPP
+TASKSCHEDULER.CPP
 ***********************************************************************/
-#ifdef VCZH_MSVC
 
 namespace vl
 {
@@ -2695,977 +2694,1507 @@ namespace vl
 	using namespace collections;
 
 /***********************************************************************
-WaitableObject
+CancellationToken
 ***********************************************************************/
 
-	namespace threading_internal
+	void CancellationToken::Cancel()
 	{
-		struct WaitableData
-		{
-			HANDLE			handle;
-
-			WaitableData(HANDLE _handle)
-				:handle(_handle)
-			{
-			}
-		};
+		cancelled = 1;
 	}
 
-	WaitableObject::WaitableObject()
-		:waitableData(0)
+	bool CancellationToken::IsCancelled()
 	{
+		return cancelled != 0;
 	}
 
-	void WaitableObject::SetData(threading_internal::WaitableData* data)
-	{
-		waitableData=data;
-	}
+/***********************************************************************
+TaskScheduler
+***********************************************************************/
 
-	bool WaitableObject::IsCreated()
+	namespace threading_internal
 	{
-		return waitableData!=0;
-	}
+		struct TaskGroupData
+		{
+			CriticalSection					lock;
+			ConditionVariable				condition;
+			vint							pending = 0;
+			vint							version = 0;
+			TaskScheduler::Priority			priority = TaskScheduler::Background;
+			Ptr<CancellationToken>			token;
+		};
 
-	bool WaitableObject::Wait()
-	{
-		return WaitForTime(INFINITE);
-	}
+		struct SchedulerTask
+		{
+			Func<void()>					proc;
+			Ptr<CancellationToken>			token;
+			TaskGroupData*					group = nullptr;
+		};
 
-	bool WaitableObject::WaitForTime(vint ms)
-	{
-		if(IsCreated())
+		class SchedulerTaskQueue : public Object
 		{
-			if(WaitForSingleObject(waitableData->handle, (DWORD)ms)==WAIT_OBJECT_0)
+		protected:
+			Array<SchedulerTask>			tasks;
+			vint							head = 0;
+			volatile vint					count = 0;
+
+			void Grow()
+			{
+				vint oldCapacity = tasks.Count();
+				tasks.Resize(oldCapacity == 0 ? 16 : oldCapacity * 2);
+				for (vint i = 0; i < head + count - oldCapacity; i++)
+				{
+					tasks[oldCapacity + i] = MoveValue(tasks[i]);
+					tasks[i] = SchedulerTask();
+				}
+			}
+
+			void Take(vint index, SchedulerTask& task)
+			{
+				task = MoveValue(tasks[index]);
+				tasks[index] = SchedulerTask();
+			}
+		public:
+			bool IsEmpty()
+			{
+				return count == 0;
+			}
+
+			void PushBack(const SchedulerTask& task)
+			{
+				if (count == tasks.Count())
+				{
+					Grow();
+				}
+				tasks[(head + count) % tasks.Count()] = task;
+				count++;
+			}
+
+			bool PopBack(SchedulerTask& task)
 			{
+				if (count == 0) return false;
+				count--;
+				Take((head + count) % tasks.Count(), task);
 				return true;
 			}
-		}
-		return false;
-	}
 
-	bool WaitableObject::WaitAll(WaitableObject** objects, vint count)
-	{
-		Array<HANDLE> handles(count);
-		for(vint i=0;i<count;i++)
+			bool PopFront(SchedulerTask& task)
+			{
+				if (count == 0) return false;
+				Take(head, task);
+				head = (head + 1) % tasks.Count();
+				count--;
+				return true;
+			}
+		};
+
+		struct SchedulerWorker
 		{
-			handles[i]=objects[i]->waitableData->handle;
-		}
-		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], TRUE, INFINITE);
-		return result==WAIT_OBJECT_0 || result==WAIT_ABANDONED_0;
+			Thread*							thread = nullptr;
+			vint							index = 0;
+			volatile vint					threadId = -1;
+			SpinLock						locks[2];
+			SchedulerTaskQueue				queues[2];
+		};
 
-	}
+		SpinLock							schedulerLock;
+		Semaphore							schedulerSemaphore;
+		bool								schedulerSemaphoreCreated = false;
+		volatile bool						schedulerStarted = false;
+		volatile vint						schedulerStopping = 0;
+		volatile bool						schedulerDiscarding = false;
+		volatile bool						schedulerExiting = false;
+		volatile vint						schedulerAccessing = 0;
+		vint								schedulerWorkerCount = 0;
+		SpinLock							schedulerSharedLocks[2];
+		SchedulerTaskQueue					schedulerSharedQueues[2];
+		List<SchedulerWorker*>				schedulerWorkers;
 
-	bool WaitableObject::WaitAllForTime(WaitableObject** objects, vint count, vint ms)
-	{
-		Array<HANDLE> handles(count);
-		for(vint i=0;i<count;i++)
+		vint GetDefaultWorkerCount()
 		{
-			handles[i]=objects[i]->waitableData->handle;
+			if (schedulerWorkerCount > 0) return schedulerWorkerCount;
+			// ThreadPoolLite used to start 4 threads per processor, callers may block in tasks and rely on that
+			return Thread::GetCPUCount() * 4;
 		}
-		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], TRUE, (DWORD)ms);
-		return result==WAIT_OBJECT_0 || result==WAIT_ABANDONED_0;
-	}
 
-	vint WaitableObject::WaitAny(WaitableObject** objects, vint count, bool* abandoned)
-	{
-		Array<HANDLE> handles(count);
-		for(vint i=0;i<count;i++)
-		{
-			handles[i]=objects[i]->waitableData->handle;
-		}
-		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], FALSE, INFINITE);
-		if(WAIT_OBJECT_0 <= result && result<WAIT_OBJECT_0+count)
-		{
-			*abandoned=false;
-			return result-WAIT_OBJECT_0;
-		}
-		else if(WAIT_ABANDONED_0 <= result && result<WAIT_ABANDONED_0+count)
-		{
-			*abandoned=true;
-			return result-WAIT_ABANDONED_0;
-		}
-		else
+		SchedulerWorker* FindCurrentWorker()
 		{
-			return -1;
+			vint threadId = Thread::GetCurrentThreadId();
+			for (vint i = 0; i < schedulerWorkers.Count(); i++)
+			{
+				auto worker = schedulerWorkers[i];
+				if (worker->threadId == threadId)
+				{
+					return worker;
+				}
+			}
+			return nullptr;
 		}
-	}
 
-	vint WaitableObject::WaitAnyForTime(WaitableObject** objects, vint count, vint ms, bool* abandoned)
-	{
-		Array<HANDLE> handles(count);
-		for(vint i=0;i<count;i++)
-		{
-			handles[i]=objects[i]->waitableData->handle;
-		}
-		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], FALSE, (DWORD)ms);
-		if(WAIT_OBJECT_0 <= result && result<WAIT_OBJECT_0+count)
-		{
-			*abandoned=false;
-			return result-WAIT_OBJECT_0;
-		}
-		else if(WAIT_ABANDONED_0 <= result && result<WAIT_ABANDONED_0+count)
+		bool TakeTaskFrom(SpinLock& lock, SchedulerTaskQueue& queue, SchedulerTask& task, bool back)
 		{
-			*abandoned=true;
-			return result-WAIT_ABANDONED_0;
+			if (queue.IsEmpty()) return false;
+			SPIN_LOCK(lock)
+			{
+				return back ? queue.PopBack(task) : queue.PopFront(task);
+			}
+			return false;
 		}
-		else
+
+		bool TakeTask(SchedulerWorker* worker, SchedulerTask& task)
 		{
-			return -1;
-		}
-	}
+			for (vint priority = 0; priority < 2; priority++)
+			{
+				if (worker && TakeTaskFrom(worker->locks[priority], worker->queues[priority], task, true))
+				{
+					return true;
+				}
 
-/***********************************************************************
-Thread
-***********************************************************************/
+				if (TakeTaskFrom(schedulerSharedLocks[priority], schedulerSharedQueues[priority], task, false))
+				{
+					return true;
+				}
 
-	namespace threading_internal
-	{
-		struct ThreadData : public WaitableData
-		{
-			DWORD						id;
+				if (worker)
+				{
+					vint count = schedulerWorkers.Count();
+					for (vint i = 1; i < count; i++)
+					{
+						auto victim = schedulerWorkers[(worker->index + i) % count];
+						if (TakeTaskFrom(victim->locks[priority], victim->queues[priority], task, false))
+						{
+							return true;
+						}
+					}
+				}
+			}
+			return false;
+		}
 
-			ThreadData()
-				:WaitableData(NULL)
+		void FinishGroupTask(TaskGroupData* group)
+		{
+			CS_LOCK(group->lock)
 			{
-				id=-1;
+				if (--group->pending == 0)
+				{
+					group->condition.WakeAllPendings();
+				}
 			}
-		};
+		}
 
-		class ProceduredThread : public Thread
+		bool RunNextTask(SchedulerWorker* worker)
 		{
-		private:
-			Thread::ThreadProcedure		procedure;
-			void*						argument;
-			bool						deleteAfterStopped;
+			SchedulerTask task;
+			if (!TakeTask(worker, task)) return false;
 
-		protected:
-			void Run()
+			if (!task.token || !task.token->IsCancelled())
 			{
-				bool deleteAfterStopped = this->deleteAfterStopped;
-				ThreadLocalStorage::FixStorages();
 				try
 				{
-					procedure(this, argument);
-					threadState=Thread::Stopped;
-					ThreadLocalStorage::ClearStorages();
+					task.proc();
 				}
 				catch (...)
 				{
-					ThreadLocalStorage::ClearStorages();
-					throw;
-				}
-				if(deleteAfterStopped)
-				{
-					delete this;
 				}
 			}
-		public:
-			ProceduredThread(Thread::ThreadProcedure _procedure, void* _argument, bool _deleteAfterStopped)
-				:procedure(_procedure)
-				,argument(_argument)
-				,deleteAfterStopped(_deleteAfterStopped)
+
+			if (task.group)
 			{
+				FinishGroupTask(task.group);
 			}
-		};
+			return true;
+		}
 
-		class LambdaThread : public Thread
+		void SchedulerWorkerProc(Thread* thread, void* argument)
 		{
-		private:
-			Func<void()>				procedure;
-			bool						deleteAfterStopped;
-
-		protected:
-			void Run()
+			auto worker = (SchedulerWorker*)argument;
+			worker->threadId = Thread::GetCurrentThreadId();
+			ThreadLocalStorage::FixStorages();
+			while (true)
 			{
-				bool deleteAfterStopped = this->deleteAfterStopped;
-				ThreadLocalStorage::FixStorages();
-				try
+				schedulerSemaphore.Wait();
+				while (RunNextTask(worker))
 				{
-					procedure();
-					threadState=Thread::Stopped;
 					ThreadLocalStorage::ClearStorages();
 				}
-				catch (...)
+
+				if (schedulerExiting)
 				{
-					ThreadLocalStorage::ClearStorages();
-					throw;
+					return;
 				}
-				if(deleteAfterStopped)
+			}
+		}
+
+		bool EnterScheduler()
+		{
+			while (true)
+			{
+				INCRC(&schedulerAccessing);
+				if (schedulerStopping)
 				{
-					delete this;
+					DECRC(&schedulerAccessing);
+					return false;
+				}
+				if (schedulerStarted)
+				{
+					return true;
+				}
+				DECRC(&schedulerAccessing);
+
+				SPIN_LOCK(schedulerLock)
+				{
+					if (!schedulerStarted && !schedulerStopping)
+					{
+						if (!schedulerSemaphoreCreated)
+						{
+							schedulerSemaphoreCreated = true;
+							schedulerSemaphore.Create(0, 65536);
+						}
+
+						vint count = GetDefaultWorkerCount();
+						for (vint i = 0; i < count; i++)
+						{
+							auto worker = new SchedulerWorker;
+							worker->index = i;
+							schedulerWorkers.Add(worker);
+						}
+						for (vint i = 0; i < count; i++)
+						{
+							auto worker = schedulerWorkers[i];
+							worker->thread = Thread::CreateAndStart(&SchedulerWorkerProc, worker, false);
+						}
+						schedulerExiting = false;
+						schedulerStarted = true;
+					}
 				}
 			}
-		public:
-			LambdaThread(const Func<void()>& _procedure, bool _deleteAfterStopped)
-				:procedure(_procedure)
-				,deleteAfterStopped(_deleteAfterStopped)
+		}
+
+		void LeaveScheduler()
+		{
+			DECRC(&schedulerAccessing);
+		}
+
+		SchedulerWorker* GetCurrentWorker()
+		{
+			// workers are only deleted inside schedulerLock, and they keep running tasks until they exit, even when the scheduler is stopping
+			SchedulerWorker* worker = nullptr;
+			SPIN_LOCK(schedulerLock)
 			{
+				if (schedulerStarted)
+				{
+					worker = FindCurrentWorker();
+				}
 			}
-		};
+			return worker;
+		}
+
+		void DiscardTasks(SpinLock& lock, SchedulerTaskQueue& queue)
+		{
+			while (true)
+			{
+				SchedulerTask task;
+				if (!TakeTaskFrom(lock, queue, task, false)) break;
+				if (task.group)
+				{
+					FinishGroupTask(task.group);
+				}
+			}
+		}
 	}
 
-	void InternalThreadProc(Thread* thread)
+	TaskScheduler::TaskScheduler()
 	{
-		thread->Run();
 	}
 
-	DWORD WINAPI InternalThreadProcWrapper(LPVOID lpParameter)
+	TaskScheduler::~TaskScheduler()
 	{
-		InternalThreadProc((Thread*)lpParameter);
-		return 0;
 	}
 
-	Thread::Thread()
+	bool TaskScheduler::Queue(const Func<void()>& proc, Priority priority, Ptr<CancellationToken> token, TaskGroup* group)
 	{
-		internalData=new ThreadData;
-		internalData->handle=CreateThread(NULL, 0, InternalThreadProcWrapper, this, CREATE_SUSPENDED, &internalData->id);
-		threadState=Thread::NotStarted;
-		SetData(internalData);
-	}
+		bool entered = EnterScheduler();
+		auto worker = entered ? FindCurrentWorker() : GetCurrentWorker();
+		if (!entered)
+		{
+			// when the scheduler is stopping, only tasks queued by running tasks are accepted, and only if pending tasks are not discarded
+			// the worker runs them before it exits, so Stop(false) still waits for them
+			if (!worker || schedulerDiscarding) return false;
+		}
 
-	Thread::~Thread()
-	{
-		if (internalData)
+		SchedulerTask task;
+		task.proc = proc;
+		task.token = token;
+		if (group)
 		{
-			Stop();
-			CloseHandle(internalData->handle);
-			delete internalData;
+			task.group = group->internalData;
+			CS_LOCK(task.group->lock)
+			{
+				task.group->pending++;
+			}
 		}
-	}
 
-	Thread* Thread::CreateAndStart(ThreadProcedure procedure, void* argument, bool deleteAfterStopped)
-	{
-		if(procedure)
+		if (worker)
 		{
-			Thread* thread=new ProceduredThread(procedure, argument, deleteAfterStopped);
-			if(thread->Start())
+			SPIN_LOCK(worker->locks[priority])
 			{
-				return thread;
+				worker->queues[priority].PushBack(task);
 			}
-			else
+		}
+		else
+		{
+			SPIN_LOCK(schedulerSharedLocks[priority])
 			{
-				delete thread;
+				schedulerSharedQueues[priority].PushBack(task);
 			}
 		}
-		return 0;
-	}
-
-	Thread* Thread::CreateAndStart(const Func<void()>& procedure, bool deleteAfterStopped)
-	{
-		Thread* thread=new LambdaThread(procedure, deleteAfterStopped);
-		if(thread->Start())
+		schedulerSemaphore.Release();
+		if (entered)
 		{
-			return thread;
+			LeaveScheduler();
 		}
-		else
+
+		if (group)
 		{
-			delete thread;
+			CS_LOCK(task.group->lock)
+			{
+				task.group->version++;
+				task.group->condition.WakeAllPendings();
+			}
 		}
-		return 0;
+		return true;
 	}
 
-	void Thread::Sleep(vint ms)
+	void TaskScheduler::SetWorkerCount(vint count)
 	{
-		::Sleep((DWORD)ms);
+		SPIN_LOCK(schedulerLock)
+		{
+			schedulerWorkerCount = count;
+		}
 	}
 
-	
-	vint Thread::GetCPUCount()
+	vint TaskScheduler::GetWorkerCount()
 	{
-		SYSTEM_INFO info;
-		GetSystemInfo(&info);
-		return info.dwNumberOfProcessors;
+		SPIN_LOCK(schedulerLock)
+		{
+			return schedulerStarted ? schedulerWorkers.Count() : GetDefaultWorkerCount();
+		}
+		return 0;
 	}
 
-	vint Thread::GetCurrentThreadId()
+	bool TaskScheduler::IsWorkerThread()
 	{
-		return (vint)::GetCurrentThreadId();
+		return GetCurrentWorker() != nullptr;
 	}
 
-	bool Thread::Start()
+	bool TaskScheduler::Stop(bool discardPendingTasks)
 	{
-		if(threadState==Thread::NotStarted && internalData->handle!=NULL)
+		SPIN_LOCK(schedulerLock)
 		{
-			if(ResumeThread(internalData->handle)!=-1)
+			if (!schedulerStarted) return false;
+			if (schedulerStopping) return false;
+			schedulerDiscarding = discardPendingTasks;
+			INCRC(&schedulerStopping);
+		}
+
+		while (schedulerAccessing > 0)
+		{
+			Thread::Sleep(0);
+		}
+
+		if (discardPendingTasks)
+		{
+			for (vint priority = 0; priority < 2; priority++)
 			{
-				threadState=Thread::Running;
-				return true;
+				DiscardTasks(schedulerSharedLocks[priority], schedulerSharedQueues[priority]);
+				for (vint i = 0; i < schedulerWorkers.Count(); i++)
+				{
+					auto worker = schedulerWorkers[i];
+					DiscardTasks(worker->locks[priority], worker->queues[priority]);
+				}
 			}
 		}
-		return false;
-	}
 
-	bool Thread::Stop()
-	{
-		if(internalData->handle!=NULL)
+		schedulerExiting = true;
+		schedulerSemaphore.Release(schedulerWorkers.Count());
+		for (vint i = 0; i < schedulerWorkers.Count(); i++)
 		{
-			if (SuspendThread(internalData->handle) != -1)
+			schedulerWorkers[i]->thread->Wait();
+		}
+
+		SPIN_LOCK(schedulerLock)
+		{
+			for (vint i = 0; i < schedulerWorkers.Count(); i++)
 			{
-				threadState=Thread::Stopped;
-				return true;
+				auto worker = schedulerWorkers[i];
+				delete worker->thread;
+				delete worker;
 			}
+			schedulerWorkers.Clear();
+			schedulerStarted = false;
+			schedulerDiscarding = false;
+			DECRC(&schedulerStopping);
 		}
-		return false;
+		return true;
 	}
 
-	Thread::ThreadState Thread::GetState()
-	{
-		return threadState;
-	}
+/***********************************************************************
+TaskGroup
+***********************************************************************/
 
-	void Thread::SetCPU(vint index)
+	TaskGroup::TaskGroup(TaskScheduler::Priority priority)
+		:internalData(new TaskGroupData)
 	{
-		SetThreadAffinityMask(internalData->handle, ((vint)1 << index));
+		internalData->priority = priority;
+		internalData->token = new CancellationToken;
 	}
 
-/***********************************************************************
-Mutex
-***********************************************************************/
-
-	namespace threading_internal
+	TaskGroup::~TaskGroup()
 	{
-		struct MutexData : public WaitableData
-		{
-			MutexData(HANDLE _handle)
-				:WaitableData(_handle)
-			{
-			}
-		};
+		Join();
+		delete internalData;
 	}
 
-	Mutex::Mutex()
-		:internalData(0)
+	bool TaskGroup::Run(const Func<void()>& proc)
 	{
+		return TaskScheduler::Queue(proc, internalData->priority, internalData->token, this);
 	}
 
-	Mutex::~Mutex()
+	void TaskGroup::Cancel()
 	{
-		if(internalData)
-		{
-			CloseHandle(internalData->handle);
-			delete internalData;
-		}
+		internalData->token->Cancel();
 	}
 
-	bool Mutex::Create(bool owned, const WString& name)
+	bool TaskGroup::IsCancelled()
 	{
-		if(IsCreated())return false;
-		BOOL aOwned=owned?TRUE:FALSE;
-		LPCTSTR aName=name==L""?NULL:name.Buffer();
-		HANDLE handle=CreateMutex(NULL, aOwned, aName);
-		if(handle)
-		{
-			internalData=new MutexData(handle);
-			SetData(internalData);
-		}
-		return IsCreated();
+		return internalData->token->IsCancelled();
 	}
 
-	bool Mutex::Open(bool inheritable, const WString& name)
+	Ptr<CancellationToken> TaskGroup::GetToken()
 	{
-		if(IsCreated())return false;
-		BOOL aInteritable=inheritable?TRUE:FALSE;
-		HANDLE handle=OpenMutex(SYNCHRONIZE, aInteritable, name.Buffer());
-		if(handle)
-		{
-			internalData=new MutexData(handle);
-			SetData(internalData);
-		}
-		return IsCreated();
+		return internalData->token;
 	}
 
-	bool Mutex::Release()
+	void TaskGroup::Join()
 	{
-		if(IsCreated())
+		auto worker = GetCurrentWorker();
+
+		while (true)
 		{
-			return ReleaseMutex(internalData->handle)!=0;
+			vint version = 0;
+			CS_LOCK(internalData->lock)
+			{
+				if (!worker)
+				{
+					while (internalData->pending > 0)
+					{
+						internalData->condition.SleepWith(internalData->lock);
+					}
+				}
+				if (internalData->pending == 0)
+				{
+					return;
+				}
+				version = internalData->version;
+			}
+
+			if (RunNextTask(worker))
+			{
+				continue;
+			}
+
+			CS_LOCK(internalData->lock)
+			{
+				if (internalData->pending > 0 && internalData->version == version)
+				{
+					internalData->condition.SleepWith(internalData->lock);
+				}
+			}
 		}
-		return false;
 	}
+}
 
 /***********************************************************************
-Semaphore
+THREADING.CPP
+***********************************************************************/
+#ifdef VCZH_MSVC
+
+namespace vl
+{
+	using namespace threading_internal;
+	using namespace collections;
+
+/***********************************************************************
+WaitableObject
 ***********************************************************************/
 
 	namespace threading_internal
 	{
-		struct SemaphoreData : public WaitableData
+		struct WaitableData
 		{
-			SemaphoreData(HANDLE _handle)
-				:WaitableData(_handle)
+			HANDLE			handle;
+
+			WaitableData(HANDLE _handle)
+				:handle(_handle)
 			{
 			}
 		};
 	}
 
-	Semaphore::Semaphore()
-		:internalData(0)
+	WaitableObject::WaitableObject()
+		:waitableData(0)
 	{
 	}
 
-	Semaphore::~Semaphore()
+	void WaitableObject::SetData(threading_internal::WaitableData* data)
 	{
-		if(internalData)
-		{
-			CloseHandle(internalData->handle);
-			delete internalData;
-		}
+		waitableData=data;
 	}
 
-	bool Semaphore::Create(vint initialCount, vint maxCount, const WString& name)
+	bool WaitableObject::IsCreated()
 	{
-		if(IsCreated())return false;
-		LONG aInitial=(LONG)initialCount;
-		LONG aMax=(LONG)maxCount;
-		LPCTSTR aName=name==L""?NULL:name.Buffer();
-		HANDLE handle=CreateSemaphore(NULL, aInitial, aMax, aName);
-		if(handle)
-		{
-			internalData=new SemaphoreData(handle);
-			SetData(internalData);
-		}
-		return IsCreated();
+		return waitableData!=0;
 	}
 
-	bool Semaphore::Open(bool inheritable, const WString& name)
+	bool WaitableObject::Wait()
 	{
-		if(IsCreated())return false;
-		BOOL aInteritable=inheritable?TRUE:FALSE;
-		HANDLE handle=OpenSemaphore(SYNCHRONIZE, aInteritable, name.Buffer());
-		if(handle)
-		{
-			internalData=new SemaphoreData(handle);
-			SetData(internalData);
-		}
-		return IsCreated();
+		return WaitForTime(INFINITE);
 	}
 
-	bool Semaphore::Release()
+	bool WaitableObject::WaitForTime(vint ms)
 	{
 		if(IsCreated())
 		{
-			return Release(1)!=-1;
+			if(WaitForSingleObject(waitableData->handle, (DWORD)ms)==WAIT_OBJECT_0)
+			{
+				return true;
+			}
 		}
 		return false;
 	}
 
-	vint Semaphore::Release(vint count)
+	bool WaitableObject::WaitAll(WaitableObject** objects, vint count)
 	{
-		if(IsCreated())
+		Array<HANDLE> handles(count);
+		for(vint i=0;i<count;i++)
 		{
-			LONG previous=-1;
-			if(ReleaseSemaphore(internalData->handle, (LONG)count, &previous)!=0)
-			{
-				return (vint)previous;
-			}
+			handles[i]=objects[i]->waitableData->handle;
 		}
-		return -1;
-	}
-
-/***********************************************************************
-EventObject
-***********************************************************************/
+		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], TRUE, INFINITE);
+		return result==WAIT_OBJECT_0 || result==WAIT_ABANDONED_0;
 
-	namespace threading_internal
-	{
-		struct EventData : public WaitableData
-		{
-			EventData(HANDLE _handle)
-				:WaitableData(_handle)
-			{
-			}
-		};
 	}
 
-	EventObject::EventObject()
-		:internalData(0)
+	bool WaitableObject::WaitAllForTime(WaitableObject** objects, vint count, vint ms)
 	{
-	}
-
-	EventObject::~EventObject()
-	{
-		if(internalData)
+		Array<HANDLE> handles(count);
+		for(vint i=0;i<count;i++)
 		{
-			CloseHandle(internalData->handle);
-			delete internalData;
+			handles[i]=objects[i]->waitableData->handle;
 		}
+		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], TRUE, (DWORD)ms);
+		return result==WAIT_OBJECT_0 || result==WAIT_ABANDONED_0;
 	}
 
-	bool EventObject::CreateAutoUnsignal(bool signaled, const WString& name)
+	vint WaitableObject::WaitAny(WaitableObject** objects, vint count, bool* abandoned)
 	{
-		if(IsCreated())return false;
-		BOOL aSignaled=signaled?TRUE:FALSE;
-		LPCTSTR aName=name==L""?NULL:name.Buffer();
-		HANDLE handle=CreateEvent(NULL, FALSE, aSignaled, aName);
-		if(handle)
+		Array<HANDLE> handles(count);
+		for(vint i=0;i<count;i++)
 		{
-			internalData=new EventData(handle);
-			SetData(internalData);
+			handles[i]=objects[i]->waitableData->handle;
 		}
-		return IsCreated();
-	}
-
-	bool EventObject::CreateManualUnsignal(bool signaled, const WString& name)
-	{
-		if(IsCreated())return false;
-		BOOL aSignaled=signaled?TRUE:FALSE;
-		LPCTSTR aName=name==L""?NULL:name.Buffer();
-		HANDLE handle=CreateEvent(NULL, TRUE, aSignaled, aName);
-		if(handle)
+		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], FALSE, INFINITE);
+		if(WAIT_OBJECT_0 <= result && result<WAIT_OBJECT_0+count)
 		{
-			internalData=new EventData(handle);
-			SetData(internalData);
+			*abandoned=false;
+			return result-WAIT_OBJECT_0;
 		}
-		return IsCreated();
-	}
-
-	bool EventObject::Open(bool inheritable, const WString& name)
-	{
-		if(IsCreated())return false;
-		BOOL aInteritable=inheritable?TRUE:FALSE;
-		HANDLE handle=OpenEvent(SYNCHRONIZE, aInteritable, name.Buffer());
-		if(handle)
+		else if(WAIT_ABANDONED_0 <= result && result<WAIT_ABANDONED_0+count)
 		{
-			internalData=new EventData(handle);
-			SetData(internalData);
+			*abandoned=true;
+			return result-WAIT_ABANDONED_0;
 		}
-		return IsCreated();
-	}
-
-	bool EventObject::Signal()
-	{
-		if(IsCreated())
+		else
 		{
-			return SetEvent(internalData->handle)!=0;
+			return -1;
 		}
-		return false;
 	}
 
-	bool EventObject::Unsignal()
+	vint WaitableObject::WaitAnyForTime(WaitableObject** objects, vint count, vint ms, bool* abandoned)
 	{
-		if(IsCreated())
+		Array<HANDLE> handles(count);
+		for(vint i=0;i<count;i++)
 		{
-			return ResetEvent(internalData->handle)!=0;
+			handles[i]=objects[i]->waitableData->handle;
+		}
+		DWORD result=WaitForMultipleObjects((DWORD)count, &handles[0], FALSE, (DWORD)ms);
+		if(WAIT_OBJECT_0 <= result && result<WAIT_OBJECT_0+count)
+		{
+			*abandoned=false;
+			return result-WAIT_OBJECT_0;
+		}
+		else if(WAIT_ABANDONED_0 <= result && result<WAIT_ABANDONED_0+count)
+		{
+			*abandoned=true;
+			return result-WAIT_ABANDONED_0;
+		}
+		else
+		{
+			return -1;
 		}
-		return false;
 	}
 
 /***********************************************************************
-ThreadPoolLite
+Thread
 ***********************************************************************/
 
-		struct ThreadPoolQueueProcArgument
-		{
-			void(*proc)(void*);
-			void* argument;
-		};
-
-		DWORD WINAPI ThreadPoolQueueProc(void* argument)
+	namespace threading_internal
+	{
+		struct ThreadData : public WaitableData
 		{
-			Ptr<ThreadPoolQueueProcArgument> proc=(ThreadPoolQueueProcArgument*)argument;
-			ThreadLocalStorage::FixStorages();
-			try
-			{
-				proc->proc(proc->argument);
-				ThreadLocalStorage::ClearStorages();
-			}
-			catch (...)
-			{
-				ThreadLocalStorage::ClearStorages();
-			}
-			return 0;
-		}
+			DWORD						id;
 
-		DWORD WINAPI ThreadPoolQueueFunc(void* argument)
-		{
-			Ptr<Func<void()>> proc=(Func<void()>*)argument;
-			ThreadLocalStorage::FixStorages();
-			try
-			{
-				(*proc.Obj())();
-				ThreadLocalStorage::ClearStorages();
-			}
-			catch (...)
+			ThreadData()
+				:WaitableData(NULL)
 			{
-				ThreadLocalStorage::ClearStorages();
+				id=-1;
 			}
-			return 0;
-		}
-
-		ThreadPoolLite::ThreadPoolLite()
-		{
-		}
+		};
 
-		ThreadPoolLite::~ThreadPoolLite()
+		class ProceduredThread : public Thread
 		{
-		}
+		private:
+			Thread::ThreadProcedure		procedure;
+			void*						argument;
+			bool						deleteAfterStopped;
 
-		bool ThreadPoolLite::Queue(void(*proc)(void*), void* argument)
-		{
-			ThreadPoolQueueProcArgument* p=new ThreadPoolQueueProcArgument;
-			p->proc=proc;
-			p->argument=argument;
-			if(QueueUserWorkItem(&ThreadPoolQueueProc, p, WT_EXECUTEDEFAULT))
+		protected:
+			void Run()
 			{
-				return true;
+				bool deleteAfterStopped = this->deleteAfterStopped;
+				ThreadLocalStorage::FixStorages();
+				try
+				{
+					procedure(this, argument);
+					threadState=Thread::Stopped;
+					ThreadLocalStorage::ClearStorages();
+				}
+				catch (...)
+				{
+					ThreadLocalStorage::ClearStorages();
+					throw;
+				}
+				if(deleteAfterStopped)
+				{
+					delete this;
+				}
 			}
-			else
+		public:
+			ProceduredThread(Thread::ThreadProcedure _procedure, void* _argument, bool _deleteAfterStopped)
+				:procedure(_procedure)
+				,argument(_argument)
+				,deleteAfterStopped(_deleteAfterStopped)
 			{
-				delete p;
-				return false;
 			}
-		}
+		};
 
-		bool ThreadPoolLite::Queue(const Func<void()>& proc)
+		class LambdaThread : public Thread
 		{
-			Func<void()>* p=new Func<void()>(proc);
-			if(QueueUserWorkItem(&ThreadPoolQueueFunc, p, WT_EXECUTEDEFAULT))
+		private:
+			Func<void()>				procedure;
+			bool						deleteAfterStopped;
+
+		protected:
+			void Run()
 			{
-				return true;
+				bool deleteAfterStopped = this->deleteAfterStopped;
+				ThreadLocalStorage::FixStorages();
+				try
+				{
+					procedure();
+					threadState=Thread::Stopped;
+					ThreadLocalStorage::ClearStorages();
+				}
+				catch (...)
+				{
+					ThreadLocalStorage::ClearStorages();
+					throw;
+				}
+				if(deleteAfterStopped)
+				{
+					delete this;
+				}
 			}
-			else
+		public:
+			LambdaThread(const Func<void()>& _procedure, bool _deleteAfterStopped)
+				:procedure(_procedure)
+				,deleteAfterStopped(_deleteAfterStopped)
 			{
-				delete p;
-				return false;
 			}
-		}
-
-/***********************************************************************
-CriticalSection
-***********************************************************************/
-
-	namespace threading_internal
-	{
-		struct CriticalSectionData
-		{
-			CRITICAL_SECTION		criticalSection;
 		};
 	}
 
-	CriticalSection::Scope::Scope(CriticalSection& _criticalSection)
-		:criticalSection(&_criticalSection)
+	void InternalThreadProc(Thread* thread)
 	{
-		criticalSection->Enter();
+		thread->Run();
 	}
 
-	CriticalSection::Scope::~Scope()
-	{
-		criticalSection->Leave();
-	}
-			
-	CriticalSection::CriticalSection()
+	DWORD WINAPI InternalThreadProcWrapper(LPVOID lpParameter)
 	{
-		internalData=new CriticalSectionData;
-		InitializeCriticalSection(&internalData->criticalSection);
+		InternalThreadProc((Thread*)lpParameter);
+		return 0;
 	}
 
-	CriticalSection::~CriticalSection()
+	Thread::Thread()
 	{
-		DeleteCriticalSection(&internalData->criticalSection);
-		delete internalData;
+		internalData=new ThreadData;
+		internalData->handle=CreateThread(NULL, 0, InternalThreadProcWrapper, this, CREATE_SUSPENDED, &internalData->id);
+		threadState=Thread::NotStarted;
+		SetData(internalData);
 	}
 
-	bool CriticalSection::TryEnter()
+	Thread::~Thread()
 	{
-		return TryEnterCriticalSection(&internalData->criticalSection)!=0;
+		if (internalData)
+		{
+			Stop();
+			CloseHandle(internalData->handle);
+			delete internalData;
+		}
 	}
 
-	void CriticalSection::Enter()
+	Thread* Thread::CreateAndStart(ThreadProcedure procedure, void* argument, bool deleteAfterStopped)
 	{
-		EnterCriticalSection(&internalData->criticalSection);
+		if(procedure)
+		{
+			Thread* thread=new ProceduredThread(procedure, argument, deleteAfterStopped);
+			if(thread->Start())
+			{
+				return thread;
+			}
+			else
+			{
+				delete thread;
+			}
+		}
+		return 0;
 	}
 
-	void CriticalSection::Leave()
+	Thread* Thread::CreateAndStart(const Func<void()>& procedure, bool deleteAfterStopped)
 	{
-		LeaveCriticalSection(&internalData->criticalSection);
+		Thread* thread=new LambdaThread(procedure, deleteAfterStopped);
+		if(thread->Start())
+		{
+			return thread;
+		}
+		else
+		{
+			delete thread;
+		}
+		return 0;
 	}
 
-/***********************************************************************
-ReaderWriterLock
-***********************************************************************/
-
-	namespace threading_internal
+	void Thread::Sleep(vint ms)
 	{
-		struct ReaderWriterLockData
-		{
-			SRWLOCK			lock;
-		};
+		::Sleep((DWORD)ms);
 	}
 
-	ReaderWriterLock::ReaderScope::ReaderScope(ReaderWriterLock& _lock)
-		:lock(&_lock)
+	
+	vint Thread::GetCPUCount()
 	{
-		lock->EnterReader();
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwNumberOfProcessors;
 	}
 
-	ReaderWriterLock::ReaderScope::~ReaderScope()
+	vint Thread::GetCurrentThreadId()
 	{
-		lock->LeaveReader();
+		return (vint)::GetCurrentThreadId();
 	}
 
-	ReaderWriterLock::WriterScope::WriterScope(ReaderWriterLock& _lock)
-		:lock(&_lock)
+	bool Thread::Start()
 	{
-		lock->EnterWriter();
+		if(threadState==Thread::NotStarted && internalData->handle!=NULL)
+		{
+			if(ResumeThread(internalData->handle)!=-1)
+			{
+				threadState=Thread::Running;
+				return true;
+			}
+		}
+		return false;
 	}
 
-	ReaderWriterLock::WriterScope::~WriterScope()
+	bool Thread::Stop()
 	{
-		lock->LeaveWriter();
+		if(internalData->handle!=NULL)
+		{
+			if (SuspendThread(internalData->handle) != -1)
+			{
+				threadState=Thread::Stopped;
+				return true;
+			}
+		}
+		return false;
 	}
 
-	ReaderWriterLock::ReaderWriterLock()
-		:internalData(new threading_internal::ReaderWriterLockData)
+	Thread::ThreadState Thread::GetState()
 	{
-		InitializeSRWLock(&internalData->lock);
+		return threadState;
 	}
 
-	ReaderWriterLock::~ReaderWriterLock()
+	void Thread::SetCPU(vint index)
 	{
-		delete internalData;
+		SetThreadAffinityMask(internalData->handle, ((vint)1 << index));
 	}
 
-	bool ReaderWriterLock::TryEnterReader()
+/***********************************************************************
+Mutex
+***********************************************************************/
+
+	namespace threading_internal
 	{
-		return TryAcquireSRWLockShared(&internalData->lock)!=0;
+		struct MutexData : public WaitableData
+		{
+			MutexData(HANDLE _handle)
+				:WaitableData(_handle)
+			{
+			}
+		};
 	}
 
-	void ReaderWriterLock::EnterReader()
+	Mutex::Mutex()
+		:internalData(0)
 	{
-		AcquireSRWLockShared(&internalData->lock);
 	}
 
-	void ReaderWriterLock::LeaveReader()
+	Mutex::~Mutex()
 	{
-		ReleaseSRWLockShared(&internalData->lock);
+		if(internalData)
+		{
+			CloseHandle(internalData->handle);
+			delete internalData;
+		}
 	}
 
-	bool ReaderWriterLock::TryEnterWriter()
+	bool Mutex::Create(bool owned, const WString& name)
 	{
-		return TryAcquireSRWLockExclusive(&internalData->lock)!=0;
+		if(IsCreated())return false;
+		BOOL aOwned=owned?TRUE:FALSE;
+		LPCTSTR aName=name==L""?NULL:name.Buffer();
+		HANDLE handle=CreateMutex(NULL, aOwned, aName);
+		if(handle)
+		{
+			internalData=new MutexData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-	void ReaderWriterLock::EnterWriter()
+	bool Mutex::Open(bool inheritable, const WString& name)
 	{
-		AcquireSRWLockExclusive(&internalData->lock);
+		if(IsCreated())return false;
+		BOOL aInteritable=inheritable?TRUE:FALSE;
+		HANDLE handle=OpenMutex(SYNCHRONIZE, aInteritable, name.Buffer());
+		if(handle)
+		{
+			internalData=new MutexData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-	void ReaderWriterLock::LeaveWriter()
+	bool Mutex::Release()
 	{
-		ReleaseSRWLockExclusive(&internalData->lock);
+		if(IsCreated())
+		{
+			return ReleaseMutex(internalData->handle)!=0;
+		}
+		return false;
 	}
 
 /***********************************************************************
-ConditionVariable
+Semaphore
 ***********************************************************************/
 
 	namespace threading_internal
 	{
-		struct ConditionVariableData
+		struct SemaphoreData : public WaitableData
 		{
-			CONDITION_VARIABLE			variable;
+			SemaphoreData(HANDLE _handle)
+				:WaitableData(_handle)
+			{
+			}
 		};
 	}
 
-	ConditionVariable::ConditionVariable()
-		:internalData(new threading_internal::ConditionVariableData)
+	Semaphore::Semaphore()
+		:internalData(0)
 	{
-		InitializeConditionVariable(&internalData->variable);
 	}
 
-	ConditionVariable::~ConditionVariable()
+	Semaphore::~Semaphore()
 	{
-		delete internalData;
+		if(internalData)
+		{
+			CloseHandle(internalData->handle);
+			delete internalData;
+		}
 	}
 
-	bool ConditionVariable::SleepWith(CriticalSection& cs)
+	bool Semaphore::Create(vint initialCount, vint maxCount, const WString& name)
 	{
-		return SleepConditionVariableCS(&internalData->variable, &cs.internalData->criticalSection, INFINITE)!=0;
+		if(IsCreated())return false;
+		LONG aInitial=(LONG)initialCount;
+		LONG aMax=(LONG)maxCount;
+		LPCTSTR aName=name==L""?NULL:name.Buffer();
+		HANDLE handle=CreateSemaphore(NULL, aInitial, aMax, aName);
+		if(handle)
+		{
+			internalData=new SemaphoreData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-	bool ConditionVariable::SleepWithForTime(CriticalSection& cs, vint ms)
+	bool Semaphore::Open(bool inheritable, const WString& name)
 	{
-		return SleepConditionVariableCS(&internalData->variable, &cs.internalData->criticalSection, (DWORD)ms)!=0;
+		if(IsCreated())return false;
+		BOOL aInteritable=inheritable?TRUE:FALSE;
+		HANDLE handle=OpenSemaphore(SYNCHRONIZE, aInteritable, name.Buffer());
+		if(handle)
+		{
+			internalData=new SemaphoreData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-	bool ConditionVariable::SleepWithReader(ReaderWriterLock& lock)
+	bool Semaphore::Release()
 	{
-		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, INFINITE, CONDITION_VARIABLE_LOCKMODE_SHARED)!=0;
+		if(IsCreated())
+		{
+			return Release(1)!=-1;
+		}
+		return false;
 	}
 
-	bool ConditionVariable::SleepWithReaderForTime(ReaderWriterLock& lock, vint ms)
+	vint Semaphore::Release(vint count)
 	{
-		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, (DWORD)ms, CONDITION_VARIABLE_LOCKMODE_SHARED)!=0;
+		if(IsCreated())
+		{
+			LONG previous=-1;
+			if(ReleaseSemaphore(internalData->handle, (LONG)count, &previous)!=0)
+			{
+				return (vint)previous;
+			}
+		}
+		return -1;
 	}
 
-	bool ConditionVariable::SleepWithWriter(ReaderWriterLock& lock)
+/***********************************************************************
+EventObject
+***********************************************************************/
+
+	namespace threading_internal
 	{
-		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, INFINITE, 0)!=0;
+		struct EventData : public WaitableData
+		{
+			EventData(HANDLE _handle)
+				:WaitableData(_handle)
+			{
+			}
+		};
 	}
 
-	bool ConditionVariable::SleepWithWriterForTime(ReaderWriterLock& lock, vint ms)
+	EventObject::EventObject()
+		:internalData(0)
 	{
-		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, (DWORD)ms, 0)!=0;
 	}
 
-	void ConditionVariable::WakeOnePending()
+	EventObject::~EventObject()
 	{
-		WakeConditionVariable(&internalData->variable);
+		if(internalData)
+		{
+			CloseHandle(internalData->handle);
+			delete internalData;
+		}
 	}
 
-	void ConditionVariable::WakeAllPendings()
+	bool EventObject::CreateAutoUnsignal(bool signaled, const WString& name)
 	{
-		WakeAllConditionVariable(&internalData->variable);
+		if(IsCreated())return false;
+		BOOL aSignaled=signaled?TRUE:FALSE;
+		LPCTSTR aName=name==L""?NULL:name.Buffer();
+		HANDLE handle=CreateEvent(NULL, FALSE, aSignaled, aName);
+		if(handle)
+		{
+			internalData=new EventData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-/***********************************************************************
-SpinLock
-***********************************************************************/
-
-	SpinLock::Scope::Scope(SpinLock& _spinLock)
-		:spinLock(&_spinLock)
+	bool EventObject::CreateManualUnsignal(bool signaled, const WString& name)
 	{
-		spinLock->Enter();
+		if(IsCreated())return false;
+		BOOL aSignaled=signaled?TRUE:FALSE;
+		LPCTSTR aName=name==L""?NULL:name.Buffer();
+		HANDLE handle=CreateEvent(NULL, TRUE, aSignaled, aName);
+		if(handle)
+		{
+			internalData=new EventData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-	SpinLock::Scope::~Scope()
-	{
-		spinLock->Leave();
-	}
-			
-	SpinLock::SpinLock()
-		:token(0)
+	bool EventObject::Open(bool inheritable, const WString& name)
 	{
+		if(IsCreated())return false;
+		BOOL aInteritable=inheritable?TRUE:FALSE;
+		HANDLE handle=OpenEvent(SYNCHRONIZE, aInteritable, name.Buffer());
+		if(handle)
+		{
+			internalData=new EventData(handle);
+			SetData(internalData);
+		}
+		return IsCreated();
 	}
 
-	SpinLock::~SpinLock()
+	bool EventObject::Signal()
 	{
+		if(IsCreated())
+		{
+			return SetEvent(internalData->handle)!=0;
+		}
+		return false;
 	}
 
-	bool SpinLock::TryEnter()
+	bool EventObject::Unsignal()
 	{
-		return _InterlockedExchange(&token, 1)==0;
+		if(IsCreated())
+		{
+			return ResetEvent(internalData->handle)!=0;
+		}
+		return false;
 	}
 
-	void SpinLock::Enter()
-	{
-		while(_InterlockedCompareExchange(&token, 1, 0)!=0)
+/***********************************************************************
+ThreadPoolLite
+***********************************************************************/
+
+		struct ThreadPoolQueueProcArgument
 		{
-			while(token!=0) _mm_pause();
+			void(*proc)(void*);
+			void* argument;
+		};
+
+		DWORD WINAPI ThreadPoolQueueProc(void* argument)
+		{
+			Ptr<ThreadPoolQueueProcArgument> proc=(ThreadPoolQueueProcArgument*)argument;
+			ThreadLocalStorage::FixStorages();
+			try
+			{
+				proc->proc(proc->argument);
+				ThreadLocalStorage::ClearStorages();
+			}
+			catch (...)
+			{
+				ThreadLocalStorage::ClearStorages();
+			}
+			return 0;
 		}
-	}
 
-	void SpinLock::Leave()
-	{
-		_InterlockedExchange(&token, 0);
-	}
+		DWORD WINAPI ThreadPoolQueueFunc(void* argument)
+		{
+			Ptr<Func<void()>> proc=(Func<void()>*)argument;
+			ThreadLocalStorage::FixStorages();
+			try
+			{
+				(*proc.Obj())();
+				ThreadLocalStorage::ClearStorages();
+			}
+			catch (...)
+			{
+				ThreadLocalStorage::ClearStorages();
+			}
+			return 0;
+		}
+
+		ThreadPoolLite::ThreadPoolLite()
+		{
+		}
+
+		ThreadPoolLite::~ThreadPoolLite()
+		{
+		}
+
+		bool ThreadPoolLite::Queue(void(*proc)(void*), void* argument)
+		{
+			ThreadPoolQueueProcArgument* p=new ThreadPoolQueueProcArgument;
+			p->proc=proc;
+			p->argument=argument;
+			if(QueueUserWorkItem(&ThreadPoolQueueProc, p, WT_EXECUTEDEFAULT))
+			{
+				return true;
+			}
+			else
+			{
+				delete p;
+				return false;
+			}
+		}
+
+		bool ThreadPoolLite::Queue(const Func<void()>& proc)
+		{
+			Func<void()>* p=new Func<void()>(proc);
+			if(QueueUserWorkItem(&ThreadPoolQueueFunc, p, WT_EXECUTEDEFAULT))
+			{
+				return true;
+			}
+			else
+			{
+				delete p;
+				return false;
+			}
+		}
 
 /***********************************************************************
-ThreadLocalStorage
+CriticalSection
 ***********************************************************************/
 
-#define KEY ((DWORD&)key)
+	namespace threading_internal
+	{
+		struct CriticalSectionData
+		{
+			CRITICAL_SECTION		criticalSection;
+		};
+	}
 
-	ThreadLocalStorage::ThreadLocalStorage(Destructor _destructor)
-		:destructor(_destructor)
+	CriticalSection::Scope::Scope(CriticalSection& _criticalSection)
+		:criticalSection(&_criticalSection)
 	{
-		static_assert(sizeof(key) >= sizeof(DWORD), "ThreadLocalStorage's key storage is not large enouth.");
-		PushStorage(this);
-		KEY = TlsAlloc();
-		CHECK_ERROR(KEY != TLS_OUT_OF_INDEXES, L"vl::ThreadLocalStorage::ThreadLocalStorage()#Failed to alloc new thread local storage index.");
+		criticalSection->Enter();
 	}
 
-	ThreadLocalStorage::~ThreadLocalStorage()
+	CriticalSection::Scope::~Scope()
 	{
-		TlsFree(KEY);
+		criticalSection->Leave();
+	}
+			
+	CriticalSection::CriticalSection()
+	{
+		internalData=new CriticalSectionData;
+		InitializeCriticalSection(&internalData->criticalSection);
 	}
 
-	void* ThreadLocalStorage::Get()
+	CriticalSection::~CriticalSection()
 	{
-		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Get()#Cannot access a disposed ThreadLocalStorage.");
-		return TlsGetValue(KEY);
+		DeleteCriticalSection(&internalData->criticalSection);
+		delete internalData;
 	}
 
-	void ThreadLocalStorage::Set(void* data)
+	bool CriticalSection::TryEnter()
 	{
-		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Set()#Cannot access a disposed ThreadLocalStorage.");
-		TlsSetValue(KEY, data);
+		return TryEnterCriticalSection(&internalData->criticalSection)!=0;
 	}
 
-#undef KEY
-}
-#endif
+	void CriticalSection::Enter()
+	{
+		EnterCriticalSection(&internalData->criticalSection);
+	}
+
+	void CriticalSection::Leave()
+	{
+		LeaveCriticalSection(&internalData->criticalSection);
+	}
 
 /***********************************************************************
-ThreadLocalStorage Common Implementations
+ReaderWriterLock
 ***********************************************************************/
 
-namespace vl
-{
-	void ThreadLocalStorage::Clear()
+	namespace threading_internal
 	{
-		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Clear()#Cannot access a disposed ThreadLocalStorage.");
-		if(destructor)
+		struct ReaderWriterLockData
 		{
-			if (auto data = Get())
-			{
-				destructor(data);
-			}
-		}
-		Set(nullptr);
+			SRWLOCK			lock;
+		};
 	}
 
-	void ThreadLocalStorage::Dispose()
+	ReaderWriterLock::ReaderScope::ReaderScope(ReaderWriterLock& _lock)
+		:lock(&_lock)
 	{
-		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Dispose()#Cannot access a disposed ThreadLocalStorage.");
-		Clear();
-		disposed = true;
+		lock->EnterReader();
 	}
 
-	struct TlsStorageLink
+	ReaderWriterLock::ReaderScope::~ReaderScope()
 	{
-		ThreadLocalStorage*		storage = nullptr;
-		TlsStorageLink*			next = nullptr;
-	};
+		lock->LeaveReader();
+	}
 
-	volatile bool				tlsFixed = false;
-	TlsStorageLink*				tlsHead = nullptr;
-	TlsStorageLink**			tlsTail = &tlsHead;
+	ReaderWriterLock::WriterScope::WriterScope(ReaderWriterLock& _lock)
+		:lock(&_lock)
+	{
+		lock->EnterWriter();
+	}
 
-	void ThreadLocalStorage::PushStorage(ThreadLocalStorage* storage)
+	ReaderWriterLock::WriterScope::~WriterScope()
 	{
-		CHECK_ERROR(!tlsFixed, L"vl::ThreadLocalStorage::PushStorage(ThreadLocalStorage*)#Cannot create new ThreadLocalStorage instance after calling ThreadLocalStorage::FixStorages().");
-		auto link = new TlsStorageLink;
-		link->storage = storage;
-		*tlsTail = link;
-		tlsTail = &link->next;
+		lock->LeaveWriter();
 	}
 
-	void ThreadLocalStorage::FixStorages()
+	ReaderWriterLock::ReaderWriterLock()
+		:internalData(new threading_internal::ReaderWriterLockData)
 	{
-		tlsFixed = true;
+		InitializeSRWLock(&internalData->lock);
 	}
 
-	void ThreadLocalStorage::ClearStorages()
+	ReaderWriterLock::~ReaderWriterLock()
 	{
-		FixStorages();
-		auto current = tlsHead;
-		while (current)
-		{
-			current->storage->Clear();
-			current = current->next;
-		}
+		delete internalData;
 	}
 
-	void ThreadLocalStorage::DisposeStorages()
+	bool ReaderWriterLock::TryEnterReader()
 	{
-		FixStorages();
-		auto current = tlsHead;
-		tlsHead = nullptr;
-		tlsTail = nullptr;
-		while (current)
-		{
-			current->storage->Dispose();
+		return TryAcquireSRWLockShared(&internalData->lock)!=0;
+	}
+
+	void ReaderWriterLock::EnterReader()
+	{
+		AcquireSRWLockShared(&internalData->lock);
+	}
+
+	void ReaderWriterLock::LeaveReader()
+	{
+		ReleaseSRWLockShared(&internalData->lock);
+	}
+
+	bool ReaderWriterLock::TryEnterWriter()
+	{
+		return TryAcquireSRWLockExclusive(&internalData->lock)!=0;
+	}
+
+	void ReaderWriterLock::EnterWriter()
+	{
+		AcquireSRWLockExclusive(&internalData->lock);
+	}
+
+	void ReaderWriterLock::LeaveWriter()
+	{
+		ReleaseSRWLockExclusive(&internalData->lock);
+	}
+
+/***********************************************************************
+ConditionVariable
+***********************************************************************/
+
+	namespace threading_internal
+	{
+		struct ConditionVariableData
+		{
+			CONDITION_VARIABLE			variable;
+		};
+	}
+
+	ConditionVariable::ConditionVariable()
+		:internalData(new threading_internal::ConditionVariableData)
+	{
+		InitializeConditionVariable(&internalData->variable);
+	}
+
+	ConditionVariable::~ConditionVariable()
+	{
+		delete internalData;
+	}
+
+	bool ConditionVariable::SleepWith(CriticalSection& cs)
+	{
+		return SleepConditionVariableCS(&internalData->variable, &cs.internalData->criticalSection, INFINITE)!=0;
+	}
+
+	bool ConditionVariable::SleepWithForTime(CriticalSection& cs, vint ms)
+	{
+		return SleepConditionVariableCS(&internalData->variable, &cs.internalData->criticalSection, (DWORD)ms)!=0;
+	}
+
+	bool ConditionVariable::SleepWithReader(ReaderWriterLock& lock)
+	{
+		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, INFINITE, CONDITION_VARIABLE_LOCKMODE_SHARED)!=0;
+	}
+
+	bool ConditionVariable::SleepWithReaderForTime(ReaderWriterLock& lock, vint ms)
+	{
+		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, (DWORD)ms, CONDITION_VARIABLE_LOCKMODE_SHARED)!=0;
+	}
+
+	bool ConditionVariable::SleepWithWriter(ReaderWriterLock& lock)
+	{
+		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, INFINITE, 0)!=0;
+	}
+
+	bool ConditionVariable::SleepWithWriterForTime(ReaderWriterLock& lock, vint ms)
+	{
+		return SleepConditionVariableSRW(&internalData->variable, &lock.internalData->lock, (DWORD)ms, 0)!=0;
+	}
+
+	void ConditionVariable::WakeOnePending()
+	{
+		WakeConditionVariable(&internalData->variable);
+	}
+
+	void ConditionVariable::WakeAllPendings()
+	{
+		WakeAllConditionVariable(&internalData->variable);
+	}
+
+/***********************************************************************
+SpinLock
+***********************************************************************/
+
+	SpinLock::Scope::Scope(SpinLock& _spinLock)
+		:spinLock(&_spinLock)
+	{
+		spinLock->Enter();
+	}
+
+	SpinLock::Scope::~Scope()
+	{
+		spinLock->Leave();
+	}
+			
+	SpinLock::SpinLock()
+		:token(0)
+	{
+	}
+
+	SpinLock::~SpinLock()
+	{
+	}
+
+	bool SpinLock::TryEnter()
+	{
+		return _InterlockedExchange(&token, 1)==0;
+	}
+
+	void SpinLock::Enter()
+	{
+		while(_InterlockedCompareExchange(&token, 1, 0)!=0)
+		{
+			while(token!=0) _mm_pause();
+		}
+	}
+
+	void SpinLock::Leave()
+	{
+		_InterlockedExchange(&token, 0);
+	}
+
+/***********************************************************************
+ThreadLocalStorage
+***********************************************************************/
+
+#define KEY ((DWORD&)key)
+
+	ThreadLocalStorage::ThreadLocalStorage(Destructor _destructor)
+		:destructor(_destructor)
+	{
+		static_assert(sizeof(key) >= sizeof(DWORD), "ThreadLocalStorage's key storage is not large enouth.");
+		PushStorage(this);
+		KEY = TlsAlloc();
+		CHECK_ERROR(KEY != TLS_OUT_OF_INDEXES, L"vl::ThreadLocalStorage::ThreadLocalStorage()#Failed to alloc new thread local storage index.");
+	}
+
+	ThreadLocalStorage::~ThreadLocalStorage()
+	{
+		TlsFree(KEY);
+	}
+
+	void* ThreadLocalStorage::Get()
+	{
+		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Get()#Cannot access a disposed ThreadLocalStorage.");
+		return TlsGetValue(KEY);
+	}
+
+	void ThreadLocalStorage::Set(void* data)
+	{
+		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Set()#Cannot access a disposed ThreadLocalStorage.");
+		TlsSetValue(KEY, data);
+	}
+
+#undef KEY
+}
+#endif
+
+/***********************************************************************
+ThreadLocalStorage Common Implementations
+***********************************************************************/
+
+namespace vl
+{
+	void ThreadLocalStorage::Clear()
+	{
+		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Clear()#Cannot access a disposed ThreadLocalStorage.");
+		if(destructor)
+		{
+			if (auto data = Get())
+			{
+				destructor(data);
+			}
+		}
+		Set(nullptr);
+	}
+
+	void ThreadLocalStorage::Dispose()
+	{
+		CHECK_ERROR(!disposed, L"vl::ThreadLocalStorage::Dispose()#Cannot access a disposed ThreadLocalStorage.");
+		Clear();
+		disposed = true;
+	}
+
+	struct TlsStorageLink
+	{
+		ThreadLocalStorage*		storage = nullptr;
+		TlsStorageLink*			next = nullptr;
+	};
+
+	volatile bool				tlsFixed = false;
+	TlsStorageLink*				tlsHead = nullptr;
+	TlsStorageLink**			tlsTail = &tlsHead;
+
+	void ThreadLocalStorage::PushStorage(ThreadLocalStorage* storage)
+	{
+		CHECK_ERROR(!tlsFixed, L"vl::ThreadLocalStorage::PushStorage(ThreadLocalStorage*)#Cannot create new ThreadLocalStorage instance after calling ThreadLocalStorage::FixStorages().");
+		auto link = new TlsStorageLink;
+		link->storage = storage;
+		*tlsTail = link;
+		tlsTail = &link->next;
+	}
+
+	void ThreadLocalStorage::FixStorages()
+	{
+		tlsFixed = true;
+	}
+
+	void ThreadLocalStorage::ClearStorages()
+	{
+		FixStorages();
+		auto current = tlsHead;
+		while (current)
+		{
+			current->storage->Clear();
+			current = current->next;
+		}
+	}
+
+	void ThreadLocalStorage::DisposeStorages()
+	{
+		FixStorages();
+		auto current = tlsHead;
+		tlsHead = nullptr;
+		tlsTail = nullptr;
+		while (current)
+		{
+			current->storage->Dispose();
 
 			auto temp = current;
 			current = current->next;
@@ -4192,160 +4721,27 @@ EventObject
 ThreadPoolLite
 ***********************************************************************/
 
-	namespace threading_internal
+	ThreadPoolLite::ThreadPoolLite()
 	{
-		struct ThreadPoolTask
-		{
-			Func<void()>			task;
-			Ptr<ThreadPoolTask>		next;
-		};
+	}
 
-		struct ThreadPoolData
-		{
-			Semaphore				semaphore;
-			EventObject				taskFinishEvent;
-			Ptr<ThreadPoolTask>		taskBegin;
-			Ptr<ThreadPoolTask>*	taskEnd = nullptr;
-			volatile bool			stopping = false;
-			List<Thread*>			taskThreads;
-		};
+	ThreadPoolLite::~ThreadPoolLite()
+	{
+	}
 
-		SpinLock					threadPoolLock;
-		ThreadPoolData*				threadPoolData = nullptr;
+	bool ThreadPoolLite::Queue(void(*proc)(void*), void* argument)
+	{
+		return TaskScheduler::Queue([proc, argument](){proc(argument);});
+	}
 
-		void ThreadPoolProc(Thread* thread, void* argument)
-		{
-			while (true)
-			{
-				Ptr<ThreadPoolTask> task;
-
-				threadPoolData->semaphore.Wait();
-				SPIN_LOCK(threadPoolLock)
-				{
-					if (threadPoolData->taskBegin)
-					{
-						task = threadPoolData->taskBegin;
-						threadPoolData->taskBegin = task->next;
-					}
-
-					if (!threadPoolData->taskBegin)
-					{
-						threadPoolData->taskEnd = &threadPoolData->taskBegin;
-						threadPoolData->taskFinishEvent.Signal();
-					}
-				}
-
-				if (task)
-				{
-					ThreadLocalStorage::FixStorages();
-					try
-					{
-						task->task();
-						ThreadLocalStorage::ClearStorages();
-					}
-					catch (...)
-					{
-						ThreadLocalStorage::ClearStorages();
-					}
-				}
-				else if (threadPoolData->stopping)
-				{
-					return;
-				}
-			}
-		}
-
-		bool ThreadPoolQueue(const Func<void()>& proc)
-		{
-			SPIN_LOCK(threadPoolLock)
-			{
-				if (!threadPoolData)
-				{
-					threadPoolData = new ThreadPoolData;
-					threadPoolData->semaphore.Create(0, 65536);
-					threadPoolData->taskFinishEvent.CreateManualUnsignal(false);
-					threadPoolData->taskEnd = &threadPoolData->taskBegin;
-
-					for (vint i = 0; i < Thread::GetCPUCount() * 4; i++)
-					{
-						threadPoolData->taskThreads.Add(Thread::CreateAndStart(&ThreadPoolProc, nullptr, false));
-					}
-				}
-
-				if (threadPoolData)
-				{
-					if (threadPoolData->stopping)
-					{
-						return false;
-					}
-
-					auto task = MakePtr<ThreadPoolTask>();
-					task->task = proc;
-					*threadPoolData->taskEnd = task;
-					threadPoolData->taskEnd = &task->next;
-					threadPoolData->semaphore.Release();
-					threadPoolData->taskFinishEvent.Unsignal();
-				}
-			}
-			return true;
-		}
-
-		bool ThreadPoolStop(bool discardPendingTasks)
-		{
-			SPIN_LOCK(threadPoolLock)
-			{
-				if (!threadPoolData) return false;
-				if (threadPoolData->stopping) return false;
-
-				threadPoolData->stopping = true;
-				if (discardPendingTasks)
-				{
-					threadPoolData->taskEnd = &threadPoolData->taskBegin;
-					threadPoolData->taskBegin = nullptr;
-				}
-
-				threadPoolData->semaphore.Release(threadPoolData->taskThreads.Count());
-			}
-
-			threadPoolData->taskFinishEvent.Wait();
-			for (vint i = 0; i < threadPoolData->taskThreads.Count(); i++)
-			{
-				auto thread = threadPoolData->taskThreads[i];
-				thread->Wait();
-				delete thread;
-			}
-			threadPoolData->taskThreads.Clear();
-
-			SPIN_LOCK(threadPoolLock)
-			{
-				delete threadPoolData;
-				threadPoolData = nullptr;
-			}
-			return true;
-		}
-	}
-
-	ThreadPoolLite::ThreadPoolLite()
-	{
-	}
-
-	ThreadPoolLite::~ThreadPoolLite()
-	{
-	}
-
-	bool ThreadPoolLite::Queue(void(*proc)(void*), void* argument)
-	{
-		return ThreadPoolQueue([proc, argument](){proc(argument);});
-	}
-
-	bool ThreadPoolLite::Queue(const Func<void()>& proc)
-	{
-		return ThreadPoolQueue(proc);
-	}
+	bool ThreadPoolLite::Queue(const Func<void()>& proc)
+	{
+		return TaskScheduler::Queue(proc);
+	}
 
 	bool ThreadPoolLite::Stop(bool discardPendingTasks)
 	{
-		return ThreadPoolStop(discardPendingTasks);
+		return TaskScheduler::Stop(discardPendingTasks);
 	}
 
 /***********************************************************************
@@ -13799,69 +14195,52 @@ JsonPrintVisitor
 			class JsonPrintVisitor : public Object, public JsonNode::IVisitor
 			{
 			public:
-				TextWriter&					writer;
+				JsonWriter&					writer;
 
-				JsonPrintVisitor(TextWriter& _writer)
+				JsonPrintVisitor(JsonWriter& _writer)
 					:writer(_writer)
 				{
 				}
 
 				void Visit(JsonLiteral* node)
 				{
-					switch(node->value)
-					{
-					case JsonLiteral::JsonValue::True:
-						writer.WriteString(L"true");
-						break;
-					case JsonLiteral::JsonValue::False:
-						writer.WriteString(L"false");
-						break;
-					case JsonLiteral::JsonValue::Null:
-						writer.WriteString(L"null");
-						break;
-					}
+					writer.Literal(node->value);
 				}
 
 				void Visit(JsonString* node)
 				{
-					writer.WriteChar(L'\"');
-					JsonEscapeString(node->content.value, writer);
-					writer.WriteChar(L'\"');
+					writer.String(node->content.value);
 				}
 
 				void Visit(JsonNumber* node)
 				{
-					writer.WriteString(node->content.value);
+					writer.Number(node->content.value);
 				}
 
 				void Visit(JsonArray* node)
 				{
-					writer.WriteChar(L'[');
-					FOREACH_INDEXER(Ptr<JsonNode>, item, i, node->items)
+					writer.BeginArray();
+					FOREACH(Ptr<JsonNode>, item, node->items)
 					{
-						if(i>0) writer.WriteChar(L',');
 						item->Accept(this);
 					}
-					writer.WriteChar(L']');
+					writer.EndArray();
 				}
 
 				void Visit(JsonObjectField* node)
 				{
-					writer.WriteChar(L'\"');
-					JsonEscapeString(node->name.value, writer);
-					writer.WriteString(L"\":");
+					writer.Field(node->name.value);
 					node->value->Accept(this);
 				}
 
 				void Visit(JsonObject* node)
 				{
-					writer.WriteChar(L'{');
-					FOREACH_INDEXER(Ptr<JsonObjectField>, field, i, node->fields)
+					writer.BeginObject();
+					FOREACH(Ptr<JsonObjectField>, field, node->fields)
 					{
-						if(i>0) writer.WriteChar(L',');
 						field->Accept(this);
 					}
-					writer.WriteChar(L'}');
+					writer.EndObject();
 				}
 			};
 
@@ -13951,561 +14330,1796 @@ API
 
 			void JsonPrint(Ptr<JsonNode> node, stream::TextWriter& writer)
 			{
-				JsonPrintVisitor visitor(writer);
+				JsonWriter jsonWriter(writer);
+				JsonPrintVisitor visitor(jsonWriter);
 				node->Accept(&visitor);
 			}
 
-			WString JsonToString(Ptr<JsonNode> node)
+			class JsonStringWriter : public TextWriter
 			{
-				MemoryStream stream;
+			public:
+				Array<wchar_t>				buffer;
+				vint						used = 0;
+
+				using TextWriter::WriteString;
+
+				void WriteChar(wchar_t c)override
 				{
-					StreamWriter writer(stream);
-					JsonPrint(node, writer);
+					WriteString(&c, 1);
 				}
-				stream.SeekFromBegin(0);
+
+				void WriteString(const wchar_t* string, vint charCount)override
 				{
-					StreamReader reader(stream);
-					return reader.ReadToEnd();
+					if (used + charCount > buffer.Count())
+					{
+						vint size = buffer.Count() * 2;
+						buffer.Resize(size < used + charCount ? used + charCount : size);
+					}
+					memcpy(&buffer[used], string, charCount * sizeof(wchar_t));
+					used += charCount;
 				}
-			}
-		}
-	}
-}
-
-/***********************************************************************
-PARSING\JSON\PARSINGJSON_PARSER.CPP
-***********************************************************************/
-
-namespace vl
-{
-	namespace parsing
-	{
-		namespace json
-		{
-/***********************************************************************
-ParserText
-***********************************************************************/
-
-const wchar_t parserTextBuffer[] = 
-L"\r\n" L""
-L"\r\n" L"class Node"
-L"\r\n" L"{"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"class Literal:Node"
-L"\r\n" L"{"
-L"\r\n" L"\tenum Value"
-L"\r\n" L"\t{"
-L"\r\n" L"\t\tTrue,"
-L"\r\n" L"\t\tFalse,"
-L"\r\n" L"\t\tNull,"
-L"\r\n" L"\t}"
-L"\r\n" L""
-L"\r\n" L"\tValue value;"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"class String:Node"
-L"\r\n" L"{"
-L"\r\n" L"\ttoken content(JsonUnescapingString)\t\t\t\t@Color(\"String\");"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"class Number:Node"
-L"\r\n" L"{"
-L"\r\n" L"\ttoken content;"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"class Array:Node"
-L"\r\n" L"{"
-L"\r\n" L"\tNode[] items;"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"class ObjectField:Node"
-L"\r\n" L"{"
-L"\r\n" L"\ttoken name(JsonUnescapingString)\t\t\t\t@Color(\"AttName\");"
-L"\r\n" L"\tNode value;"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"class Object:Node"
-L"\r\n" L"{"
-L"\r\n" L"\tObjectField[] fields;"
-L"\r\n" L"}"
-L"\r\n" L""
-L"\r\n" L"token TRUEVALUE = \"true\"\t\t\t\t\t\t\t@Color(\"Keyword\");"
-L"\r\n" L"token FALSEVALUE = \"false\"\t\t\t\t\t\t\t@Color(\"Keyword\");"
-L"\r\n" L"token NULLVALUE = \"null\"\t\t\t\t\t\t\t@Color(\"Keyword\");"
-L"\r\n" L"token OBJOPEN = \"\\{\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
-L"\r\n" L"token OBJCLOSE = \"\\}\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
-L"\r\n" L"token ARROPEN = \"\\[\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
-L"\r\n" L"token ARRCLOSE = \"\\]\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
-L"\r\n" L"token COMMA = \",\";"
-L"\r\n" L"token COLON = \":\";"
-L"\r\n" L"token NUMBER = \"[\\-]?\\d+(.\\d+)?([eE][+\\-]?\\d+)?\"\t@Color(\"Number\");"
-L"\r\n" L"token STRING = \"\"\"([^\\\\\"\"]|\\\\[^u]|\\\\u\\d{4})*\"\"\"\t\t@ContextColor();"
-L"\r\n" L""
-L"\r\n" L"discardtoken SPACE = \"\\s+\";"
-L"\r\n" L""
-L"\r\n" L"rule Node JLiteral"
-L"\r\n" L"\t= STRING:content as String"
-L"\r\n" L"\t= NUMBER:content as Number"
-L"\r\n" L"\t= \"true\" as Literal with {value = \"True\"}"
-L"\r\n" L"\t= \"false\" as Literal with {value = \"False\"}"
-L"\r\n" L"\t= \"null\" as Literal with {value = \"Null\"}"
-L"\r\n" L"\t;"
-L"\r\n" L""
-L"\r\n" L"rule ObjectField JField"
-L"\r\n" L"\t= STRING:name \":\" JValue:value as ObjectField"
-L"\r\n" L"\t;"
-L"\r\n" L""
-L"\r\n" L"rule Object JObject"
-L"\r\n" L"\t= \"{\" [JField:fields {\",\" JField:fields} ] \"}\" as Object"
-L"\r\n" L"\t;"
-L"\r\n" L""
-L"\r\n" L"rule Array JArray"
-L"\r\n" L"\t= \"[\" [JValue:items {\",\" JValue:items} ] \"]\" as Array"
-L"\r\n" L"\t;"
-L"\r\n" L""
-L"\r\n" L"rule Node JValue"
-L"\r\n" L"\t= !JLiteral"
-L"\r\n" L"\t= !JObject"
-L"\r\n" L"\t= !JArray"
-L"\r\n" L"\t;"
-L"\r\n" L""
-L"\r\n" L"rule Node JRoot"
-L"\r\n" L"\t= !JObject"
-L"\r\n" L"\t= !JArray"
-L"\r\n" L"\t;"
-;
+			};
 
-			vl::WString JsonGetParserTextBuffer()
+			WString JsonToString(Ptr<JsonNode> node)
 			{
-				return parserTextBuffer;
+				// JsonWriter sends large blocks, they are collected with an exponentially growing buffer
+				JsonStringWriter writer;
+				JsonPrint(node, writer);
+				return writer.used == 0 ? WString::Empty : WString(&writer.buffer[0], writer.used);
 			}
 
 /***********************************************************************
-SerializedTable
+JsonWriter
 ***********************************************************************/
 
-const vint parserBufferLength = 3788; // 17748 bytes before compressing
-const vint parserBufferBlock = 1024;
-const vint parserBufferRemain = 716;
-const vint parserBufferRows = 4;
-const char* parserBuffer[] = {
-"\x00\x0B\x00\x02\x83\x80\x07\x7D\x00\x82\x03\xFF\x45\x08\x82\x83\x86\x81\x21\x6F\x6C\x2F\x32\x37\x84\x86\x02\x86\x00\x17\x82\x93\x24\x3A\x39\x34\x37\x67\x06\x98\x8A\x88\x8E\x84\x00\x88\x12\x94\x98\x87\x0B\x93\x81\x20\x3A\x74\x4E\x21\x2D\x35\x32\x90\x86\x92\x0C\xA6\xA8\x93\x85\x88\x84\x96\x86\x3F\x80\x0B\x25\x39\x3F\x3B\x88\x32\x36\x88\xB8\x88\x8A\x99\x88\x9F\x96\x40\x83\x83\xA5\xA7\xA1\xA4\x83\xA5\x04\xCD\xA9\x9D\x94\x81\xA1\xAE\xA9\x44\xC6\xB2\x28\xAC\xA9\x86\x93\xAC\x03\xBB\xAA\x8C\x88\x00\x8D\xB6\x81\x42\x6F\x35\x2E\x34\x31\x32\x39\x3C\x56\xE6\xA5\x89\xBE\xA3\xB4\x85\xB7\x7F\x83\xB1\xB3\xB5\xBF\xB9\xBC\x81\x58\x83\x9A\xAF\xAC\xB6\xB6\xC0\xB9\x74\xF6\xB8\xA5\xB8\xC7\xB2\xC4\xBE\x5B\x8E\xCD\xD0\xB0\xCD\xC3\xC9\x91\x96\x8D\x98\xCC\xC8\x82\x8D\xD3\x81\x4E\x75\x2D\x22\x35\x32\x3B\xC3\x82\x0C\x18\xB1\xCF\x8F\x36\x34\x3B\x32\x78\x74\x2A\xB8\x80\x06\xAF\xCB\x9C\x2E\xF2\x32\x21\x38\xBF\x7E\xE3\xE3\xFF\x3E\xC2\x81\xAC\x21\x37\xDB\xE1\x6C\x48\xC8\xE4\x08\x8C\xEA\x80\x27\x6F\x64\x35\x92\xE6\xE6\xD0\x82\xD3\xA9\xAB\xED\xDC\xED\xE8\x8E\xD3\x27\x62\x6A\x25\x23\x34\x3C\xF3\x7F\x80\x0C\xF0\xC0\x08\xFA\xF4\xF6\x23\x34\x65\x6C\x08\xA4\xFE\xEB\x82\xD2\x8E\x1E\x60\x4E\x7A\x72\x00\x21\x65\x81\x70\xC3\x79\x16\x82\x49\xCE\x65\x1D\x1B\x1C\x03\x90\x50\x01\x73\xCF\x61\x1C\x1B\x82\x03\x76\x16\x85\x1D\xDB\x5C\x7D\x7E\x40\xE0\x6A\x6C\x6A\x1C\x04\x81\x53\x19\x6D\xB7\x76\x6E\x7B\x87\x19\x43\x44\x7F\x7A\x74\x2C\x86\x6A\x19\xF8\x7A\x70\x84\x79\xF2\x44\x42\x7F\x8B\xF6\x75\x84\x1A\x75\x08\x40\x9E\x1B\x4C\x65\x14\x60\x40\x46\x3B\xA9\x70\x8F\x7D\xF9\x64\x18\x86\x40\x1A\xAC\x1C\x87\x8A\xE6\x43\x40\x83\x47\x67\x25\x83\x43\x89\xB6\x65\x16\x6C\x6F\x0F\x18\x44\x08\x46\x61\xBC\x66\x9A\x52\xEE\x64\x77\x9B\x4D\x69\x9C\x7B\x98\x9A\x6D\x88\x7F\x9B\x55\x71\x88\x79\x00\x46\x77\x82\x44\x16\x14\x55\x05\x16\x15\x10\x4C\x3D\x90\x90\x41\x40\x9D\x4C\x84\x6F\x02\x18\x4A\x02\xA2\x03\x46\x10\xA3\x14\x7E\x80\xAD\x9F\x93\x00\x26\x16\x87\x1C\x45\x98\x43\x00\x9E\x9C\x97\x75\x14\x13\x4C\x3F\x91\xA1\x11\x83\x83\x42\x91\x1D\x6C\x2C\x19\xA0\x43\xA5\x8B\x72\x87\x13\x42\x0A\x1F\x10\x14\x45\x0E\x1B\xA8\x42\xB7\x9C\x1B\x1F\xA6\xC0\x5B\x61\x62\x40\xB0\x8A\x13\x10\x13\x4F\x10\xA7\xAC\x41\xB9\xBD\x1D\xA9\x8B\x51\x4D\xB0\x01\x10\x52\x12\x13\xAD\xAD\xC7\x83\x49\xAF\x16\x06\x84\x80\x60\x41\x80\x50\xB2\x17\xB0\xC5\x85\x15\xB6\x40\xB9\x9D\x1C\x8B\xB6\xBF\x4C\x59\x5B\x13\x4D\x0D\x11\x12\x91\x3D\x6C\x04\x82\x7B\x94\x83\x1F\x10\xB1\x4E\x30\xB3\x42\x0E\xE8\x88\x6C\x7D\x95\x9E\x8D\x12\x11\x11\x52\x1F\x08\x46\xC1\x02\x5B\x1C\x15\x0B\x5D\x3F\x0C\x14\x19\x2B\x28\x0E\x0B\xC3\x2B\x29\x0F\x0C\x0A\x5B\x25\x15\x11\x17\x5B\x2B\x0B\xC1\xC3\x14\xD6\xC9\x9C\x42\x23\xDF\x70\xC0\x00\x53\x3B\x99\x12\x13\x47\x1B\x08\x46\xCB\x02\x62\x08\xC6\x17\x5C\x1C\x12\x09\x17\x7C\x35\xCB\x16\x17\x75\x38\xC5\xCD\x1D\x0F\xFB\x14\x0D\x1F\x29\x2A\x02\x0B\xA2\x0C\x48\xD8\x42\x91\x94\x93\x10\x15\x10\x43\x05\x1C\xAC\x42\x53\xDC\x13\x1F\x0A\x39\x89\x44\x7B\x98\x16\x67\xCA\x11\x10\xC2\x44\x70\x04\x46\x63\xC2\x4F\xD5\xD8\x79\x2E\x02\x17\x1B\x6F\x34\x1C\x46\x5D\x74\x19\xD2\x42\x7C\x40\x20\x04\x08\x0F\x67\xC9\x8E\x0E\x8C\x03\x79\xD4\x73\x6C\x08\x40\xEE\xDD\xDA\x6F\xF2\x14\x1E\xD2\x04\x4A\xD5\xDC\xDE\x60\xFA\xDC\xDE\xD9\x8D\xC4\x7D\xBC\x00\x80\x43\xEE\x09\x0C\x45\x18\x49\xE6\x40\x8C\xE8\xDE\x0E\x0E\x20\x22\x0B\x16\x08\x75\xDB\x10\x0A\x12\x56\x1B\x85\x18\x08\xA0\xCD\x8F\x80\x08\x7B\x21\xEC\x0A\x08\xA7\xE9\xE2\x97\xEA\xAD\xF7\x6F\xE9\x1F\x20\x1D\x11\xE9\x17\xB4\xE1\x13\x1C\x08\x91\xF9\x1F\xE0\x00\x83\xD3\xE5\xE5\xF1\x2E\x33\x0B\xE4\x42\xCF\xDD\xEA\xDC\xE8\xA2\xF4\xE6\xE8\xEA\xAA\xEC\xE0\x0A\xEB\xC3\xF1\xE2\x0B\xEC\xB5\xD9\xF9\xEE\x83\xC3\xFC\xEE\xEF\xCD\xC1\xC3\xF5\xF0\x10\xCA\xFD\xD4\x85\x6B\x16\x88\xE3\x42\xD2\x4A\x2F\xF0\x77\xE5\xFA\x18\x49\xFC\xE7\xF5\xCD\x80\x77\xE7\x20\x0E\x09\x15\x02\x64\x60\xED\x5C\x49\x45\x74\x00\x06\xF0\x01\x82\x45\xD6\x00\x0D\x01\x0A\x18\x6E\xFD\x16\x40\x80\x11\x16\x54\x0D\x98\x49\x7C\x08\x13\x8C\x0D\xBA\x77\x0E\x39\x68\x10\x74\x08\x51\x4C\x42\x10\x3D\x01\x74\x46\x17\x51\x19\x34\x7D\x0E\x08\x92\x86\x7F\x14\x94\x7A\xA1\x2B\x8A\x81\xE1\x5C\x86\x83\x20\x82\x84\x09\xAB\x77\x84\x11\x14\x0A\x0E\x1C\x4C\x86\x0B\xFD\x75\x42",
-"\x36\x15\x86\x0D\xA8\x4C\x0E\x06\xB7\x80\x05\x0F\xB4\x09\x84\xB1\x7B\x86\x09\xA1\x79\x35\x54\x42\x89\x82\x44\x90\x7E\x11\xA0\x79\x64\x29\x2B\x67\x08\x06\x88\x46\x97\x09\x8B\x81\x2B\x60\x20\x08\x5A\x46\x6C\x8F\x74\x05\x65\x81\x23\x62\x56\x4A\x4C\x3F\xE5\x49\x08\x22\x3A\xBC\x7B\x8D\x15\x9B\x0C\xE9\x20\x07\x7A\x26\x7A\x3A\x7B\x34\x4D\x49\xF7\x32\x74\x76\x25\x3E\x8C\x0C\x80\x9E\x45\xF9\x3D\x71\x75\x3E\x1A\x83\x8D\xC7\x63\x72\x03\x18\x23\x92\xC8\x68\x6A\x6D\x6C\x74\x0D\x11\x74\x22\x6F\x23\x42\x27\x6E\x83\x7E\x04\x08\x40\x01\x92\xDB\x5C\x45\x7D\x66\x66\x95\x19\x17\x7D\x06\x8C\x2D\x94\x7F\xAA\x80\x81\x08\x03\x7F\x80\x2C\xB1\x90\x74\xB3\x8B\x8D\x2D\xF8\x67\x96\x10\x33\x97\x86\x94\x4A\x0B\xDA\x6D\x69\x8C\xE4\x43\x9C\x0E\x97\x65\x04\x46\x4A\x9C\x7F\x63\xB2\x90\x8E\xF5\x34\x0F\x2E\xC2\x99\x93\x67\xAB\x78\x95\xC8\x7C\x81\xD9\x08\x2B\x9B\x2C\xB7\x7F\x98\x9B\x84\x0D\x03\x18\x23\x9D\x4F\xAF\x85\x88\xA2\x88\x8E\x84\x50\x90\x47\x36\x82\x27\x8D\x6B\x8E\x06\x0C\x76\x88\x20\x7A\xB8\x68\x8F\xD4\x7A\x8C\x1F\xA7\x77\x91\x44\x82\x92\x84\xDF\x65\x91\x3F\xA0\x71\x90\x1B\x60\x06\x7C\x8D\x8F\x91\x1C\xD2\x91\x93\x43\x98\x9E\x90\x3E\x57\x72\x0E\x18\x23\xA2\xFE\x47\x90\x80\x5D\x9F\x8A\xF6\x43\x44\x27\xBA\x62\x02\x07\x85\x8A\x96\xF6\x52\x8B\x81\x35\x87\x91\x92\xC5\x6F\xA0\xF3\x32\x0C\x10\x8C\x2D\xA4\x7F\xC5\x75\x83\xE8\x7B\x98\x7B\xDB\x5A\x7C\x7B\x75\x7E\x78\xF8\x35\xA5\x85\xF1\x7B\x74\x91\xE8\x75\x84\xF1\x68\x63\x89\x98\x94\x7B\xA6\xD7\x62\xA6\x4F\xC3\x70\x08\x9D\xA1\xA2\x7C\xDB\x7A\x77\x22\xE7\x70\x78\xA1\x85\x7D\xA1\x3E\x4F\xA3\x21\xCD\x75\xA2\x84\x1D\xA8\x6F\x17\xBC\x8A\xCA\x2C\x6B\xA2\x22\x61\x70\xA4\xE1\x76\xA4\xE8\x24\xA3\x78\x93\xBE\x44\x94\x5E\x6A\x95\x25\x88\x23\xAE\x9E\xAB\x90\x9C\x9C\x88\x4B\x40\x20\x91\x97\x51\x81\x9F\x98\xE5\x88\x21\x60\xD4\x9D\x6C\x4C\xAD\x69\x9C\xF2\x62\x22\xD2\x20\x9E\x99\x51\x85\x9C\x9D\xEC\x25\x4C\x42\x12\xB0\xB2\x64\xB8\xAC\x0C\x80\x64\x20\xE0\x20\x98\x8F\x51\x98\xAD\x49\x5A\xB1\xA2\x0C\x5D\xA4\x21\xAF\x90\xA5\x49\x18\xA3\xAC\x18\xA0\x7C\xA3\xD5\x5F\xA3\x8F\x76\xA3\xA5\xF6\x25\xAB\xA1\x93\x9E\x69\xA5\x9A\x28\x78\xF3\x34\x0F\x78\x82\x11\x79\x94\x47\xB6\x79\x5A\xBD\xA1\xAA\xF2\x40\xA3\x76\x75\x71\xB7\x52\x87\xA0\xA9\xAA\x8B\x87\xAA\x5E\x67\x93\x5C\x84\x25\xAF\xAD\x97\xB5\x93\xF2\x20\x97\x45\x8E\xBB\x9D\x35\xAE\x98\x00\xF0\x8B\xA2\x0B\x35\x04\x12\x8C\x25\xBF\x8E\x0B\xB9\x8E\x70\xA7\xBF\x8E\x82\x8A\x93\x94\x4E\xBC\x9E\x8F\x7E\x96\xA0\x84\xA2\x06\x91\x42\xAB\x8F\x10\xF8\x91\x74\x7D\xBD\x8B\xBE\xEE\xA2\x91\x4E\x84\x92\xBF\x26\x74\xBC\x0C\x53\xA9\xA1\x7E\x8B\xAF\xB0\xEF\x9D\x50\x79\xF1\x93\x04\x3D\x84\x26\x9F\xCA\xAA\xBC\xA6\x03\xA0\x05\x41\x88\xC7\xB8\xD8\x99\xC3\xC3\x09\xD7\xBE\x42\xD1\x9F\xB2\xFD\x1B\x9C\x20\xDD\x96\xB9\x26\x85\x71\x6E\xBD\x82\x25\x6E\xDA\xBE\x47\xDE\x51\xBE\x47\xCC\x83\x22\x70\x5B\xAC\xC5\x62\x80\x0A\x70\x10\x20\xAA\xC6\xA5\x8A\x77\x89\x83\x2D\x9A\x55\x86\xB6\x6D\x74\x10\x6C\x76\x83\x20\xC6\x5E\xAA\x73\xC6\x5D\x69\x96\xEA\x36\xC2\x20\xC1\x46\xCA\xC7\x8C\x4F\xC6\x8F\xF6\xAE\x07\x87\x9C\x82\x02\x18\x20\xCE\xD9\x1C\x87\xC8\x16\xC1\xB4\x20\x81\xAD\xCA\x37\x94\x8E\xCA\x18\xAC\x0B\xBA\x03\x35\xAC\x99\xAC\xC4\xCA\x00\x00\x73\x71\x6B\xC6\x89\x83\x8B\xA1\x02\x8C\x3D\xCA\x8D\xE2\xA7\x98\x9D\xB2\x3C\xC8\xBB\x77\x99\xBD\x7B\xD1\x9B\x99\x83\x23\xB1\x78\xAC\xC3\xC9\x5A\xC7\xD1\x34\xBE\x0F\xAF\x4C\x92\xB4\x20\x94\xA7\x99\x99\xC9\xC6\x71\x1D\xFD\xC4\xB1\xD5\x95\xD1\xDB\x10\xD6\x99\x4C\xAE\x04\xC5\xDF\xA3\x64\x9E\xCE\x98\xA4\xB4\x6A\xA7\x92\x35\x1D\xB7\x40\x3F\xB6\xA9\xD0\x48\xAB\xB8\xB8\x65\xBB\xEB\x71\xBA\xB8\x5D\xE1\xC6\xB9\xEA\x68\x6C\x5C\xD1\xC8\x78\x87\xB9\xB4\xBD\x64\x0E\x04\x0D\x24\xBB\x5F\x81\x3F\xC0\xB5\x62\xBE\x88\x59\xAC\xB6\xAD\xD7\xB8\xD2\xB6\x36\xB4\xB5\x34\x87\x9C\x7D\x63\xDC\x86\xD3\xEE\x6E\xCE\x3C\xFB\x78\x20\x72\xE7\x9A\x8B\x15\x97\x81\x06\xC2\xAC\x83\x26\xB9\x81\x8A\xD9\x7D\x85\x0A\x98\x84\x87\x3E\x13\x9C\x83\x47\x89\x8B\x12\xEE\xCE\xDD\x27\xBA\x81\xDE\x54\x9A\xDF\x41\xF7\xDE\xCC\x00\x82\x84\x80\x52\x01\x8D\x97\x36\x32\xA9\xF0\x23\x44\xE0\xE8\x92\x84\x10\xB4\x8B\x81\x76\xCE\x88\x8A\x23\x80\xE2\x0F\x93\xEC\x84\x88\xE8\xD9\xDA\x1A\xA0\x77\x01\xE3\x82\xA8\x33\xA7\x0A\x9D\xCE\x55\xB1\xAA\xFD\x61\x9E\x1A",
-"\x13\xC3\x20\x15\xDC\xBE\x08\x7E\xB5\xC1\xF6\x9A\xC7\xBD\xBC\xDF\xC3\x7B\xF6\xB8\xBE\x6D\xF0\x43\xD8\xA7\x24\xDB\xE0\x14\x55\x79\x39\x5A\x6E\x43\x34\xCD\x48\xA9\xEE\xAD\x48\xDE\x16\x03\x24\xFF\x42\xEA\x2A\xCB\x50\x48\xEC\x1A\x3C\x37\x18\x10\xE8\x77\x6D\xC5\x88\xAA\xE8\x31\x3B\x65\x1C\x36\x06\x5A\xE2\x3B\x44\xF0\x47\x78\x6B\x9C\x34\x07\x64\xE8\x38\x51\xF4\x0E\xEB\xD7\x20\xEC\x6F\x1E\x0C\xED\xE3\x1C\x03\x5C\xAF\x3F\x1C\x6F\x46\x46\xE9\xBE\xFE\xE8\x31\x46\x5F\x1F\x77\xE3\x5F\xEF\xBF\xF9\xE8\xEE\x85\xE6\x57\x5E\x0C\x24\xF0\xBF\xED\xD1\x41\x06\x59\x01\xE2\xA6\x62\xEA\xD5\x4B\x5C\x37\x94\x5B\x84\xE2\xBF\x87\x94\x6F\xEE\xCE\xEF\xC5\x9C\x80\x6F\x5C\xEA\x8B\xBC\xC6\x47\xF2\x7D\xEB\x5A\x81\x0D\xFD\xEF\xC7\xC4\x39\xF2\x93\xFE\x3D\x5C\x96\xFD\xEF\xCC\xEA\x74\x52\xF3\xD8\x50\xE9\xD0\x30\xF4\x09\x62\xF1\xB7\xDC\x41\xDD\x11\xF9\xEC\x44\xD4\xC6\xEA\xF5\x18\x2C\xF6\xD1\xAE\xFA\x40\x8C\x12\xF1\xF6\xCC\x41\xE8\xF2\x53\xE5\xF7\xC5\xC0\x02\xF3\xD5\x28\x35\x12\xBB\xF6\x43\xDE\xCE\x5F\xF7\xBE\x41\xFB\x98\xEE\xC9\xEE\x02\x46\x46\xEF\x84\xEB\xF4\xF4\xD1\xF4\xF2\xDD\xA8\x68\xF6\xD0\xE1\xCB\xED\x05\x21\xF1\xC1\xEB\xF9\xFD\xC9\xEB\xFC\xF3\xF0\xF1\xF6\xF9\xD3\x49\xF0\x3B\x63\x35\xEB\x73\x12\x81\x7B\x68\x02\x16\x7C\x73\x28\x7C\x8C\x7A\x7F\xB7\x5F\x7E\xCE\x7C\x80\x95\x77\x3B\x7C\x72\x21\x5F\x12\x10\x23\x7F\x25\xC0\x73\x10\x95\x30\x7E\x73\x27\x3C\x0E\x7D\x1A\xA3\x7E\x79\xC3\x71\x78\x70\x67\x80\xEB\x7A\x80\xB8\x20\x81\xD2\x73\x74\x0F\x81\x7F\xB3\x72\x81\x7D\x75\x4C\x17\x84\x07\x21\x8E\x2B\x79\x6E\x78\x27\x36\x72\x35\x8F\x2B\xD9\x4F\x79\x79\x76\x24\x2C\x2E\x77\x13\x86\x74\x44\x78\x36\xBC\x1C\x7C\xFF\x04\x78\x49\x89\x81\x67\x26\x24\x08\x34\x35\xEB\x75\x84\x09\x27\x84\x0D\x89\x20\x2C\x2F\x84\x93\x7C\x7C\x02\x83\x80\xE9\x28\x16\x66\x37\x4C\x4B\x8E\x2C\x6F\x26\x24\xCF\x70\x85\xD0\x72\x85\xC4\x14\x85\x42\x70\x5D\x0C\x15\x86\x59\x85\x85\xC4\x1B\x85\x5C\x8C\x7E\xB2\x72\x65\xF3\x7F\x26\x3F\x8F\x60\x73\x80\x78\x23\x14\x78\x04\x2B\x77\x2D\x89\x82\xC4\x64\x10\x6E\x89\x78\xDC\x7C\x06\x72\x8C\x85\xFE\x71\x76\x89\x79\x77\x93\x3B\x63\x7B\x8C\x87\x37\x15\x82\x9E\x41\x7B\xF8\x7D\x2B\xB1\x76\x76\xEC\x13\x84\x41\x29\x7D\x02\x1D\x5A\x6A\x8B\x82\x87\x4E\x77\x79\x8C\x10\x94\x83\x80\xFF\x09\x88\x61\x81\x38\x7D\x76\x24\x62\x62\x88\xD2\x74\x10\xAF\x8F\x86\x11\x8C\x21\xCA\x7A\x2E\x98\x8C\x3D\xA1\x8D\x7E\x83\x3B\x8A\x68\x6D\x8A\x7E\x69\x7F\x83\x83\x10\x7F\x6D\x7F\x2F\x8C\x21\x9C\x8E\x85\xB8\x87\x7D\xAA\x3B\x8B\x75\x85\x6C\x3E\x2E\x8B\x37\x60\x8C\x0B\x85\x8D\xB1\x86\x2D\x2A\x8C\x8B\xAA\x47\x8B\xCA\x8A\x8C\xBA\x87\x32\xBC\x85\x74\x78\x81\x78\x46\x27\x69\x91\x81\x89\xA5\x8C\x4D\xEB\x79\x8C\x6B\x28\x76\x0B\x5C\x1B\x9A\x8D\x1E\x4A\x84\x78\x93\x30\x88\x0C\x18\x85\x03\x19\x88\x38\x84\x6C\x69\x74\x81\x03\x11\x14\x95\x57\x85\xEB\x71\x8F\xFA\x81\x85\xD6\x74\x58\xF2\x8E\x8F\x4D\x81\x88\x04\x15\x90\xCB\x77\x32\xFD\x82\x86\xFF\x8C\x72\x0B\x5C\x22\x85\x85\x78\x04\x97\x8E\x20\x27\x8C\x8C\x80\x7D\x79\x75\x67\xC5\x8A\x91\x67\x29\x77\x01\x82\x92\x79\x7D\x49\xB3\x86\x92\xE4\x88\x11\x13\x0B\x8E\xEB\x7B\x74\xB5\x5E\x23\xCE\x8B\x91\x66\x37\x48\xD2\x88\x18\x84\x74\x01\xD4\x88\x10\x15\x0A\x29\x2F\x9E\x62\xF3\x11\x93\x4D\x70\x8E\xCF\x88\x6C\x2C\x2D\x93\x2E\x82\x74\x87\x4C\x8D\xCF\x8D\x7E\x20\x60\x8F\xDD\x5B\x50\x37\x90\x00\x3A\x96\x74\x4C\x3E\x93\xD0\x70\x93\xDB\x62\x93\x44\x94\x93\xD0\x8D\x24\x2C\x27\x7E\xAD\x79\x74\xFA\x1C\x94\x5E\x9E\x94\x8A\x40\x95\x29\x71\x91\x22\x9B\x87\x87\x7E\x89\xB1\x78\x82\x04\x11\x92\x89\x75\x62\x4E\x2C\x90\x75\x9C\x91\x08\x8D\x8D\xE9\x28\x7D\xAC\x23\x10\x9C\x75\x06\x87\x8E\x7D\x3E\x13\x10\x1C\x82\x7E\x3C\x89\x67\xA6\x70\x97\x93\x72\x97\xC4\x89\x8D\x45\x97\x48\xFC\x74\x8B\x2B\x84\x7D\x44\x86\x7D\x3B\x48\x7B\x2A\x43\x98\x31\x8E\x7B\x9F\x7C\x84\x94\x32\x7C\xA5\x71\x78\xC5\x77\x82\xD6\x73\x97\x90\x9E\x95\xC8\x63\x99\x79\x95\x8B\x65\x0B\x97\x5D\x8D\x97\xB4\x7F\x97\xD7\x1B\x7D\x22\x8A\x45\x84\x95\x81\x13\x2F\x99\xE1\x7A\x81\xA2\x90\x1D\xE5\x77\x9A\x89\x77\x89\x08\x14\x97\x85\x76\x97\xAC\x97\x9C\x1C\x94\x7F\x23\x16\x7F\xD0\x74\x9C\xA8\x99\x94\xA2\x8E\x23\xC9\x9F\x77\x8B\x89\x10\x05\x8C\x98\x89\x7E\x98\x02\x16\x9C\xD6\x94\x96\x77\x9D\x86\xA9\x91\x7D\x76\x5C\x8E\xAE\x2E\x2C\x33\x8B\x83",
-"\x88\x97\x83\x63\x94\x6C\x1F\x82\x07\xEA\x9E\x9B\xE3\x73\x82\x23\x14\x89\xB0\x97\x26\xDC\x90\x00\xDE\x9B\x8F\xD3\x9D\x24\xD5\x9C\x9F\xDA\x8A\x3A\xE6\x9D\x1B\x12\x29\x9E\xA0\x9B\x81\xBC\x9D\x81\x39\x8D\x11\x58\x21\x9F\x02\x18\xA0\x45\x47\x15\x81\x78\x78\x8D\x92\x9C\x02\x19\x92\xCA\x9B\x86\x0E\x82\x9E\xD2\x91\xA0\xB7\x37\x9F\x07\x28\x89\x7E\x9D\x89\x7A\x23\x71\x9C\x96\x74\xA1\x79\xA0\x88\x9B\x9E\x1C\x4B\x98\xB4\x91\x97\x16\xA0\x00\x18\xAF\x9D\x1A\xA0\x79\x78\x99\xA1\x95\x93\x9B\x73\x26\x7B\xB7\x3A\x99\xF4\x67\xA2\x73\x29\xA2\x11\xA7\xA0\xBF\x96\x21\xC4\x7A\x9D\x85\x79\x9F\x33\xA0\xA0\x45\x95\x3C\xFF\x9D\x9E\x39\xAF\xA1\xD5\x72\xA2\x3A\xA4\x28\xDA\x79\x2A\x40\xAF\x26\x42\xA8\x9B\x44\xA3\x9F\xA3\x93\x12\xE6\x77\x7F\x31\xAB\xA4\x50\xA1\x8E\x1B\xA8\x10\x17\x94\xA3\x51\xA7\x28\x79\x7E\x9C\x96\x83\xA6\xE3\x96\x1A\x2C\x8C\xA1\xC6\x8E\x9A\xD8\x93\x12\x06\x80\x00\x20\xAC\x1B\x4A\xA1\xA7\x7D\x3E\xA4\x37\xAA\xA6\x1E\xA8\x8C\x9D\x98\x9E\x62\x48\x81\xBD\x9F\xA0\x45\xAC\x06\x4C\xAE\x95\xEF\x9E\xA0\xA1\x9E\xA5\xC0\x94\x82\x48\xAF\x77\x7D\xAD\xA1\x4D\xA7\xA6\x84\x8E\xA7\x76\x84\xA8\x28\xA5\xA0\x87\xA4\x83\x5D\xAD\x83\x43\xAF\x90\xC4\x6A\x83\xA3\xAC\x9E\xB1\x7E\x88\x59\x6A\x92\x23\x1D\x49\x48\x9D\x96\x46\x79\x77\x94\x8D\x49\xE8\x71\xA3\xB1\xA3\x79\xF1\x83\xA0\x88\x70\x8A\x5D\x94\x9E\x36\x91\x78\xBC\x17\x01\xB2\xA3\x87\xB4\xA0\x94\x93\x7A\x2F\xC7\x70\x97\xBE\xA3\x8C\xAA\x91\xAC\x23\x1C\x1B\x69\xA5\xAC\xBC\x1F\x96\x2F\xA3\x79\x89\x8F\xA4\xA6\xAB\xA6\xAF\x93\xA5\xCB\x83\xA2\x56\xA5\xA2\x9D\x76\x83\x87\x9B\x26\x5B\xAC\x7B\xA9\xAD\xA2\x81\x77\x7A\xEB\x79\xAD\x81\xAD\xA8\xE4\x96\x99\x3B\xA8\x99\xB7\x76\x7D\xB9\x72\x98\xB7\x98\xAE\x9F\xAF\x7D\x2A\xA2\x9F\x89\x9A\xAE\x23\x15\x9A\xD0\x7E\xAE\x74\xA4\x99\x83\xAD\xAD\x97\x94\xA5\x52\xAF\xA2\x55\x4C\x06\x59\xA6\xAE\x9E\x95\xAA\x3C\x8C\xA2\xE4\x71\x78\x61\xA0\x7D\x57\x95\xB0\xAD\x9C\xAD\xCC\x97\x13\x6E\xA9\xAC\x31\xA3\xAD\x65\xA5\x94\xAA\x47\xA7\x37\x19\xA7\x7B\xA8\x95\xCB\x8B\xA9\x98\xAA\x9A\xAA\x43\xA0\x32\x81\xAA\x90\xA0\xA1\x5C\xAB\xAD\xED\x7F\xA8\xE9\xA5\xB1\xF5\x95\xA9\x7E\x74\xB0\x68\xAC\xA9\xD3\x72\xA0\x85\xA5\x98\x16\x82\xB3\x39\xB2\xB1\x6F\x27\x3C\xA8\xA9\xA8\x91\xA4\xAA\x5F\xA7\x13\xBC\x10\x33\xD4\xA3\x8E\x23\x14\xA1\xC3\x9C\xB3\x31\xA6\x12\xE0\xAA\x78\xE2\xA8\xAF\xE4\xAD\xAF\x67\x27\xAE\xDD\x77\xB4\x4F\xBA\x14\xEC\xAF\x9C\x58\xB8\x89\xCA\x89\x99\xF6\xAB\x99\xF9\xA3\xB6\xFB\xA4\xB4\xBB\x98\xB4\xFE\xA4\xB1\xF4\x97\x13\x02\xBF\xA6\xD7\xAB\x26\x3C\xAC\x21\x88\x7D\xB0\x0F\xB1\xB6\x11\xB5\xB3\x13\xBE\xAF\xAA\xA6\xB2\x4A\x18\xB2\x62\xAC\x10\x30\xB0\xAA\x0B\x72\xAA\x4C\xB4\xB3\xFA\xAA\xA0\xEE\x9D\x40\xF0\x94\xB6\x93\xAB\xB3\x7B\xB5\x78\x84\x7D\xB8\x86\xAF\xB8\x33\xBB\xA8\xF0\xAF\x1F\x0C\xA0\x12\xA1\xB2\xA9\x46\xA2\xAC\x18\x1D\x01\x53\xB4\x8A\x16\xB1\xA3\xAE\xA0\xB5\x07\x3D\xBA\x7D\x71\x9C\x6A\xB9\x78\x19\xB8\x10\xF8\x85\x78\x6E\x7D\xB1\x4A\x1F\xB1\xB8\xB1\xA3\xBB\xBF\x77\xBD\xB4\xBB\x73\x80",
-};
-
-			void JsonGetParserBuffer(vl::stream::MemoryStream& stream)
+			void JsonWriter::Write(wchar_t c)
 			{
-				vl::stream::MemoryStream compressedStream;
-				for (vint i = 0; i < parserBufferRows; i++)
-				{
-					vint size = i == parserBufferRows - 1 ? parserBufferRemain : parserBufferBlock;
-					compressedStream.Write((void*)parserBuffer[i], size);
-				}
-				compressedStream.SeekFromBegin(0);
-				vl::stream::LzwDecoder decoder;
-				vl::stream::DecoderStream decoderStream(compressedStream, decoder);
-				vl::collections::Array<vl::vuint8_t> buffer(65536);
-				while (true)
+				if (used == buffer.Count() - 1)
 				{
-					vl::vint size = decoderStream.Read(&buffer[0], 65536);
-					if (size == 0) break;
-					stream.Write(&buffer[0], size);
+					Flush();
 				}
-				stream.SeekFromBegin(0);
+				buffer[used++] = c;
 			}
-/***********************************************************************
-Unescaping Function Foward Declarations
-***********************************************************************/
-
-			extern void JsonUnescapingString(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens);
-
-/***********************************************************************
-Parsing Tree Conversion Driver Implementation
-***********************************************************************/
 
-			class JsonTreeConverter : public vl::parsing::ParsingTreeConverter
+			void JsonWriter::Write(const wchar_t* text, vint length)
 			{
-			public:
-				using vl::parsing::ParsingTreeConverter::SetMember;
-
-				bool SetMember(JsonLiteral::JsonValue& member, vl::Ptr<vl::parsing::ParsingTreeNode> node, const TokenList& tokens)
+				while (length > 0)
 				{
-					vl::Ptr<vl::parsing::ParsingTreeToken> token=node.Cast<vl::parsing::ParsingTreeToken>();
-					if(token)
+					vint available = buffer.Count() - 1 - used;
+					if (available == 0)
 					{
-						if(token->GetValue()==L"True") { member=JsonLiteral::JsonValue::True; return true; }
-						else if(token->GetValue()==L"False") { member=JsonLiteral::JsonValue::False; return true; }
-						else if(token->GetValue()==L"Null") { member=JsonLiteral::JsonValue::Null; return true; }
-						else { member=JsonLiteral::JsonValue::True; return false; }
+						Flush();
+						available = buffer.Count() - 1;
 					}
-					member=JsonLiteral::JsonValue::True;
-					return false;
+					vint count = length < available ? length : available;
+					memcpy(&buffer[used], text, count * sizeof(wchar_t));
+					used += count;
+					text += count;
+					length -= count;
 				}
+			}
 
-				void Fill(vl::Ptr<JsonNode> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+			void JsonWriter::WriteEscaped(const wchar_t* text, vint length)
+			{
+				// the same as JsonEscapeString
+				vint begin = 0;
+				for (vint i = 0; i < length; i++)
 				{
+					const wchar_t* escaped = nullptr;
+					switch (text[i])
+					{
+					case L'\"': escaped = L"\\\""; break;
+					case L'\\': escaped = L"\\\\"; break;
+					case L'/': escaped = L"\\/"; break;
+					case L'\b': escaped = L"\\b"; break;
+					case L'\f': escaped = L"\\f"; break;
+					case L'\n': escaped = L"\\n"; break;
+					case L'\r': escaped = L"\\r"; break;
+					case L'\t': escaped = L"\\t"; break;
+					default: continue;
+					}
+					Write(text + begin, i - begin);
+					Write(escaped, 2);
+					begin = i + 1;
 				}
+				Write(text + begin, length - begin);
+			}
 
-				void Fill(vl::Ptr<JsonLiteral> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+			void JsonWriter::BeginValue()
+			{
+				if (needComma)
 				{
-					SetMember(tree->value, obj->GetMember(L"value"), tokens);
+					Write(L',');
 				}
+				needComma = true;
+			}
 
-				void Fill(vl::Ptr<JsonString> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+			JsonWriter::JsonWriter(stream::TextWriter& _writer, vint bufferSize)
+				:writer(_writer)
+				, buffer(bufferSize < 16 ? 16 : bufferSize)
+			{
+			}
+
+			JsonWriter::~JsonWriter()
+			{
+				Flush();
+			}
+
+			void JsonWriter::Flush()
+			{
+				if (used > 0)
 				{
-					if(SetMember(tree->content, obj->GetMember(L"content"), tokens))
+					// TextWriter::WriteString(const wchar_t*, vint) may stop at the zero terminator
+					buffer[used] = 0;
+					writer.WriteString(&buffer[0], used);
+					used = 0;
+				}
+			}
+
+			void JsonWriter::BeginObject()
+			{
+				BeginValue();
+				Write(L'{');
+				needComma = false;
+			}
+
+			void JsonWriter::EndObject()
+			{
+				Write(L'}');
+				needComma = true;
+			}
+
+			void JsonWriter::Field(const WString& name)
+			{
+				BeginValue();
+				Write(L'\"');
+				WriteEscaped(name.Buffer(), name.Length());
+				Write(L"\":", 2);
+				needComma = false;
+			}
+
+			void JsonWriter::BeginArray()
+			{
+				BeginValue();
+				Write(L'[');
+				needComma = false;
+			}
+
+			void JsonWriter::EndArray()
+			{
+				Write(L']');
+				needComma = true;
+			}
+
+			void JsonWriter::String(const WString& value)
+			{
+				BeginValue();
+				Write(L'\"');
+				WriteEscaped(value.Buffer(), value.Length());
+				Write(L'\"');
+			}
+
+			void JsonWriter::Number(const WString& text)
+			{
+				BeginValue();
+				Write(text.Buffer(), text.Length());
+			}
+
+			void JsonWriter::Literal(JsonLiteral::JsonValue value)
+			{
+				BeginValue();
+				switch (value)
+				{
+				case JsonLiteral::JsonValue::True:
+					Write(L"true", 4);
+					break;
+				case JsonLiteral::JsonValue::False:
+					Write(L"false", 5);
+					break;
+				case JsonLiteral::JsonValue::Null:
+					Write(L"null", 4);
+					break;
+				}
+			}
+
+/***********************************************************************
+JsonFastParser
+***********************************************************************/
+
+			template<typename THandler>
+			class JsonFastParser : public Object
+			{
+				typedef typename THandler::ValueType		ValueType;
+				typedef typename THandler::ObjectType		ObjectType;
+				typedef typename THandler::ArrayType		ArrayType;
+			protected:
+				THandler&							handler;
+				List<Ptr<ParsingError>>&			errors;
+				vint								codeIndex;
+				const wchar_t*						input;
+				const wchar_t*						reading;
+				const wchar_t*						rowStart;
+				vint								row = 0;
+				vint								depth = 0;
+				ParsingTextPos						lastEnd;
+				Array<wchar_t>						unescaping;
+
+				ParsingTextPos GetPos(const wchar_t* position)
+				{
+					ParsingTextPos pos;
+					pos.index = position - input;
+					pos.row = row;
+					pos.column = position - rowStart;
+					return pos;
+				}
+
+				bool Fail(const wchar_t* position, const WString& message)
+				{
+					auto error = MakePtr<ParsingError>(message);
+					error->codeRange = ParsingTextRange(GetPos(position), GetPos(position), codeIndex);
+					errors.Add(error);
+					return false;
+				}
+
+				void SkipSpaces()
+				{
+					while (true)
 					{
-						JsonUnescapingString(tree->content, tokens);
+						switch (*reading)
+						{
+						case L'\n':
+							reading++;
+							row++;
+							rowStart = reading;
+							break;
+						case L' ':
+						case L'\t':
+						case L'\r':
+							reading++;
+							break;
+						default:
+							return;
+						}
 					}
 				}
 
-				void Fill(vl::Ptr<JsonNumber> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				static bool IsHex(wchar_t c)
 				{
-					SetMember(tree->content, obj->GetMember(L"content"), tokens);
+					return (L'0' <= c && c <= L'9') || (L'a' <= c && c <= L'f') || (L'A' <= c && c <= L'F');
 				}
 
-				void Fill(vl::Ptr<JsonArray> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				static vuint16_t GetHexValue(wchar_t c)
 				{
-					SetMember(tree->items, obj->GetMember(L"items"), tokens);
+					return c <= L'9' ? c - L'0' : c <= L'F' ? c - L'A' + 10 : c - L'a' + 10;
 				}
 
-				void Fill(vl::Ptr<JsonObjectField> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				bool ParseString(const wchar_t*& text, vint& length, ParsingTextRange& range)
 				{
-					if(SetMember(tree->name, obj->GetMember(L"name"), tokens))
+					// strings are escaped in the same way as JsonUnescapeString
+					ParsingTextPos start = GetPos(reading);
+					const wchar_t* begin = ++reading;
+					bool escaped = false;
+					while (true)
 					{
-						JsonUnescapingString(tree->name, tokens);
+						wchar_t c = *reading;
+						if (c == L'\"')
+						{
+							break;
+						}
+						else if (c == 0)
+						{
+							return Fail(begin - 1, L"The string is not closed.");
+						}
+						else if (c == L'\\')
+						{
+							escaped = true;
+							if (reading[1] == L'u')
+							{
+								if (!IsHex(reading[2]) || !IsHex(reading[3]) || !IsHex(reading[4]) || !IsHex(reading[5]))
+								{
+									return Fail(reading, L"Four hexadecimal digits are expected after \"\\u\".");
+								}
+								reading += 6;
+								continue;
+							}
+							else if (reading[1] == 0)
+							{
+								return Fail(begin - 1, L"The string is not closed.");
+							}
+							reading++;
+							c = *reading;
+						}
+
+						reading++;
+						if (c == L'\n')
+						{
+							row++;
+							rowStart = reading;
+						}
 					}
-					SetMember(tree->value, obj->GetMember(L"value"), tokens);
+					range = ParsingTextRange(start, GetPos(reading), codeIndex);
+					length = reading - begin;
+					reading++;
+
+					if (!escaped)
+					{
+						text = begin;
+						return true;
+					}
+
+					if (unescaping.Count() < length)
+					{
+						unescaping.Resize(length);
+					}
+					wchar_t* writing = &unescaping[0];
+					for (vint i = 0; i < length; i++)
+					{
+						wchar_t c = begin[i];
+						if (c != L'\\')
+						{
+							*writing++ = c;
+							continue;
+						}
+						switch (c = begin[++i])
+						{
+						case L'b': *writing++ = L'\b'; break;
+						case L'f': *writing++ = L'\f'; break;
+						case L'n': *writing++ = L'\n'; break;
+						case L'r': *writing++ = L'\r'; break;
+						case L't': *writing++ = L'\t'; break;
+						case L'u':
+							*writing++ = (wchar_t)(vuint16_t)(
+								(GetHexValue(begin[i + 1]) << 12) +
+								(GetHexValue(begin[i + 2]) << 8) +
+								(GetHexValue(begin[i + 3]) << 4) +
+								(GetHexValue(begin[i + 4]) << 0)
+								);
+							i += 4;
+							break;
+						default: *writing++ = c;
+						}
+					}
+					text = &unescaping[0];
+					length = writing - text;
+					return true;
 				}
 
-				void Fill(vl::Ptr<JsonObject> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				static bool IsDigit(wchar_t c)
 				{
-					SetMember(tree->fields, obj->GetMember(L"fields"), tokens);
+					return L'0' <= c && c <= L'9';
 				}
 
-				vl::Ptr<vl::parsing::ParsingTreeCustomBase> ConvertClass(vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)override
+				bool ParseNumber(ValueType& value)
 				{
-					if(obj->GetType()==L"Literal")
+					const wchar_t* begin = reading;
+					if (*reading == L'-') reading++;
+					if (!IsDigit(*reading))
 					{
-						vl::Ptr<JsonLiteral> tree = new JsonLiteral;
-						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
-						Fill(tree, obj, tokens);
-						Fill(tree.Cast<JsonNode>(), obj, tokens);
-						return tree;
+						return Fail(begin, L"A number is expected.");
 					}
-					else if(obj->GetType()==L"String")
+					while (IsDigit(*reading)) reading++;
+					if (reading[0] == L'.' && IsDigit(reading[1]))
 					{
-						vl::Ptr<JsonString> tree = new JsonString;
-						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
-						Fill(tree, obj, tokens);
-						Fill(tree.Cast<JsonNode>(), obj, tokens);
-						return tree;
+						reading++;
+						while (IsDigit(*reading)) reading++;
 					}
-					else if(obj->GetType()==L"Number")
+					if (reading[0] == L'e' || reading[0] == L'E')
 					{
-						vl::Ptr<JsonNumber> tree = new JsonNumber;
-						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
-						Fill(tree, obj, tokens);
-						Fill(tree.Cast<JsonNode>(), obj, tokens);
-						return tree;
+						vint sign = reading[1] == L'+' || reading[1] == L'-' ? 1 : 0;
+						if (IsDigit(reading[1 + sign]))
+						{
+							reading += 1 + sign;
+							while (IsDigit(*reading)) reading++;
+						}
 					}
-					else if(obj->GetType()==L"Array")
+
+					ParsingTextRange range(GetPos(begin), GetPos(reading - 1), codeIndex);
+					value = handler.Number(begin, reading - begin, range);
+					lastEnd = range.end;
+					return true;
+				}
+
+				bool ParseLiteral(const wchar_t* keyword, vint length, JsonLiteral::JsonValue literal, ValueType& value)
+				{
+					if (wcsncmp(reading, keyword, length) != 0)
 					{
-						vl::Ptr<JsonArray> tree = new JsonArray;
-						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
-						Fill(tree, obj, tokens);
-						Fill(tree.Cast<JsonNode>(), obj, tokens);
-						return tree;
+						return Fail(reading, L"A value is expected.");
 					}
-					else if(obj->GetType()==L"ObjectField")
+					ParsingTextRange range(GetPos(reading), GetPos(reading + length - 1), codeIndex);
+					reading += length;
+					value = handler.Literal(literal, range);
+					lastEnd = range.end;
+					return true;
+				}
+
+				// objects and arrays are parsed recursively, deeper inputs are rejected before the stack overflows
+				bool EnterNested()
+				{
+					if (++depth > JsonMaxNestingLevel)
 					{
-						vl::Ptr<JsonObjectField> tree = new JsonObjectField;
-						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
-						Fill(tree, obj, tokens);
-						Fill(tree.Cast<JsonNode>(), obj, tokens);
-						return tree;
+						return Fail(reading, L"Objects and arrays are nested deeper than " + itow(JsonMaxNestingLevel) + L" levels.");
 					}
-					else if(obj->GetType()==L"Object")
+					return true;
+				}
+
+				bool ParseObject(ValueType& value)
+				{
+					if (!EnterNested()) return false;
+					ParsingTextPos start = GetPos(reading);
+					ObjectType object = handler.BeginObject(ParsingTextRange(start, start, codeIndex));
+					reading++;
+					SkipSpaces();
+					if (*reading != L'}')
+					{
+						while (true)
+						{
+							SkipSpaces();
+							if (*reading != L'\"')
+							{
+								return Fail(reading, L"The name of a field is expected.");
+							}
+
+							const wchar_t* name = nullptr;
+							vint length = 0;
+							ParsingTextRange nameRange;
+							if (!ParseString(name, length, nameRange)) return false;
+							handler.FieldName(object, name, length, nameRange);
+
+							SkipSpaces();
+							if (*reading != L':')
+							{
+								return Fail(reading, L"\":\" is expected after the name of a field.");
+							}
+							reading++;
+
+							ValueType fieldValue;
+							if (!ParseValue(fieldValue)) return false;
+							handler.FieldValue(object, fieldValue, ParsingTextRange(nameRange.start, lastEnd, codeIndex));
+
+							SkipSpaces();
+							if (*reading == L',')
+							{
+								reading++;
+							}
+							else if (*reading == L'}')
+							{
+								break;
+							}
+							else
+							{
+								return Fail(reading, L"\",\" or \"}\" is expected in an object.");
+							}
+						}
+					}
+
+					lastEnd = GetPos(reading);
+					reading++;
+					value = handler.EndObject(object, ParsingTextRange(start, lastEnd, codeIndex));
+					depth--;
+					return true;
+				}
+
+				bool ParseArray(ValueType& value)
+				{
+					if (!EnterNested()) return false;
+					ParsingTextPos start = GetPos(reading);
+					ArrayType array = handler.BeginArray(ParsingTextRange(start, start, codeIndex));
+					reading++;
+					SkipSpaces();
+					if (*reading != L']')
+					{
+						while (true)
+						{
+							ValueType item;
+							if (!ParseValue(item)) return false;
+							handler.Item(array, item);
+
+							SkipSpaces();
+							if (*reading == L',')
+							{
+								reading++;
+							}
+							else if (*reading == L']')
+							{
+								break;
+							}
+							else
+							{
+								return Fail(reading, L"\",\" or \"]\" is expected in an array.");
+							}
+						}
+					}
+
+					lastEnd = GetPos(reading);
+					reading++;
+					value = handler.EndArray(array, ParsingTextRange(start, lastEnd, codeIndex));
+					depth--;
+					return true;
+				}
+
+				bool ParseValue(ValueType& value)
+				{
+					SkipSpaces();
+					switch (*reading)
+					{
+					case L'{':
+						return ParseObject(value);
+					case L'[':
+						return ParseArray(value);
+					case L'\"':
+						{
+							const wchar_t* text = nullptr;
+							vint length = 0;
+							ParsingTextRange range;
+							if (!ParseString(text, length, range)) return false;
+							value = handler.String(text, length, range);
+							lastEnd = range.end;
+							return true;
+						}
+					case L't':
+						return ParseLiteral(L"true", 4, JsonLiteral::JsonValue::True, value);
+					case L'f':
+						return ParseLiteral(L"false", 5, JsonLiteral::JsonValue::False, value);
+					case L'n':
+						return ParseLiteral(L"null", 4, JsonLiteral::JsonValue::Null, value);
+					case L'-':
+					case L'0': case L'1': case L'2': case L'3': case L'4':
+					case L'5': case L'6': case L'7': case L'8': case L'9':
+						return ParseNumber(value);
+					case 0:
+						return Fail(reading, L"A value is expected before the end of the input.");
+					default:
+						return Fail(reading, L"A value is expected.");
+					}
+				}
+			public:
+				JsonFastParser(THandler& _handler, List<Ptr<ParsingError>>& _errors, vint _codeIndex)
+					:handler(_handler)
+					, errors(_errors)
+					, codeIndex(_codeIndex)
+				{
+				}
+
+				bool Parse(const WString& text, ValueType& value)
+				{
+					input = text.Buffer();
+					reading = input;
+					rowStart = input;
+					row = 0;
+					depth = 0;
+
+					SkipSpaces();
+					if (*reading != L'{' && *reading != L'[')
+					{
+						return Fail(reading, L"The root value should be an object or an array.");
+					}
+					if (!ParseValue(value)) return false;
+					SkipSpaces();
+					if (*reading != 0)
+					{
+						return Fail(reading, L"Nothing is expected after the root value.");
+					}
+					return true;
+				}
+			};
+
+/***********************************************************************
+JsonRead
+***********************************************************************/
+
+			class JsonNodeBuilder
+			{
+			public:
+				typedef Ptr<JsonNode>				ValueType;
+				typedef Ptr<JsonObject>				ObjectType;
+				typedef Ptr<JsonArray>				ArrayType;
+
+				ObjectType BeginObject(const ParsingTextRange& range)
+				{
+					return MakePtr<JsonObject>();
+				}
+
+				void FieldName(ObjectType& object, const wchar_t* name, vint length, const ParsingTextRange& range)
+				{
+					auto field = MakePtr<JsonObjectField>();
+					field->name.codeRange = range;
+					field->name.value = WString(name, length);
+					object->fields.Add(field);
+				}
+
+				void FieldValue(ObjectType& object, ValueType& value, const ParsingTextRange& range)
+				{
+					auto field = object->fields[object->fields.Count() - 1].Obj();
+					field->codeRange = range;
+					field->value = value;
+				}
+
+				ValueType EndObject(ObjectType& object, const ParsingTextRange& range)
+				{
+					object->codeRange = range;
+					return object;
+				}
+
+				ArrayType BeginArray(const ParsingTextRange& range)
+				{
+					return MakePtr<JsonArray>();
+				}
+
+				void Item(ArrayType& array, ValueType& value)
+				{
+					array->items.Add(value);
+				}
+
+				ValueType EndArray(ArrayType& array, const ParsingTextRange& range)
+				{
+					array->codeRange = range;
+					return array;
+				}
+
+				ValueType String(const wchar_t* text, vint length, const ParsingTextRange& range)
+				{
+					auto node = MakePtr<JsonString>();
+					node->codeRange = range;
+					node->content.codeRange = range;
+					node->content.value = WString(text, length);
+					return node;
+				}
+
+				ValueType Number(const wchar_t* text, vint length, const ParsingTextRange& range)
+				{
+					auto node = MakePtr<JsonNumber>();
+					node->codeRange = range;
+					node->content.codeRange = range;
+					node->content.value = WString(text, length);
+					return node;
+				}
+
+				ValueType Literal(JsonLiteral::JsonValue value, const ParsingTextRange& range)
+				{
+					auto node = MakePtr<JsonLiteral>();
+					node->codeRange = range;
+					node->value = value;
+					return node;
+				}
+			};
+
+			class JsonCallbackAdapter
+			{
+			public:
+				typedef bool						ValueType;
+				typedef bool						ObjectType;
+				typedef bool						ArrayType;
+
+				IJsonReaderCallback&				callback;
+
+				JsonCallbackAdapter(IJsonReaderCallback& _callback)
+					:callback(_callback)
+				{
+				}
+
+				ObjectType BeginObject(const ParsingTextRange& range)
+				{
+					callback.OnBeginObject(range);
+					return true;
+				}
+
+				void FieldName(ObjectType& object, const wchar_t* name, vint length, const ParsingTextRange& range)
+				{
+					callback.OnField(name, length, range);
+				}
+
+				void FieldValue(ObjectType& object, ValueType& value, const ParsingTextRange& range)
+				{
+				}
+
+				ValueType EndObject(ObjectType& object, const ParsingTextRange& range)
+				{
+					callback.OnEndObject(range);
+					return true;
+				}
+
+				ArrayType BeginArray(const ParsingTextRange& range)
+				{
+					callback.OnBeginArray(range);
+					return true;
+				}
+
+				void Item(ArrayType& array, ValueType& value)
+				{
+				}
+
+				ValueType EndArray(ArrayType& array, const ParsingTextRange& range)
+				{
+					callback.OnEndArray(range);
+					return true;
+				}
+
+				ValueType String(const wchar_t* text, vint length, const ParsingTextRange& range)
+				{
+					callback.OnString(text, length, range);
+					return true;
+				}
+
+				ValueType Number(const wchar_t* text, vint length, const ParsingTextRange& range)
+				{
+					callback.OnNumber(text, length, range);
+					return true;
+				}
+
+				ValueType Literal(JsonLiteral::JsonValue value, const ParsingTextRange& range)
+				{
+					callback.OnLiteral(value, range);
+					return true;
+				}
+			};
+
+			bool JsonRead(const WString& input, IJsonReaderCallback& callback, collections::List<Ptr<ParsingError>>& errors, vint codeIndex)
+			{
+				JsonCallbackAdapter adapter(callback);
+				JsonFastParser<JsonCallbackAdapter> parser(adapter, errors, codeIndex);
+				bool value = false;
+				return parser.Parse(input, value);
+			}
+
+			Ptr<JsonNode> JsonParse(const WString& input, collections::List<Ptr<ParsingError>>& errors, vint codeIndex)
+			{
+				JsonNodeBuilder builder;
+				JsonFastParser<JsonNodeBuilder> parser(builder, errors, codeIndex);
+				Ptr<JsonNode> value;
+				if (parser.Parse(input, value))
+				{
+					return value;
+				}
+				return nullptr;
+			}
+
+			double JsonParseNumber(const wchar_t* text, vint length)
+			{
+				// exact when the mantissa fits in 53 bits and the power of 10 is exactly representable
+				static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+				const wchar_t* reading = text;
+				const wchar_t* end = text + length;
+				bool negative = reading < end && *reading == L'-';
+				if (negative) reading++;
+
+				vuint64_t mantissa = 0;
+				vint digits = 0;
+				vint exponent = 0;
+				for (; reading < end && L'0' <= *reading && *reading <= L'9'; reading++)
+				{
+					mantissa = mantissa * 10 + (*reading - L'0');
+					if (mantissa > 0) digits++;
+				}
+				if (reading < end && *reading == L'.')
+				{
+					for (reading++; reading < end && L'0' <= *reading && *reading <= L'9'; reading++)
+					{
+						mantissa = mantissa * 10 + (*reading - L'0');
+						if (mantissa > 0) digits++;
+						exponent--;
+					}
+				}
+				if (reading < end && (*reading == L'e' || *reading == L'E'))
+				{
+					reading++;
+					bool negativeExponent = reading < end && *reading == L'-';
+					if (reading < end && (*reading == L'-' || *reading == L'+')) reading++;
+					vint value = 0;
+					for (; reading < end && L'0' <= *reading && *reading <= L'9'; reading++)
+					{
+						if (value < 100000) value = value * 10 + (*reading - L'0');
+					}
+					exponent += negativeExponent ? -value : value;
+				}
+
+				if (digits <= 15 && -22 <= exponent && exponent <= 22)
+				{
+					double result = (double)mantissa;
+					result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+					return negative ? -result : result;
+				}
+
+				wchar_t buffer[64];
+				if (length < (vint)(sizeof(buffer) / sizeof(*buffer)))
+				{
+					memcpy(buffer, text, length * sizeof(wchar_t));
+					buffer[length] = 0;
+					return wcstod(buffer, nullptr);
+				}
+				return wcstod(WString(text, length).Buffer(), nullptr);
+			}
+		}
+	}
+}
+
+/***********************************************************************
+PARSING\JSON\PARSINGJSON_PARSER.CPP
+***********************************************************************/
+
+namespace vl
+{
+	namespace parsing
+	{
+		namespace json
+		{
+/***********************************************************************
+ParserText
+***********************************************************************/
+
+const wchar_t parserTextBuffer[] = 
+L"\r\n" L""
+L"\r\n" L"class Node"
+L"\r\n" L"{"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"class Literal:Node"
+L"\r\n" L"{"
+L"\r\n" L"\tenum Value"
+L"\r\n" L"\t{"
+L"\r\n" L"\t\tTrue,"
+L"\r\n" L"\t\tFalse,"
+L"\r\n" L"\t\tNull,"
+L"\r\n" L"\t}"
+L"\r\n" L""
+L"\r\n" L"\tValue value;"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"class String:Node"
+L"\r\n" L"{"
+L"\r\n" L"\ttoken content(JsonUnescapingString)\t\t\t\t@Color(\"String\");"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"class Number:Node"
+L"\r\n" L"{"
+L"\r\n" L"\ttoken content;"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"class Array:Node"
+L"\r\n" L"{"
+L"\r\n" L"\tNode[] items;"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"class ObjectField:Node"
+L"\r\n" L"{"
+L"\r\n" L"\ttoken name(JsonUnescapingString)\t\t\t\t@Color(\"AttName\");"
+L"\r\n" L"\tNode value;"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"class Object:Node"
+L"\r\n" L"{"
+L"\r\n" L"\tObjectField[] fields;"
+L"\r\n" L"}"
+L"\r\n" L""
+L"\r\n" L"token TRUEVALUE = \"true\"\t\t\t\t\t\t\t@Color(\"Keyword\");"
+L"\r\n" L"token FALSEVALUE = \"false\"\t\t\t\t\t\t\t@Color(\"Keyword\");"
+L"\r\n" L"token NULLVALUE = \"null\"\t\t\t\t\t\t\t@Color(\"Keyword\");"
+L"\r\n" L"token OBJOPEN = \"\\{\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
+L"\r\n" L"token OBJCLOSE = \"\\}\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
+L"\r\n" L"token ARROPEN = \"\\[\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
+L"\r\n" L"token ARRCLOSE = \"\\]\"\t\t\t\t\t\t\t\t@Color(\"Boundary\");"
+L"\r\n" L"token COMMA = \",\";"
+L"\r\n" L"token COLON = \":\";"
+L"\r\n" L"token NUMBER = \"[\\-]?\\d+(.\\d+)?([eE][+\\-]?\\d+)?\"\t@Color(\"Number\");"
+L"\r\n" L"token STRING = \"\"\"([^\\\\\"\"]|\\\\[^u]|\\\\u\\d{4})*\"\"\"\t\t@ContextColor();"
+L"\r\n" L""
+L"\r\n" L"discardtoken SPACE = \"\\s+\";"
+L"\r\n" L""
+L"\r\n" L"rule Node JLiteral"
+L"\r\n" L"\t= STRING:content as String"
+L"\r\n" L"\t= NUMBER:content as Number"
+L"\r\n" L"\t= \"true\" as Literal with {value = \"True\"}"
+L"\r\n" L"\t= \"false\" as Literal with {value = \"False\"}"
+L"\r\n" L"\t= \"null\" as Literal with {value = \"Null\"}"
+L"\r\n" L"\t;"
+L"\r\n" L""
+L"\r\n" L"rule ObjectField JField"
+L"\r\n" L"\t= STRING:name \":\" JValue:value as ObjectField"
+L"\r\n" L"\t;"
+L"\r\n" L""
+L"\r\n" L"rule Object JObject"
+L"\r\n" L"\t= \"{\" [JField:fields {\",\" JField:fields} ] \"}\" as Object"
+L"\r\n" L"\t;"
+L"\r\n" L""
+L"\r\n" L"rule Array JArray"
+L"\r\n" L"\t= \"[\" [JValue:items {\",\" JValue:items} ] \"]\" as Array"
+L"\r\n" L"\t;"
+L"\r\n" L""
+L"\r\n" L"rule Node JValue"
+L"\r\n" L"\t= !JLiteral"
+L"\r\n" L"\t= !JObject"
+L"\r\n" L"\t= !JArray"
+L"\r\n" L"\t;"
+L"\r\n" L""
+L"\r\n" L"rule Node JRoot"
+L"\r\n" L"\t= !JObject"
+L"\r\n" L"\t= !JArray"
+L"\r\n" L"\t;"
+;
+
+			vl::WString JsonGetParserTextBuffer()
+			{
+				return parserTextBuffer;
+			}
+
+/***********************************************************************
+SerializedTable
+***********************************************************************/
+
+const vint parserBufferLength = 3788; // 17748 bytes before compressing
+const vint parserBufferBlock = 1024;
+const vint parserBufferRemain = 716;
+const vint parserBufferRows = 4;
+const char* parserBuffer[] = {
+"\x00\x0B\x00\x02\x83\x80\x07\x7D\x00\x82\x03\xFF\x45\x08\x82\x83\x86\x81\x21\x6F\x6C\x2F\x32\x37\x84\x86\x02\x86\x00\x17\x82\x93\x24\x3A\x39\x34\x37\x67\x06\x98\x8A\x88\x8E\x84\x00\x88\x12\x94\x98\x87\x0B\x93\x81\x20\x3A\x74\x4E\x21\x2D\x35\x32\x90\x86\x92\x0C\xA6\xA8\x93\x85\x88\x84\x96\x86\x3F\x80\x0B\x25\x39\x3F\x3B\x88\x32\x36\x88\xB8\x88\x8A\x99\x88\x9F\x96\x40\x83\x83\xA5\xA7\xA1\xA4\x83\xA5\x04\xCD\xA9\x9D\x94\x81\xA1\xAE\xA9\x44\xC6\xB2\x28\xAC\xA9\x86\x93\xAC\x03\xBB\xAA\x8C\x88\x00\x8D\xB6\x81\x42\x6F\x35\x2E\x34\x31\x32\x39\x3C\x56\xE6\xA5\x89\xBE\xA3\xB4\x85\xB7\x7F\x83\xB1\xB3\xB5\xBF\xB9\xBC\x81\x58\x83\x9A\xAF\xAC\xB6\xB6\xC0\xB9\x74\xF6\xB8\xA5\xB8\xC7\xB2\xC4\xBE\x5B\x8E\xCD\xD0\xB0\xCD\xC3\xC9\x91\x96\x8D\x98\xCC\xC8\x82\x8D\xD3\x81\x4E\x75\x2D\x22\x35\x32\x3B\xC3\x82\x0C\x18\xB1\xCF\x8F\x36\x34\x3B\x32\x78\x74\x2A\xB8\x80\x06\xAF\xCB\x9C\x2E\xF2\x32\x21\x38\xBF\x7E\xE3\xE3\xFF\x3E\xC2\x81\xAC\x21\x37\xDB\xE1\x6C\x48\xC8\xE4\x08\x8C\xEA\x80\x27\x6F\x64\x35\x92\xE6\xE6\xD0\x82\xD3\xA9\xAB\xED\xDC\xED\xE8\x8E\xD3\x27\x62\x6A\x25\x23\x34\x3C\xF3\x7F\x80\x0C\xF0\xC0\x08\xFA\xF4\xF6\x23\x34\x65\x6C\x08\xA4\xFE\xEB\x82\xD2\x8E\x1E\x60\x4E\x7A\x72\x00\x21\x65\x81\x70\xC3\x79\x16\x82\x49\xCE\x65\x1D\x1B\x1C\x03\x90\x50\x01\x73\xCF\x61\x1C\x1B\x82\x03\x76\x16\x85\x1D\xDB\x5C\x7D\x7E\x40\xE0\x6A\x6C\x6A\x1C\x04\x81\x53\x19\x6D\xB7\x76\x6E\x7B\x87\x19\x43\x44\x7F\x7A\x74\x2C\x86\x6A\x19\xF8\x7A\x70\x84\x79\xF2\x44\x42\x7F\x8B\xF6\x75\x84\x1A\x75\x08\x40\x9E\x1B\x4C\x65\x14\x60\x40\x46\x3B\xA9\x70\x8F\x7D\xF9\x64\x18\x86\x40\x1A\xAC\x1C\x87\x8A\xE6\x43\x40\x83\x47\x67\x25\x83\x43\x89\xB6\x65\x16\x6C\x6F\x0F\x18\x44\x08\x46\x61\xBC\x66\x9A\x52\xEE\x64\x77\x9B\x4D\x69\x9C\x7B\x98\x9A\x6D\x88\x7F\x9B\x55\x71\x88\x79\x00\x46\x77\x82\x44\x16\x14\x55\x05\x16\x15\x10\x4C\x3D\x90\x90\x41\x40\x9D\x4C\x84\x6F\x02\x18\x4A\x02\xA2\x03\x46\x10\xA3\x14\x7E\x80\xAD\x9F\x93\x00\x26\x16\x87\x1C\x45\x98\x43\x00\x9E\x9C\x97\x75\x14\x13\x4C\x3F\x91\xA1\x11\x83\x83\x42\x91\x1D\x6C\x2C\x19\xA0\x43\xA5\x8B\x72\x87\x13\x42\x0A\x1F\x10\x14\x45\x0E\x1B\xA8\x42\xB7\x9C\x1B\x1F\xA6\xC0\x5B\x61\x62\x40\xB0\x8A\x13\x10\x13\x4F\x10\xA7\xAC\x41\xB9\xBD\x1D\xA9\x8B\x51\x4D\xB0\x01\x10\x52\x12\x13\xAD\xAD\xC7\x83\x49\xAF\x16\x06\x84\x80\x60\x41\x80\x50\xB2\x17\xB0\xC5\x85\x15\xB6\x40\xB9\x9D\x1C\x8B\xB6\xBF\x4C\x59\x5B\x13\x4D\x0D\x11\x12\x91\x3D\x6C\x04\x82\x7B\x94\x83\x1F\x10\xB1\x4E\x30\xB3\x42\x0E\xE8\x88\x6C\x7D\x95\x9E\x8D\x12\x11\x11\x52\x1F\x08\x46\xC1\x02\x5B\x1C\x15\x0B\x5D\x3F\x0C\x14\x19\x2B\x28\x0E\x0B\xC3\x2B\x29\x0F\x0C\x0A\x5B\x25\x15\x11\x17\x5B\x2B\x0B\xC1\xC3\x14\xD6\xC9\x9C\x42\x23\xDF\x70\xC0\x00\x53\x3B\x99\x12\x13\x47\x1B\x08\x46\xCB\x02\x62\x08\xC6\x17\x5C\x1C\x12\x09\x17\x7C\x35\xCB\x16\x17\x75\x38\xC5\xCD\x1D\x0F\xFB\x14\x0D\x1F\x29\x2A\x02\x0B\xA2\x0C\x48\xD8\x42\x91\x94\x93\x10\x15\x10\x43\x05\x1C\xAC\x42\x53\xDC\x13\x1F\x0A\x39\x89\x44\x7B\x98\x16\x67\xCA\x11\x10\xC2\x44\x70\x04\x46\x63\xC2\x4F\xD5\xD8\x79\x2E\x02\x17\x1B\x6F\x34\x1C\x46\x5D\x74\x19\xD2\x42\x7C\x40\x20\x04\x08\x0F\x67\xC9\x8E\x0E\x8C\x03\x79\xD4\x73\x6C\x08\x40\xEE\xDD\xDA\x6F\xF2\x14\x1E\xD2\x04\x4A\xD5\xDC\xDE\x60\xFA\xDC\xDE\xD9\x8D\xC4\x7D\xBC\x00\x80\x43\xEE\x09\x0C\x45\x18\x49\xE6\x40\x8C\xE8\xDE\x0E\x0E\x20\x22\x0B\x16\x08\x75\xDB\x10\x0A\x12\x56\x1B\x85\x18\x08\xA0\xCD\x8F\x80\x08\x7B\x21\xEC\x0A\x08\xA7\xE9\xE2\x97\xEA\xAD\xF7\x6F\xE9\x1F\x20\x1D\x11\xE9\x17\xB4\xE1\x13\x1C\x08\x91\xF9\x1F\xE0\x00\x83\xD3\xE5\xE5\xF1\x2E\x33\x0B\xE4\x42\xCF\xDD\xEA\xDC\xE8\xA2\xF4\xE6\xE8\xEA\xAA\xEC\xE0\x0A\xEB\xC3\xF1\xE2\x0B\xEC\xB5\xD9\xF9\xEE\x83\xC3\xFC\xEE\xEF\xCD\xC1\xC3\xF5\xF0\x10\xCA\xFD\xD4\x85\x6B\x16\x88\xE3\x42\xD2\x4A\x2F\xF0\x77\xE5\xFA\x18\x49\xFC\xE7\xF5\xCD\x80\x77\xE7\x20\x0E\x09\x15\x02\x64\x60\xED\x5C\x49\x45\x74\x00\x06\xF0\x01\x82\x45\xD6\x00\x0D\x01\x0A\x18\x6E\xFD\x16\x40\x80\x11\x16\x54\x0D\x98\x49\x7C\x08\x13\x8C\x0D\xBA\x77\x0E\x39\x68\x10\x74\x08\x51\x4C\x42\x10\x3D\x01\x74\x46\x17\x51\x19\x34\x7D\x0E\x08\x92\x86\x7F\x14\x94\x7A\xA1\x2B\x8A\x81\xE1\x5C\x86\x83\x20\x82\x84\x09\xAB\x77\x84\x11\x14\x0A\x0E\x1C\x4C\x86\x0B\xFD\x75\x42",
+"\x36\x15\x86\x0D\xA8\x4C\x0E\x06\xB7\x80\x05\x0F\xB4\x09\x84\xB1\x7B\x86\x09\xA1\x79\x35\x54\x42\x89\x82\x44\x90\x7E\x11\xA0\x79\x64\x29\x2B\x67\x08\x06\x88\x46\x97\x09\x8B\x81\x2B\x60\x20\x08\x5A\x46\x6C\x8F\x74\x05\x65\x81\x23\x62\x56\x4A\x4C\x3F\xE5\x49\x08\x22\x3A\xBC\x7B\x8D\x15\x9B\x0C\xE9\x20\x07\x7A\x26\x7A\x3A\x7B\x34\x4D\x49\xF7\x32\x74\x76\x25\x3E\x8C\x0C\x80\x9E\x45\xF9\x3D\x71\x75\x3E\x1A\x83\x8D\xC7\x63\x72\x03\x18\x23\x92\xC8\x68\x6A\x6D\x6C\x74\x0D\x11\x74\x22\x6F\x23\x42\x27\x6E\x83\x7E\x04\x08\x40\x01\x92\xDB\x5C\x45\x7D\x66\x66\x95\x19\x17\x7D\x06\x8C\x2D\x94\x7F\xAA\x80\x81\x08\x03\x7F\x80\x2C\xB1\x90\x74\xB3\x8B\x8D\x2D\xF8\x67\x96\x10\x33\x97\x86\x94\x4A\x0B\xDA\x6D\x69\x8C\xE4\x43\x9C\x0E\x97\x65\x04\x46\x4A\x9C\x7F\x63\xB2\x90\x8E\xF5\x34\x0F\x2E\xC2\x99\x93\x67\xAB\x78\x95\xC8\x7C\x81\xD9\x08\x2B\x9B\x2C\xB7\x7F\x98\x9B\x84\x0D\x03\x18\x23\x9D\x4F\xAF\x85\x88\xA2\x88\x8E\x84\x50\x90\x47\x36\x82\x27\x8D\x6B\x8E\x06\x0C\x76\x88\x20\x7A\xB8\x68\x8F\xD4\x7A\x8C\x1F\xA7\x77\x91\x44\x82\x92\x84\xDF\x65\x91\x3F\xA0\x71\x90\x1B\x60\x06\x7C\x8D\x8F\x91\x1C\xD2\x91\x93\x43\x98\x9E\x90\x3E\x57\x72\x0E\x18\x23\xA2\xFE\x47\x90\x80\x5D\x9F\x8A\xF6\x43\x44\x27\xBA\x62\x02\x07\x85\x8A\x96\xF6\x52\x8B\x81\x35\x87\x91\x92\xC5\x6F\xA0\xF3\x32\x0C\x10\x8C\x2D\xA4\x7F\xC5\x75\x83\xE8\x7B\x98\x7B\xDB\x5A\x7C\x7B\x75\x7E\x78\xF8\x35\xA5\x85\xF1\x7B\x74\x91\xE8\x75\x84\xF1\x68\x63\x89\x98\x94\x7B\xA6\xD7\x62\xA6\x4F\xC3\x70\x08\x9D\xA1\xA2\x7C\xDB\x7A\x77\x22\xE7\x70\x78\xA1\x85\x7D\xA1\x3E\x4F\xA3\x21\xCD\x75\xA2\x84\x1D\xA8\x6F\x17\xBC\x8A\xCA\x2C\x6B\xA2\x22\x61\x70\xA4\xE1\x76\xA4\xE8\x24\xA3\x78\x93\xBE\x44\x94\x5E\x6A\x95\x25\x88\x23\xAE\x9E\xAB\x90\x9C\x9C\x88\x4B\x40\x20\x91\x97\x51\x81\x9F\x98\xE5\x88\x21\x60\xD4\x9D\x6C\x4C\xAD\x69\x9C\xF2\x62\x22\xD2\x20\x9E\x99\x51\x85\x9C\x9D\xEC\x25\x4C\x42\x12\xB0\xB2\x64\xB8\xAC\x0C\x80\x64\x20\xE0\x20\x98\x8F\x51\x98\xAD\x49\x5A\xB1\xA2\x0C\x5D\xA4\x21\xAF\x90\xA5\x49\x18\xA3\xAC\x18\xA0\x7C\xA3\xD5\x5F\xA3\x8F\x76\xA3\xA5\xF6\x25\xAB\xA1\x93\x9E\x69\xA5\x9A\x28\x78\xF3\x34\x0F\x78\x82\x11\x79\x94\x47\xB6\x79\x5A\xBD\xA1\xAA\xF2\x40\xA3\x76\x75\x71\xB7\x52\x87\xA0\xA9\xAA\x8B\x87\xAA\x5E\x67\x93\x5C\x84\x25\xAF\xAD\x97\xB5\x93\xF2\x20\x97\x45\x8E\xBB\x9D\x35\xAE\x98\x00\xF0\x8B\xA2\x0B\x35\x04\x12\x8C\x25\xBF\x8E\x0B\xB9\x8E\x70\xA7\xBF\x8E\x82\x8A\x93\x94\x4E\xBC\x9E\x8F\x7E\x96\xA0\x84\xA2\x06\x91\x42\xAB\x8F\x10\xF8\x91\x74\x7D\xBD\x8B\xBE\xEE\xA2\x91\x4E\x84\x92\xBF\x26\x74\xBC\x0C\x53\xA9\xA1\x7E\x8B\xAF\xB0\xEF\x9D\x50\x79\xF1\x93\x04\x3D\x84\x26\x9F\xCA\xAA\xBC\xA6\x03\xA0\x05\x41\x88\xC7\xB8\xD8\x99\xC3\xC3\x09\xD7\xBE\x42\xD1\x9F\xB2\xFD\x1B\x9C\x20\xDD\x96\xB9\x26\x85\x71\x6E\xBD\x82\x25\x6E\xDA\xBE\x47\xDE\x51\xBE\x47\xCC\x83\x22\x70\x5B\xAC\xC5\x62\x80\x0A\x70\x10\x20\xAA\xC6\xA5\x8A\x77\x89\x83\x2D\x9A\x55\x86\xB6\x6D\x74\x10\x6C\x76\x83\x20\xC6\x5E\xAA\x73\xC6\x5D\x69\x96\xEA\x36\xC2\x20\xC1\x46\xCA\xC7\x8C\x4F\xC6\x8F\xF6\xAE\x07\x87\x9C\x82\x02\x18\x20\xCE\xD9\x1C\x87\xC8\x16\xC1\xB4\x20\x81\xAD\xCA\x37\x94\x8E\xCA\x18\xAC\x0B\xBA\x03\x35\xAC\x99\xAC\xC4\xCA\x00\x00\x73\x71\x6B\xC6\x89\x83\x8B\xA1\x02\x8C\x3D\xCA\x8D\xE2\xA7\x98\x9D\xB2\x3C\xC8\xBB\x77\x99\xBD\x7B\xD1\x9B\x99\x83\x23\xB1\x78\xAC\xC3\xC9\x5A\xC7\xD1\x34\xBE\x0F\xAF\x4C\x92\xB4\x20\x94\xA7\x99\x99\xC9\xC6\x71\x1D\xFD\xC4\xB1\xD5\x95\xD1\xDB\x10\xD6\x99\x4C\xAE\x04\xC5\xDF\xA3\x64\x9E\xCE\x98\xA4\xB4\x6A\xA7\x92\x35\x1D\xB7\x40\x3F\xB6\xA9\xD0\x48\xAB\xB8\xB8\x65\xBB\xEB\x71\xBA\xB8\x5D\xE1\xC6\xB9\xEA\x68\x6C\x5C\xD1\xC8\x78\x87\xB9\xB4\xBD\x64\x0E\x04\x0D\x24\xBB\x5F\x81\x3F\xC0\xB5\x62\xBE\x88\x59\xAC\xB6\xAD\xD7\xB8\xD2\xB6\x36\xB4\xB5\x34\x87\x9C\x7D\x63\xDC\x86\xD3\xEE\x6E\xCE\x3C\xFB\x78\x20\x72\xE7\x9A\x8B\x15\x97\x81\x06\xC2\xAC\x83\x26\xB9\x81\x8A\xD9\x7D\x85\x0A\x98\x84\x87\x3E\x13\x9C\x83\x47\x89\x8B\x12\xEE\xCE\xDD\x27\xBA\x81\xDE\x54\x9A\xDF\x41\xF7\xDE\xCC\x00\x82\x84\x80\x52\x01\x8D\x97\x36\x32\xA9\xF0\x23\x44\xE0\xE8\x92\x84\x10\xB4\x8B\x81\x76\xCE\x88\x8A\x23\x80\xE2\x0F\x93\xEC\x84\x88\xE8\xD9\xDA\x1A\xA0\x77\x01\xE3\x82\xA8\x33\xA7\x0A\x9D\xCE\x55\xB1\xAA\xFD\x61\x9E\x1A",
+"\x13\xC3\x20\x15\xDC\xBE\x08\x7E\xB5\xC1\xF6\x9A\xC7\xBD\xBC\xDF\xC3\x7B\xF6\xB8\xBE\x6D\xF0\x43\xD8\xA7\x24\xDB\xE0\x14\x55\x79\x39\x5A\x6E\x43\x34\xCD\x48\xA9\xEE\xAD\x48\xDE\x16\x03\x24\xFF\x42\xEA\x2A\xCB\x50\x48\xEC\x1A\x3C\x37\x18\x10\xE8\x77\x6D\xC5\x88\xAA\xE8\x31\x3B\x65\x1C\x36\x06\x5A\xE2\x3B\x44\xF0\x47\x78\x6B\x9C\x34\x07\x64\xE8\x38\x51\xF4\x0E\xEB\xD7\x20\xEC\x6F\x1E\x0C\xED\xE3\x1C\x03\x5C\xAF\x3F\x1C\x6F\x46\x46\xE9\xBE\xFE\xE8\x31\x46\x5F\x1F\x77\xE3\x5F\xEF\xBF\xF9\xE8\xEE\x85\xE6\x57\x5E\x0C\x24\xF0\xBF\xED\xD1\x41\x06\x59\x01\xE2\xA6\x62\xEA\xD5\x4B\x5C\x37\x94\x5B\x84\xE2\xBF\x87\x94\x6F\xEE\xCE\xEF\xC5\x9C\x80\x6F\x5C\xEA\x8B\xBC\xC6\x47\xF2\x7D\xEB\x5A\x81\x0D\xFD\xEF\xC7\xC4\x39\xF2\x93\xFE\x3D\x5C\x96\xFD\xEF\xCC\xEA\x74\x52\xF3\xD8\x50\xE9\xD0\x30\xF4\x09\x62\xF1\xB7\xDC\x41\xDD\x11\xF9\xEC\x44\xD4\xC6\xEA\xF5\x18\x2C\xF6\xD1\xAE\xFA\x40\x8C\x12\xF1\xF6\xCC\x41\xE8\xF2\x53\xE5\xF7\xC5\xC0\x02\xF3\xD5\x28\x35\x12\xBB\xF6\x43\xDE\xCE\x5F\xF7\xBE\x41\xFB\x98\xEE\xC9\xEE\x02\x46\x46\xEF\x84\xEB\xF4\xF4\xD1\xF4\xF2\xDD\xA8\x68\xF6\xD0\xE1\xCB\xED\x05\x21\xF1\xC1\xEB\xF9\xFD\xC9\xEB\xFC\xF3\xF0\xF1\xF6\xF9\xD3\x49\xF0\x3B\x63\x35\xEB\x73\x12\x81\x7B\x68\x02\x16\x7C\x73\x28\x7C\x8C\x7A\x7F\xB7\x5F\x7E\xCE\x7C\x80\x95\x77\x3B\x7C\x72\x21\x5F\x12\x10\x23\x7F\x25\xC0\x73\x10\x95\x30\x7E\x73\x27\x3C\x0E\x7D\x1A\xA3\x7E\x79\xC3\x71\x78\x70\x67\x80\xEB\x7A\x80\xB8\x20\x81\xD2\x73\x74\x0F\x81\x7F\xB3\x72\x81\x7D\x75\x4C\x17\x84\x07\x21\x8E\x2B\x79\x6E\x78\x27\x36\x72\x35\x8F\x2B\xD9\x4F\x79\x79\x76\x24\x2C\x2E\x77\x13\x86\x74\x44\x78\x36\xBC\x1C\x7C\xFF\x04\x78\x49\x89\x81\x67\x26\x24\x08\x34\x35\xEB\x75\x84\x09\x27\x84\x0D\x89\x20\x2C\x2F\x84\x93\x7C\x7C\x02\x83\x80\xE9\x28\x16\x66\x37\x4C\x4B\x8E\x2C\x6F\x26\x24\xCF\x70\x85\xD0\x72\x85\xC4\x14\x85\x42\x70\x5D\x0C\x15\x86\x59\x85\x85\xC4\x1B\x85\x5C\x8C\x7E\xB2\x72\x65\xF3\x7F\x26\x3F\x8F\x60\x73\x80\x78\x23\x14\x78\x04\x2B\x77\x2D\x89\x82\xC4\x64\x10\x6E\x89\x78\xDC\x7C\x06\x72\x8C\x85\xFE\x71\x76\x89\x79\x77\x93\x3B\x63\x7B\x8C\x87\x37\x15\x82\x9E\x41\x7B\xF8\x7D\x2B\xB1\x76\x76\xEC\x13\x84\x41\x29\x7D\x02\x1D\x5A\x6A\x8B\x82\x87\x4E\x77\x79\x8C\x10\x94\x83\x80\xFF\x09\x88\x61\x81\x38\x7D\x76\x24\x62\x62\x88\xD2\x74\x10\xAF\x8F\x86\x11\x8C\x21\xCA\x7A\x2E\x98\x8C\x3D\xA1\x8D\x7E\x83\x3B\x8A\x68\x6D\x8A\x7E\x69\x7F\x83\x83\x10\x7F\x6D\x7F\x2F\x8C\x21\x9C\x8E\x85\xB8\x87\x7D\xAA\x3B\x8B\x75\x85\x6C\x3E\x2E\x8B\x37\x60\x8C\x0B\x85\x8D\xB1\x86\x2D\x2A\x8C\x8B\xAA\x47\x8B\xCA\x8A\x8C\xBA\x87\x32\xBC\x85\x74\x78\x81\x78\x46\x27\x69\x91\x81\x89\xA5\x8C\x4D\xEB\x79\x8C\x6B\x28\x76\x0B\x5C\x1B\x9A\x8D\x1E\x4A\x84\x78\x93\x30\x88\x0C\x18\x85\x03\x19\x88\x38\x84\x6C\x69\x74\x81\x03\x11\x14\x95\x57\x85\xEB\x71\x8F\xFA\x81\x85\xD6\x74\x58\xF2\x8E\x8F\x4D\x81\x88\x04\x15\x90\xCB\x77\x32\xFD\x82\x86\xFF\x8C\x72\x0B\x5C\x22\x85\x85\x78\x04\x97\x8E\x20\x27\x8C\x8C\x80\x7D\x79\x75\x67\xC5\x8A\x91\x67\x29\x77\x01\x82\x92\x79\x7D\x49\xB3\x86\x92\xE4\x88\x11\x13\x0B\x8E\xEB\x7B\x74\xB5\x5E\x23\xCE\x8B\x91\x66\x37\x48\xD2\x88\x18\x84\x74\x01\xD4\x88\x10\x15\x0A\x29\x2F\x9E\x62\xF3\x11\x93\x4D\x70\x8E\xCF\x88\x6C\x2C\x2D\x93\x2E\x82\x74\x87\x4C\x8D\xCF\x8D\x7E\x20\x60\x8F\xDD\x5B\x50\x37\x90\x00\x3A\x96\x74\x4C\x3E\x93\xD0\x70\x93\xDB\x62\x93\x44\x94\x93\xD0\x8D\x24\x2C\x27\x7E\xAD\x79\x74\xFA\x1C\x94\x5E\x9E\x94\x8A\x40\x95\x29\x71\x91\x22\x9B\x87\x87\x7E\x89\xB1\x78\x82\x04\x11\x92\x89\x75\x62\x4E\x2C\x90\x75\x9C\x91\x08\x8D\x8D\xE9\x28\x7D\xAC\x23\x10\x9C\x75\x06\x87\x8E\x7D\x3E\x13\x10\x1C\x82\x7E\x3C\x89\x67\xA6\x70\x97\x93\x72\x97\xC4\x89\x8D\x45\x97\x48\xFC\x74\x8B\x2B\x84\x7D\x44\x86\x7D\x3B\x48\x7B\x2A\x43\x98\x31\x8E\x7B\x9F\x7C\x84\x94\x32\x7C\xA5\x71\x78\xC5\x77\x82\xD6\x73\x97\x90\x9E\x95\xC8\x63\x99\x79\x95\x8B\x65\x0B\x97\x5D\x8D\x97\xB4\x7F\x97\xD7\x1B\x7D\x22\x8A\x45\x84\x95\x81\x13\x2F\x99\xE1\x7A\x81\xA2\x90\x1D\xE5\x77\x9A\x89\x77\x89\x08\x14\x97\x85\x76\x97\xAC\x97\x9C\x1C\x94\x7F\x23\x16\x7F\xD0\x74\x9C\xA8\x99\x94\xA2\x8E\x23\xC9\x9F\x77\x8B\x89\x10\x05\x8C\x98\x89\x7E\x98\x02\x16\x9C\xD6\x94\x96\x77\x9D\x86\xA9\x91\x7D\x76\x5C\x8E\xAE\x2E\x2C\x33\x8B\x83",
+"\x88\x97\x83\x63\x94\x6C\x1F\x82\x07\xEA\x9E\x9B\xE3\x73\x82\x23\x14\x89\xB0\x97\x26\xDC\x90\x00\xDE\x9B\x8F\xD3\x9D\x24\xD5\x9C\x9F\xDA\x8A\x3A\xE6\x9D\x1B\x12\x29\x9E\xA0\x9B\x81\xBC\x9D\x81\x39\x8D\x11\x58\x21\x9F\x02\x18\xA0\x45\x47\x15\x81\x78\x78\x8D\x92\x9C\x02\x19\x92\xCA\x9B\x86\x0E\x82\x9E\xD2\x91\xA0\xB7\x37\x9F\x07\x28\x89\x7E\x9D\x89\x7A\x23\x71\x9C\x96\x74\xA1\x79\xA0\x88\x9B\x9E\x1C\x4B\x98\xB4\x91\x97\x16\xA0\x00\x18\xAF\x9D\x1A\xA0\x79\x78\x99\xA1\x95\x93\x9B\x73\x26\x7B\xB7\x3A\x99\xF4\x67\xA2\x73\x29\xA2\x11\xA7\xA0\xBF\x96\x21\xC4\x7A\x9D\x85\x79\x9F\x33\xA0\xA0\x45\x95\x3C\xFF\x9D\x9E\x39\xAF\xA1\xD5\x72\xA2\x3A\xA4\x28\xDA\x79\x2A\x40\xAF\x26\x42\xA8\x9B\x44\xA3\x9F\xA3\x93\x12\xE6\x77\x7F\x31\xAB\xA4\x50\xA1\x8E\x1B\xA8\x10\x17\x94\xA3\x51\xA7\x28\x79\x7E\x9C\x96\x83\xA6\xE3\x96\x1A\x2C\x8C\xA1\xC6\x8E\x9A\xD8\x93\x12\x06\x80\x00\x20\xAC\x1B\x4A\xA1\xA7\x7D\x3E\xA4\x37\xAA\xA6\x1E\xA8\x8C\x9D\x98\x9E\x62\x48\x81\xBD\x9F\xA0\x45\xAC\x06\x4C\xAE\x95\xEF\x9E\xA0\xA1\x9E\xA5\xC0\x94\x82\x48\xAF\x77\x7D\xAD\xA1\x4D\xA7\xA6\x84\x8E\xA7\x76\x84\xA8\x28\xA5\xA0\x87\xA4\x83\x5D\xAD\x83\x43\xAF\x90\xC4\x6A\x83\xA3\xAC\x9E\xB1\x7E\x88\x59\x6A\x92\x23\x1D\x49\x48\x9D\x96\x46\x79\x77\x94\x8D\x49\xE8\x71\xA3\xB1\xA3\x79\xF1\x83\xA0\x88\x70\x8A\x5D\x94\x9E\x36\x91\x78\xBC\x17\x01\xB2\xA3\x87\xB4\xA0\x94\x93\x7A\x2F\xC7\x70\x97\xBE\xA3\x8C\xAA\x91\xAC\x23\x1C\x1B\x69\xA5\xAC\xBC\x1F\x96\x2F\xA3\x79\x89\x8F\xA4\xA6\xAB\xA6\xAF\x93\xA5\xCB\x83\xA2\x56\xA5\xA2\x9D\x76\x83\x87\x9B\x26\x5B\xAC\x7B\xA9\xAD\xA2\x81\x77\x7A\xEB\x79\xAD\x81\xAD\xA8\xE4\x96\x99\x3B\xA8\x99\xB7\x76\x7D\xB9\x72\x98\xB7\x98\xAE\x9F\xAF\x7D\x2A\xA2\x9F\x89\x9A\xAE\x23\x15\x9A\xD0\x7E\xAE\x74\xA4\x99\x83\xAD\xAD\x97\x94\xA5\x52\xAF\xA2\x55\x4C\x06\x59\xA6\xAE\x9E\x95\xAA\x3C\x8C\xA2\xE4\x71\x78\x61\xA0\x7D\x57\x95\xB0\xAD\x9C\xAD\xCC\x97\x13\x6E\xA9\xAC\x31\xA3\xAD\x65\xA5\x94\xAA\x47\xA7\x37\x19\xA7\x7B\xA8\x95\xCB\x8B\xA9\x98\xAA\x9A\xAA\x43\xA0\x32\x81\xAA\x90\xA0\xA1\x5C\xAB\xAD\xED\x7F\xA8\xE9\xA5\xB1\xF5\x95\xA9\x7E\x74\xB0\x68\xAC\xA9\xD3\x72\xA0\x85\xA5\x98\x16\x82\xB3\x39\xB2\xB1\x6F\x27\x3C\xA8\xA9\xA8\x91\xA4\xAA\x5F\xA7\x13\xBC\x10\x33\xD4\xA3\x8E\x23\x14\xA1\xC3\x9C\xB3\x31\xA6\x12\xE0\xAA\x78\xE2\xA8\xAF\xE4\xAD\xAF\x67\x27\xAE\xDD\x77\xB4\x4F\xBA\x14\xEC\xAF\x9C\x58\xB8\x89\xCA\x89\x99\xF6\xAB\x99\xF9\xA3\xB6\xFB\xA4\xB4\xBB\x98\xB4\xFE\xA4\xB1\xF4\x97\x13\x02\xBF\xA6\xD7\xAB\x26\x3C\xAC\x21\x88\x7D\xB0\x0F\xB1\xB6\x11\xB5\xB3\x13\xBE\xAF\xAA\xA6\xB2\x4A\x18\xB2\x62\xAC\x10\x30\xB0\xAA\x0B\x72\xAA\x4C\xB4\xB3\xFA\xAA\xA0\xEE\x9D\x40\xF0\x94\xB6\x93\xAB\xB3\x7B\xB5\x78\x84\x7D\xB8\x86\xAF\xB8\x33\xBB\xA8\xF0\xAF\x1F\x0C\xA0\x12\xA1\xB2\xA9\x46\xA2\xAC\x18\x1D\x01\x53\xB4\x8A\x16\xB1\xA3\xAE\xA0\xB5\x07\x3D\xBA\x7D\x71\x9C\x6A\xB9\x78\x19\xB8\x10\xF8\x85\x78\x6E\x7D\xB1\x4A\x1F\xB1\xB8\xB1\xA3\xBB\xBF\x77\xBD\xB4\xBB\x73\x80",
+};
+
+			void JsonGetParserBuffer(vl::stream::MemoryStream& stream)
+			{
+				vl::stream::MemoryStream compressedStream;
+				for (vint i = 0; i < parserBufferRows; i++)
+				{
+					vint size = i == parserBufferRows - 1 ? parserBufferRemain : parserBufferBlock;
+					compressedStream.Write((void*)parserBuffer[i], size);
+				}
+				compressedStream.SeekFromBegin(0);
+				vl::stream::LzwDecoder decoder;
+				vl::stream::DecoderStream decoderStream(compressedStream, decoder);
+				vl::collections::Array<vl::vuint8_t> buffer(65536);
+				while (true)
+				{
+					vl::vint size = decoderStream.Read(&buffer[0], 65536);
+					if (size == 0) break;
+					stream.Write(&buffer[0], size);
+				}
+				stream.SeekFromBegin(0);
+			}
+/***********************************************************************
+Unescaping Function Foward Declarations
+***********************************************************************/
+
+			extern void JsonUnescapingString(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens);
+
+/***********************************************************************
+Parsing Tree Conversion Driver Implementation
+***********************************************************************/
+
+			class JsonTreeConverter : public vl::parsing::ParsingTreeConverter
+			{
+			public:
+				using vl::parsing::ParsingTreeConverter::SetMember;
+
+				bool SetMember(JsonLiteral::JsonValue& member, vl::Ptr<vl::parsing::ParsingTreeNode> node, const TokenList& tokens)
+				{
+					vl::Ptr<vl::parsing::ParsingTreeToken> token=node.Cast<vl::parsing::ParsingTreeToken>();
+					if(token)
+					{
+						if(token->GetValue()==L"True") { member=JsonLiteral::JsonValue::True; return true; }
+						else if(token->GetValue()==L"False") { member=JsonLiteral::JsonValue::False; return true; }
+						else if(token->GetValue()==L"Null") { member=JsonLiteral::JsonValue::Null; return true; }
+						else { member=JsonLiteral::JsonValue::True; return false; }
+					}
+					member=JsonLiteral::JsonValue::True;
+					return false;
+				}
+
+				void Fill(vl::Ptr<JsonNode> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+				}
+
+				void Fill(vl::Ptr<JsonLiteral> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+					SetMember(tree->value, obj->GetMember(L"value"), tokens);
+				}
+
+				void Fill(vl::Ptr<JsonString> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+					if(SetMember(tree->content, obj->GetMember(L"content"), tokens))
+					{
+						JsonUnescapingString(tree->content, tokens);
+					}
+				}
+
+				void Fill(vl::Ptr<JsonNumber> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+					SetMember(tree->content, obj->GetMember(L"content"), tokens);
+				}
+
+				void Fill(vl::Ptr<JsonArray> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+					SetMember(tree->items, obj->GetMember(L"items"), tokens);
+				}
+
+				void Fill(vl::Ptr<JsonObjectField> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+					if(SetMember(tree->name, obj->GetMember(L"name"), tokens))
+					{
+						JsonUnescapingString(tree->name, tokens);
+					}
+					SetMember(tree->value, obj->GetMember(L"value"), tokens);
+				}
+
+				void Fill(vl::Ptr<JsonObject> tree, vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)
+				{
+					SetMember(tree->fields, obj->GetMember(L"fields"), tokens);
+				}
+
+				vl::Ptr<vl::parsing::ParsingTreeCustomBase> ConvertClass(vl::Ptr<vl::parsing::ParsingTreeObject> obj, const TokenList& tokens)override
+				{
+					if(obj->GetType()==L"Literal")
+					{
+						vl::Ptr<JsonLiteral> tree = new JsonLiteral;
+						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
+						Fill(tree, obj, tokens);
+						Fill(tree.Cast<JsonNode>(), obj, tokens);
+						return tree;
+					}
+					else if(obj->GetType()==L"String")
+					{
+						vl::Ptr<JsonString> tree = new JsonString;
+						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
+						Fill(tree, obj, tokens);
+						Fill(tree.Cast<JsonNode>(), obj, tokens);
+						return tree;
+					}
+					else if(obj->GetType()==L"Number")
+					{
+						vl::Ptr<JsonNumber> tree = new JsonNumber;
+						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
+						Fill(tree, obj, tokens);
+						Fill(tree.Cast<JsonNode>(), obj, tokens);
+						return tree;
+					}
+					else if(obj->GetType()==L"Array")
+					{
+						vl::Ptr<JsonArray> tree = new JsonArray;
+						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
+						Fill(tree, obj, tokens);
+						Fill(tree.Cast<JsonNode>(), obj, tokens);
+						return tree;
+					}
+					else if(obj->GetType()==L"ObjectField")
+					{
+						vl::Ptr<JsonObjectField> tree = new JsonObjectField;
+						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
+						Fill(tree, obj, tokens);
+						Fill(tree.Cast<JsonNode>(), obj, tokens);
+						return tree;
+					}
+					else if(obj->GetType()==L"Object")
+					{
+						vl::Ptr<JsonObject> tree = new JsonObject;
+						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
+						Fill(tree, obj, tokens);
+						Fill(tree.Cast<JsonNode>(), obj, tokens);
+						return tree;
+					}
+					else 
+						return 0;
+				}
+			};
+
+			vl::Ptr<vl::parsing::ParsingTreeCustomBase> JsonConvertParsingTreeNode(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				JsonTreeConverter converter;
+				vl::Ptr<vl::parsing::ParsingTreeCustomBase> tree;
+				converter.SetMember(tree, node, tokens);
+				return tree;
+			}
+
+/***********************************************************************
+Parsing Tree Conversion Implementation
+***********************************************************************/
+
+			vl::Ptr<JsonLiteral> JsonLiteral::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonLiteral>();
+			}
+
+			vl::Ptr<JsonString> JsonString::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonString>();
+			}
+
+			vl::Ptr<JsonNumber> JsonNumber::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonNumber>();
+			}
+
+			vl::Ptr<JsonArray> JsonArray::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonArray>();
+			}
+
+			vl::Ptr<JsonObjectField> JsonObjectField::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonObjectField>();
+			}
+
+			vl::Ptr<JsonObject> JsonObject::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonObject>();
+			}
+
+/***********************************************************************
+Visitor Pattern Implementation
+***********************************************************************/
+
+			void JsonLiteral::Accept(JsonNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void JsonString::Accept(JsonNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void JsonNumber::Accept(JsonNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void JsonArray::Accept(JsonNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void JsonObjectField::Accept(JsonNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+			void JsonObject::Accept(JsonNode::IVisitor* visitor)
+			{
+				visitor->Visit(this);
+			}
+
+/***********************************************************************
+Parser Function
+***********************************************************************/
+
+			vl::Ptr<vl::parsing::ParsingTreeNode> JsonParseAsParsingTreeNode(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::collections::List<vl::Ptr<vl::parsing::ParsingError>>& errors, vl::vint codeIndex)
+			{
+				vl::parsing::tabling::ParsingState state(input, table, codeIndex);
+				state.Reset(L"JRoot");
+				vl::Ptr<vl::parsing::tabling::ParsingGeneralParser> parser=vl::parsing::tabling::CreateStrictParser(table);
+				vl::Ptr<vl::parsing::ParsingTreeNode> node=parser->Parse(state, errors);
+				return node;
+			}
+
+			vl::Ptr<vl::parsing::ParsingTreeNode> JsonParseAsParsingTreeNode(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::vint codeIndex)
+			{
+				vl::collections::List<vl::Ptr<vl::parsing::ParsingError>> errors;
+				return JsonParseAsParsingTreeNode(input, table, errors, codeIndex);
+			}
+
+			vl::Ptr<JsonNode> JsonParse(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::collections::List<vl::Ptr<vl::parsing::ParsingError>>& errors, vl::vint codeIndex)
+			{
+				vl::parsing::tabling::ParsingState state(input, table, codeIndex);
+				state.Reset(L"JRoot");
+				vl::Ptr<vl::parsing::tabling::ParsingGeneralParser> parser=vl::parsing::tabling::CreateStrictParser(table);
+				vl::Ptr<vl::parsing::ParsingTreeNode> node=parser->Parse(state, errors);
+				if(node && errors.Count()==0)
+				{
+					return JsonConvertParsingTreeNode(node, state.GetTokens()).Cast<JsonNode>();
+				}
+				return 0;
+			}
+
+			vl::Ptr<JsonNode> JsonParse(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::vint codeIndex)
+			{
+				vl::collections::List<vl::Ptr<vl::parsing::ParsingError>> errors;
+				return JsonParse(input, table, errors, codeIndex);
+			}
+
+/***********************************************************************
+Table Generation
+***********************************************************************/
+
+			vl::Ptr<vl::parsing::tabling::ParsingTable> JsonLoadTable()
+			{
+				vl::stream::MemoryStream stream;
+				JsonGetParserBuffer(stream);
+				vl::Ptr<vl::parsing::tabling::ParsingTable> table=new vl::parsing::tabling::ParsingTable(stream);
+				table->Initialize();
+				return table;
+			}
+
+		}
+	}
+}
+namespace vl
+{
+	namespace reflection
+	{
+		namespace description
+		{
+#ifndef VCZH_DEBUG_NO_REFLECTION
+			using namespace vl::parsing::json;
+
+#define PARSING_TOKEN_FIELD(NAME)\
+			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(get_##NAME, NO_PARAMETER, vl::WString(ClassType::*)(), [](ClassType* node) { return node->NAME.value; }, L"*", L"*")\
+			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(set_##NAME, { L"value" }, void(ClassType::*)(const vl::WString&), [](ClassType* node, const vl::WString& value) { node->NAME.value = value; }, L"*", L"*")\
+			CLASS_MEMBER_PROPERTY_REFERENCETEMPLATE(NAME, get_##NAME, set_##NAME, L"$This->$Name.value")\
+
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonNode, system::JsonNode)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonLiteral, system::JsonLiteral)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonLiteral::JsonValue, system::JsonLiteral::JsonValue)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonString, system::JsonString)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonNumber, system::JsonNumber)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonArray, system::JsonArray)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonObjectField, system::JsonObjectField)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonObject, system::JsonObject)
+			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonNode::IVisitor, system::JsonNode::IVisitor)
+
+			BEGIN_CLASS_MEMBER(JsonNode)
+				CLASS_MEMBER_METHOD(Accept, {L"visitor"})
+			END_CLASS_MEMBER(JsonNode)
+
+			BEGIN_CLASS_MEMBER(JsonLiteral)
+				CLASS_MEMBER_BASE(JsonNode)
+
+				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonLiteral>(), NO_PARAMETER)
+
+				CLASS_MEMBER_FIELD(value)
+			END_CLASS_MEMBER(JsonLiteral)
+
+			BEGIN_ENUM_ITEM(JsonLiteral::JsonValue)
+				ENUM_ITEM_NAMESPACE(JsonLiteral::JsonValue)
+				ENUM_NAMESPACE_ITEM(True)
+				ENUM_NAMESPACE_ITEM(False)
+				ENUM_NAMESPACE_ITEM(Null)
+			END_ENUM_ITEM(JsonLiteral::JsonValue)
+
+			BEGIN_CLASS_MEMBER(JsonString)
+				CLASS_MEMBER_BASE(JsonNode)
+
+				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonString>(), NO_PARAMETER)
+
+				PARSING_TOKEN_FIELD(content)
+			END_CLASS_MEMBER(JsonString)
+
+			BEGIN_CLASS_MEMBER(JsonNumber)
+				CLASS_MEMBER_BASE(JsonNode)
+
+				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonNumber>(), NO_PARAMETER)
+
+				PARSING_TOKEN_FIELD(content)
+			END_CLASS_MEMBER(JsonNumber)
+
+			BEGIN_CLASS_MEMBER(JsonArray)
+				CLASS_MEMBER_BASE(JsonNode)
+
+				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonArray>(), NO_PARAMETER)
+
+				CLASS_MEMBER_FIELD(items)
+			END_CLASS_MEMBER(JsonArray)
+
+			BEGIN_CLASS_MEMBER(JsonObjectField)
+				CLASS_MEMBER_BASE(JsonNode)
+
+				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonObjectField>(), NO_PARAMETER)
+
+				PARSING_TOKEN_FIELD(name)
+				CLASS_MEMBER_FIELD(value)
+			END_CLASS_MEMBER(JsonObjectField)
+
+			BEGIN_CLASS_MEMBER(JsonObject)
+				CLASS_MEMBER_BASE(JsonNode)
+
+				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonObject>(), NO_PARAMETER)
+
+				CLASS_MEMBER_FIELD(fields)
+			END_CLASS_MEMBER(JsonObject)
+
+			BEGIN_INTERFACE_MEMBER(JsonNode::IVisitor)
+				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonLiteral* node))
+				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonString* node))
+				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonNumber* node))
+				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonArray* node))
+				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonObjectField* node))
+				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonObject* node))
+			END_INTERFACE_MEMBER(JsonNode)
+
+#undef PARSING_TOKEN_FIELD
+
+			class JsonTypeLoader : public vl::Object, public ITypeLoader
+			{
+			public:
+				void Load(ITypeManager* manager)
+				{
+					ADD_TYPE_INFO(vl::parsing::json::JsonNode)
+					ADD_TYPE_INFO(vl::parsing::json::JsonLiteral)
+					ADD_TYPE_INFO(vl::parsing::json::JsonLiteral::JsonValue)
+					ADD_TYPE_INFO(vl::parsing::json::JsonString)
+					ADD_TYPE_INFO(vl::parsing::json::JsonNumber)
+					ADD_TYPE_INFO(vl::parsing::json::JsonArray)
+					ADD_TYPE_INFO(vl::parsing::json::JsonObjectField)
+					ADD_TYPE_INFO(vl::parsing::json::JsonObject)
+					ADD_TYPE_INFO(vl::parsing::json::JsonNode::IVisitor)
+				}
+
+				void Unload(ITypeManager* manager)
+				{
+				}
+			};
+#endif
+
+			bool JsonLoadTypes()
+			{
+#ifndef VCZH_DEBUG_NO_REFLECTION
+				ITypeManager* manager=GetGlobalTypeManager();
+				if(manager)
+				{
+					Ptr<ITypeLoader> loader=new JsonTypeLoader;
+					return manager->AddTypeLoader(loader);
+				}
+#endif
+				return false;
+			}
+		}
+	}
+}
+
+/***********************************************************************
+PARSING\XML\PARSINGXML.CPP
+***********************************************************************/
+
+namespace vl
+{
+	namespace parsing
+	{
+		namespace xml
+		{
+			using namespace stream;
+			using namespace collections;
+			using namespace regex;
+
+/***********************************************************************
+Unescaping Function Foward Declarations
+***********************************************************************/
+
+			void XmlMergeTextFragment(vl::collections::List<vl::Ptr<XmlNode>>& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				vint begin=-1;
+				vint end=-1;
+				for(vint i=value.Count()-1;i>=-1;i--)
+				{
+					if(i==-1)
+					{
+						if(end!=-1) begin=0;
+					}
+					else if(value[i].Cast<XmlText>())
+					{
+						if(end==-1) end=i;
+					}
+					else
+					{
+						if(end!=-1) begin=i+1;
+					}
+					if(begin!=-1 && end!=-1)
+					{
+						vint tokenBegin=value[begin].Cast<XmlText>()->content.tokenIndex;
+						vint tokenEnd=value[end].Cast<XmlText>()->content.tokenIndex;
+						while(tokenBegin>0)
+						{
+							if(tokens.Get(tokenBegin-1).token==(vint)XmlParserTokenIndex::SPACE || tokens.Get(tokenBegin-1).token==-1)
+							{
+								tokenBegin--;
+							}
+							else
+							{
+								break;
+							}
+						}
+						while(tokenEnd<tokens.Count()-1)
+						{
+							if(tokens.Get(tokenEnd+1).token==(vint)XmlParserTokenIndex::SPACE || tokens.Get(tokenEnd+1).token==-1)
+							{
+								tokenEnd++;
+							}
+							else
+							{
+								break;
+							}
+						}
+
+						const RegexToken& beginToken=tokens.Get(tokenBegin);
+						const RegexToken& endToken=tokens.Get(tokenEnd);
+						const wchar_t* textBegin=beginToken.reading;
+						const wchar_t* textEnd=endToken.reading+endToken.length;
+						WString text(textBegin, vint(textEnd-textBegin));
+						ParsingTextRange range(&beginToken, &endToken);
+
+						Ptr<XmlText> xmlText=new XmlText;
+						xmlText->codeRange=range;
+						xmlText->content.codeRange=range;
+						xmlText->content.value=XmlUnescapeValue(text);
+
+						value.RemoveRange(begin, end-begin+1);
+						value.Insert(begin, xmlText);
+
+						begin=-1;
+						end=-1;
+					}
+				}
+			}
+
+			void XmlUnescapeAttributeValue(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				value.value=XmlUnescapeValue(value.value.Sub(1, value.value.Length()-2));
+			}
+
+			void XmlUnescapeCData(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				value.value=XmlUnescapeCData(value.value);
+			}
+
+			void XmlUnescapeComment(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			{
+				value.value=XmlUnescapeComment(value.value);
+			}
+
+/***********************************************************************
+XmlPrintVisitor
+***********************************************************************/
+
+			class XmlPrintVisitor : public Object, public XmlNode::IVisitor
+			{
+			public:
+				TextWriter&					writer;
+
+				XmlPrintVisitor(TextWriter& _writer)
+					:writer(_writer)
+				{
+				}
+
+				void Visit(XmlText* node)
+				{
+					writer.WriteString(XmlEscapeValue(node->content.value));
+				}
+
+				void Visit(XmlCData* node)
+				{
+					writer.WriteString(XmlEscapeCData(node->content.value));
+				}
+
+				void Visit(XmlAttribute* node)
+				{
+					writer.WriteString(node->name.value);
+					writer.WriteString(L"=\"");
+					writer.WriteString(XmlEscapeValue(node->value.value));
+					writer.WriteString(L"\"");
+				}
+
+				void Visit(XmlComment* node)
+				{
+					writer.WriteString(XmlEscapeComment(node->content.value));
+				}
+
+				void Visit(XmlElement* node)
+				{
+					writer.WriteChar(L'<');
+					writer.WriteString(node->name.value);
+					FOREACH(Ptr<XmlAttribute>, att, node->attributes)
+					{
+						writer.WriteChar(L' ');
+						att->Accept(this);
+					}
+					if(node->subNodes.Count()==0)
+					{
+						writer.WriteString(L"/>");
+					}
+					else
+					{
+						writer.WriteChar(L'>');
+						FOREACH(Ptr<XmlNode>, subNode, node->subNodes)
+						{
+							subNode->Accept(this);
+						}
+						writer.WriteString(L"</");
+						writer.WriteString(node->name.value);
+						writer.WriteChar(L'>');
+					}
+				}
+
+				void Visit(XmlInstruction* node)
+				{
+					writer.WriteString(L"<?");
+					writer.WriteString(node->name.value);
+					FOREACH(Ptr<XmlAttribute>, att, node->attributes)
+					{
+						writer.WriteChar(L' ');
+						att->Accept(this);
+					}
+					writer.WriteString(L"?>");
+				}
+
+				void Visit(XmlDocument* node)
+				{
+					FOREACH(Ptr<XmlNode>, prolog, node->prologs)
+					{
+						prolog->Accept(this);
+					}
+					node->rootElement->Accept(this);
+				}
+			};
+
+/***********************************************************************
+API
+***********************************************************************/
+
+			WString XmlEscapeValue(const WString& value)
+			{
+				WString result;
+				const wchar_t* reading=value.Buffer();
+				while(wchar_t c=*reading++)
+				{
+					switch(c)
+					{
+					case L'<':
+						result+=L"&lt;";
+						break;
+					case L'>':
+						result+=L"&gt;";
+						break;
+					case L'&':
+						result+=L"&amp;";
+						break;
+					case L'\'':
+						result+=L"&apos;";
+						break;
+					case L'\"':
+						result+=L"&quot;";
+						break;
+					default:
+						result+=c;
+					}
+				}
+				return result;
+			}
+
+			WString XmlUnescapeValue(const WString& value)
+			{
+				WString result;
+				const wchar_t* reading=value.Buffer();
+				while(*reading)
+				{
+					if(wcsncmp(reading, L"&lt;", 4)==0)
+					{
+						result+=L'<';
+						reading+=4;
+					}
+					else if(wcsncmp(reading, L"&gt;", 4)==0)
+					{
+						result+=L'>';
+						reading+=4;
+					}
+					else if(wcsncmp(reading, L"&amp;", 5)==0)
+					{
+						result+=L'&';
+						reading+=5;
+					}
+					else if(wcsncmp(reading, L"&apos;", 6)==0)
+					{
+						result+=L'\'';
+						reading+=6;
+					}
+					else if(wcsncmp(reading, L"&quot;", 6)==0)
+					{
+						result+=L'\"';
+						reading+=6;
+					}
+					else
 					{
-						vl::Ptr<JsonObject> tree = new JsonObject;
-						vl::collections::CopyFrom(tree->creatorRules, obj->GetCreatorRules());
-						Fill(tree, obj, tokens);
-						Fill(tree.Cast<JsonNode>(), obj, tokens);
-						return tree;
+						result+=*reading++;
 					}
-					else 
-						return 0;
 				}
-			};
+				return result;
+			}
 
-			vl::Ptr<vl::parsing::ParsingTreeCustomBase> JsonConvertParsingTreeNode(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			WString XmlEscapeCData(const WString& value)
 			{
-				JsonTreeConverter converter;
-				vl::Ptr<vl::parsing::ParsingTreeCustomBase> tree;
-				converter.SetMember(tree, node, tokens);
-				return tree;
+				return L"<![CDATA["+value+L"]]>";
 			}
 
-/***********************************************************************
-Parsing Tree Conversion Implementation
-***********************************************************************/
-
-			vl::Ptr<JsonLiteral> JsonLiteral::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			WString XmlUnescapeCData(const WString& value)
 			{
-				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonLiteral>();
+				return value.Sub(9, value.Length()-12);
 			}
 
-			vl::Ptr<JsonString> JsonString::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			WString XmlEscapeComment(const WString& value)
 			{
-				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonString>();
+				return L"<!--"+value+L"-->";
 			}
 
-			vl::Ptr<JsonNumber> JsonNumber::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			WString XmlUnescapeComment(const WString& value)
 			{
-				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonNumber>();
+				return value.Sub(4, value.Length()-7);
 			}
 
-			vl::Ptr<JsonArray> JsonArray::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			void XmlPrint(Ptr<XmlNode> node, stream::TextWriter& writer)
 			{
-				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonArray>();
+				XmlPrintVisitor visitor(writer);
+				node->Accept(&visitor);
 			}
 
-			vl::Ptr<JsonObjectField> JsonObjectField::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			void XmlPrintContent(Ptr<XmlElement> element, stream::TextWriter& writer)
 			{
-				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonObjectField>();
+				XmlPrintVisitor visitor(writer);
+				FOREACH(Ptr<XmlNode>, node, element->subNodes)
+				{
+					node->Accept(&visitor);
+				}
 			}
 
-			vl::Ptr<JsonObject> JsonObject::Convert(vl::Ptr<vl::parsing::ParsingTreeNode> node, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			WString XmlToString(Ptr<XmlNode> node)
 			{
-				return JsonConvertParsingTreeNode(node, tokens).Cast<JsonObject>();
+				MemoryStream stream;
+				{
+					StreamWriter writer(stream);
+					XmlPrint(node, writer);
+				}
+				stream.SeekFromBegin(0);
+				{
+					StreamReader reader(stream);
+					return reader.ReadToEnd();
+				}
 			}
 
 /***********************************************************************
-Visitor Pattern Implementation
+Linq To Xml
 ***********************************************************************/
 
-			void JsonLiteral::Accept(JsonNode::IVisitor* visitor)
+			Ptr<XmlAttribute> XmlGetAttribute(Ptr<XmlElement> element, const WString& name)
 			{
-				visitor->Visit(this);
+				return XmlGetAttribute(element.Obj(), name);
 			}
 
-			void JsonString::Accept(JsonNode::IVisitor* visitor)
+			Ptr<XmlElement> XmlGetElement(Ptr<XmlElement> element, const WString& name)
 			{
-				visitor->Visit(this);
+				return XmlGetElement(element.Obj(), name);
 			}
 
-			void JsonNumber::Accept(JsonNode::IVisitor* visitor)
+			collections::LazyList<Ptr<XmlElement>> XmlGetElements(Ptr<XmlElement> element)
 			{
-				visitor->Visit(this);
+				return XmlGetElements(element.Obj());
 			}
 
-			void JsonArray::Accept(JsonNode::IVisitor* visitor)
+			collections::LazyList<Ptr<XmlElement>> XmlGetElements(Ptr<XmlElement> element, const WString& name)
 			{
-				visitor->Visit(this);
+				return XmlGetElements(element.Obj(), name);
 			}
 
-			void JsonObjectField::Accept(JsonNode::IVisitor* visitor)
+			WString XmlGetValue(Ptr<XmlElement> element)
 			{
-				visitor->Visit(this);
+				return XmlGetValue(element.Obj());
 			}
 
-			void JsonObject::Accept(JsonNode::IVisitor* visitor)
+			Ptr<XmlAttribute> XmlGetAttribute(XmlElement* element, const WString& name)
 			{
-				visitor->Visit(this);
+				FOREACH(Ptr<XmlAttribute>, att, element->attributes)
+				{
+					if(att->name.value==name)
+					{
+						return att;
+					}
+				}
+				return 0;
 			}
 
-/***********************************************************************
-Parser Function
-***********************************************************************/
-
-			vl::Ptr<vl::parsing::ParsingTreeNode> JsonParseAsParsingTreeNode(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::collections::List<vl::Ptr<vl::parsing::ParsingError>>& errors, vl::vint codeIndex)
+			Ptr<XmlElement> XmlGetElement(XmlElement* element, const WString& name)
 			{
-				vl::parsing::tabling::ParsingState state(input, table, codeIndex);
-				state.Reset(L"JRoot");
-				vl::Ptr<vl::parsing::tabling::ParsingGeneralParser> parser=vl::parsing::tabling::CreateStrictParser(table);
-				vl::Ptr<vl::parsing::ParsingTreeNode> node=parser->Parse(state, errors);
-				return node;
+				FOREACH(Ptr<XmlNode>, node, element->subNodes)
+				{
+					Ptr<XmlElement> subElement=node.Cast<XmlElement>();
+					if(subElement && subElement->name.value==name)
+					{
+						return subElement;
+					}
+				}
+				return 0;
 			}
 
-			vl::Ptr<vl::parsing::ParsingTreeNode> JsonParseAsParsingTreeNode(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::vint codeIndex)
+			collections::LazyList<Ptr<XmlElement>> XmlGetElements(XmlElement* element)
 			{
-				vl::collections::List<vl::Ptr<vl::parsing::ParsingError>> errors;
-				return JsonParseAsParsingTreeNode(input, table, errors, codeIndex);
+				return From(element->subNodes)
+					.FindType<XmlElement>();
 			}
 
-			vl::Ptr<JsonNode> JsonParse(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::collections::List<vl::Ptr<vl::parsing::ParsingError>>& errors, vl::vint codeIndex)
+			collections::LazyList<Ptr<XmlElement>> XmlGetElements(XmlElement* element, const WString& name)
 			{
-				vl::parsing::tabling::ParsingState state(input, table, codeIndex);
-				state.Reset(L"JRoot");
-				vl::Ptr<vl::parsing::tabling::ParsingGeneralParser> parser=vl::parsing::tabling::CreateStrictParser(table);
-				vl::Ptr<vl::parsing::ParsingTreeNode> node=parser->Parse(state, errors);
-				if(node && errors.Count()==0)
-				{
-					return JsonConvertParsingTreeNode(node, state.GetTokens()).Cast<JsonNode>();
-				}
-				return 0;
+				return From(element->subNodes)
+					.FindType<XmlElement>()
+					.Where([name](Ptr<XmlElement> e){return e->name.value==name;});
 			}
 
-			vl::Ptr<JsonNode> JsonParse(const vl::WString& input, vl::Ptr<vl::parsing::tabling::ParsingTable> table, vl::vint codeIndex)
+			WString XmlGetValue(XmlElement* element)
 			{
-				vl::collections::List<vl::Ptr<vl::parsing::ParsingError>> errors;
-				return JsonParse(input, table, errors, codeIndex);
+				WString result;
+				FOREACH(Ptr<XmlNode>, node, element->subNodes)
+				{
+					if(Ptr<XmlText> text=node.Cast<XmlText>())
+					{
+						result+=text->content.value;
+					}
+					else if(Ptr<XmlCData> text=node.Cast<XmlCData>())
+					{
+						result+=text->content.value;
+					}
+				}
+				return result;
 			}
 
 /***********************************************************************
-Table Generation
+XmlElementWriter
 ***********************************************************************/
 
-			vl::Ptr<vl::parsing::tabling::ParsingTable> JsonLoadTable()
+			XmlElementWriter::XmlElementWriter(Ptr<XmlElement> _element, const XmlElementWriter* _previousWriter)
+				:element(_element)
+				,previousWriter(_previousWriter)
 			{
-				vl::stream::MemoryStream stream;
-				JsonGetParserBuffer(stream);
-				vl::Ptr<vl::parsing::tabling::ParsingTable> table=new vl::parsing::tabling::ParsingTable(stream);
-				table->Initialize();
-				return table;
 			}
 
-		}
-	}
-}
-namespace vl
-{
-	namespace reflection
-	{
-		namespace description
-		{
-#ifndef VCZH_DEBUG_NO_REFLECTION
-			using namespace vl::parsing::json;
-
-#define PARSING_TOKEN_FIELD(NAME)\
-			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(get_##NAME, NO_PARAMETER, vl::WString(ClassType::*)(), [](ClassType* node) { return node->NAME.value; }, L"*", L"*")\
-			CLASS_MEMBER_EXTERNALMETHOD_TEMPLATE(set_##NAME, { L"value" }, void(ClassType::*)(const vl::WString&), [](ClassType* node, const vl::WString& value) { node->NAME.value = value; }, L"*", L"*")\
-			CLASS_MEMBER_PROPERTY_REFERENCETEMPLATE(NAME, get_##NAME, set_##NAME, L"$This->$Name.value")\
-
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonNode, system::JsonNode)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonLiteral, system::JsonLiteral)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonLiteral::JsonValue, system::JsonLiteral::JsonValue)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonString, system::JsonString)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonNumber, system::JsonNumber)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonArray, system::JsonArray)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonObjectField, system::JsonObjectField)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonObject, system::JsonObject)
-			IMPL_TYPE_INFO_RENAME(vl::parsing::json::JsonNode::IVisitor, system::JsonNode::IVisitor)
-
-			BEGIN_CLASS_MEMBER(JsonNode)
-				CLASS_MEMBER_METHOD(Accept, {L"visitor"})
-			END_CLASS_MEMBER(JsonNode)
-
-			BEGIN_CLASS_MEMBER(JsonLiteral)
-				CLASS_MEMBER_BASE(JsonNode)
-
-				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonLiteral>(), NO_PARAMETER)
-
-				CLASS_MEMBER_FIELD(value)
-			END_CLASS_MEMBER(JsonLiteral)
-
-			BEGIN_ENUM_ITEM(JsonLiteral::JsonValue)
-				ENUM_ITEM_NAMESPACE(JsonLiteral::JsonValue)
-				ENUM_NAMESPACE_ITEM(True)
-				ENUM_NAMESPACE_ITEM(False)
-				ENUM_NAMESPACE_ITEM(Null)
-			END_ENUM_ITEM(JsonLiteral::JsonValue)
-
-			BEGIN_CLASS_MEMBER(JsonString)
-				CLASS_MEMBER_BASE(JsonNode)
-
-				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonString>(), NO_PARAMETER)
-
-				PARSING_TOKEN_FIELD(content)
-			END_CLASS_MEMBER(JsonString)
-
-			BEGIN_CLASS_MEMBER(JsonNumber)
-				CLASS_MEMBER_BASE(JsonNode)
-
-				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonNumber>(), NO_PARAMETER)
-
-				PARSING_TOKEN_FIELD(content)
-			END_CLASS_MEMBER(JsonNumber)
-
-			BEGIN_CLASS_MEMBER(JsonArray)
-				CLASS_MEMBER_BASE(JsonNode)
-
-				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonArray>(), NO_PARAMETER)
-
-				CLASS_MEMBER_FIELD(items)
-			END_CLASS_MEMBER(JsonArray)
-
-			BEGIN_CLASS_MEMBER(JsonObjectField)
-				CLASS_MEMBER_BASE(JsonNode)
-
-				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonObjectField>(), NO_PARAMETER)
-
-				PARSING_TOKEN_FIELD(name)
-				CLASS_MEMBER_FIELD(value)
-			END_CLASS_MEMBER(JsonObjectField)
-
-			BEGIN_CLASS_MEMBER(JsonObject)
-				CLASS_MEMBER_BASE(JsonNode)
-
-				CLASS_MEMBER_CONSTRUCTOR(vl::Ptr<JsonObject>(), NO_PARAMETER)
+			XmlElementWriter::~XmlElementWriter()
+			{
+			}
 
-				CLASS_MEMBER_FIELD(fields)
-			END_CLASS_MEMBER(JsonObject)
+			const XmlElementWriter& XmlElementWriter::Attribute(const WString& name, const WString& value)const
+			{
+				Ptr<XmlAttribute> node=new XmlAttribute;
+				node->name.value=name;
+				node->value.value=value;
+				element->attributes.Add(node);
+				return *this;
+			}
 
-			BEGIN_INTERFACE_MEMBER(JsonNode::IVisitor)
-				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonLiteral* node))
-				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonString* node))
-				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonNumber* node))
-				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonArray* node))
-				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonObjectField* node))
-				CLASS_MEMBER_METHOD_OVERLOAD(Visit, {L"node"}, void(JsonNode::IVisitor::*)(JsonObject* node))
-			END_INTERFACE_MEMBER(JsonNode)
+			XmlElementWriter XmlElementWriter::Element(const WString& name)const
+			{
+				Ptr<XmlElement> node=new XmlElement;
+				node->name.value=name;
+				element->subNodes.Add(node);
+				return XmlElementWriter(node, this);
+			}
 
-#undef PARSING_TOKEN_FIELD
+			const XmlElementWriter& XmlElementWriter::End()const
+			{
+				return *previousWriter;
+			}
 
-			class JsonTypeLoader : public vl::Object, public ITypeLoader
+			const XmlElementWriter& XmlElementWriter::Text(const WString& value)const
 			{
-			public:
-				void Load(ITypeManager* manager)
-				{
-					ADD_TYPE_INFO(vl::parsing::json::JsonNode)
-					ADD_TYPE_INFO(vl::parsing::json::JsonLiteral)
-					ADD_TYPE_INFO(vl::parsing::json::JsonLiteral::JsonValue)
-					ADD_TYPE_INFO(vl::parsing::json::JsonString)
-					ADD_TYPE_INFO(vl::parsing::json::JsonNumber)
-					ADD_TYPE_INFO(vl::parsing::json::JsonArray)
-					ADD_TYPE_INFO(vl::parsing::json::JsonObjectField)
-					ADD_TYPE_INFO(vl::parsing::json::JsonObject)
-					ADD_TYPE_INFO(vl::parsing::json::JsonNode::IVisitor)
-				}
+				Ptr<XmlText> node=new XmlText;
+				node->content.value=value;
+				element->subNodes.Add(node);
+				return *this;
+			}
 
-				void Unload(ITypeManager* manager)
-				{
-				}
-			};
-#endif
+			const XmlElementWriter& XmlElementWriter::CData(const WString& value)const
+			{
+				Ptr<XmlCData> node=new XmlCData;
+				node->content.value=value;
+				element->subNodes.Add(node);
+				return *this;
+			}
 
-			bool JsonLoadTypes()
+			const XmlElementWriter& XmlElementWriter::Comment(const WString& value)const
 			{
-#ifndef VCZH_DEBUG_NO_REFLECTION
-				ITypeManager* manager=GetGlobalTypeManager();
-				if(manager)
-				{
-					Ptr<ITypeLoader> loader=new JsonTypeLoader;
-					return manager->AddTypeLoader(loader);
-				}
-#endif
-				return false;
+				Ptr<XmlComment> node=new XmlComment;
+				node->content.value=value;
+				element->subNodes.Add(node);
+				return *this;
 			}
 		}
 	}
 }
 
 /***********************************************************************
-PARSING\XML\PARSINGXML.CPP
+PARSING\XML\PARSINGXML_READER.CPP
 ***********************************************************************/
 
 namespace vl
@@ -14516,442 +16130,890 @@ namespace vl
 		{
 			using namespace stream;
 			using namespace collections;
-			using namespace regex;
 
 /***********************************************************************
-Unescaping Function Foward Declarations
+XmlNameTable
 ***********************************************************************/
 
-			void XmlMergeTextFragment(vl::collections::List<vl::Ptr<XmlNode>>& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			vuint32_t XmlNameTable::Hash(const wchar_t* buffer, vint length)
 			{
-				vint begin=-1;
-				vint end=-1;
-				for(vint i=value.Count()-1;i>=-1;i--)
+				vuint32_t hash = 2166136261u;
+				for (vint i = 0; i < length; i++)
 				{
-					if(i==-1)
+					hash = (hash ^ (vuint32_t)buffer[i]) * 16777619u;
+				}
+				return hash;
+			}
+
+			void XmlNameTable::Rehash(vint bucketCount)
+			{
+				buckets.Resize(bucketCount);
+				for (vint i = 0; i < bucketCount; i++)
+				{
+					buckets[i] = -1;
+				}
+				for (vint i = 0; i < names.Count(); i++)
+				{
+					vint bucket = (vint)(hashes[i] % (vuint32_t)bucketCount);
+					nexts[i] = buckets[bucket];
+					buckets[bucket] = i;
+				}
+			}
+
+			XmlNameTable::XmlNameTable()
+			{
+				Rehash(256);
+			}
+
+			XmlNameTable::~XmlNameTable()
+			{
+			}
+
+			WString XmlNameTable::Get(const wchar_t* buffer, vint length)
+			{
+				vuint32_t hash = Hash(buffer, length);
+				vint index = buckets[(vint)(hash % (vuint32_t)buckets.Count())];
+				while (index != -1)
+				{
+					const WString& name = names[index];
+					if (hashes[index] == hash && name.Length() == length && wcsncmp(name.Buffer(), buffer, length) == 0)
 					{
-						if(end!=-1) begin=0;
+						return name;
 					}
-					else if(value[i].Cast<XmlText>())
+					index = nexts[index];
+				}
+
+				WString name(buffer, length);
+				names.Add(name);
+				hashes.Add(hash);
+				nexts.Add(-1);
+				if (names.Count() > buckets.Count())
+				{
+					Rehash(buckets.Count() * 2);
+				}
+				else
+				{
+					vint bucket = (vint)(hash % (vuint32_t)buckets.Count());
+					nexts[names.Count() - 1] = buckets[bucket];
+					buckets[bucket] = names.Count() - 1;
+				}
+				return name;
+			}
+
+			vint XmlNameTable::Count()
+			{
+				return names.Count();
+			}
+
+/***********************************************************************
+XmlReader (Input)
+***********************************************************************/
+
+			const vint XmlReaderByteBlockSize = 65536;
+			const vint XmlReaderCharBlockSize = 16384;
+			const vint XmlReaderMaxInternedValue = 32;
+
+			vint XmlReader::DecodeStream(wchar_t* target, vint count)
+			{
+				vint decoded = 0;
+				while (decoded < count)
+				{
+					if (bytesEnd - bytesBegin < 4 && stream)
 					{
-						if(end==-1) end=i;
+						vint remain = bytesEnd - bytesBegin;
+						if (remain > 0)
+						{
+							memmove(&bytes[0], &bytes[bytesBegin], remain);
+						}
+						bytesBegin = 0;
+						bytesEnd = remain;
+						vint size = stream->Read(&bytes[bytesEnd], bytes.Count() - bytesEnd);
+						if (size <= 0)
+						{
+							stream = nullptr;
+						}
+						else
+						{
+							bytesEnd += size;
+						}
 					}
-					else
+					if (bytesBegin == bytesEnd)
 					{
-						if(end!=-1) begin=i+1;
+						break;
 					}
-					if(begin!=-1 && end!=-1)
+
+					// decode in the same way as Utf8Decoder
+					const vuint8_t* source = &bytes[bytesBegin];
+					vint sourceCount = (source[0] & 0xF0) == 0xF0 ? 4 : (source[0] & 0xE0) == 0xE0 ? 3 : (source[0] & 0xC0) == 0xC0 ? 2 : 1;
+					if (bytesEnd - bytesBegin < sourceCount)
 					{
-						vint tokenBegin=value[begin].Cast<XmlText>()->content.tokenIndex;
-						vint tokenEnd=value[end].Cast<XmlText>()->content.tokenIndex;
-						while(tokenBegin>0)
-						{
-							if(tokens.Get(tokenBegin-1).token==(vint)XmlParserTokenIndex::SPACE || tokens.Get(tokenBegin-1).token==-1)
-							{
-								tokenBegin--;
-							}
-							else
-							{
-								break;
-							}
-						}
-						while(tokenEnd<tokens.Count()-1)
+						bytesBegin = bytesEnd;
+						break;
+					}
+
+					vuint32_t code = 0;
+					switch (sourceCount)
+					{
+					case 1:
+						code = source[0];
+						break;
+					case 2:
+						code = (((vuint32_t)source[0] & 0x1F) << 6) + ((vuint32_t)source[1] & 0x3F);
+						break;
+					case 3:
+						code = (((vuint32_t)source[0] & 0xF) << 12) + (((vuint32_t)source[1] & 0x3F) << 6) + ((vuint32_t)source[2] & 0x3F);
+						break;
+					default:
+						code = (((vuint32_t)source[0] & 0x7) << 18) + (((vuint32_t)source[1] & 0x3F) << 12) + (((vuint32_t)source[2] & 0x3F) << 6) + ((vuint32_t)source[3] & 0x3F);
+					}
+
+#if defined VCZH_MSVC
+					if (code >= 0x10000)
+					{
+						if (count - decoded < 2)
 						{
-							if(tokens.Get(tokenEnd+1).token==(vint)XmlParserTokenIndex::SPACE || tokens.Get(tokenEnd+1).token==-1)
-							{
-								tokenEnd++;
-							}
-							else
-							{
-								break;
-							}
+							break;
 						}
+						code -= 0x10000;
+						target[decoded++] = (wchar_t)(0xD800 + (code >> 10));
+						target[decoded++] = (wchar_t)(0xDC00 + (code & 0x3FF));
+					}
+					else
+#endif
+					{
+						target[decoded++] = (wchar_t)code;
+					}
+					bytesBegin += sourceCount;
+				}
+				return decoded;
+			}
 
-						const RegexToken& beginToken=tokens.Get(tokenBegin);
-						const RegexToken& endToken=tokens.Get(tokenEnd);
-						const wchar_t* textBegin=beginToken.reading;
-						const wchar_t* textEnd=endToken.reading+endToken.length;
-						WString text(textBegin, vint(textEnd-textBegin));
-						ParsingTextRange range(&beginToken, &endToken);
+			bool XmlReader::Fill(vint count)
+			{
+				if (!stream && bytesBegin == bytesEnd)
+				{
+					return false;
+				}
 
-						Ptr<XmlText> xmlText=new XmlText;
-						xmlText->codeRange=range;
-						xmlText->content.codeRange=range;
-						xmlText->content.value=XmlUnescapeValue(text);
+				// characters before "keeping" are not used anymore
+				if (keeping > 0)
+				{
+					vint kept = bufferLength - keeping;
+					if (kept > 0)
+					{
+						memmove(&chars[0], &chars[keeping], kept * sizeof(wchar_t));
+					}
+					reading -= keeping;
+					bufferLength = kept;
+					keeping = 0;
+				}
 
-						value.RemoveRange(begin, end-begin+1);
-						value.Insert(begin, xmlText);
+				vint required = reading + count;
+				if (chars.Count() < required + XmlReaderCharBlockSize)
+				{
+					vint size = chars.Count() * 2;
+					chars.Resize(size < required + XmlReaderCharBlockSize ? required + XmlReaderCharBlockSize : size);
+				}
+				buffer = &chars[0];
 
-						begin=-1;
-						end=-1;
+				while (bufferLength < required)
+				{
+					vint decoded = DecodeStream(&chars[bufferLength], chars.Count() - bufferLength);
+					if (decoded == 0)
+					{
+						break;
 					}
+					bufferLength += decoded;
 				}
+				return bufferLength >= required;
 			}
 
-			void XmlUnescapeAttributeValue(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			wchar_t XmlReader::Peek(vint offset)
 			{
-				value.value=XmlUnescapeValue(value.value.Sub(1, value.value.Length()-2));
+				if (reading + offset < bufferLength || Fill(offset + 1))
+				{
+					return buffer[reading + offset];
+				}
+				return 0;
 			}
 
-			void XmlUnescapeCData(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			void XmlReader::Advance(vint count)
 			{
-				value.value=XmlUnescapeCData(value.value);
+				for (vint i = 0; i < count; i++)
+				{
+					lastPosition = position;
+					if (buffer[reading++] == L'\n')
+					{
+						position.row++;
+						position.column = 0;
+					}
+					else
+					{
+						position.column++;
+					}
+					position.index++;
+				}
 			}
 
-			void XmlUnescapeComment(vl::parsing::ParsingToken& value, const vl::collections::List<vl::regex::RegexToken>& tokens)
+			bool XmlReader::Match(const wchar_t* text)
 			{
-				value.value=XmlUnescapeComment(value.value);
+				for (vint i = 0; text[i]; i++)
+				{
+					if (Peek(i) != text[i])
+					{
+						return false;
+					}
+				}
+				return true;
 			}
 
-/***********************************************************************
-XmlPrintVisitor
-***********************************************************************/
-
-			class XmlPrintVisitor : public Object, public XmlNode::IVisitor
+			void XmlReader::SkipSpaces()
 			{
-			public:
-				TextWriter&					writer;
-
-				XmlPrintVisitor(TextWriter& _writer)
-					:writer(_writer)
+				while (true)
 				{
+					switch (Peek(0))
+					{
+					case L' ':
+					case L'\t':
+					case L'\r':
+					case L'\n':
+						Advance(1);
+						break;
+					default:
+						return;
+					}
 				}
+			}
 
-				void Visit(XmlText* node)
-				{
-					writer.WriteString(XmlEscapeValue(node->content.value));
-				}
+			void XmlReader::ReportError(const ParsingTextPos& start, const WString& message)
+			{
+				auto error = MakePtr<ParsingError>(message);
+				error->codeRange = ParsingTextRange(start, start, codeIndex);
+				errors.Add(error);
+				nodeType = XmlReaderNodeType::None;
+			}
 
-				void Visit(XmlCData* node)
+			WString XmlReader::Unescape(const wchar_t* text, vint length, bool intern)
+			{
+				vint first = 0;
+				while (first < length && text[first] != L'&')
 				{
-					writer.WriteString(XmlEscapeCData(node->content.value));
+					first++;
 				}
-
-				void Visit(XmlAttribute* node)
+				if (first == length)
 				{
-					writer.WriteString(node->name.value);
-					writer.WriteString(L"=\"");
-					writer.WriteString(XmlEscapeValue(node->value.value));
-					writer.WriteString(L"\"");
+					return intern && length <= XmlReaderMaxInternedValue ? nameTable->Get(text, length) : WString(text, length);
 				}
 
-				void Visit(XmlComment* node)
+				// the same as XmlUnescapeValue
+				if (unescaping.Count() < length)
 				{
-					writer.WriteString(XmlEscapeComment(node->content.value));
-				}
-
-				void Visit(XmlElement* node)
+					unescaping.Resize(length);
+				}
+				wchar_t* writing = &unescaping[0];
+				memcpy(writing, text, first * sizeof(wchar_t));
+				writing += first;
+				for (vint i = first; i < length;)
 				{
-					writer.WriteChar(L'<');
-					writer.WriteString(node->name.value);
-					FOREACH(Ptr<XmlAttribute>, att, node->attributes)
+					const wchar_t* reading = text + i;
+					vint remain = length - i;
+					if (remain >= 4 && wcsncmp(reading, L"&lt;", 4) == 0)
 					{
-						writer.WriteChar(L' ');
-						att->Accept(this);
+						*writing++ = L'<';
+						i += 4;
 					}
-					if(node->subNodes.Count()==0)
+					else if (remain >= 4 && wcsncmp(reading, L"&gt;", 4) == 0)
 					{
-						writer.WriteString(L"/>");
+						*writing++ = L'>';
+						i += 4;
 					}
-					else
+					else if (remain >= 5 && wcsncmp(reading, L"&amp;", 5) == 0)
 					{
-						writer.WriteChar(L'>');
-						FOREACH(Ptr<XmlNode>, subNode, node->subNodes)
-						{
-							subNode->Accept(this);
-						}
-						writer.WriteString(L"</");
-						writer.WriteString(node->name.value);
-						writer.WriteChar(L'>');
+						*writing++ = L'&';
+						i += 5;
 					}
-				}
-
-				void Visit(XmlInstruction* node)
-				{
-					writer.WriteString(L"<?");
-					writer.WriteString(node->name.value);
-					FOREACH(Ptr<XmlAttribute>, att, node->attributes)
+					else if (remain >= 6 && wcsncmp(reading, L"&apos;", 6) == 0)
 					{
-						writer.WriteChar(L' ');
-						att->Accept(this);
+						*writing++ = L'\'';
+						i += 6;
 					}
-					writer.WriteString(L"?>");
-				}
-
-				void Visit(XmlDocument* node)
-				{
-					FOREACH(Ptr<XmlNode>, prolog, node->prologs)
+					else if (remain >= 6 && wcsncmp(reading, L"&quot;", 6) == 0)
 					{
-						prolog->Accept(this);
+						*writing++ = L'\"';
+						i += 6;
+					}
+					else
+					{
+						*writing++ = *reading;
+						i++;
 					}
-					node->rootElement->Accept(this);
 				}
-			};
+
+				vint unescapedLength = writing - &unescaping[0];
+				return intern && unescapedLength <= XmlReaderMaxInternedValue ? nameTable->Get(&unescaping[0], unescapedLength) : WString(&unescaping[0], unescapedLength);
+			}
 
 /***********************************************************************
-API
+XmlReader (Markups)
 ***********************************************************************/
 
-			WString XmlEscapeValue(const WString& value)
+			bool XmlReader::ReadName(WString& _name, ParsingTextRange& _range)
 			{
-				WString result;
-				const wchar_t* reading=value.Buffer();
-				while(wchar_t c=*reading++)
+				ParsingTextPos start = position;
+				keeping = reading;
+				while (true)
 				{
-					switch(c)
+					wchar_t c = Peek(0);
+					if ((L'a' <= c && c <= L'z') || (L'A' <= c && c <= L'Z') || (L'0' <= c && c <= L'9') || c == L':' || c == L'.' || c == L'_' || c == L'-' || c >= 0x80)
+					{
+						Advance(1);
+					}
+					else
 					{
-					case L'<':
-						result+=L"&lt;";
-						break;
-					case L'>':
-						result+=L"&gt;";
-						break;
-					case L'&':
-						result+=L"&amp;";
-						break;
-					case L'\'':
-						result+=L"&apos;";
-						break;
-					case L'\"':
-						result+=L"&quot;";
 						break;
-					default:
-						result+=c;
 					}
 				}
-				return result;
+
+				if (reading == keeping)
+				{
+					ReportError(start, L"A name is expected.");
+					return false;
+				}
+				_name = nameTable->Get(buffer + keeping, reading - keeping);
+				_range = ParsingTextRange(start, lastPosition, codeIndex);
+				return true;
 			}
 
-			WString XmlUnescapeValue(const WString& value)
+			bool XmlReader::ReadAttributes()
 			{
-				WString result;
-				const wchar_t* reading=value.Buffer();
-				while(*reading)
+				while (true)
 				{
-					if(wcsncmp(reading, L"&lt;", 4)==0)
-					{
-						result+=L'<';
-						reading+=4;
-					}
-					else if(wcsncmp(reading, L"&gt;", 4)==0)
+					SkipSpaces();
+					wchar_t c = Peek(0);
+					if (c == L'>' || c == L'/' || c == L'?' || c == 0)
 					{
-						result+=L'>';
-						reading+=4;
+						return true;
 					}
-					else if(wcsncmp(reading, L"&amp;", 5)==0)
+
+					if (attributeCount == attributes.Count())
 					{
-						result+=L'&';
-						reading+=5;
+						attributes.Add(Attribute());
 					}
-					else if(wcsncmp(reading, L"&apos;", 6)==0)
+					auto& attribute = attributes[attributeCount++];
+					if (!ReadName(attribute.name, attribute.nameRange)) return false;
+
+					SkipSpaces();
+					if (Peek(0) != L'=')
 					{
-						result+=L'\'';
-						reading+=6;
+						ReportError(position, L"\"=\" is expected after the name of attribute \"" + attribute.name + L"\".");
+						return false;
 					}
-					else if(wcsncmp(reading, L"&quot;", 6)==0)
+					Advance(1);
+					SkipSpaces();
+
+					ParsingTextPos start = position;
+					wchar_t quote = Peek(0);
+					if (quote != L'\"' && quote != L'\'')
 					{
-						result+=L'\"';
-						reading+=6;
+						ReportError(start, L"A quoted value is expected for attribute \"" + attribute.name + L"\".");
+						return false;
 					}
-					else
+					Advance(1);
+					keeping = reading;
+					while (true)
 					{
-						result+=*reading++;
+						c = Peek(0);
+						if (c == quote)
+						{
+							break;
+						}
+						else if (c == 0 || c == L'<')
+						{
+							ReportError(start, L"The value of attribute \"" + attribute.name + L"\" is not closed.");
+							return false;
+						}
+						Advance(1);
 					}
+					attribute.value = Unescape(buffer + keeping, reading - keeping, true);
+					Advance(1);
+					attribute.valueRange = ParsingTextRange(start, lastPosition, codeIndex);
 				}
-				return result;
 			}
 
-			WString XmlEscapeCData(const WString& value)
+			bool XmlReader::ReadElementBegin()
 			{
-				return L"<![CDATA["+value+L"]]>";
-			}
+				ParsingTextPos start = position;
+				Advance(1);
+				SkipSpaces();
+				if (!ReadName(name, nameRange)) return false;
+				if (!ReadAttributes()) return false;
 
-			WString XmlUnescapeCData(const WString& value)
-			{
-				return value.Sub(9, value.Length()-12);
-			}
+				if (Match(L"/>"))
+				{
+					Advance(2);
+					emptyElement = true;
+					pendingElementEnd = true;
+				}
+				else if (Peek(0) == L'>')
+				{
+					Advance(1);
+				}
+				else
+				{
+					ReportError(position, L"\">\" or \"/>\" is expected to close element \"" + name + L"\".");
+					return false;
+				}
 
-			WString XmlEscapeComment(const WString& value)
-			{
-				return L"<!--"+value+L"-->";
+				nodeType = XmlReaderNodeType::ElementBegin;
+				range = ParsingTextRange(start, lastPosition, codeIndex);
+				depth = openedElements.Count();
+				openedElements.Add(name);
+				return true;
 			}
 
-			WString XmlUnescapeComment(const WString& value)
+			bool XmlReader::ReadElementEnd()
 			{
-				return value.Sub(4, value.Length()-7);
+				ParsingTextPos start = position;
+				Advance(2);
+				SkipSpaces();
+				if (!ReadName(name, nameRange)) return false;
+				SkipSpaces();
+				if (Peek(0) != L'>')
+				{
+					ReportError(position, L"\">\" is expected to close element \"" + name + L"\".");
+					return false;
+				}
+				Advance(1);
+
+				const WString& openedName = openedElements[openedElements.Count() - 1];
+				if (name != openedName)
+				{
+					ReportError(start, L"The closing tag \"" + name + L"\" does not match element \"" + openedName + L"\".");
+					return false;
+				}
+
+				nodeType = XmlReaderNodeType::ElementEnd;
+				range = ParsingTextRange(start, lastPosition, codeIndex);
+				openedElements.RemoveAt(openedElements.Count() - 1);
+				depth = openedElements.Count();
+				if (depth == 0)
+				{
+					rootElementRead = true;
+				}
+				return true;
 			}
 
-			void XmlPrint(Ptr<XmlNode> node, stream::TextWriter& writer)
+			bool XmlReader::ReadInstruction()
 			{
-				XmlPrintVisitor visitor(writer);
-				node->Accept(&visitor);
+				ParsingTextPos start = position;
+				Advance(2);
+				SkipSpaces();
+				if (!ReadName(name, nameRange)) return false;
+				if (!ReadAttributes()) return false;
+				if (!Match(L"?>"))
+				{
+					ReportError(position, L"\"?>\" is expected to close instruction \"" + name + L"\".");
+					return false;
+				}
+				Advance(2);
+
+				nodeType = XmlReaderNodeType::Instruction;
+				range = ParsingTextRange(start, lastPosition, codeIndex);
+				depth = 0;
+				return true;
 			}
 
-			void XmlPrintContent(Ptr<XmlElement> element, stream::TextWriter& writer)
+			bool XmlReader::ReadDelimited(XmlReaderNodeType _nodeType, vint openingLength, const wchar_t* closing)
 			{
-				XmlPrintVisitor visitor(writer);
-				FOREACH(Ptr<XmlNode>, node, element->subNodes)
+				ParsingTextPos start = position;
+				Advance(openingLength);
+				keeping = reading;
+				while (!Match(closing))
 				{
-					node->Accept(&visitor);
+					if (Peek(0) == 0)
+					{
+						ReportError(start, _nodeType == XmlReaderNodeType::Comment ? L"The comment is not closed." : L"The CDATA section is not closed.");
+						return false;
+					}
+					Advance(1);
 				}
+				value = WString(buffer + keeping, reading - keeping);
+				Advance(wcslen(closing));
+
+				nodeType = _nodeType;
+				range = ParsingTextRange(start, lastPosition, codeIndex);
+				depth = openedElements.Count();
+				return true;
 			}
 
-			WString XmlToString(Ptr<XmlNode> node)
+			bool XmlReader::ReadText(bool& blank)
 			{
-				MemoryStream stream;
+				// the text covers all characters between two markups, including spaces
+				ParsingTextPos start = position;
+				keeping = reading;
+				blank = true;
+				while (true)
 				{
-					StreamWriter writer(stream);
-					XmlPrint(node, writer);
+					wchar_t c = Peek(0);
+					if (c == L'<' || c == 0)
+					{
+						break;
+					}
+					else if (c != L' ' && c != L'\t' && c != L'\r' && c != L'\n')
+					{
+						blank = false;
+					}
+					Advance(1);
 				}
-				stream.SeekFromBegin(0);
+
+				if (!blank)
 				{
-					StreamReader reader(stream);
-					return reader.ReadToEnd();
+					value = Unescape(buffer + keeping, reading - keeping, false);
+					nodeType = XmlReaderNodeType::Text;
+					range = ParsingTextRange(start, lastPosition, codeIndex);
+					depth = openedElements.Count();
 				}
+				return true;
 			}
 
 /***********************************************************************
-Linq To Xml
+XmlReader
 ***********************************************************************/
 
-			Ptr<XmlAttribute> XmlGetAttribute(Ptr<XmlElement> element, const WString& name)
+			void XmlReader::Initialize()
 			{
-				return XmlGetAttribute(element.Obj(), name);
+				position.index = 0;
+				position.row = 0;
+				position.column = 0;
+				if (!nameTable)
+				{
+					nameTable = new XmlNameTable;
+				}
+				if (Peek(0) == 0xFEFF)
+				{
+					reading++;
+				}
 			}
 
-			Ptr<XmlElement> XmlGetElement(Ptr<XmlElement> element, const WString& name)
+			XmlReader::XmlReader(stream::IStream& _stream, vint _codeIndex, Ptr<XmlNameTable> _nameTable)
+				:stream(&_stream)
+				, codeIndex(_codeIndex)
+				, nameTable(_nameTable)
 			{
-				return XmlGetElement(element.Obj(), name);
+				bytes.Resize(XmlReaderByteBlockSize);
+				Initialize();
 			}
 
-			collections::LazyList<Ptr<XmlElement>> XmlGetElements(Ptr<XmlElement> element)
+			XmlReader::XmlReader(const WString& _input, vint _codeIndex, Ptr<XmlNameTable> _nameTable)
+				:input(_input)
+				, codeIndex(_codeIndex)
+				, nameTable(_nameTable)
 			{
-				return XmlGetElements(element.Obj());
+				buffer = input.Buffer();
+				bufferLength = input.Length();
+				Initialize();
 			}
 
-			collections::LazyList<Ptr<XmlElement>> XmlGetElements(Ptr<XmlElement> element, const WString& name)
+			XmlReader::~XmlReader()
 			{
-				return XmlGetElements(element.Obj(), name);
 			}
 
-			WString XmlGetValue(Ptr<XmlElement> element)
+			bool XmlReader::Read()
 			{
-				return XmlGetValue(element.Obj());
-			}
+				if (errors.Count() > 0)
+				{
+					return false;
+				}
 
-			Ptr<XmlAttribute> XmlGetAttribute(XmlElement* element, const WString& name)
-			{
-				FOREACH(Ptr<XmlAttribute>, att, element->attributes)
+				if (pendingElementEnd)
 				{
-					if(att->name.value==name)
+					pendingElementEnd = false;
+					nodeType = XmlReaderNodeType::ElementEnd;
+					nameRange = ParsingTextRange();
+					openedElements.RemoveAt(openedElements.Count() - 1);
+					depth = openedElements.Count();
+					if (depth == 0)
 					{
-						return att;
+						rootElementRead = true;
 					}
+					return true;
 				}
-				return 0;
-			}
 
-			Ptr<XmlElement> XmlGetElement(XmlElement* element, const WString& name)
-			{
-				FOREACH(Ptr<XmlNode>, node, element->subNodes)
+				nodeType = XmlReaderNodeType::None;
+				name = WString::Empty;
+				value = WString::Empty;
+				nameRange = ParsingTextRange();
+				emptyElement = false;
+				attributeCount = 0;
+
+				while (true)
 				{
-					Ptr<XmlElement> subElement=node.Cast<XmlElement>();
-					if(subElement && subElement->name.value==name)
+					keeping = reading;
+					bool inRoot = openedElements.Count() > 0;
+					if (!inRoot)
 					{
-						return subElement;
+						SkipSpaces();
+					}
+
+					ParsingTextPos start = position;
+					wchar_t c = Peek(0);
+					if (c == 0)
+					{
+						if (inRoot)
+						{
+							ReportError(start, L"Element \"" + openedElements[openedElements.Count() - 1] + L"\" is not closed.");
+						}
+						else if (!rootElementRead)
+						{
+							ReportError(start, L"The root element is missing.");
+						}
+						return false;
+					}
+					else if (c != L'<')
+					{
+						if (!inRoot)
+						{
+							ReportError(start, L"Text is not allowed outside of the root element.");
+							return false;
+						}
+						bool blank = false;
+						if (!ReadText(blank)) return false;
+						if (!blank) return true;
+					}
+					else if (Match(L"<!--"))
+					{
+						return ReadDelimited(XmlReaderNodeType::Comment, 4, L"-->");
+					}
+					else if (Match(L"<![CDATA["))
+					{
+						if (!inRoot)
+						{
+							ReportError(start, L"CDATA section is not allowed outside of the root element.");
+							return false;
+						}
+						return ReadDelimited(XmlReaderNodeType::CData, 9, L"]]>");
+					}
+					else if (Peek(1) == L'?')
+					{
+						if (inRoot || rootElementRead)
+						{
+							ReportError(start, L"Instruction is only allowed before the root element.");
+							return false;
+						}
+						return ReadInstruction();
+					}
+					else if (Peek(1) == L'/')
+					{
+						if (!inRoot)
+						{
+							ReportError(start, L"Closing tag is not allowed outside of the root element.");
+							return false;
+						}
+						return ReadElementEnd();
+					}
+					else
+					{
+						if (!inRoot && rootElementRead)
+						{
+							ReportError(start, L"Only one root element is allowed.");
+							return false;
+						}
+						return ReadElementBegin();
 					}
 				}
-				return 0;
 			}
 
-			collections::LazyList<Ptr<XmlElement>> XmlGetElements(XmlElement* element)
+			collections::List<Ptr<ParsingError>>& XmlReader::GetErrors()
+			{
+				return errors;
+			}
+
+			Ptr<XmlNameTable> XmlReader::GetNameTable()
+			{
+				return nameTable;
+			}
+
+			XmlReaderNodeType XmlReader::GetNodeType()
+			{
+				return nodeType;
+			}
+
+			vint XmlReader::GetDepth()
 			{
-				return From(element->subNodes)
-					.FindType<XmlElement>();
+				return depth;
 			}
 
-			collections::LazyList<Ptr<XmlElement>> XmlGetElements(XmlElement* element, const WString& name)
+			const WString& XmlReader::GetName()
 			{
-				return From(element->subNodes)
-					.FindType<XmlElement>()
-					.Where([name](Ptr<XmlElement> e){return e->name.value==name;});
+				return name;
 			}
 
-			WString XmlGetValue(XmlElement* element)
+			const WString& XmlReader::GetValue()
 			{
-				WString result;
-				FOREACH(Ptr<XmlNode>, node, element->subNodes)
-				{
-					if(Ptr<XmlText> text=node.Cast<XmlText>())
-					{
-						result+=text->content.value;
-					}
-					else if(Ptr<XmlCData> text=node.Cast<XmlCData>())
-					{
-						result+=text->content.value;
-					}
-				}
-				return result;
+				return value;
 			}
 
-/***********************************************************************
-XmlElementWriter
-***********************************************************************/
+			const ParsingTextRange& XmlReader::GetRange()
+			{
+				return range;
+			}
 
-			XmlElementWriter::XmlElementWriter(Ptr<XmlElement> _element, const XmlElementWriter* _previousWriter)
-				:element(_element)
-				,previousWriter(_previousWriter)
+			const ParsingTextRange& XmlReader::GetNameRange()
 			{
+				return nameRange;
 			}
 
-			XmlElementWriter::~XmlElementWriter()
+			bool XmlReader::IsEmptyElement()
 			{
+				return emptyElement;
 			}
 
-			const XmlElementWriter& XmlElementWriter::Attribute(const WString& name, const WString& value)const
+			vint XmlReader::GetAttributeCount()
 			{
-				Ptr<XmlAttribute> node=new XmlAttribute;
-				node->name.value=name;
-				node->value.value=value;
-				element->attributes.Add(node);
-				return *this;
+				return attributeCount;
 			}
 
-			XmlElementWriter XmlElementWriter::Element(const WString& name)const
+			const XmlReader::Attribute& XmlReader::GetAttribute(vint index)
 			{
-				Ptr<XmlElement> node=new XmlElement;
-				node->name.value=name;
-				element->subNodes.Add(node);
-				return XmlElementWriter(node, this);
+				CHECK_ERROR(0 <= index && index < attributeCount, L"XmlReader::GetAttribute(vint)#Index out of range.");
+				return attributes[index];
 			}
 
-			const XmlElementWriter& XmlElementWriter::End()const
+/***********************************************************************
+Document Loading
+***********************************************************************/
+
+			template<typename TNode>
+			void XmlReadAttributes(XmlReader& reader, TNode* node)
 			{
-				return *previousWriter;
+				for (vint i = 0; i < reader.GetAttributeCount(); i++)
+				{
+					auto& readerAttribute = reader.GetAttribute(i);
+					auto attribute = MakePtr<XmlAttribute>();
+					attribute->codeRange = ParsingTextRange(readerAttribute.nameRange.start, readerAttribute.valueRange.end, readerAttribute.nameRange.codeIndex);
+					attribute->name.codeRange = readerAttribute.nameRange;
+					attribute->name.value = readerAttribute.name;
+					attribute->value.codeRange = readerAttribute.valueRange;
+					attribute->value.value = readerAttribute.value;
+					node->attributes.Add(attribute);
+				}
 			}
 
-			const XmlElementWriter& XmlElementWriter::Text(const WString& value)const
+			Ptr<XmlDocument> XmlReadDocument(XmlReader& reader, collections::List<Ptr<ParsingError>>& errors)
 			{
-				Ptr<XmlText> node=new XmlText;
-				node->content.value=value;
-				element->subNodes.Add(node);
-				return *this;
+				auto document = MakePtr<XmlDocument>();
+				List<XmlElement*> elements;
+				while (reader.Read())
+				{
+					XmlElement* parent = elements.Count() == 0 ? nullptr : elements[elements.Count() - 1];
+					Ptr<XmlNode> node;
+					switch (reader.GetNodeType())
+					{
+					case XmlReaderNodeType::Instruction:
+						{
+							auto instruction = MakePtr<XmlInstruction>();
+							instruction->name.codeRange = reader.GetNameRange();
+							instruction->name.value = reader.GetName();
+							XmlReadAttributes(reader, instruction.Obj());
+							node = instruction;
+						}
+						break;
+					case XmlReaderNodeType::ElementBegin:
+						{
+							auto element = MakePtr<XmlElement>();
+							element->name.codeRange = reader.GetNameRange();
+							element->name.value = reader.GetName();
+							XmlReadAttributes(reader, element.Obj());
+							element->codeRange = reader.GetRange();
+							if (parent)
+							{
+								parent->subNodes.Add(element);
+							}
+							else
+							{
+								document->rootElement = element;
+							}
+							elements.Add(element.Obj());
+						}
+						continue;
+					case XmlReaderNodeType::ElementEnd:
+						if (parent)
+						{
+							if (!reader.IsEmptyElement())
+							{
+								parent->closingName.codeRange = reader.GetNameRange();
+								parent->closingName.value = reader.GetName();
+							}
+							parent->codeRange.end = reader.GetRange().end;
+							elements.RemoveAt(elements.Count() - 1);
+						}
+						continue;
+					case XmlReaderNodeType::Text:
+						{
+							auto text = MakePtr<XmlText>();
+							text->content.codeRange = reader.GetRange();
+							text->content.value = reader.GetValue();
+							node = text;
+						}
+						break;
+					case XmlReaderNodeType::CData:
+						{
+							auto cdata = MakePtr<XmlCData>();
+							cdata->content.codeRange = reader.GetRange();
+							cdata->content.value = reader.GetValue();
+							node = cdata;
+						}
+						break;
+					case XmlReaderNodeType::Comment:
+						{
+							auto comment = MakePtr<XmlComment>();
+							comment->content.codeRange = reader.GetRange();
+							comment->content.value = reader.GetValue();
+							node = comment;
+						}
+						break;
+					default:
+						continue;
+					}
+
+					node->codeRange = reader.GetRange();
+					if (parent)
+					{
+						parent->subNodes.Add(node);
+					}
+					else if (!document->rootElement)
+					{
+						document->prologs.Add(node);
+					}
+					// comments after the root element are not kept in XmlDocument
+				}
+
+				if (reader.GetErrors().Count() > 0)
+				{
+					CopyFrom(errors, reader.GetErrors(), true);
+					return nullptr;
+				}
+				if (!document->rootElement)
+				{
+					errors.Add(new ParsingError(L"The root element is missing."));
+					return nullptr;
+				}
+
+				auto first = document->prologs.Count() > 0 ? document->prologs[0].Obj() : document->rootElement.Obj();
+				document->codeRange = ParsingTextRange(first->codeRange.start, document->rootElement->codeRange.end, first->codeRange.codeIndex);
+				return document;
 			}
 
-			const XmlElementWriter& XmlElementWriter::CData(const WString& value)const
+			Ptr<XmlDocument> XmlParseDocument(stream::IStream& input, collections::List<Ptr<ParsingError>>& errors, vint codeIndex)
 			{
-				Ptr<XmlCData> node=new XmlCData;
-				node->content.value=value;
-				element->subNodes.Add(node);
-				return *this;
+				XmlReader reader(input, codeIndex);
+				return XmlReadDocument(reader, errors);
 			}
 
-			const XmlElementWriter& XmlElementWriter::Comment(const WString& value)const
+			Ptr<XmlDocument> XmlParseDocument(const WString& input, collections::List<Ptr<ParsingError>>& errors, vint codeIndex)
 			{
-				Ptr<XmlComment> node=new XmlComment;
-				node->content.value=value;
-				element->subNodes.Add(node);
-				return *this;
+				XmlReader reader(input, codeIndex);
+				return XmlReadDocument(reader, errors);
 			}
 		}
 	}
@@ -15812,6 +17874,7 @@ description::Value
 			Value::Value(DescriptableObject* value)
 				:valueType(value ? RawPtr :Null)
 				,rawPtr(nullptr)
+				,inlineType(nullptr)
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				,typeDescriptor(0)
 #endif
@@ -15829,6 +17892,7 @@ description::Value
 			Value::Value(Ptr<DescriptableObject> value)
 				:valueType(value ? SharedPtr : Null)
 				,rawPtr(nullptr)
+				,inlineType(nullptr)
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				,typeDescriptor(0)
 #endif
@@ -15849,6 +17913,7 @@ description::Value
 				:valueType(value ? BoxedValue : Null)
 				, rawPtr(nullptr)
 				, boxedValue(value)
+				, inlineType(nullptr)
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				, typeDescriptor(associatedTypeDescriptor)
 #endif
@@ -15992,6 +18057,7 @@ description::Value
 			Value::Value()
 				:valueType(Null)
 				,rawPtr(0)
+				,inlineType(nullptr)
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				,typeDescriptor(0)
 #endif
@@ -16003,10 +18069,37 @@ description::Value
 				,rawPtr(value.rawPtr)
 				,sharedPtr(value.sharedPtr)
 				,boxedValue(value.boxedValue ? value.boxedValue->Copy() : nullptr)
+				,inlineType(value.inlineType)
+#ifndef VCZH_DEBUG_NO_REFLECTION
+				,typeDescriptor(value.typeDescriptor)
+#endif
+			{
+				if (inlineType)
+				{
+					memcpy(inlineBuffer, value.inlineBuffer, sizeof(inlineBuffer));
+				}
+			}
+
+			Value::Value(Value&& value)
+				:valueType(value.valueType)
+				,rawPtr(value.rawPtr)
+				,sharedPtr(MoveValue(value.sharedPtr))
+				,boxedValue(MoveValue(value.boxedValue))
+				,inlineType(value.inlineType)
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				,typeDescriptor(value.typeDescriptor)
 #endif
 			{
+				if (inlineType)
+				{
+					memcpy(inlineBuffer, value.inlineBuffer, sizeof(inlineBuffer));
+				}
+				value.valueType = Null;
+				value.rawPtr = nullptr;
+				value.inlineType = nullptr;
+#ifndef VCZH_DEBUG_NO_REFLECTION
+				value.typeDescriptor = nullptr;
+#endif
 			}
 
 			Value& Value::operator=(const Value& value)
@@ -16015,12 +18108,43 @@ description::Value
 				rawPtr = value.rawPtr;
 				sharedPtr = value.sharedPtr;
 				boxedValue = value.boxedValue ? value.boxedValue->Copy() : nullptr;
+				inlineType = value.inlineType;
+				if (inlineType)
+				{
+					memcpy(inlineBuffer, value.inlineBuffer, sizeof(inlineBuffer));
+				}
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				typeDescriptor = value.typeDescriptor;
 #endif
 				return *this;
 			}
 
+			Value& Value::operator=(Value&& value)
+			{
+				if (this != &value)
+				{
+					valueType = value.valueType;
+					rawPtr = value.rawPtr;
+					sharedPtr = MoveValue(value.sharedPtr);
+					boxedValue = MoveValue(value.boxedValue);
+					inlineType = value.inlineType;
+					if (inlineType)
+					{
+						memcpy(inlineBuffer, value.inlineBuffer, sizeof(inlineBuffer));
+					}
+#ifndef VCZH_DEBUG_NO_REFLECTION
+					typeDescriptor = value.typeDescriptor;
+#endif
+					value.valueType = Null;
+					value.rawPtr = nullptr;
+					value.inlineType = nullptr;
+#ifndef VCZH_DEBUG_NO_REFLECTION
+					value.typeDescriptor = nullptr;
+#endif
+				}
+				return *this;
+			}
+
 			Value::ValueType Value::GetValueType()const
 			{
 				return valueType;
@@ -16038,6 +18162,21 @@ description::Value
 
 			Ptr<IBoxedValue> Value::GetBoxedValue()const
 			{
+				if (inlineType)
+				{
+					// a const value could be shared by multiple threads, so it is not changed here
+					return inlineType->boxer(inlineBuffer);
+				}
+				return boxedValue;
+			}
+
+			Ptr<IBoxedValue> Value::GetBoxedValue()
+			{
+				if (inlineType)
+				{
+					boxedValue = inlineType->boxer(inlineBuffer);
+					inlineType = nullptr;
+				}
 				return boxedValue;
 			}
 
@@ -16319,14 +18458,66 @@ description::Value
 description::TypeManager
 ***********************************************************************/
 
+			std::atomic<vint> globalTypeDescriptorVersion(1);
+
 			class TypeManager : public Object, public ITypeManager
 			{
 			protected:
+				struct IndexItem
+				{
+					vuint										hash = 0;
+					WString										name;
+					ITypeDescriptor*							typeDescriptor = nullptr;
+				};
+
 				Dictionary<WString, Ptr<ITypeDescriptor>>		typeDescriptors;
+				Array<IndexItem>								typeDescriptorIndex;
 				List<Ptr<ITypeLoader>>							typeLoaders;
 				ITypeDescriptor*								rootType;
 				bool											loaded;
 
+				static vuint HashTypeName(const WString& name)
+				{
+					vuint hash = 2166136261u;
+					auto buffer = name.Buffer();
+					for (vint i = 0; i < name.Length(); i++)
+					{
+						hash = (hash ^ (vuint)buffer[i]) * 16777619u;
+					}
+					return hash;
+				}
+
+				void InsertIndex(const WString& name, ITypeDescriptor* typeDescriptor)
+				{
+					vuint hash = HashTypeName(name);
+					vint mask = typeDescriptorIndex.Count() - 1;
+					vint index = (vint)(hash & (vuint)mask);
+					while (typeDescriptorIndex[index].typeDescriptor)
+					{
+						index = (index + 1) & mask;
+					}
+					typeDescriptorIndex[index].hash = hash;
+					typeDescriptorIndex[index].name = name;
+					typeDescriptorIndex[index].typeDescriptor = typeDescriptor;
+				}
+
+				void RebuildIndex()
+				{
+					vint count = typeDescriptors.Count();
+					vint capacity = 64;
+					while (capacity < count * 2)
+					{
+						capacity *= 2;
+					}
+
+					typeDescriptorIndex.Resize(0);
+					typeDescriptorIndex.Resize(capacity);
+					for (vint i = 0; i < count; i++)
+					{
+						InsertIndex(typeDescriptors.Keys()[i], typeDescriptors.Values()[i].Obj());
+					}
+				}
+
 			public:
 				TypeManager()
 					:rootType(0)
@@ -16351,8 +18542,21 @@ description::TypeManager
 
 				ITypeDescriptor* GetTypeDescriptor(const WString& name)override
 				{
-					vint index=typeDescriptors.Keys().IndexOf(name);
-					return index==-1?0:typeDescriptors.Values().Get(index).Obj();
+					vint capacity = typeDescriptorIndex.Count();
+					if (capacity == 0) return 0;
+
+					vuint hash = HashTypeName(name);
+					vint mask = capacity - 1;
+					vint index = (vint)(hash & (vuint)mask);
+					while (auto typeDescriptor = typeDescriptorIndex[index].typeDescriptor)
+					{
+						if (typeDescriptorIndex[index].hash == hash && typeDescriptorIndex[index].name == name)
+						{
+							return typeDescriptor;
+						}
+						index = (index + 1) & mask;
+					}
+					return 0;
 				}
 
 				bool SetTypeDescriptor(const WString& name, Ptr<ITypeDescriptor> typeDescriptor)override
@@ -16366,6 +18570,15 @@ description::TypeManager
 						if(typeDescriptor)
 						{
 							typeDescriptors.Add(name, typeDescriptor);
+							if (typeDescriptors.Count() * 2 > typeDescriptorIndex.Count())
+							{
+								RebuildIndex();
+							}
+							else
+							{
+								InsertIndex(name, typeDescriptor.Obj());
+							}
+							globalTypeDescriptorVersion++;
 							return true;
 						}
 					}
@@ -16374,6 +18587,8 @@ description::TypeManager
 						if(!typeDescriptor)
 						{
 							typeDescriptors.Remove(name);
+							RebuildIndex();
+							globalTypeDescriptorVersion++;
 							return true;
 						}
 					}
@@ -16444,6 +18659,8 @@ description::TypeManager
 							typeLoaders[i]->Unload(this);
 						}
 						typeDescriptors.Clear();
+						typeDescriptorIndex.Resize(0);
+						globalTypeDescriptorVersion++;
 						return true;
 					}
 					else
@@ -17468,6 +19685,127 @@ MethodGroupInfoImpl
 				return true;
 			}
 
+/***********************************************************************
+MethodCallSiteCache
+***********************************************************************/
+
+			bool MethodCallSiteCache::Find(IMemberInfo* member, const Value* thisObject, collections::Array<Value>& arguments, Entry& entry)
+			{
+				if (arguments.Count() > MaxArgumentCount) return false;
+				auto thisType = thisObject ? thisObject->GetTypeDescriptor() : nullptr;
+				auto thisValueType = thisObject ? thisObject->GetValueType() : Value::Null;
+
+				SPIN_LOCK(*lock.Obj())
+				{
+					for (vint i = 0; i < MaxEntryCount; i++)
+					{
+						auto& candidate = entries[i];
+						if (candidate.member != member) continue;
+						if (candidate.thisType != thisType || candidate.thisValueType != thisValueType) continue;
+						if (candidate.argumentCount != arguments.Count()) continue;
+
+						bool matched = true;
+						for (vint j = 0; j < arguments.Count(); j++)
+						{
+							if (candidate.argumentTypes[j] != arguments[j].GetTypeDescriptor() || candidate.argumentValueTypes[j] != arguments[j].GetValueType())
+							{
+								matched = false;
+								break;
+							}
+						}
+
+						if (matched)
+						{
+							entry = candidate;
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+
+			bool MethodCallSiteCache::Fill(IMemberInfo* member, IMethodInfo* method, const Value* thisObject, collections::Array<Value>& arguments, Entry& entry)
+			{
+				if (arguments.Count() > MaxArgumentCount) return false;
+
+				entry.member = member;
+				entry.method = method;
+				entry.methodImpl = dynamic_cast<MethodInfoImpl*>(method);
+				entry.thisType = thisObject ? thisObject->GetTypeDescriptor() : nullptr;
+				entry.thisValueType = thisObject ? thisObject->GetValueType() : Value::Null;
+				entry.argumentCount = arguments.Count();
+				for (vint i = 0; i < arguments.Count(); i++)
+				{
+					entry.argumentTypes[i] = arguments[i].GetTypeDescriptor();
+					entry.argumentValueTypes[i] = arguments[i].GetValueType();
+				}
+				return true;
+			}
+
+			void MethodCallSiteCache::Remember(const Entry& entry)
+			{
+				SPIN_LOCK(*lock.Obj())
+				{
+					entries[nextEntry] = entry;
+					nextEntry = (nextEntry + 1) % MaxEntryCount;
+				}
+			}
+
+			MethodCallSiteCache::MethodCallSiteCache()
+				:lock(new SpinLock)
+			{
+			}
+
+			MethodCallSiteCache::~MethodCallSiteCache()
+			{
+			}
+
+			IMethodInfo* MethodCallSiteCache::SelectMethod(IMethodGroupInfo* methodGroup, collections::Array<Value>& arguments)
+			{
+				if (methodGroup->GetMethodCount() == 1)
+				{
+					return methodGroup->GetMethod(0);
+				}
+
+				Entry entry;
+				if (Find(methodGroup, nullptr, arguments, entry))
+				{
+					return entry.method;
+				}
+
+				auto method = Value::SelectMethod(methodGroup, arguments);
+				if (Fill(methodGroup, method, nullptr, arguments, entry))
+				{
+					try
+					{
+						method->CheckArguments(arguments);
+						Remember(entry);
+					}
+					catch (const TypeDescriptorException&)
+					{
+					}
+				}
+				return method;
+			}
+
+			Value MethodCallSiteCache::Invoke(IMethodInfo* method, const Value& thisObject, collections::Array<Value>& arguments)
+			{
+				Entry entry;
+				if (Find(method, &thisObject, arguments, entry))
+				{
+					return entry.methodImpl->InvokeInternal(thisObject, arguments);
+				}
+
+				// only methods implemented by MethodInfoImpl could be invoked without checking
+				bool filled = Fill(method, method, &thisObject, arguments, entry) && entry.methodImpl;
+				auto result = method->Invoke(thisObject, arguments);
+				if (filled)
+				{
+					Remember(entry);
+				}
+				return result;
+			}
+
 /***********************************************************************
 EventInfoImpl
 ***********************************************************************/
@@ -18336,6 +20674,27 @@ ValueTypeDescriptorBase
 
 #endif
 
+/***********************************************************************
+SubscriptionScheduler
+***********************************************************************/
+
+			IValueSubscriptionScheduler* valueSubscriptionScheduler = nullptr;
+
+			IValueSubscriptionScheduler* SubscriptionScheduler::GetScheduler()
+			{
+				return valueSubscriptionScheduler;
+			}
+
+			void SubscriptionScheduler::SetScheduler(IValueSubscriptionScheduler* scheduler)
+			{
+				valueSubscriptionScheduler = scheduler;
+			}
+
+			bool SubscriptionScheduler::Schedule(IValueSubscription* subscription)
+			{
+				return valueSubscriptionScheduler && valueSubscriptionScheduler->Schedule(subscription);
+			}
+
 /***********************************************************************
 TypeName
 ***********************************************************************/
@@ -18344,6 +20703,7 @@ TypeName
 			
 			IMPL_TYPE_INFO_RENAME(vl::reflection::description::Sys,							system::Sys)
 			IMPL_TYPE_INFO_RENAME(vl::reflection::description::Math,						system::Math)
+			IMPL_TYPE_INFO_RENAME(vl::reflection::description::SubscriptionScheduler,		system::SubscriptionScheduler)
 			IMPL_TYPE_INFO_RENAME(void,														system::Void)
 			IMPL_TYPE_INFO_RENAME(vl::reflection::description::VoidValue,					system::Void)
 			IMPL_TYPE_INFO_RENAME(vl::reflection::IDescriptable,							system::Interface)
@@ -18874,6 +21234,10 @@ LoadPredefinedTypes
 				CLASS_MEMBER_STATIC_METHOD(Find, { L"value" _ L"substr" })
 			END_CLASS_MEMBER(Sys)
 
+			BEGIN_CLASS_MEMBER(SubscriptionScheduler)
+				CLASS_MEMBER_STATIC_METHOD(Schedule, { L"subscription" })
+			END_CLASS_MEMBER(SubscriptionScheduler)
+
 			BEGIN_CLASS_MEMBER(Math)
 				CLASS_MEMBER_STATIC_METHOD_OVERLOAD(Abs, { L"value" }, vint8_t(*)(vint8_t))
 				CLASS_MEMBER_STATIC_METHOD_OVERLOAD(Abs, { L"value" }, vint16_t(*)(vint16_t))
@@ -19222,6 +21586,7 @@ LoadPredefinedTypes
 
 					ADD_TYPE_INFO(Sys)
 					ADD_TYPE_INFO(Math)
+					ADD_TYPE_INFO(SubscriptionScheduler)
 
 					ADD_TYPE_INFO(VoidValue)
 					ADD_TYPE_INFO(IDescriptable)
@@ -19397,7 +21762,8 @@ Regex
 				const wchar_t* start=text.Buffer();
 				const wchar_t* input=start;
 				RichResult result;
-				while(rich->Match(input, start, result))
+				RichMatchContext context;
+				while(rich->Match(input, start, result, nullptr, &context))
 				{
 					vint offset=input-start;
 					if(keepFail)
@@ -19620,6 +21986,34 @@ Regex
 			}
 		}
 
+		bool Regex::TestHead(const wchar_t* begin, const wchar_t* end)const
+		{
+			if(pure)
+			{
+				PureResult result;
+				return pure->MatchHead(begin, begin, result, end);
+			}
+			else
+			{
+				RichResult result;
+				return rich->MatchHead(begin, begin, result, end);
+			}
+		}
+
+		bool Regex::Test(const wchar_t* begin, const wchar_t* end)const
+		{
+			if(pure)
+			{
+				PureResult result;
+				return pure->Match(begin, begin, result, end);
+			}
+			else
+			{
+				RichResult result;
+				return rich->Match(begin, begin, result, end);
+			}
+		}
+
 		void Regex::Search(const WString& text, RegexMatch::List& matches)const
 		{
 			Process(text, false, true, false, matches);
@@ -19635,6 +22029,118 @@ Regex
 			Process(text, keepEmptyMatch, true, true, matches);
 		}
 
+/***********************************************************************
+RegexCursor
+***********************************************************************/
+
+		RegexCursor::RegexCursor(const Regex& _regex)
+			:regex(_regex)
+			,begin(nullptr)
+			,end(nullptr)
+			,reading(nullptr)
+			,richResult(nullptr)
+			,richContext(nullptr)
+		{
+			if(regex.rich)
+			{
+				richResult=new RichResult;
+				richContext=new RichMatchContext;
+			}
+		}
+
+		RegexCursor::RegexCursor(const Regex& _regex, const wchar_t* _begin, const wchar_t* _end)
+			:RegexCursor(_regex)
+		{
+			Reset(_begin, _end);
+		}
+
+		RegexCursor::RegexCursor(const Regex& _regex, const WString& text)
+			:RegexCursor(_regex)
+		{
+			Reset(text);
+		}
+
+		RegexCursor::~RegexCursor()
+		{
+			if(richResult)delete richResult;
+			if(richContext)delete richContext;
+		}
+
+		void RegexCursor::Reset(const wchar_t* _begin, const wchar_t* _end)
+		{
+			begin=_begin;
+			end=_end;
+			reading=_begin;
+			match=RegexSpan();
+			if(richResult)
+			{
+				richResult->captures.Clear();
+			}
+		}
+
+		void RegexCursor::Reset(const WString& text)
+		{
+			Reset(text.Buffer(), text.Buffer()+text.Length());
+		}
+
+		bool RegexCursor::Next()
+		{
+			if(reading<end)
+			{
+				bool found=false;
+				if(regex.rich)
+				{
+					found=regex.rich->Match(reading, begin, *richResult, end, richContext);
+					match.start=richResult->start;
+					match.length=richResult->length;
+				}
+				else
+				{
+					PureResult result;
+					found=regex.pure->Match(reading, begin, result, end);
+					match.start=result.start;
+					match.length=result.length;
+				}
+
+				if(found)
+				{
+					// step over an empty match to make sure the enumeration terminates
+					reading=begin+match.start+(match.length==0?1:match.length);
+					return true;
+				}
+			}
+			reading=end;
+			match=RegexSpan();
+			return false;
+		}
+
+		const RegexSpan& RegexCursor::GetMatch()const
+		{
+			return match;
+		}
+
+		vint RegexCursor::GetCaptureCount()const
+		{
+			return richResult?richResult->captures.Count():0;
+		}
+
+		RegexSpan RegexCursor::GetCapture(vint index)const
+		{
+			CHECK_ERROR(0<=index && index<GetCaptureCount(), L"RegexCursor::GetCapture(vint)#Argument index not in range.");
+			const CaptureRecord& record=richResult->captures[index];
+			RegexSpan span;
+			span.capture=record.capture;
+			span.start=record.start;
+			span.length=record.length;
+			return span;
+		}
+
+		const WString& RegexCursor::GetCaptureName(vint capture)const
+		{
+			CHECK_ERROR(regex.rich, L"RegexCursor::GetCaptureName(vint)#The regular expression does not have named groups.");
+			return regex.rich->CaptureNames()[capture];
+		}
+
 /***********************************************************************
 RegexTokens
 ***********************************************************************/
@@ -20014,6 +22520,26 @@ RegexLexerColorizer
 
 			while(index<length)
 			{
+				if(currentState!=-1)
+				{
+					//状态转换成功时不会产生记号的边界，因此一次性执行所有成功的转换，只保留最后一个终结状态
+					vint finalLength=-1;
+					vint lastFinalState=-1;
+					vint consumed=walker.pure->Run(input+index, length-index, currentState, finalLength, lastFinalState);
+					if(consumed>0)
+					{
+						if(finalLength!=-1)
+						{
+							stop=index+finalLength;
+							state=lastFinalState;
+							token=walker.stateTokens.Get(lastFinalState);
+						}
+						index+=consumed;
+						finalState=walker.pure->IsFinalState(currentState);
+						continue;
+					}
+				}
+
 				currentToken=-1;
 				finalState=false;
 				previousTokenStop=false;
@@ -22279,38 +24805,25 @@ PureInterpretor
 ***********************************************************************/
 
 		PureInterpretor::PureInterpretor(Automaton::Ref dfa, CharRange::List& subsets)
-			:transition(0)
+			:charPages(0)
+			,transition16(0)
+			,transition32(0)
+			,asciiLoops(0)
 			,finalState(0)
 			,relatedFinalState(0)
 		{
 			stateCount=dfa->states.Count();
-			charSetCount=subsets.Count()+1;
 			startState=dfa->states.IndexOf(dfa->startState);
 
-			//填充字符映射表
-			for(vint i=0;i<SupportedCharCount;i++)
+			//构造未压缩的状态转换表，每个字符集一列，最后一列表示不属于任何字符集的字符
+			vint subsetCount=subsets.Count()+1;
+			Array<vint> columns(subsetCount*stateCount);
+			for(vint i=0;i<columns.Count();i++)
 			{
-				charMap[i]=charSetCount-1;
-			}
-			for(vint i=0;i<subsets.Count();i++)
-			{
-				CharRange range=subsets[i];
-				for(vint j=range.begin;j<=range.end;j++)
-				{
-					charMap[j]=i;
-				}
+				columns[i]=-1;
 			}
-			
-			//构造状态转换表
-			transition=new vint*[stateCount];
 			for(vint i=0;i<stateCount;i++)
 			{
-				transition[i]=new vint[charSetCount];
-				for(vint j=0;j<charSetCount;j++)
-				{
-					transition[i][j]=-1;
-				}
-
 				State* state=dfa->states[i].Obj();
 				for(vint j=0;j<state->transitions.Count();j++)
 				{
@@ -22324,7 +24837,7 @@ PureInterpretor
 							{
 								CHECK_ERROR(false, L"PureInterpretor::PureInterpretor(Automaton::Ref, CharRange::List&)#Specified chars don't appear in the normalized char ranges.");
 							}
-							transition[i][index]=dfa->states.IndexOf(dfaTransition->target);
+							columns[index*stateCount+i]=dfa->states.IndexOf(dfaTransition->target);
 						}
 						break;
 					default:
@@ -22333,6 +24846,154 @@ PureInterpretor
 				}
 			}
 
+			//合并状态转换完全相同的字符集
+			Array<vint> subsetMap(subsetCount);
+			List<vint> representatives;
+			{
+				Group<vuint64_t, vint> hashes;
+				for(vint i=0;i<subsetCount;i++)
+				{
+					const vint* column=&columns[i*stateCount];
+					vuint64_t hash=0;
+					for(vint j=0;j<stateCount;j++)
+					{
+						hash=hash*31+(vuint64_t)column[j];
+					}
+
+					subsetMap[i]=-1;
+					vint index=hashes.Keys().IndexOf(hash);
+					if(index!=-1)
+					{
+						FOREACH(vint, representative, hashes.GetByIndex(index))
+						{
+							if(memcmp(column, &columns[representatives[representative]*stateCount], sizeof(vint)*stateCount)==0)
+							{
+								subsetMap[i]=representative;
+								break;
+							}
+						}
+					}
+					if(subsetMap[i]==-1)
+					{
+						subsetMap[i]=representatives.Count();
+						hashes.Add(hash, representatives.Count());
+						representatives.Add(i);
+					}
+				}
+			}
+			charSetCount=representatives.Count();
+			CHECK_ERROR(charSetCount<=0xFFFF, L"PureInterpretor::PureInterpretor(Automaton::Ref, CharRange::List&)#Too many char sets.");
+
+			//逐页填充字符映射表，内容相同的页只保存一份，不需要构造整个字符集大小的临时映射表
+			{
+				Array<vint> pageMap(CharPageCount);
+				List<vuint16_t> distinctPages;
+				Group<vuint64_t, vint> hashes;
+				vuint16_t page[CharPageSize];
+				vint nextSubset=0;
+				for(vint i=0;i<CharPageCount;i++)
+				{
+					vint pageBegin=i*CharPageSize;
+					vint pageEnd=pageBegin+CharPageSize-1;
+					for(vint j=0;j<CharPageSize;j++)
+					{
+						page[j]=(vuint16_t)subsetMap[subsetCount-1];
+					}
+					//subsets是排好序且不重叠的，跨页的字符集在下一页仍然从同一个位置开始找
+					while(nextSubset<subsets.Count() && subsets[nextSubset].end<pageBegin)
+					{
+						nextSubset++;
+					}
+					for(vint j=nextSubset;j<subsets.Count() && subsets[j].begin<=pageEnd;j++)
+					{
+						CharRange range=subsets[j];
+						vint begin=range.begin<pageBegin?pageBegin:range.begin;
+						vint end=range.end>pageEnd?pageEnd:range.end;
+						for(vint k=begin;k<=end;k++)
+						{
+							page[k-pageBegin]=(vuint16_t)subsetMap[j];
+						}
+					}
+
+					vuint64_t hash=0;
+					for(vint j=0;j<CharPageSize;j++)
+					{
+						hash=hash*31+page[j];
+					}
+
+					pageMap[i]=-1;
+					vint index=hashes.Keys().IndexOf(hash);
+					if(index!=-1)
+					{
+						FOREACH(vint, distinctPage, hashes.GetByIndex(index))
+						{
+							if(memcmp(page, &distinctPages[distinctPage*CharPageSize], sizeof(vuint16_t)*CharPageSize)==0)
+							{
+								pageMap[i]=distinctPage;
+								break;
+							}
+						}
+					}
+					if(pageMap[i]==-1)
+					{
+						vint distinctPage=distinctPages.Count()/CharPageSize;
+						pageMap[i]=distinctPage;
+						hashes.Add(hash, distinctPage);
+						for(vint j=0;j<CharPageSize;j++)
+						{
+							distinctPages.Add(page[j]);
+						}
+					}
+				}
+
+				charPages=new vuint16_t[distinctPages.Count()];
+				memcpy(charPages, &distinctPages[0], sizeof(vuint16_t)*distinctPages.Count());
+				for(vint i=0;i<CharPageCount;i++)
+				{
+					charMap[i]=&charPages[pageMap[i]*CharPageSize];
+				}
+			}
+			
+			//构造压缩的状态转换表，状态数量允许的时候使用16位的状态
+			if(stateCount<0xFFFF)
+			{
+				transition16=new vuint16_t[stateCount*charSetCount];
+			}
+			else
+			{
+				transition32=new vuint32_t[stateCount*charSetCount];
+			}
+			for(vint i=0;i<stateCount;i++)
+			{
+				for(vint j=0;j<charSetCount;j++)
+				{
+					vint target=columns[representatives[j]*stateCount+i];
+					if(transition16)
+					{
+						transition16[i*charSetCount+j]=(vuint16_t)target;
+					}
+					else
+					{
+						transition32[i*charSetCount+j]=(vuint32_t)target;
+					}
+				}
+			}
+
+			//记录保持状态不变的ASCII字符，'\0'总是结束匹配因此不包括在内
+			asciiLoops=new vuint64_t[stateCount*2];
+			for(vint i=0;i<stateCount;i++)
+			{
+				asciiLoops[i*2]=0;
+				asciiLoops[i*2+1]=0;
+				for(vint j=1;j<128;j++)
+				{
+					if(GetTransition(i, GetCharSetIndex((wchar_t)j))==i)
+					{
+						asciiLoops[i*2+j/64]|=(vuint64_t)1<<(j%64);
+					}
+				}
+			}
+
 			//填充终结状态表
 			finalState=new bool[stateCount];
 			for(vint i=0;i<stateCount;i++)
@@ -22345,14 +25006,34 @@ PureInterpretor
 		{
 			if(relatedFinalState) delete[] relatedFinalState;
 			delete[] finalState;
-			for(vint i=0;i<stateCount;i++)
+			delete[] asciiLoops;
+			if(transition16) delete[] transition16;
+			if(transition32) delete[] transition32;
+			delete[] charPages;
+		}
+
+		vint PureInterpretor::GetCharSetIndex(wchar_t input)
+		{
+			vuint32_t c=(vuint32_t)input;
+			return charMap[c/(vuint32_t)CharPageSize][c%(vuint32_t)CharPageSize];
+		}
+
+		vint PureInterpretor::GetTransition(vint state, vint charSetIndex)
+		{
+			if(transition16)
+			{
+				vuint16_t nextState=transition16[state*charSetCount+charSetIndex];
+				return nextState==(vuint16_t)-1?-1:nextState;
+			}
+			else
 			{
-				delete[] transition[i];
+				vuint32_t nextState=transition32[state*charSetCount+charSetIndex];
+				return nextState==(vuint32_t)-1?-1:nextState;
 			}
-			delete[] transition;
 		}
 
-		bool PureInterpretor::MatchHead(const wchar_t* input, const wchar_t* start, PureResult& result)
+		template<typename TState>
+		bool PureInterpretor::MatchHeadInternal(const TState* transition, const wchar_t* input, const wchar_t* start, PureResult& result, const wchar_t* end)
 		{
 			result.start=input-start;
 			result.length=-1;
@@ -22363,7 +25044,7 @@ PureInterpretor
 			vint terminateState=-1;
 			vint terminateLength=-1;
 			const wchar_t* read=input;
-			while(currentState!=-1)
+			while(true)
 			{
 				terminateState=currentState;
 				terminateLength=read-input;
@@ -22372,12 +25053,24 @@ PureInterpretor
 					result.length=terminateLength;
 					result.finalState=currentState;
 				}
-				if(!*read)break;
+				if(read==end || !*read)break;
 #ifdef VCZH_GCC
 				if(*read>=SupportedCharCount)break;
 #endif
-				vint charIndex=charMap[*read++];
-				currentState=transition[currentState][charIndex];
+				TState nextState=transition[currentState*charSetCount+GetCharSetIndex(*read++)];
+				if(nextState==(TState)-1)break;
+				if(nextState==currentState)
+				{
+					//跳过保持状态不变的ASCII字符，例如标识符、空白和注释
+					const vuint64_t* loops=asciiLoops+currentState*2;
+					while(read!=end)
+					{
+						vuint32_t c=(vuint32_t)*read;
+						if(c>=128 || !(loops[c/64]&((vuint64_t)1<<(c%64))))break;
+						read++;
+					}
+				}
+				currentState=nextState;
 			}
 
 			if(result.finalState==-1)
@@ -22395,12 +25088,24 @@ PureInterpretor
 			}
 		}
 
-		bool PureInterpretor::Match(const wchar_t* input, const wchar_t* start, PureResult& result)
+		bool PureInterpretor::MatchHead(const wchar_t* input, const wchar_t* start, PureResult& result, const wchar_t* end)
+		{
+			if(transition16)
+			{
+				return MatchHeadInternal(transition16, input, start, result, end);
+			}
+			else
+			{
+				return MatchHeadInternal(transition32, input, start, result, end);
+			}
+		}
+
+		bool PureInterpretor::Match(const wchar_t* input, const wchar_t* start, PureResult& result, const wchar_t* end)
 		{
 			const wchar_t* read=input;
-			while(*read)
+			while(read!=end && *read)
 			{
-				if(MatchHead(read, start, result))
+				if(MatchHead(read, start, result, end))
 				{
 					return true;
 				}
@@ -22418,9 +25123,10 @@ PureInterpretor
 		{
 			if(0<=state && state<stateCount)
 			{
-				vint charIndex=charMap[input];
-				vint nextState=transition[state][charIndex];
-				return nextState;
+#ifdef VCZH_GCC
+				if(input>=SupportedCharCount) return -1;
+#endif
+				return GetTransition(state, GetCharSetIndex(input));
 			}
 			else
 			{
@@ -22428,6 +25134,56 @@ PureInterpretor
 			}
 		}
 
+		template<typename TState>
+		vint PureInterpretor::RunInternal(const TState* transition, const wchar_t* input, vint length, vint& state, vint& finalLength, vint& lastFinalState)
+		{
+			vint currentState=state;
+			vint index=0;
+			while(index<length)
+			{
+#ifdef VCZH_GCC
+				if(input[index]>=SupportedCharCount)break;
+#endif
+				TState nextState=transition[currentState*charSetCount+GetCharSetIndex(input[index])];
+				if(nextState==(TState)-1)break;
+				index++;
+				if(nextState==currentState)
+				{
+					//跳过保持状态不变的ASCII字符，例如标识符、空白和注释
+					const vuint64_t* loops=asciiLoops+currentState*2;
+					while(index<length)
+					{
+						vuint32_t c=(vuint32_t)input[index];
+						if(c>=128 || !(loops[c/64]&((vuint64_t)1<<(c%64))))break;
+						index++;
+					}
+				}
+				currentState=nextState;
+				if(finalState[currentState])
+				{
+					finalLength=index;
+					lastFinalState=currentState;
+				}
+			}
+			state=currentState;
+			return index;
+		}
+
+		vint PureInterpretor::Run(const wchar_t* input, vint length, vint& state, vint& finalLength, vint& lastFinalState)
+		{
+			finalLength=-1;
+			lastFinalState=-1;
+			if(state<0 || state>=stateCount) return 0;
+			if(transition16)
+			{
+				return RunInternal(transition16, input, length, state, finalLength, lastFinalState);
+			}
+			else
+			{
+				return RunInternal(transition32, input, length, state, finalLength, lastFinalState);
+			}
+		}
+
 		bool PureInterpretor::IsFinalState(vint state)
 		{
 			return 0<=state && state<stateCount && finalState[state];
@@ -22438,7 +25194,7 @@ PureInterpretor
 			if(state==-1) return true;
 			for(vint i=0;i<charSetCount;i++)
 			{
-				if(transition[state][i]!=-1)
+				if(GetTransition(state, i)!=-1)
 				{
 					return false;
 				}
@@ -22465,7 +25221,7 @@ PureInterpretor
 							vint state=-1;
 							for(vint j=0;j<charSetCount;j++)
 							{
-								vint nextState=transition[i][j];
+								vint nextState=GetTransition(i, j);
 								if(nextState!=-1)
 								{
 									state=relatedFinalState[nextState];
@@ -22507,62 +25263,6 @@ namespace vl
 	{
 		using namespace collections;
 
-/***********************************************************************
-回溯辅助数据结构
-***********************************************************************/
-
-		class SaverBase
-		{
-		public:
-			bool					available;
-			vint					previous;
-		};
-
-		class StateSaver
-		{
-		public:
-			enum StateStoreType
-			{
-				Positive,
-				Negative,
-				Other
-			};
-
-			const wchar_t*			reading;					//当前字符串位置
-			State*					currentState;				//当前状态
-			vint					minTransition;				//最小可用转换
-			vint					captureCount;				//有效capture数量
-			vint					stateSaverCount;			//有效回溯状态数量
-			vint					extensionSaverAvailable;	//有效未封闭扩展功能数量
-			vint					extensionSaverCount;		//所有未封闭扩展功能数量
-			StateStoreType			storeType;					//保存状态的原因
-
-			bool operator==(const StateSaver& saver)const
-			{
-				return
-					reading==saver.reading &&
-					currentState==saver.currentState &&
-					minTransition==saver.minTransition &&
-					captureCount==saver.captureCount;
-			}
-		};
-
-		class ExtensionSaver : public SaverBase
-		{
-		public:
-			vint					captureListIndex;
-			Transition*				transition;
-			const wchar_t*			reading;
-
-			bool operator==(const ExtensionSaver& saver)const
-			{
-				return
-					captureListIndex==saver.captureListIndex &&
-					transition==saver.transition &&
-					reading==saver.reading;
-			}
-		};
-
 		template<typename T, typename K>
 		void Push(List<T, K>& elements, vint& available, vint& count, const T& element)
 		{
@@ -22608,18 +25308,6 @@ namespace vl
 		}
 	}
 
-	template<>
-	struct POD<regex_internal::StateSaver>
-	{
-		static const bool Result=true;
-	};
-
-	template<>
-	struct POD<regex_internal::ExtensionSaver>
-	{
-		static const bool Result=true;
-	};
-
 	namespace regex_internal
 	{
 /***********************************************************************
@@ -22672,10 +25360,15 @@ RichInterpretor
 			delete[] datas;
 		}
 
-		bool RichInterpretor::MatchHead(const wchar_t* input, const wchar_t* start, RichResult& result)
+		bool RichInterpretor::MatchHead(const wchar_t* input, const wchar_t* start, RichResult& result, const wchar_t* end, RichMatchContext* context)
 		{
-			List<StateSaver> stateSavers;
-			List<ExtensionSaver> extensionSavers;
+			RichMatchContext temporaryContext;
+			if(!context)
+			{
+				context=&temporaryContext;
+			}
+			List<StateSaver>& stateSavers=context->stateSavers;
+			List<ExtensionSaver>& extensionSavers=context->extensionSavers;
 
 			StateSaver currentState;
 			currentState.captureCount=0;
@@ -22701,6 +25394,7 @@ RichInterpretor
 						{
 							CharRange range=transition->range;
 							found=
+								currentState.reading!=end &&
 								range.begin<=*currentState.reading && 
 								range.end>=*currentState.reading;
 							if(found)
@@ -22716,7 +25410,7 @@ RichInterpretor
 						break;
 					case Transition::EndString:
 						{
-							found=*currentState.reading==L'\0';
+							found=currentState.reading==end || *currentState.reading==L'\0';
 						}
 						break;
 					case Transition::Nop:
@@ -22751,7 +25445,7 @@ RichInterpretor
 								{
 									if(capture.length!=-1 && (transition->index==-1 || transition->index==index))
 									{
-										if(wcsncmp(start+capture.start, currentState.reading, capture.length)==0)
+										if((!end || end-currentState.reading>=capture.length) && wcsncmp(start+capture.start, currentState.reading, capture.length)==0)
 										{
 											currentState.reading+=capture.length;
 											found=true;
@@ -22911,12 +25605,17 @@ RichInterpretor
 			}
 		}
 
-		bool RichInterpretor::Match(const wchar_t* input, const wchar_t* start, RichResult& result)
+		bool RichInterpretor::Match(const wchar_t* input, const wchar_t* start, RichResult& result, const wchar_t* end, RichMatchContext* context)
 		{
+			RichMatchContext temporaryContext;
+			if(!context)
+			{
+				context=&temporaryContext;
+			}
 			const wchar_t* read=input;
-			while(*read)
+			while(read!=end && *read)
 			{
-				if(MatchHead(read, start, result))
+				if(MatchHead(read, start, result, end, context))
 				{
 					return true;
 				}
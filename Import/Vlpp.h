@@ -3251,6 +3251,25 @@ List
 				return Insert(this->count, item);
 			}
 
+			/// <summary>Move an item to the end of the list.</summary>
+			/// <returns>The index of the added item.</returns>
+			/// <param name="item">The item to add.</param>
+			vint Add(T&& item)
+			{
+				bool uninitialized = false;
+				vint index = this->count;
+				this->MakeRoom(index, 1, uninitialized);
+				if (uninitialized)
+				{
+					new(&this->ItemOf(index))T(MoveValue(item));
+				}
+				else
+				{
+					this->ItemOf(index) = MoveValue(item);
+				}
+				return index;
+			}
+
 			/// <summary>Add an item at the specified position.</summary>
 			/// <returns>The index of the added item.</returns>
 			/// <param name="index">The position of the item to add.</param>
@@ -6591,6 +6610,8 @@ Classes:
 	RegexString						：字符串匹配结果
 	RegexMatch						：匹配结果
 	Regex							：正则表达式引擎
+	RegexSpan						：不复制字符串的匹配位置
+	RegexCursor						：逐个枚举匹配结果
 	RegexToken						：词法记号
 	RegexTokens						：词法记号表
 	RegexLexer						：词法分析器
@@ -6608,6 +6629,7 @@ namespace vl
 		class PureInterpretor;
 		class RichResult;
 		class RichInterpretor;
+		class RichMatchContext;
 	}
 
 	namespace regex
@@ -6730,6 +6752,7 @@ namespace vl
 		/// ]]></summary>
 		class Regex : public Object, private NotCopyable
 		{
+			friend class RegexCursor;
 		protected:
 			regex_internal::PureInterpretor*			pure;
 			regex_internal::RichInterpretor*			rich;
@@ -6765,6 +6788,16 @@ namespace vl
 			/// <returns>Returns true if succeeded.</returns>
 			/// <param name="text">The text to match.</param>
 			bool										Test(const WString& text)const;
+			/// <summary>Match a prefix of a range of characters, ignoring all capturing requirements. The range does not need to be zero terminated.</summary>
+			/// <returns>Returns true if succeeded.</returns>
+			/// <param name="begin">The first character to match.</param>
+			/// <param name="end">The position after the last character to match.</param>
+			bool										TestHead(const wchar_t* begin, const wchar_t* end)const;
+			/// <summary>Match a fragment of a range of characters, ignoring all capturing requirements. The range does not need to be zero terminated.</summary>
+			/// <returns>Returns true if succeeded.</returns>
+			/// <param name="begin">The first character to match.</param>
+			/// <param name="end">The position after the last character to match.</param>
+			bool										Test(const wchar_t* begin, const wchar_t* end)const;
 			/// <summary>Find all matched fragments of the text, returning all matched fragments.</summary>
 			/// <param name="text">The text to match.</param>
 			/// <param name="matches">All successful matches.</param>
@@ -6781,6 +6814,77 @@ namespace vl
 			void										Cut(const WString& text, bool keepEmptyMatch, RegexMatch::List& matches)const;
 		};
 
+		/// <summary>A fragment of the input represented only by its position. Unlike [T:vl.regex.RegexString], the text is not copied.</summary>
+		class RegexSpan
+		{
+		public:
+			/// <summary>The index of the named group in the regular expression, or -1 for the whole match or an unnamed capture.</summary>
+			vint										capture = -1;
+			/// <summary>Position of the first character, relative to the beginning of the input.</summary>
+			vint										start = -1;
+			/// <summary>Size of this fragment in characters.</summary>
+			vint										length = -1;
+		};
+
+		/// <summary>
+		/// Enumerate matches one by one in a text or a range of characters, reporting positions instead of creating a [T:vl.regex.RegexMatch] for each match.
+		/// The input is not copied and must be alive while the cursor is in use.
+		/// After an empty match, the next search starts one character later, so that the enumeration always terminates.
+		/// A cursor can be reset to another input, reusing all buffers it has already allocated.
+		/// </summary>
+		class RegexCursor : public Object, private NotCopyable
+		{
+		protected:
+			const Regex&								regex;
+			const wchar_t*								begin;
+			const wchar_t*								end;
+			const wchar_t*								reading;
+			RegexSpan									match;
+			regex_internal::RichResult*					richResult;
+			regex_internal::RichMatchContext*			richContext;
+
+		public:
+			/// <summary>Create a cursor with an empty input. Call [M:vl.regex.RegexCursor.Reset] before enumerating.</summary>
+			/// <param name="_regex">The regular expression to match.</param>
+			RegexCursor(const Regex& _regex);
+			/// <summary>Create a cursor on a range of characters.</summary>
+			/// <param name="_regex">The regular expression to match.</param>
+			/// <param name="_begin">The first character to match.</param>
+			/// <param name="_end">The position after the last character to match.</param>
+			RegexCursor(const Regex& _regex, const wchar_t* _begin, const wchar_t* _end);
+			/// <summary>Create a cursor on a text.</summary>
+			/// <param name="_regex">The regular expression to match.</param>
+			/// <param name="text">The text to match.</param>
+			RegexCursor(const Regex& _regex, const WString& text);
+			~RegexCursor();
+
+			/// <summary>Start over on a range of characters.</summary>
+			/// <param name="_begin">The first character to match.</param>
+			/// <param name="_end">The position after the last character to match.</param>
+			void										Reset(const wchar_t* _begin, const wchar_t* _end);
+			/// <summary>Start over on a text.</summary>
+			/// <param name="text">The text to match.</param>
+			void										Reset(const WString& text);
+			/// <summary>Find the next match.</summary>
+			/// <returns>Returns false if there is no more match.</returns>
+			bool										Next();
+
+			/// <summary>Get the last match.</summary>
+			/// <returns>The last match.</returns>
+			const RegexSpan&							GetMatch()const;
+			/// <summary>Get the number of captures in the last match. Captures are only available when [M:vl.regex.Regex.IsPureMatch] returns false.</summary>
+			/// <returns>The number of captures.</returns>
+			vint										GetCaptureCount()const;
+			/// <summary>Get a capture in the last match, in the order of where they appear in the regular expression.</summary>
+			/// <returns>The capture.</returns>
+			/// <param name="index">The index of the capture.</param>
+			RegexSpan									GetCapture(vint index)const;
+			/// <summary>Get the name of a named group.</summary>
+			/// <returns>The name of the group.</returns>
+			/// <param name="capture">The value of [F:vl.regex.RegexSpan.capture].</param>
+			const WString&								GetCaptureName(vint capture)const;
+		};
+
 /***********************************************************************
 正则表达式词法分析器
 ***********************************************************************/
@@ -6841,6 +6945,7 @@ namespace vl
 		class RegexLexerWalker : public Object
 		{
 			friend class RegexLexer;
+			friend class RegexLexerColorizer;
 		protected:
 			regex_internal::PureInterpretor*			pure;
 			const collections::Array<vint>&				stateTokens;
@@ -8243,6 +8348,9 @@ XML Representation for Code Generation:
 #ifndef VCZH_REFLECTION_GUITYPEDESCRIPTOR
 #define VCZH_REFLECTION_GUITYPEDESCRIPTOR
 
+#include <type_traits>
+#include <typeinfo>
+#include <atomic>
 
 namespace vl
 {
@@ -8761,10 +8869,29 @@ Value
 					BoxedValue,
 				};
 			protected:
+				// 16 bytes hold vint, double, enums, Color, Point and Size, but not Rect or Margin on 64-bit platforms
+				// a larger buffer makes every Value larger, including values that store objects
+				static const vint				InlineBufferSize = 2;
+
+				struct InlineType
+				{
+					const std::type_info*		typeInfo;
+					Ptr<IBoxedValue>			(*boxer)(const void* buffer);
+				};
+
+				template<typename T>
+				struct InlineTypeOf
+				{
+					static const InlineType		Instance;
+				};
+
 				ValueType						valueType;
 				DescriptableObject*				rawPtr;
 				Ptr<DescriptableObject>			sharedPtr;
 				Ptr<IBoxedValue>				boxedValue;
+				// a small value is stored in inlineBuffer until the non-const GetBoxedValue is called, inlineType identifies its type
+				const InlineType*				inlineType;
+				vuint64_t						inlineBuffer[InlineBufferSize];
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				ITypeDescriptor*				typeDescriptor;
 #endif
@@ -8774,10 +8901,24 @@ Value
 				Value(Ptr<IBoxedValue> value, ITypeDescriptor* associatedTypeDescriptor);
 
 				vint							Compare(const Value& a, const Value& b)const;
+
+				template<typename T>
+				static Ptr<IBoxedValue>			BoxInline(const void* buffer);
 			public:
+				/// <summary>Test if a type can be stored in a value without allocating a boxed value.</summary>
+				/// <typeparam name="T">The type to test.</typeparam>
+				template<typename T>
+				struct InlineStorage
+				{
+					/// <summary>Returns true if the type is trivially copyable and fits in the inline buffer.</summary>
+					static const bool Result = std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(vuint64_t) * InlineBufferSize && alignof(T) <= alignof(vuint64_t);
+				};
+
 				Value();
 				Value(const Value& value);
+				Value(Value&& value);
 				Value&							operator=(const Value& value);
+				Value&							operator=(Value&& value);
 				bool							operator==(const Value& value)const { return Compare(*this, value) == 0; }
 				bool							operator!=(const Value& value)const { return Compare(*this, value) != 0; }
 				bool							operator<(const Value& value)const { return Compare(*this, value)<0; }
@@ -8794,9 +8935,12 @@ Value
 				/// <summary>Get the stored shared pointer if possible.</summary>
 				/// <returns>The stored shared pointer. Returns null if failed.</returns>
 				Ptr<DescriptableObject>			GetSharedPtr()const;
-				/// <summary>Get the stored text if possible.</summary>
-				/// <returns>The stored text. Returns empty if failed.</returns>
+				/// <summary>Get the stored boxed value if possible. If the value is stored inline, a new boxed value holding a copy is returned, and changing it does not affect this value.</summary>
+				/// <returns>The stored boxed value. Returns null if failed.</returns>
 				Ptr<IBoxedValue>				GetBoxedValue()const;
+				/// <summary>Get the stored boxed value if possible. If the value is stored inline, it is moved into a boxed value owned by this value, so that changing the boxed value changes this value.</summary>
+				/// <returns>The stored boxed value. Returns null if failed.</returns>
+				Ptr<IBoxedValue>				GetBoxedValue();
 				/// <summary>Get the real type of the stored object.</summary>
 				/// <returns>The real type. Returns null if the value is null.</returns>
 
@@ -8821,6 +8965,38 @@ Value
 				/// <param name="value">The text to store.</param>
 				/// <param name="type">The type that you expect to interpret the text.</param>
 				static Value					From(Ptr<IBoxedValue> value, ITypeDescriptor* type);
+				/// <summary>Store a small value without allocating a boxed value. The boxed value is only created when <see cref="GetBoxedValue"/> is called.</summary>
+				/// <typeparam name="T">The type of the value, <see cref="InlineStorage`1"/> should be true for this type.</typeparam>
+				/// <returns>The boxed value.</returns>
+				/// <param name="value">The value to store.</param>
+				/// <param name="type">The type that you expect to interpret the value.</param>
+				template<typename T>
+				static Value					FromInline(const T& value, ITypeDescriptor* type)
+				{
+					static_assert(InlineStorage<T>::Result, "vl::reflection::description::Value::FromInline<T>(const T&, ITypeDescriptor*)#The type is not allowed to store inline.");
+					Value result;
+					result.valueType = BoxedValue;
+					result.inlineType = &InlineTypeOf<T>::Instance;
+					new(result.inlineBuffer)T(value);
+#ifndef VCZH_DEBUG_NO_REFLECTION
+					result.typeDescriptor = type;
+#endif
+					return result;
+				}
+				/// <summary>Get the stored small value if it is stored by <see cref="FromInline`1"/> using the same type and has not been converted to a boxed value.</summary>
+				/// <typeparam name="T">The type of the value.</typeparam>
+				/// <returns>The stored value. Returns null if failed.</returns>
+				template<typename T>
+				const T*						GetInlineValue()const
+				{
+					if (!inlineType) return nullptr;
+					// InlineTypeOf<T>::Instance is different in each module, so the type is compared in the same way as casting a boxed value
+					if (inlineType == &InlineTypeOf<T>::Instance || *inlineType->typeInfo == typeid(T))
+					{
+						return reinterpret_cast<const T*>(inlineBuffer);
+					}
+					return nullptr;
+				}
 
 #ifndef VCZH_DEBUG_NO_REFLECTION
 				static IMethodInfo*				SelectMethod(IMethodGroupInfo* methodGroup, collections::Array<Value>& arguments);
@@ -8915,6 +9091,43 @@ ValueType
 				virtual IBoxedValue::CompareResult	Compare(const Value& a, const Value& b) = 0;
 			};
 
+			template<typename T>
+			Ptr<IBoxedValue> Value::BoxInline(const void* buffer)
+			{
+				return new IValueType::TypedBox<T>(*reinterpret_cast<const T*>(buffer));
+			}
+
+			template<typename T>
+			const Value::InlineType Value::InlineTypeOf<T>::Instance = { &typeid(T), &Value::BoxInline<T> };
+
+			template<typename T, bool = Value::InlineStorage<T>::Result>
+			struct ValueInlineHelper
+			{
+				static Value Box(const T& object, ITypeDescriptor* typeDescriptor)
+				{
+					return Value::From(new IValueType::TypedBox<T>(object), typeDescriptor);
+				}
+
+				static const T* Unbox(const Value& value)
+				{
+					return nullptr;
+				}
+			};
+
+			template<typename T>
+			struct ValueInlineHelper<T, true>
+			{
+				static Value Box(const T& object, ITypeDescriptor* typeDescriptor)
+				{
+					return Value::FromInline<T>(object, typeDescriptor);
+				}
+
+				static const T* Unbox(const Value& value)
+				{
+					return value.GetInlineValue<T>();
+				}
+			};
+
 			class IEnumType : public virtual IDescriptable, public Description<IEnumType>
 			{
 			public:
@@ -9258,6 +9471,8 @@ ITypeManager
 			extern bool							DestroyGlobalTypeManager();
 			extern bool							ResetGlobalTypeManager();
 			extern ITypeDescriptor*				GetTypeDescriptor(const WString& name);
+			/// <summary>Increased whenever a type descriptor is added to or removed from the global type manager. Cached type descriptors are valid only when they are cached under the current version.</summary>
+			extern std::atomic<vint>			globalTypeDescriptorVersion;
 			extern bool							IsInterfaceType(ITypeDescriptor* typeDescriptor, bool& acceptProxy);
 			extern void							LogTypeManager(stream::TextWriter& writer);
 
@@ -9384,6 +9599,16 @@ Interface Implementation Proxy
 				virtual bool					Close() = 0;
 			};
 
+			/// <summary>Decides when a subscription re-evaluates after anything it observes is changed. Install an implementation by calling [M:vl.reflection.description.SubscriptionScheduler.SetScheduler].</summary>
+			class IValueSubscriptionScheduler : public virtual Interface
+			{
+			public:
+				/// <summary>Called when anything observed by a subscription is changed.</summary>
+				/// <returns>Returns true if the scheduler will call [M:vl.reflection.description.IValueSubscription.Update] later. Returns false to re-evaluate immediately.</returns>
+				/// <param name="subscription">The subscription to re-evaluate.</param>
+				virtual bool					Schedule(IValueSubscription* subscription) = 0;
+			};
+
 /***********************************************************************
 Interface Implementation Proxy (Implement)
 ***********************************************************************/
@@ -11129,10 +11354,36 @@ TypeInfo
 			{
 			};
 
+			template<typename T>
+			struct TypeInfoCache
+			{
+				static std::atomic<ITypeDescriptor*>	typeDescriptor;
+				static std::atomic<vint>				version;
+			};
+
+			template<typename T>
+			std::atomic<ITypeDescriptor*> TypeInfoCache<T>::typeDescriptor(nullptr);
+
+			template<typename T>
+			std::atomic<vint> TypeInfoCache<T>::version(0);
+
 			template<typename T>
 			ITypeDescriptor* GetTypeDescriptor()
 			{
-				return GetTypeDescriptor(TypeInfo<T>::content.typeName);
+				vint version = globalTypeDescriptorVersion;
+				if (TypeInfoCache<T>::version.load(std::memory_order_acquire) == version)
+				{
+					return TypeInfoCache<T>::typeDescriptor.load(std::memory_order_relaxed);
+				}
+
+				auto typeDescriptor = GetTypeDescriptor(TypeInfo<T>::content.typeName);
+				if (typeDescriptor && version == globalTypeDescriptorVersion)
+				{
+					// the version is published after the pointer, so a thread that sees the version also sees the pointer
+					TypeInfoCache<T>::typeDescriptor.store(typeDescriptor, std::memory_order_relaxed);
+					TypeInfoCache<T>::version.store(version, std::memory_order_release);
+				}
+				return typeDescriptor;
 			}
 
 /***********************************************************************
@@ -11271,6 +11522,22 @@ Predefined Libraries
 				static vint64_t		TruncI(double value)			{ return (vint64_t)trunc(value); }
 			};
 
+			/// <summary>Entry for bind expressions to defer re-evaluations. Without an installed scheduler, a bind expression re-evaluates immediately.</summary>
+			class SubscriptionScheduler : public Description<SubscriptionScheduler>
+			{
+			public:
+				/// <summary>Get the installed scheduler.</summary>
+				/// <returns>The installed scheduler.</returns>
+				static IValueSubscriptionScheduler*		GetScheduler();
+				/// <summary>Install a scheduler.</summary>
+				/// <param name="scheduler">The scheduler. Set to null to re-evaluate bind expressions immediately.</param>
+				static void								SetScheduler(IValueSubscriptionScheduler* scheduler);
+				/// <summary>Called by bind expressions when anything they observe is changed.</summary>
+				/// <returns>Returns true if the re-evaluation is deferred.</returns>
+				/// <param name="subscription">The subscription to re-evaluate.</param>
+				static bool								Schedule(IValueSubscription* subscription);
+			};
+
 /***********************************************************************
 Predefined Types
 ***********************************************************************/
@@ -11281,6 +11548,7 @@ Predefined Types
 
 			DECL_TYPE_INFO(Sys)
 			DECL_TYPE_INFO(Math)
+			DECL_TYPE_INFO(SubscriptionScheduler)
 			
 			DECL_TYPE_INFO(void)
 			DECL_TYPE_INFO(VoidValue)
@@ -11400,6 +11668,8 @@ Interfaces:
 
 namespace vl
 {
+	class SpinLock;
+
 	namespace reflection
 	{
 		namespace description
@@ -11520,6 +11790,7 @@ MethodInfoImpl
 			class MethodInfoImpl : public Object, public IMethodInfo
 			{
 				friend class PropertyInfoImpl;
+				friend class MethodCallSiteCache;
 			protected:
 				IMethodGroupInfo*						ownerMethodGroup;
 				IPropertyInfo*							ownerProperty;
@@ -11569,6 +11840,54 @@ MethodGroupInfoImpl
 				bool									AddMethod(Ptr<IMethodInfo> _method);
 			};
 
+/***********************************************************************
+MethodCallSiteCache
+***********************************************************************/
+
+			/// <summary>A cache for a call site that invokes methods repeatedly. It remembers overload resolutions and argument checks by types of the this object and arguments, and skips them when the same types are seen again.</summary>
+			class MethodCallSiteCache : public Object, private NotCopyable
+			{
+			public:
+				static const vint						MaxArgumentCount = 4;
+				static const vint						MaxEntryCount = 4;
+
+			protected:
+				struct Entry
+				{
+					IMemberInfo*						member = nullptr;
+					IMethodInfo*						method = nullptr;
+					MethodInfoImpl*						methodImpl = nullptr;
+					ITypeDescriptor*					thisType = nullptr;
+					Value::ValueType					thisValueType = Value::Null;
+					vint								argumentCount = -1;
+					ITypeDescriptor*					argumentTypes[MaxArgumentCount];
+					Value::ValueType					argumentValueTypes[MaxArgumentCount];
+				};
+
+				Ptr<SpinLock>							lock;
+				Entry									entries[MaxEntryCount];
+				vint									nextEntry = 0;
+
+				bool									Find(IMemberInfo* member, const Value* thisObject, collections::Array<Value>& arguments, Entry& entry);
+				bool									Fill(IMemberInfo* member, IMethodInfo* method, const Value* thisObject, collections::Array<Value>& arguments, Entry& entry);
+				void									Remember(const Entry& entry);
+			public:
+				MethodCallSiteCache();
+				~MethodCallSiteCache();
+
+				/// <summary>Select a method in a method group that accepts the arguments, like [M:vl.reflection.description.Value.SelectMethod].</summary>
+				/// <returns>The selected method.</returns>
+				/// <param name="methodGroup">The method group.</param>
+				/// <param name="arguments">The arguments.</param>
+				IMethodInfo*							SelectMethod(IMethodGroupInfo* methodGroup, collections::Array<Value>& arguments);
+				/// <summary>Invoke a method, like [M:vl.reflection.description.IMethodInfo.Invoke]. Checking the this object and arguments is skipped if their types passed the check before.</summary>
+				/// <returns>The return value from the method.</returns>
+				/// <param name="method">The method.</param>
+				/// <param name="thisObject">The this object.</param>
+				/// <param name="arguments">The arguments.</param>
+				Value									Invoke(IMethodInfo* method, const Value& thisObject, collections::Array<Value>& arguments);
+			};
+
 /***********************************************************************
 EventInfoImpl
 ***********************************************************************/
@@ -12042,7 +12361,7 @@ TypeInfoRetriver Helper Functions (BoxValue, UnboxValue)
 			/// <param name="typeDescriptor">The type descriptor of the object (optional).</param>
 			/// <param name="valueName">The name of the object to provide a friendly exception message if the conversion is failed (optional).</param>
 			template<typename T>
-			T UnboxValue(const Value& value, ITypeDescriptor* typeDescriptor=0, const WString& valueName=L"value")
+			T UnboxValue(const Value& value, ITypeDescriptor* typeDescriptor=0, const WString& valueName=WString(L"value", false))
 			{
 				using Type = typename RemoveCVR<T>::Type;
 				return ValueAccessor<Type, TypeInfoRetriver<Type>::Decorator>::UnboxValue(value, typeDescriptor, valueName);
@@ -12075,7 +12394,7 @@ TypeInfoRetriver Helper Functions (UnboxParameter)
 			/// <param name="typeDescriptor">The type descriptor of the object (optional).</param>
 			/// <param name="valueName">The name of the object to provide a friendly exception message if the conversion is failed (optional).</param>
 			template<typename T>
-			void UnboxParameter(const Value& value, T& result, ITypeDescriptor* typeDescriptor=0, const WString& valueName=L"value")
+			void UnboxParameter(const Value& value, T& result, ITypeDescriptor* typeDescriptor=0, const WString& valueName=WString(L"value", false))
 			{
 				ParameterAccessor<T, TypeInfoRetriver<T>::TypeFlag>::UnboxParameter(value, result, typeDescriptor, valueName);
 			}
@@ -12343,6 +12662,10 @@ StructTypeDescriptor
 
 					Value GetValueInternal(const Value& thisObject)override
 					{
+						if (auto inlineValue = ValueInlineHelper<T>::Unbox(thisObject))
+						{
+							return BoxValue<TField>(inlineValue->*field);
+						}
 						auto structValue = thisObject.GetBoxedValue().Cast<IValueType::TypedBox<T>>();
 						if (!structValue)
 						{
@@ -13300,6 +13623,7 @@ namespace vl
 			static Nullable<T> Unbox(const reflection::description::Value& value)
 			{
 				if (value.IsNull()) return Nullable<T>();
+				if (auto inlineValue = reflection::description::ValueInlineHelper<T>::Unbox(value)) return Nullable<T>(*inlineValue);
 				auto boxed = value.GetBoxedValue().Cast<reflection::description::IValueType::TypedBox<T>>();
 				if (!boxed) return Nullable<T>();
 				return Nullable<T>(boxed->value);
@@ -14341,13 +14665,17 @@ ParameterAccessor<TStruct>
 					}
 #endif
 					using Type = typename vl::RemoveCVR<T>::Type;
-					return Value::From(new IValueType::TypedBox<Type>(object), typeDescriptor);
+					return ValueInlineHelper<Type>::Box(object, typeDescriptor);
 				}
 
 				static T UnboxValue(const Value& value, ITypeDescriptor* typeDescriptor, const WString& valueName)
 				{
 					using Type = typename vl::RemoveCVR<T>::Type;
-					if (auto unboxedValue = value.GetBoxedValue().Cast<IValueType::TypedBox<Type>>())
+					if (auto inlineValue = ValueInlineHelper<Type>::Unbox(value))
+					{
+						return *inlineValue;
+					}
+					else if (auto unboxedValue = value.GetBoxedValue().Cast<IValueType::TypedBox<Type>>())
 					{
 						return unboxedValue->value;
 					}
@@ -17601,6 +17929,7 @@ namespace vl
 		struct CriticalSectionData;
 		struct ReaderWriterLockData;
 		struct ConditionVariableData;
+		struct TaskGroupData;
 	}
 	
 	/// <summary>Base type of all synchronization objects.</summary>
@@ -17823,7 +18152,7 @@ namespace vl
 线程池
 ***********************************************************************/
 
-	/// <summary>A light-weight thread pool.</summary>
+	/// <summary>A light-weight thread pool. In Linux, tasks are executed by <see cref="TaskScheduler"/> with background priority.</summary>
 	class ThreadPoolLite : public Object
 	{
 	private:
@@ -18044,6 +18373,118 @@ namespace vl
 #define READER_LOCK(LOCK) SCOPE_VARIABLE(const ReaderWriterLock::ReaderScope&, scope, LOCK)
 #define WRITER_LOCK(LOCK) SCOPE_VARIABLE(const ReaderWriterLock::WriterScope&, scope, LOCK)
 
+/***********************************************************************
+Task Scheduler
+***********************************************************************/
+
+	/// <summary>A flag to cancel tasks. Queued tasks that have not been started when the token is cancelled will be skipped. Running tasks could check <see cref="IsCancelled"/> to stop early.</summary>
+	class CancellationToken : public Object, public NotCopyable
+	{
+	protected:
+		volatile vint								cancelled = 0;
+	public:
+		/// <summary>Cancel all tasks that share this token.</summary>
+		void										Cancel();
+		/// <summary>Test if the token is cancelled.</summary>
+		/// <returns>Returns true if the token is cancelled.</returns>
+		bool										IsCancelled();
+	};
+
+	class TaskGroup;
+
+	/// <summary>
+	/// A work-stealing thread pool with priorities.
+	/// Every worker thread owns a task queue for each priority. Tasks queued from a worker thread go to its own queue and are executed in LIFO order, tasks queued from other threads go to a shared queue and are executed in FIFO order. An idle worker steals tasks from other workers.
+	/// Tasks of <see cref="Interactive"/> priority are always picked before tasks of <see cref="Background"/> priority.
+	/// </summary>
+	class TaskScheduler : public Object
+	{
+	private:
+		TaskScheduler();
+		~TaskScheduler();
+	public:
+		/// <summary>Priority of a task.</summary>
+		enum Priority
+		{
+			/// <summary>Tasks that the user is waiting for, e.g. colorizing visible text.</summary>
+			Interactive,
+			/// <summary>Tasks that could be delayed.</summary>
+			Background,
+		};
+
+		/// <summary>Queue a function object.</summary>
+		/// <returns>Returns true if this operation succeeded. It fails when the scheduler is stopping, and the task will not be executed. Tasks queued by running tasks are still accepted when the scheduler is stopping without discarding pending tasks.</returns>
+		/// <param name="proc">The function object.</param>
+		/// <param name="priority">The priority of the task.</param>
+		/// <param name="token">The cancellation token. The task will be skipped if the token is cancelled before the task starts.</param>
+		/// <param name="group">The task group to join. The group should not be destroyed before the task finishes.</param>
+		static bool									Queue(const Func<void()>& proc, Priority priority = Background, Ptr<CancellationToken> token = nullptr, TaskGroup* group = nullptr);
+
+		/// <summary>Queue a lambda expression.</summary>
+		/// <returns>Returns true if this operation succeeded. It fails when the scheduler is stopping.</returns>
+		/// <typeparam name="T">The type of the lambda expression.</typeparam>
+		/// <param name="proc">The lambda expression.</param>
+		/// <param name="priority">The priority of the task.</param>
+		template<typename T>
+		static bool QueueLambda(const T& proc, Priority priority = Background)
+		{
+			return Queue(Func<void()>(proc), priority);
+		}
+
+		/// <summary>Set the number of worker threads. It only takes effect when worker threads are started, that is, before the first task is queued, or after <see cref="Stop"/>. The default value is 4 times the number of processors, the same as [T:vl.ThreadPoolLite] on Linux before it is built on this scheduler, because tasks may block.</summary>
+		/// <param name="count">The number of worker threads.</param>
+		static void									SetWorkerCount(vint count);
+		/// <summary>Get the number of worker threads.</summary>
+		/// <returns>The number of worker threads.</returns>
+		static vint									GetWorkerCount();
+		/// <summary>Test if the current thread is a worker thread of the scheduler.</summary>
+		/// <returns>Returns true if the current thread is a worker thread.</returns>
+		static bool									IsWorkerThread();
+		/// <summary>Wait for all queued tasks and stop all worker threads. Worker threads will be started again when a new task is queued.</summary>
+		/// <returns>Returns true if this operation succeeded.</returns>
+		/// <param name="discardPendingTasks">Set to true to skip all tasks that have not been started. Otherwise tasks queued by running tasks are also executed before this function returns.</param>
+		static bool									Stop(bool discardPendingTasks);
+	};
+
+	/// <summary>A group of tasks that could be cancelled and joined together. The destructor joins all tasks in the group.</summary>
+	class TaskGroup : public Object, public NotCopyable
+	{
+		friend class TaskScheduler;
+	private:
+		threading_internal::TaskGroupData*			internalData;
+	public:
+		/// <summary>Create a task group.</summary>
+		/// <param name="priority">The priority of all tasks in this group.</param>
+		TaskGroup(TaskScheduler::Priority priority = TaskScheduler::Background);
+		~TaskGroup();
+
+		/// <summary>Queue a function object in this group.</summary>
+		/// <returns>Returns true if this operation succeeded.</returns>
+		/// <param name="proc">The function object.</param>
+		bool										Run(const Func<void()>& proc);
+
+		/// <summary>Queue a lambda expression in this group.</summary>
+		/// <returns>Returns true if this operation succeeded.</returns>
+		/// <typeparam name="T">The type of the lambda expression.</typeparam>
+		/// <param name="proc">The lambda expression.</param>
+		template<typename T>
+		bool RunLambda(const T& proc)
+		{
+			return Run(Func<void()>(proc));
+		}
+
+		/// <summary>Cancel all tasks in this group that have not been started.</summary>
+		void										Cancel();
+		/// <summary>Test if this group is cancelled.</summary>
+		/// <returns>Returns true if this group is cancelled.</returns>
+		bool										IsCancelled();
+		/// <summary>Get the cancellation token shared by all tasks in this group.</summary>
+		/// <returns>The cancellation token.</returns>
+		Ptr<CancellationToken>						GetToken();
+		/// <summary>Wait until all tasks in this group finish. When it is called in a worker thread, the thread executes other queued tasks while waiting.</summary>
+		void										Join();
+	};
+
 /***********************************************************************
 Thread Local Storage
 
@@ -18284,6 +18725,118 @@ namespace vl
 			extern void						JsonUnescapeString(const WString& text, stream::TextWriter& writer);
 			extern void						JsonPrint(Ptr<JsonNode> node, stream::TextWriter& writer);
 			extern WString					JsonToString(Ptr<JsonNode> node);
+
+/***********************************************************************
+JsonWriter
+***********************************************************************/
+
+			/// <summary>A buffered JSON writer, which sends text to a <see cref="stream::TextWriter"/> in blocks. Commas and colons are written automatically, but the structure is not verified.</summary>
+			class JsonWriter : public Object, private NotCopyable
+			{
+			protected:
+				stream::TextWriter&				writer;
+				collections::Array<wchar_t>		buffer;
+				vint							used = 0;
+				bool							needComma = false;
+
+				void							Write(wchar_t c);
+				void							Write(const wchar_t* text, vint length);
+				void							WriteEscaped(const wchar_t* text, vint length);
+				void							BeginValue();
+			public:
+				/// <summary>Create a JSON writer.</summary>
+				/// <param name="_writer">The text writer to receive the text.</param>
+				/// <param name="bufferSize">The number of characters to buffer before sending them to the text writer.</param>
+				JsonWriter(stream::TextWriter& _writer, vint bufferSize = 65536);
+				/// <summary>Flush and destroy the JSON writer.</summary>
+				~JsonWriter();
+
+				/// <summary>Send all buffered characters to the text writer.</summary>
+				void							Flush();
+				/// <summary>Write the beginning of an object.</summary>
+				void							BeginObject();
+				/// <summary>Write the end of an object.</summary>
+				void							EndObject();
+				/// <summary>Write the name of a field. The value should be written right after the name.</summary>
+				/// <param name="name">The name, which will be escaped.</param>
+				void							Field(const WString& name);
+				/// <summary>Write the beginning of an array.</summary>
+				void							BeginArray();
+				/// <summary>Write the end of an array.</summary>
+				void							EndArray();
+				/// <summary>Write a string.</summary>
+				/// <param name="value">The string, which will be escaped.</param>
+				void							String(const WString& value);
+				/// <summary>Write a number.</summary>
+				/// <param name="text">The number, which is written as is.</param>
+				void							Number(const WString& text);
+				/// <summary>Write a literal.</summary>
+				/// <param name="value">The literal.</param>
+				void							Literal(JsonLiteral::JsonValue value);
+			};
+
+/***********************************************************************
+JsonRead
+***********************************************************************/
+
+			/// <summary>The maximum nesting level of objects and arrays accepted by <see cref="JsonRead"/> and the parser without a parsing table. Deeper inputs are rejected with an error.</summary>
+			const vint							JsonMaxNestingLevel = 512;
+
+			/// <summary>Callback for <see cref="JsonRead"/>. Pointers to strings are only valid during the call.</summary>
+			class IJsonReaderCallback : public virtual Interface
+			{
+			public:
+				/// <summary>Called at the beginning of an object.</summary>
+				/// <param name="range">The range of "{".</param>
+				virtual void					OnBeginObject(const ParsingTextRange& range) = 0;
+				/// <summary>Called at the end of an object.</summary>
+				/// <param name="range">The range of the whole object.</param>
+				virtual void					OnEndObject(const ParsingTextRange& range) = 0;
+				/// <summary>Called with the name of a field, before the value.</summary>
+				/// <param name="name">The unescaped name.</param>
+				/// <param name="length">The length of the name.</param>
+				/// <param name="range">The range of the name, including quotes.</param>
+				virtual void					OnField(const wchar_t* name, vint length, const ParsingTextRange& range) = 0;
+				/// <summary>Called at the beginning of an array.</summary>
+				/// <param name="range">The range of "[".</param>
+				virtual void					OnBeginArray(const ParsingTextRange& range) = 0;
+				/// <summary>Called at the end of an array.</summary>
+				/// <param name="range">The range of the whole array.</param>
+				virtual void					OnEndArray(const ParsingTextRange& range) = 0;
+				/// <summary>Called with a string.</summary>
+				/// <param name="value">The unescaped string.</param>
+				/// <param name="length">The length of the string.</param>
+				/// <param name="range">The range of the string, including quotes.</param>
+				virtual void					OnString(const wchar_t* value, vint length, const ParsingTextRange& range) = 0;
+				/// <summary>Called with a number. Use <see cref="JsonParseNumber"/> to get the value.</summary>
+				/// <param name="text">The text of the number.</param>
+				/// <param name="length">The length of the text.</param>
+				/// <param name="range">The range of the number.</param>
+				virtual void					OnNumber(const wchar_t* text, vint length, const ParsingTextRange& range) = 0;
+				/// <summary>Called with a literal.</summary>
+				/// <param name="value">The literal.</param>
+				/// <param name="range">The range of the literal.</param>
+				virtual void					OnLiteral(JsonLiteral::JsonValue value, const ParsingTextRange& range) = 0;
+			};
+
+			/// <summary>Parse a JSON text without building <see cref="JsonNode"/> objects.</summary>
+			/// <returns>Returns true if the text is parsed without errors. Callbacks are still called for values before the first error.</returns>
+			/// <param name="input">The JSON text. The root value must be an object or an array.</param>
+			/// <param name="callback">The callback to receive values.</param>
+			/// <param name="errors">All errors.</param>
+			/// <param name="codeIndex">The code index for all code ranges.</param>
+			extern bool						JsonRead(const WString& input, IJsonReaderCallback& callback, collections::List<Ptr<ParsingError>>& errors, vint codeIndex = -1);
+			/// <summary>Parse a JSON text using a hand-written recursive descent parser. The result is the same as the parser using the parsing table, except that creator rules are not filled, and objects and arrays could not be nested deeper than <see cref="JsonMaxNestingLevel"/>.</summary>
+			/// <returns>The root value. Returns null if there is any error.</returns>
+			/// <param name="input">The JSON text. The root value must be an object or an array.</param>
+			/// <param name="errors">All errors.</param>
+			/// <param name="codeIndex">The code index for all code ranges.</param>
+			extern Ptr<JsonNode>			JsonParse(const WString& input, collections::List<Ptr<ParsingError>>& errors, vint codeIndex = -1);
+			/// <summary>Convert the text of a JSON number to a double without creating a string.</summary>
+			/// <returns>The value.</returns>
+			/// <param name="text">The text of the number.</param>
+			/// <param name="length">The length of the text.</param>
+			extern double					JsonParseNumber(const wchar_t* text, vint length);
 		}
 	}
 }
@@ -18355,6 +18908,230 @@ namespace vl
 
 #endif
 
+/***********************************************************************
+PARSING\XML\PARSINGXML_READER.H
+***********************************************************************/
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+Parser::ParsingXml
+
+***********************************************************************/
+
+#ifndef VCZH_PARSING_XML_PARSINGXML_READER
+#define VCZH_PARSING_XML_PARSINGXML_READER
+
+
+namespace vl
+{
+	namespace parsing
+	{
+		namespace xml
+		{
+
+/***********************************************************************
+XmlNameTable
+***********************************************************************/
+
+			/// <summary>A string pool for names in XML documents. Equal names share the same string buffer.</summary>
+			class XmlNameTable : public Object, private NotCopyable
+			{
+			protected:
+				collections::Array<vint>				buckets;
+				collections::List<WString>				names;
+				collections::List<vuint32_t>			hashes;
+				collections::List<vint>					nexts;
+
+				static vuint32_t						Hash(const wchar_t* buffer, vint length);
+				void									Rehash(vint bucketCount);
+			public:
+				XmlNameTable();
+				~XmlNameTable();
+
+				/// <summary>Get the shared string for a name, the name is added to the pool if it does not exist.</summary>
+				/// <returns>The shared string.</returns>
+				/// <param name="buffer">The first character of the name.</param>
+				/// <param name="length">The length of the name.</param>
+				WString									Get(const wchar_t* buffer, vint length);
+				/// <summary>Get the number of different names in the pool.</summary>
+				/// <returns>The number of different names.</returns>
+				vint									Count();
+			};
+
+/***********************************************************************
+XmlReader
+***********************************************************************/
+
+			/// <summary>Type of the node that a <see cref="XmlReader"/> stops at.</summary>
+			enum class XmlReaderNodeType
+			{
+				/// <summary>Nothing has been read, or the reader reaches the end of the document or an error.</summary>
+				None,
+				/// <summary>An instruction like "&lt;?xml version=&quot;1.0&quot;?&gt;". The name and attributes are available.</summary>
+				Instruction,
+				/// <summary>The beginning of an element. The name and attributes are available.</summary>
+				ElementBegin,
+				/// <summary>The end of an element. It is also reported right after the beginning of an empty element.</summary>
+				ElementEnd,
+				/// <summary>A text. Blank texts between other nodes are skipped.</summary>
+				Text,
+				/// <summary>A CDATA section.</summary>
+				CData,
+				/// <summary>A comment.</summary>
+				Comment,
+			};
+
+			/// <summary>
+			/// A forward-only XML reader, which reads one node at a time without building a syntax tree.
+			/// The input could be a string or a UTF-8 stream, which is decoded block by block.
+			/// Names and short attribute values are shared using a <see cref="XmlNameTable"/>.
+			/// Positions in code ranges are counted in the same way as <see cref="XmlParseDocument"/> with a parsing table.
+			/// </summary>
+			class XmlReader : public Object, private NotCopyable
+			{
+			public:
+				/// <summary>An attribute in an element or an instruction.</summary>
+				struct Attribute
+				{
+					/// <summary>The name.</summary>
+					WString								name;
+					/// <summary>The unescaped value.</summary>
+					WString								value;
+					/// <summary>The range of the name.</summary>
+					ParsingTextRange					nameRange;
+					/// <summary>The range of the value, including quotes.</summary>
+					ParsingTextRange					valueRange;
+				};
+
+			protected:
+				stream::IStream*						stream = nullptr;
+				WString									input;
+				collections::Array<vuint8_t>			bytes;
+				vint									bytesBegin = 0;
+				vint									bytesEnd = 0;
+				collections::Array<wchar_t>				chars;
+				collections::Array<wchar_t>				unescaping;
+
+				const wchar_t*							buffer = nullptr;
+				vint									bufferLength = 0;
+				vint									reading = 0;
+				vint									keeping = 0;
+				ParsingTextPos							position;
+				ParsingTextPos							lastPosition;
+				vint									codeIndex;
+
+				Ptr<XmlNameTable>						nameTable;
+				collections::List<Ptr<ParsingError>>	errors;
+				collections::List<WString>				openedElements;
+				bool									rootElementRead = false;
+				bool									pendingElementEnd = false;
+
+				XmlReaderNodeType						nodeType = XmlReaderNodeType::None;
+				vint									depth = 0;
+				WString									name;
+				WString									value;
+				ParsingTextRange						range;
+				ParsingTextRange						nameRange;
+				bool									emptyElement = false;
+				collections::List<Attribute>			attributes;
+				vint									attributeCount = 0;
+
+				vint									DecodeStream(wchar_t* target, vint count);
+				bool									Fill(vint count);
+				wchar_t									Peek(vint offset);
+				void									Advance(vint count);
+				bool									Match(const wchar_t* text);
+				void									SkipSpaces();
+				void									ReportError(const ParsingTextPos& start, const WString& message);
+				WString									Unescape(const wchar_t* text, vint length, bool intern);
+				bool									ReadName(WString& _name, ParsingTextRange& _range);
+				bool									ReadAttributes();
+				bool									ReadElementBegin();
+				bool									ReadElementEnd();
+				bool									ReadInstruction();
+				bool									ReadDelimited(XmlReaderNodeType _nodeType, vint openingLength, const wchar_t* closing);
+				bool									ReadText(bool& blank);
+				void									Initialize();
+			public:
+				/// <summary>Create a reader on a UTF-8 stream. A BOM at the beginning is skipped.</summary>
+				/// <param name="_stream">The stream, which must be alive until the reader is destroyed.</param>
+				/// <param name="_codeIndex">The code index for all code ranges.</param>
+				/// <param name="_nameTable">The name pool. A new one is created if it is null. Readers could share a name pool if they are not used at the same time.</param>
+				XmlReader(stream::IStream& _stream, vint _codeIndex = -1, Ptr<XmlNameTable> _nameTable = nullptr);
+				/// <summary>Create a reader on a string.</summary>
+				/// <param name="_input">The string.</param>
+				/// <param name="_codeIndex">The code index for all code ranges.</param>
+				/// <param name="_nameTable">The name pool. A new one is created if it is null. Readers could share a name pool if they are not used at the same time.</param>
+				XmlReader(const WString& _input, vint _codeIndex = -1, Ptr<XmlNameTable> _nameTable = nullptr);
+				~XmlReader();
+
+				/// <summary>Read the next node.</summary>
+				/// <returns>Returns false if the reader reaches the end of the document or an error.</returns>
+				bool									Read();
+				/// <summary>Get all errors. The reader stops at the first error.</summary>
+				/// <returns>All errors.</returns>
+				collections::List<Ptr<ParsingError>>&	GetErrors();
+				/// <summary>Get the name pool.</summary>
+				/// <returns>The name pool.</returns>
+				Ptr<XmlNameTable>						GetNameTable();
+
+				/// <summary>Get the type of the current node.</summary>
+				/// <returns>The type of the current node.</returns>
+				XmlReaderNodeType						GetNodeType();
+				/// <summary>Get the number of elements containing the current node.</summary>
+				/// <returns>The number of elements containing the current node.</returns>
+				vint									GetDepth();
+				/// <summary>Get the name of the current instruction or element.</summary>
+				/// <returns>The name.</returns>
+				const WString&							GetName();
+				/// <summary>Get the unescaped content of the current text, CDATA section or comment.</summary>
+				/// <returns>The content.</returns>
+				const WString&							GetValue();
+				/// <summary>Get the range of the current node. For an element, it is the range of the beginning or the ending tag.</summary>
+				/// <returns>The range of the current node.</returns>
+				const ParsingTextRange&					GetRange();
+				/// <summary>Get the range of the name of the current instruction or element. It is empty for the ending of an empty element.</summary>
+				/// <returns>The range of the name.</returns>
+				const ParsingTextRange&					GetNameRange();
+				/// <summary>Test if the current element is an empty element like "&lt;name/&gt;".</summary>
+				/// <returns>Returns true if the current element is an empty element.</returns>
+				bool									IsEmptyElement();
+				/// <summary>Get the number of attributes in the current instruction or the beginning of the current element.</summary>
+				/// <returns>The number of attributes.</returns>
+				vint									GetAttributeCount();
+				/// <summary>Get an attribute in the current instruction or the beginning of the current element.</summary>
+				/// <returns>The attribute.</returns>
+				/// <param name="index">The index of the attribute.</param>
+				const Attribute&						GetAttribute(vint index);
+			};
+
+/***********************************************************************
+Document Loading
+***********************************************************************/
+
+			/// <summary>Build a document from the remaining nodes in a reader.</summary>
+			/// <returns>The document. Returns null if there is any error.</returns>
+			/// <param name="reader">The reader.</param>
+			/// <param name="errors">All errors.</param>
+			extern Ptr<XmlDocument>						XmlReadDocument(XmlReader& reader, collections::List<Ptr<ParsingError>>& errors);
+			/// <summary>Parse a UTF-8 stream to a document using <see cref="XmlReader"/>.</summary>
+			/// <returns>The document. Returns null if there is any error.</returns>
+			/// <param name="input">The stream.</param>
+			/// <param name="errors">All errors.</param>
+			/// <param name="codeIndex">The code index for all code ranges.</param>
+			extern Ptr<XmlDocument>						XmlParseDocument(stream::IStream& input, collections::List<Ptr<ParsingError>>& errors, vint codeIndex = -1);
+			/// <summary>Parse a string to a document using <see cref="XmlReader"/>.</summary>
+			/// <returns>The document. Returns null if there is any error.</returns>
+			/// <param name="input">The string.</param>
+			/// <param name="errors">All errors.</param>
+			/// <param name="codeIndex">The code index for all code ranges.</param>
+			extern Ptr<XmlDocument>						XmlParseDocument(const WString& input, collections::List<Ptr<ParsingError>>& errors, vint codeIndex = -1);
+		}
+	}
+}
+
+#endif
+
 /***********************************************************************
 REFLECTION\GUITYPEDESCRIPTORINTERFACEPROXIES.H
 ***********************************************************************/
@@ -18584,22 +19361,38 @@ namespace vl
 			static const vint	SupportedCharCount = 0x110000;		// UTF-32
 #endif
 
-			vint				charMap[SupportedCharCount];		// char -> char set index
-			vint**				transition;							// (state * char set index) -> state*
+			static const vint	CharPageSize = 0x100;
+			static const vint	CharPageCount = SupportedCharCount / CharPageSize;
+
+			vuint16_t*			charMap[CharPageCount];				// (char / CharPageSize) -> (char % CharPageSize) -> char set index, identical pages are shared
+			vuint16_t*			charPages;							// all distinct pages in charMap
+			vuint16_t*			transition16;						// (state * charSetCount + char set index) -> state, 0xFFFF means no transition, used when states fit in 16 bits
+			vuint32_t*			transition32;						// the same as transition16, used when there are too many states
+			vuint64_t*			asciiLoops;							// (state * 2 + char / 64) -> bit (char % 64) is set if this ASCII char keeps the state unchanged
 			bool*				finalState;							// state -> bool
 			vint*				relatedFinalState;					// sate -> (finalState or -1)
 			vint				stateCount;
-			vint				charSetCount;
+			vint				charSetCount;						// char sets with identical transitions are merged
 			vint				startState;
+
+			vint				GetCharSetIndex(wchar_t input);
+			vint				GetTransition(vint state, vint charSetIndex);
+			template<typename TState>
+			bool				MatchHeadInternal(const TState* transition, const wchar_t* input, const wchar_t* start, PureResult& result, const wchar_t* end);
+			template<typename TState>
+			vint				RunInternal(const TState* transition, const wchar_t* input, vint length, vint& state, vint& finalLength, vint& lastFinalState);
 		public:
 			PureInterpretor(Automaton::Ref dfa, CharRange::List& subsets);
 			~PureInterpretor();
 
-			bool				MatchHead(const wchar_t* input, const wchar_t* start, PureResult& result);
-			bool				Match(const wchar_t* input, const wchar_t* start, PureResult& result);
+			// end: the position after the last character, or null if the input is zero terminated
+			bool				MatchHead(const wchar_t* input, const wchar_t* start, PureResult& result, const wchar_t* end=nullptr);
+			bool				Match(const wchar_t* input, const wchar_t* start, PureResult& result, const wchar_t* end=nullptr);
 
 			vint				GetStartState();
 			vint				Transit(wchar_t input, vint state);
+			// transit from state until there is no transition, returns the number of consumed characters and the last final state reached
+			vint				Run(const wchar_t* input, vint length, vint& state, vint& finalLength, vint& lastFinalState);
 			bool				IsFinalState(vint state);
 			bool				IsDeadState(vint state);
 
@@ -18640,6 +19433,62 @@ namespace vl
 
 			bool								operator==(const CaptureRecord& record)const;
 		};
+
+/***********************************************************************
+回溯辅助数据结构
+***********************************************************************/
+
+		class SaverBase
+		{
+		public:
+			bool					available;
+			vint					previous;
+		};
+
+		class StateSaver
+		{
+		public:
+			enum StateStoreType
+			{
+				Positive,
+				Negative,
+				Other
+			};
+
+			const wchar_t*			reading;					//当前字符串位置
+			State*					currentState;				//当前状态
+			vint					minTransition;				//最小可用转换
+			vint					captureCount;				//有效capture数量
+			vint					stateSaverCount;			//有效回溯状态数量
+			vint					extensionSaverAvailable;	//有效未封闭扩展功能数量
+			vint					extensionSaverCount;		//所有未封闭扩展功能数量
+			StateStoreType			storeType;					//保存状态的原因
+
+			bool operator==(const StateSaver& saver)const
+			{
+				return
+					reading==saver.reading &&
+					currentState==saver.currentState &&
+					minTransition==saver.minTransition &&
+					captureCount==saver.captureCount;
+			}
+		};
+
+		class ExtensionSaver : public SaverBase
+		{
+		public:
+			vint					captureListIndex;
+			Transition*				transition;
+			const wchar_t*			reading;
+
+			bool operator==(const ExtensionSaver& saver)const
+			{
+				return
+					captureListIndex==saver.captureListIndex &&
+					transition==saver.transition &&
+					reading==saver.reading;
+			}
+		};
 	}
 
 	template<>
@@ -18648,8 +19497,27 @@ namespace vl
 		static const bool Result=true;
 	};
 
+	template<>
+	struct POD<regex_internal::StateSaver>
+	{
+		static const bool Result=true;
+	};
+
+	template<>
+	struct POD<regex_internal::ExtensionSaver>
+	{
+		static const bool Result=true;
+	};
+
 	namespace regex_internal
 	{
+		class RichMatchContext
+		{
+		public:
+			collections::List<StateSaver>		stateSavers;
+			collections::List<ExtensionSaver>	extensionSavers;
+		};
+
 		class RichResult
 		{
 		public:
@@ -18674,8 +19542,10 @@ namespace vl
 			RichInterpretor(Automaton::Ref _dfa);
 			~RichInterpretor();
 
-			bool								MatchHead(const wchar_t* input, const wchar_t* start, RichResult& result);
-			bool								Match(const wchar_t* input, const wchar_t* start, RichResult& result);
+			// end: the position after the last character, or null if the input is zero terminated
+			// context: backtracking buffers to reuse between calls, or null to use temporary ones
+			bool								MatchHead(const wchar_t* input, const wchar_t* start, RichResult& result, const wchar_t* end=nullptr, RichMatchContext* context=nullptr);
+			bool								Match(const wchar_t* input, const wchar_t* start, RichResult& result, const wchar_t* end=nullptr, RichMatchContext* context=nullptr);
 			const collections::List<WString>&	CaptureNames();
 		};
 	};
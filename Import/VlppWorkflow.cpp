@@ -25,7 +25,8 @@ WfRuntimeGlobalContext
 ***********************************************************************/
 
 			WfRuntimeGlobalContext::WfRuntimeGlobalContext(Ptr<WfAssembly> _assembly)
-				:assembly(_assembly)
+				:preparedFunctions(_assembly->functions.Count())
+				, assembly(_assembly)
 			{
 				globalVariables = new WfRuntimeVariableContext;
 				globalVariables->variables.Resize(assembly->variableNames.Count());
@@ -33,6 +34,63 @@ WfRuntimeGlobalContext
 				{
 					assembly->typeImpl->SetGlobalContext(this);
 				}
+
+				// instructions are decoded for each function when it is called for the first time
+				decodedInstructions.Resize(assembly->GetInstructionCount());
+				for (vint i = 0; i < preparedFunctions.Count(); i++)
+				{
+					preparedFunctions[i].store(false, std::memory_order_relaxed);
+				}
+			}
+
+			void WfRuntimeGlobalContext::PrepareFunction(vint functionIndex)
+			{
+				if (functionIndex < 0 || functionIndex >= preparedFunctions.Count())
+				{
+					return;
+				}
+
+				// it is called for every function call, so the lock is only taken before the function is prepared
+				if (preparedFunctions[functionIndex].load(std::memory_order_acquire))
+				{
+					return;
+				}
+
+				SPIN_LOCK(prepareLock)
+				{
+					if (!preparedFunctions[functionIndex].load(std::memory_order_relaxed))
+					{
+						assembly->LoadFunctionInstructions(functionIndex);
+						auto function = assembly->functions[functionIndex];
+						for (vint i = function->firstInstruction; i >= 0 && i <= function->lastInstruction && i < decodedInstructions.Count(); i++)
+						{
+							auto& ins = assembly->GetInstruction(i);
+							auto& decoded = decodedInstructions[i];
+							decoded.code = ins.code;
+							decoded.countParameter = ins.countParameter;
+							decoded.instruction = &ins;
+							switch (ins.code)
+							{
+							case WfInsCode::LoadLocalVar:
+							case WfInsCode::LoadCapturedVar:
+							case WfInsCode::LoadGlobalVar:
+							case WfInsCode::StoreLocalVar:
+							case WfInsCode::StoreCapturedVar:
+							case WfInsCode::StoreGlobalVar:
+							case WfInsCode::Jump:
+							case WfInsCode::JumpIf:
+								decoded.indexParameter = ins.indexParameter;
+								break;
+							case WfInsCode::InvokeMethod:
+								decoded.callSiteCache = new MethodCallSiteCache;
+								break;
+							default:;
+							}
+						}
+						// decoded instructions are visible to any thread that sees the flag
+						preparedFunctions[functionIndex].store(true, std::memory_order_release);
+					}
+				}
 			}
 
 			WfRuntimeGlobalContext::~WfRuntimeGlobalContext()
@@ -153,6 +211,7 @@ WfRuntimeCallStackInfo
 				{
 					return L"";
 				}
+				assembly->LoadDebugInfo();
 				const auto& range = assembly->insBeforeCodegen->instructionCodeMapping[instruction];
 				if (range.codeIndex == -1)
 				{
@@ -167,6 +226,7 @@ WfRuntimeCallStackInfo
 				{
 					return L"";
 				}
+				assembly->LoadDebugInfo();
 				const auto& range = assembly->insAfterCodegen->instructionCodeMapping[instruction];
 				if (range.codeIndex == -1)
 				{
@@ -181,6 +241,7 @@ WfRuntimeCallStackInfo
 				{
 					return -1;
 				}
+				assembly->LoadDebugInfo();
 				const auto& range = assembly->insBeforeCodegen->instructionCodeMapping[instruction];
 				return range.start.row;
 			}
@@ -191,6 +252,7 @@ WfRuntimeCallStackInfo
 				{
 					return -1;
 				}
+				assembly->LoadDebugInfo();
 				const auto& range = assembly->insAfterCodegen->instructionCodeMapping[instruction];
 				return range.start.row;
 			}
@@ -304,6 +366,8 @@ WfRuntimeThreadContext
 					}
 				}
 
+				globalContext->PrepareFunction(functionIndex);
+
 				WfRuntimeStackFrame frame;
 				frame.capturedVariables = capturedVariables;
 				frame.functionIndex = functionIndex;
@@ -398,7 +462,7 @@ WfRuntimeThreadContext
 					WfRuntimeStackFrame& frame = GetCurrentStackFrame();
 					if (stack.Count() <= frame.freeStackBase) return WfRuntimeThreadContextError::StackCorrupted;
 				}
-				value = stack[stack.Count() - 1];
+				value = MoveValue(stack[stack.Count() - 1]);
 				stack.RemoveAt(stack.Count() - 1);
 				return WfRuntimeThreadContextError::Success;
 			}
@@ -548,11 +612,15 @@ WfRuntimeThreadContext
 				{
 					callback->EnterThreadContext(this);
 				}
-				while (Execute(callback) != WfRuntimeExecutionAction::Nop);
 				if (callback)
 				{
+					while (Execute(callback) != WfRuntimeExecutionAction::Nop);
 					callback->LeaveThreadContext(this);
 				}
+				else
+				{
+					while (ExecuteFast() != WfRuntimeExecutionAction::Nop);
+				}
 			}
 		}
 	}
@@ -2047,9 +2115,14 @@ Serialization (Assembly)
 
 				static void IOPrepare(WfReader& reader, WfAssembly& value)
 				{
-					reader.context = new WfReaderContext;
 					bool hasTypeImpl = false;
 					reader << hasTypeImpl;
+					IOPrepare(reader, value, hasTypeImpl);
+				}
+
+				static void IOPrepare(WfReader& reader, WfAssembly& value, bool hasTypeImpl)
+				{
+					reader.context = new WfReaderContext;
 					if (hasTypeImpl)
 					{
 						value.typeImpl = new WfTypeImpl;
@@ -2145,84 +2218,965 @@ Serialization (Assembly)
 					{
 						writer << mi;
 					}
-					FOREACH(IPropertyInfo*, pi, prepare.pis)
+					FOREACH(IPropertyInfo*, pi, prepare.pis)
+					{
+						writer << pi;
+					}
+					FOREACH(IEventInfo*, ei, prepare.eis)
+					{
+						writer << ei;
+					}
+				}
+
+				//----------------------------------------------------
+
+				static void IO(WfReader& reader, WfAssembly& value, bool hasTypeImpl)
+				{
+					IOPrepare(reader, value, hasTypeImpl);
+					IOContent(reader, value);
+				}
+
+				template<typename TIO>
+				static void IO(TIO& io, WfAssembly& value)
+				{
+					IOPrepare(io, value);
+					IOContent(io, value);
+				}
+
+				template<typename TIO>
+				static void IOContent(TIO& io, WfAssembly& value)
+				{
+					io	<< value.insBeforeCodegen
+						<< value.insAfterCodegen
+						<< value.variableNames
+						<< value.functionByName
+						<< value.functions
+						<< value.instructions
+						;
+					if (value.typeImpl)
+					{
+						GetGlobalTypeManager()->RemoveTypeLoader(value.typeImpl);
+					}
+				}
+			};
+
+/***********************************************************************
+Serialization (Compact Assembly)
+***********************************************************************/
+
+			namespace compact_assembly
+			{
+				const vuint8_t								Magic[] = { 'W', 'f', 'A', 's' };
+				const vint									Version = 1;
+
+				void WriteBytes(IStream& output, const void* buffer, vint size)
+				{
+					if (size > 0 && output.Write((void*)buffer, size) != size)
+					{
+						CHECK_FAIL(L"Serialization failed.");
+					}
+				}
+
+				void ReadBytes(IStream& input, void* buffer, vint size)
+				{
+					if (size > 0 && input.Read(buffer, size) != size)
+					{
+						CHECK_FAIL(L"Deserialization failed.");
+					}
+				}
+
+				void WriteCount(IStream& output, vint value)
+				{
+					vuint8_t buffer[10];
+					vint size = 0;
+					auto number = (vuint64_t)value;
+					do
+					{
+						auto byte = (vuint8_t)(number & 0x7F);
+						number >>= 7;
+						buffer[size++] = number ? (vuint8_t)(byte | 0x80) : byte;
+					} while (number);
+					WriteBytes(output, buffer, size);
+				}
+
+				vint ReadCount(IStream& input)
+				{
+					vuint64_t number = 0;
+					for (vint shift = 0; shift < 64; shift += 7)
+					{
+						vuint8_t byte = 0;
+						ReadBytes(input, &byte, 1);
+						number |= (vuint64_t)(byte & 0x7F) << shift;
+						if (!(byte & 0x80))
+						{
+							return (vint)number;
+						}
+					}
+					CHECK_FAIL(L"Deserialization failed.");
+				}
+
+				void WriteInt(IStream& output, vint value)
+				{
+					// zigzag encoding keeps small negative numbers small
+					auto number = (vint64_t)value;
+					WriteCount(output, (vint)(((vuint64_t)number << 1) ^ (vuint64_t)(number >> 63)));
+				}
+
+				vint ReadInt(IStream& input)
+				{
+					auto number = (vuint64_t)ReadCount(input);
+					return (vint)(vint64_t)((number >> 1) ^ (~(number & 1) + 1));
+				}
+
+				void CopyToStream(MemoryStream& input, IStream& output)
+				{
+					vint size = (vint)input.Size();
+					WriteCount(output, size);
+					if (size > 0)
+					{
+						Array<vuint8_t> buffer(size);
+						input.SeekFromBegin(0);
+						ReadBytes(input, &buffer[0], size);
+						WriteBytes(output, &buffer[0], size);
+					}
+				}
+
+				void ReadToBuffer(IStream& input, Array<vuint8_t>& buffer)
+				{
+					buffer.Resize(ReadCount(input));
+					if (buffer.Count() > 0)
+					{
+						ReadBytes(input, &buffer[0], buffer.Count());
+					}
+				}
+
+				void EncodeTexts(const List<WString>& texts, MemoryStream& memoryStream)
+				{
+					Utf8Encoder encoder;
+					EncoderStream encoderStream(memoryStream, encoder);
+					StreamWriter writer(encoderStream);
+					FOREACH(WString, text, texts)
+					{
+						writer.WriteString(text);
+						writer.WriteChar(L'\0');
+					}
+				}
+
+				void DecodeTexts(Array<vuint8_t>& buffer, Array<WString>& texts)
+				{
+					if (buffer.Count() == 0)
+					{
+						return;
+					}
+
+					// a UTF-8 character never takes less bytes than a wchar_t character
+					Array<wchar_t> chars(buffer.Count());
+					vint charCount = 0;
+					{
+						MemoryWrapperStream memoryStream(&buffer[0], buffer.Count());
+						Utf8Decoder decoder;
+						DecoderStream decoderStream(memoryStream, decoder);
+						while (charCount < chars.Count())
+						{
+							vint size = decoderStream.Read(&chars[charCount], (chars.Count() - charCount) * sizeof(wchar_t));
+							if (size == 0) break;
+							charCount += size / sizeof(wchar_t);
+						}
+					}
+
+					vint start = 0;
+					vint index = 0;
+					for (vint i = 0; i < charCount && index < texts.Count(); i++)
+					{
+						if (chars[i] == L'\0')
+						{
+							texts[index++] = WString(&chars[start], i - start);
+							start = i + 1;
+						}
+					}
+					CHECK_ERROR(index == texts.Count(), L"Deserialization failed.");
+				}
+
+				void WriteText(IStream& output, const WString& text)
+				{
+					List<WString> texts;
+					texts.Add(text);
+					MemoryStream memoryStream;
+					EncodeTexts(texts, memoryStream);
+					CopyToStream(memoryStream, output);
+				}
+
+				WString ReadText(IStream& input)
+				{
+					Array<vuint8_t> buffer;
+					ReadToBuffer(input, buffer);
+					Array<WString> texts(1);
+					DecodeTexts(buffer, texts);
+					return texts[0];
+				}
+
+				//----------------------------------------------------
+
+				class StringTableWriter
+				{
+				public:
+					Dictionary<WString, vint>				indices;
+					List<WString>							strings;
+
+					vint Add(const WString& value)
+					{
+						vint index = indices.Keys().IndexOf(value);
+						if (index != -1)
+						{
+							return indices.Values()[index];
+						}
+						index = strings.Add(value);
+						indices.Add(value, index);
+						return index;
+					}
+
+					void Write(IStream& output)
+					{
+						MemoryStream memoryStream;
+						EncodeTexts(strings, memoryStream);
+						WriteCount(output, strings.Count());
+						CopyToStream(memoryStream, output);
+					}
+				};
+
+				void ReadStringTable(IStream& input, Array<WString>& strings)
+				{
+					strings.Resize(ReadCount(input));
+					Array<vuint8_t> buffer;
+					ReadToBuffer(input, buffer);
+					DecodeTexts(buffer, strings);
+				}
+
+				//----------------------------------------------------
+
+				void WriteValue(WfWriter& writer, StringTableWriter& strings, Value& value)
+				{
+					auto& output = writer.output;
+					if (value.IsNull())
+					{
+						WriteCount(output, 0);
+						return;
+					}
+
+					auto type = value.GetTypeDescriptor();
+					if (type == GetTypeDescriptor<ITypeDescriptor>())
+					{
+						WriteCount(output, 1);
+						WriteInt(output, writer.context->tdIndex[UnboxValue<ITypeDescriptor*>(value)]);
+					}
+					else if (auto st = type->GetSerializableType())
+					{
+						WString text;
+						st->Serialize(value, text);
+						WriteCount(output, 2);
+						WriteInt(output, writer.context->tdIndex[type]);
+						WriteCount(output, strings.Add(text));
+					}
+					else
+					{
+						WriteCount(output, 3);
+						writer << value;
+					}
+				}
+
+				void ReadValue(WfReader& reader, Array<WString>& strings, Value& value)
+				{
+					auto& input = reader.input;
+					switch (ReadCount(input))
+					{
+					case 0:
+						value = Value();
+						break;
+					case 1:
+						value = Value::From(reader.context->tdIndex[ReadInt(input)]);
+						break;
+					case 2:
+						{
+							auto type = reader.context->tdIndex[ReadInt(input)];
+							type->GetSerializableType()->Deserialize(strings[ReadCount(input)], value);
+						}
+						break;
+					case 3:
+						reader << value;
+						break;
+					default:
+						CHECK_FAIL(L"Failed to load value.");
+					}
+				}
+
+				//----------------------------------------------------
+
+				void WriteInstruction(WfWriter& writer, StringTableWriter& strings, WfInstruction& ins, vint insIndex)
+				{
+					auto& output = writer.output;
+					WriteCount(output, (vint)ins.code);
+#define COMPACT(NAME)						case WfInsCode::NAME: break;
+#define COMPACT_VALUE(NAME)					case WfInsCode::NAME: WriteValue(writer, strings, ins.valueParameter); break;
+#define COMPACT_FUNCTION(NAME)				case WfInsCode::NAME: WriteInt(output, ins.indexParameter); break;
+#define COMPACT_FUNCTION_COUNT(NAME)		case WfInsCode::NAME: WriteInt(output, ins.indexParameter); WriteInt(output, ins.countParameter); break;
+#define COMPACT_VARIABLE(NAME)				case WfInsCode::NAME: WriteInt(output, ins.indexParameter); break;
+#define COMPACT_COUNT(NAME)					case WfInsCode::NAME: WriteInt(output, ins.countParameter); break;
+#define COMPACT_FLAG_TYPEDESCRIPTOR(NAME)	case WfInsCode::NAME: WriteCount(output, (vint)ins.flagParameter); WriteInt(output, writer.context->tdIndex[ins.typeDescriptorParameter]); break;
+#define COMPACT_PROPERTY(NAME)				case WfInsCode::NAME: WriteInt(output, writer.context->piIndex[ins.propertyParameter]); break;
+#define COMPACT_METHOD(NAME)				case WfInsCode::NAME: WriteInt(output, writer.context->miIndex[ins.methodParameter]); break;
+#define COMPACT_METHOD_COUNT(NAME)			case WfInsCode::NAME: WriteInt(output, writer.context->miIndex[ins.methodParameter]); WriteInt(output, ins.countParameter); break;
+#define COMPACT_EVENT(NAME)					case WfInsCode::NAME: WriteInt(output, writer.context->eiIndex[ins.eventParameter]); break;
+#define COMPACT_EVENT_COUNT(NAME)			case WfInsCode::NAME: WriteInt(output, writer.context->eiIndex[ins.eventParameter]); WriteInt(output, ins.countParameter); break;
+#define COMPACT_LABEL(NAME)					case WfInsCode::NAME: WriteInt(output, ins.indexParameter - insIndex); break;
+#define COMPACT_TYPE(NAME)					case WfInsCode::NAME: WriteCount(output, (vint)ins.typeParameter); break;
+
+					switch (ins.code)
+					{
+						INSTRUCTION_CASES(
+							COMPACT,
+							COMPACT_VALUE,
+							COMPACT_FUNCTION,
+							COMPACT_FUNCTION_COUNT,
+							COMPACT_VARIABLE,
+							COMPACT_COUNT,
+							COMPACT_FLAG_TYPEDESCRIPTOR,
+							COMPACT_PROPERTY,
+							COMPACT_METHOD,
+							COMPACT_METHOD_COUNT,
+							COMPACT_EVENT,
+							COMPACT_EVENT_COUNT,
+							COMPACT_LABEL,
+							COMPACT_TYPE)
+					}
+
+#undef COMPACT
+#undef COMPACT_VALUE
+#undef COMPACT_FUNCTION
+#undef COMPACT_FUNCTION_COUNT
+#undef COMPACT_VARIABLE
+#undef COMPACT_COUNT
+#undef COMPACT_FLAG_TYPEDESCRIPTOR
+#undef COMPACT_PROPERTY
+#undef COMPACT_METHOD
+#undef COMPACT_METHOD_COUNT
+#undef COMPACT_EVENT
+#undef COMPACT_EVENT_COUNT
+#undef COMPACT_LABEL
+#undef COMPACT_TYPE
+				}
+
+				void ReadInstruction(WfReader& reader, Array<WString>& strings, WfInstruction& ins, vint insIndex)
+				{
+					auto& input = reader.input;
+					ins.code = (WfInsCode)ReadCount(input);
+#define COMPACT(NAME)						case WfInsCode::NAME: break;
+#define COMPACT_VALUE(NAME)					case WfInsCode::NAME: ReadValue(reader, strings, ins.valueParameter); break;
+#define COMPACT_FUNCTION(NAME)				case WfInsCode::NAME: ins.indexParameter = ReadInt(input); break;
+#define COMPACT_FUNCTION_COUNT(NAME)		case WfInsCode::NAME: ins.indexParameter = ReadInt(input); ins.countParameter = ReadInt(input); break;
+#define COMPACT_VARIABLE(NAME)				case WfInsCode::NAME: ins.indexParameter = ReadInt(input); break;
+#define COMPACT_COUNT(NAME)					case WfInsCode::NAME: ins.countParameter = ReadInt(input); break;
+#define COMPACT_FLAG_TYPEDESCRIPTOR(NAME)	case WfInsCode::NAME: ins.flagParameter = (Value::ValueType)ReadCount(input); ins.typeDescriptorParameter = reader.context->tdIndex[ReadInt(input)]; break;
+#define COMPACT_PROPERTY(NAME)				case WfInsCode::NAME: ins.propertyParameter = reader.context->piIndex[ReadInt(input)]; break;
+#define COMPACT_METHOD(NAME)				case WfInsCode::NAME: ins.methodParameter = reader.context->miIndex[ReadInt(input)]; break;
+#define COMPACT_METHOD_COUNT(NAME)			case WfInsCode::NAME: ins.methodParameter = reader.context->miIndex[ReadInt(input)]; ins.countParameter = ReadInt(input); break;
+#define COMPACT_EVENT(NAME)					case WfInsCode::NAME: ins.eventParameter = reader.context->eiIndex[ReadInt(input)]; break;
+#define COMPACT_EVENT_COUNT(NAME)			case WfInsCode::NAME: ins.eventParameter = reader.context->eiIndex[ReadInt(input)]; ins.countParameter = ReadInt(input); break;
+#define COMPACT_LABEL(NAME)					case WfInsCode::NAME: ins.indexParameter = ReadInt(input) + insIndex; break;
+#define COMPACT_TYPE(NAME)					case WfInsCode::NAME: ins.typeParameter = (WfInsType)ReadCount(input); break;
+
+					switch (ins.code)
+					{
+						INSTRUCTION_CASES(
+							COMPACT,
+							COMPACT_VALUE,
+							COMPACT_FUNCTION,
+							COMPACT_FUNCTION_COUNT,
+							COMPACT_VARIABLE,
+							COMPACT_COUNT,
+							COMPACT_FLAG_TYPEDESCRIPTOR,
+							COMPACT_PROPERTY,
+							COMPACT_METHOD,
+							COMPACT_METHOD_COUNT,
+							COMPACT_EVENT,
+							COMPACT_EVENT_COUNT,
+							COMPACT_LABEL,
+							COMPACT_TYPE)
+					default:
+						CHECK_FAIL(L"Failed to load instruction.");
+					}
+
+#undef COMPACT
+#undef COMPACT_VALUE
+#undef COMPACT_FUNCTION
+#undef COMPACT_FUNCTION_COUNT
+#undef COMPACT_VARIABLE
+#undef COMPACT_COUNT
+#undef COMPACT_FLAG_TYPEDESCRIPTOR
+#undef COMPACT_PROPERTY
+#undef COMPACT_METHOD
+#undef COMPACT_METHOD_COUNT
+#undef COMPACT_EVENT
+#undef COMPACT_EVENT_COUNT
+#undef COMPACT_LABEL
+#undef COMPACT_TYPE
+				}
+
+				//----------------------------------------------------
+
+				void WriteDebugInfo(IStream& output, Ptr<WfInstructionDebugInfo> debugInfo)
+				{
+					WriteCount(output, debugInfo->moduleCodes.Count());
+					FOREACH(WString, code, debugInfo->moduleCodes)
+					{
+						WriteText(output, code);
+					}
+
+					// most instructions are generated from nearby code, so character indexes are stored as differences
+					WriteCount(output, debugInfo->instructionCodeMapping.Count());
+					vint previous = 0;
+					FOREACH(parsing::ParsingTextRange, range, debugInfo->instructionCodeMapping)
+					{
+						WriteInt(output, range.codeIndex);
+						WriteInt(output, range.start.index - previous);
+						WriteInt(output, range.start.row);
+						WriteInt(output, range.start.column);
+						WriteInt(output, range.end.index - range.start.index);
+						WriteInt(output, range.end.row - range.start.row);
+						WriteInt(output, range.end.column);
+						previous = range.start.index;
+					}
+				}
+
+				Ptr<WfInstructionDebugInfo> ReadDebugInfo(IStream& input)
+				{
+					auto debugInfo = MakePtr<WfInstructionDebugInfo>();
+					vint codeCount = ReadCount(input);
+					for (vint i = 0; i < codeCount; i++)
+					{
+						debugInfo->moduleCodes.Add(ReadText(input));
+					}
+
+					vint rangeCount = ReadCount(input);
+					vint previous = 0;
+					for (vint i = 0; i < rangeCount; i++)
+					{
+						parsing::ParsingTextRange range;
+						range.codeIndex = ReadInt(input);
+						range.start.index = ReadInt(input) + previous;
+						range.start.row = ReadInt(input);
+						range.start.column = ReadInt(input);
+						range.end.index = ReadInt(input) + range.start.index;
+						range.end.row = ReadInt(input) + range.start.row;
+						range.end.column = ReadInt(input);
+						debugInfo->instructionCodeMapping.Add(range);
+						previous = range.start.index;
+					}
+					return debugInfo;
+				}
+			}
+		}
+	}
+
+	namespace workflow
+	{
+		namespace runtime
+		{
+
+/***********************************************************************
+WfInstructionDebugInfo
+***********************************************************************/
+
+			void WfInstructionDebugInfo::Initialize()
+			{
+				for (vint i = 0; i < instructionCodeMapping.Count(); i++)
+				{
+					const auto& range = instructionCodeMapping[i];
+					if (range.codeIndex != -1)
+					{
+						codeInstructionMapping.Add(Tuple<vint, vint>(range.codeIndex, range.start.row), i);
+					}
+				}
+			}
+
+/***********************************************************************
+WfAssembly
+***********************************************************************/
+
+			using namespace stream;
+			using namespace stream::internal;
+			using namespace stream::internal::compact_assembly;
+
+			class WfAssembly::LazyData : public Object
+			{
+			public:
+				// instructions of a chunk are only allocated when the chunk is decoded
+				struct Chunk
+				{
+					vint											first = 0;
+					vint											count = 0;
+					vint											offset = 0;
+					vint											size = 0;
+					bool											loaded = false;
+					Array<WfInstruction>							instructions;
+				};
+
+				Ptr<WfReaderContext>								context;
+				Array<WString>										strings;
+				Array<vuint8_t>										code;
+				List<Ptr<Chunk>>									chunks;				// sorted by the first instruction
+				Array<vint>											functionChunks;		// function index -> chunk index
+				vint												instructionCount = 0;
+				bool												instructionsMerged = false;
+				bool												hasDebugInfo = false;
+				Array<vuint8_t>										debugInfo;
+				bool												debugInfoLoaded = false;
+				SpinLock											lock;
+
+				void LoadChunk(vint chunkIndex)
+				{
+					auto chunk = chunks[chunkIndex];
+					if (chunk->loaded) return;
+					chunk->loaded = true;
+					if (chunk->count == 0) return;
+
+					MemoryWrapperStream memoryStream(&code[chunk->offset], chunk->size);
+					WfReader reader(memoryStream);
+					reader.context = context;
+					chunk->instructions.Resize(chunk->count);
+					for (vint i = 0; i < chunk->count; i++)
+					{
+						ReadInstruction(reader, strings, chunk->instructions[i], chunk->first + i);
+					}
+				}
+
+				vint FindChunk(vint index)
+				{
+					vint start = 0;
+					vint end = chunks.Count() - 1;
+					while (start <= end)
+					{
+						vint middle = (start + end) / 2;
+						auto chunk = chunks[middle];
+						if (index < chunk->first)
+						{
+							end = middle - 1;
+						}
+						else if (index >= chunk->first + chunk->count)
+						{
+							start = middle + 1;
+						}
+						else
+						{
+							return middle;
+						}
+					}
+					return -1;
+				}
+			};
+
+			WfAssembly::WfAssembly()
+			{
+			}
+
+			WfAssembly::WfAssembly(stream::IStream& input)
+			{
+				vuint8_t firstByte = 0;
+				ReadBytes(input, &firstByte, 1);
+				if (firstByte == Magic[0])
+				{
+					vuint8_t magic[sizeof(Magic) - 1];
+					ReadBytes(input, magic, sizeof(magic));
+					CHECK_ERROR(memcmp(magic, Magic + 1, sizeof(magic)) == 0, L"Deserialization failed.");
+					ReadCompact(input);
+				}
+				else
+				{
+					// the legacy format starts with a bool, which is serialized as 0 or 0xFF
+					WfReader reader(input);
+					Serialization<WfAssembly>::IO(reader, *this, firstByte != 0);
+				}
+				Initialize();
+			}
+
+			void WfAssembly::ReadCompact(stream::IStream& input)
+			{
+				CHECK_ERROR(ReadCount(input) == Version, L"Deserialization failed.");
+				WfReader reader(input);
+				Serialization<WfAssembly>::IOPrepare(reader, *this);
+
+				lazyData = new LazyData;
+				lazyData->context = reader.context;
+				ReadStringTable(input, lazyData->strings);
+				auto& strings = lazyData->strings;
+
+				Array<vuint8_t> body;
+				ReadToBuffer(input, body);
+				{
+					MemoryStream emptyStream;
+					MemoryWrapperStream memoryStream(body.Count() > 0 ? &body[0] : nullptr, body.Count());
+					IStream& bodyStream = body.Count() > 0 ? (IStream&)memoryStream : (IStream&)emptyStream;
+
+					vint variableCount = ReadCount(bodyStream);
+					for (vint i = 0; i < variableCount; i++)
+					{
+						variableNames.Add(strings[ReadCount(bodyStream)]);
+					}
+
+					auto readNames = [&](List<WString>& names)
+					{
+						vint count = ReadCount(bodyStream);
+						for (vint i = 0; i < count; i++)
+						{
+							names.Add(strings[ReadCount(bodyStream)]);
+						}
+					};
+
+					vint functionCount = ReadCount(bodyStream);
+					for (vint i = 0; i < functionCount; i++)
+					{
+						auto function = MakePtr<WfAssemblyFunction>();
+						function->name = strings[ReadCount(bodyStream)];
+						readNames(function->argumentNames);
+						readNames(function->capturedVariableNames);
+						readNames(function->localVariableNames);
+						function->firstInstruction = ReadInt(bodyStream);
+						function->lastInstruction = ReadInt(bodyStream);
+						functions.Add(function);
+					}
+
+					vint functionNameCount = ReadCount(bodyStream);
+					for (vint i = 0; i < functionNameCount; i++)
+					{
+						auto name = strings[ReadCount(bodyStream)];
+						functionByName.Add(name, ReadCount(bodyStream));
+					}
+
+					// instructions stay in chunks until LoadAllInstructions is called, see GetInstruction
+					vint instructionCount = ReadCount(bodyStream);
+					lazyData->instructionCount = instructionCount;
+
+					lazyData->functionChunks.Resize(functionCount);
+					for (vint i = 0; i < functionCount; i++)
+					{
+						lazyData->functionChunks[i] = -1;
+					}
+
+					List<vint> eagerChunks;
+					vint chunkCount = ReadCount(bodyStream);
+					vint offset = 0;
+					for (vint i = 0; i < chunkCount; i++)
+					{
+						auto chunk = MakePtr<LazyData::Chunk>();
+						vint owner = ReadInt(bodyStream);
+						chunk->first = ReadCount(bodyStream);
+						chunk->count = ReadCount(bodyStream);
+						chunk->size = ReadCount(bodyStream);
+						chunk->offset = offset;
+						offset += chunk->size;
+						CHECK_ERROR(chunk->first == (i == 0 ? 0 : lazyData->chunks[i - 1]->first + lazyData->chunks[i - 1]->count), L"Deserialization failed.");
+						CHECK_ERROR(chunk->first + chunk->count <= instructionCount, L"Deserialization failed.");
+
+						vint chunkIndex = lazyData->chunks.Add(chunk);
+						if (owner == -1)
+						{
+							eagerChunks.Add(chunkIndex);
+						}
+						else
+						{
+							CHECK_ERROR(0 <= owner && owner < functionCount, L"Deserialization failed.");
+							lazyData->functionChunks[owner] = chunkIndex;
+						}
+					}
+
+					ReadToBuffer(bodyStream, lazyData->code);
+					CHECK_ERROR(offset == lazyData->code.Count(), L"Deserialization failed.");
+
+					FOREACH(vint, chunkIndex, eagerChunks)
+					{
+						lazyData->LoadChunk(chunkIndex);
+					}
+				}
+
+				lazyData->hasDebugInfo = ReadCount(input) != 0;
+				if (lazyData->hasDebugInfo)
+				{
+					ReadToBuffer(input, lazyData->debugInfo);
+				}
+
+				if (typeImpl)
+				{
+					GetGlobalTypeManager()->RemoveTypeLoader(typeImpl);
+				}
+			}
+
+			void WfAssembly::WriteCompact(stream::IStream& output, bool includeDebugInfo)
+			{
+				WriteBytes(output, Magic, sizeof(Magic));
+				WriteCount(output, Version);
+
+				WfWriter writer(output);
+				Serialization<WfAssembly>::IOPrepare(writer, *this);
+
+				StringTableWriter strings;
+				MemoryStream bodyStream;
+				{
+					WriteCount(bodyStream, variableNames.Count());
+					FOREACH(WString, name, variableNames)
+					{
+						WriteCount(bodyStream, strings.Add(name));
+					}
+
+					auto writeNames = [&](List<WString>& names)
+					{
+						WriteCount(bodyStream, names.Count());
+						FOREACH(WString, name, names)
+						{
+							WriteCount(bodyStream, strings.Add(name));
+						}
+					};
+
+					WriteCount(bodyStream, functions.Count());
+					FOREACH(Ptr<WfAssemblyFunction>, function, functions)
+					{
+						WriteCount(bodyStream, strings.Add(function->name));
+						writeNames(function->argumentNames);
+						writeNames(function->capturedVariableNames);
+						writeNames(function->localVariableNames);
+						WriteInt(bodyStream, function->firstInstruction);
+						WriteInt(bodyStream, function->lastInstruction);
+					}
+
+					vint functionNameCount = 0;
+					for (vint i = 0; i < functionByName.Count(); i++)
+					{
+						functionNameCount += functionByName.GetByIndex(i).Count();
+					}
+					WriteCount(bodyStream, functionNameCount);
+					for (vint i = 0; i < functionByName.Count(); i++)
+					{
+						vint nameIndex = strings.Add(functionByName.Keys()[i]);
+						FOREACH(vint, functionIndex, functionByName.GetByIndex(i))
+						{
+							WriteCount(bodyStream, nameIndex);
+							WriteCount(bodyStream, functionIndex);
+						}
+					}
+
+					vint instructionCount = instructions.Count();
+					WriteCount(bodyStream, instructionCount);
+
+					// every function becomes a chunk which is decoded on the first call
+					// instructions that are not owned by exactly one function are decoded at loading
+					Array<vint> owners(instructionCount);
+					for (vint i = 0; i < instructionCount; i++)
+					{
+						owners[i] = -1;
+					}
+
+					bool overlapped = false;
+					FOREACH_INDEXER(Ptr<WfAssemblyFunction>, function, functionIndex, functions)
+					{
+						if (function->firstInstruction < 0 || function->lastInstruction >= instructionCount || function->firstInstruction > function->lastInstruction)
+						{
+							continue;
+						}
+						for (vint i = function->firstInstruction; i <= function->lastInstruction; i++)
+						{
+							if (owners[i] != -1)
+							{
+								overlapped = true;
+							}
+							owners[i] = functionIndex;
+						}
+					}
+					if (overlapped)
+					{
+						for (vint i = 0; i < instructionCount; i++)
+						{
+							owners[i] = -1;
+						}
+					}
+
+					typedef Tuple<vint, vint, vint> ChunkRange;	// owner, first, count
+					List<ChunkRange> chunks;
+					for (vint i = 0; i < instructionCount; i++)
 					{
-						writer << pi;
+						if (chunks.Count() > 0)
+						{
+							auto& last = chunks[chunks.Count() - 1];
+							if (last.f0 == owners[i] && last.f1 + last.f2 == i)
+							{
+								chunks.Set(chunks.Count() - 1, ChunkRange(last.f0, last.f1, last.f2 + 1));
+								continue;
+							}
+						}
+						chunks.Add(ChunkRange(owners[i], i, 1));
 					}
-					FOREACH(IEventInfo*, ei, prepare.eis)
+
+					MemoryStream codeStream;
+					WriteCount(bodyStream, chunks.Count());
+					FOREACH(ChunkRange, chunk, chunks)
 					{
-						writer << ei;
+						vint offset = (vint)codeStream.Position();
+						{
+							WfWriter codeWriter(codeStream);
+							codeWriter.context = writer.context;
+							for (vint i = 0; i < chunk.f2; i++)
+							{
+								vint index = chunk.f1 + i;
+								WriteInstruction(codeWriter, strings, instructions[index], index);
+							}
+						}
+						WriteInt(bodyStream, chunk.f0);
+						WriteCount(bodyStream, chunk.f1);
+						WriteCount(bodyStream, chunk.f2);
+						WriteCount(bodyStream, (vint)codeStream.Position() - offset);
 					}
+					CopyToStream(codeStream, bodyStream);
 				}
 
-				//----------------------------------------------------
+				strings.Write(output);
+				CopyToStream(bodyStream, output);
 
-				template<typename TIO>
-				static void IO(TIO& io, WfAssembly& value)
+				if (includeDebugInfo && insBeforeCodegen && insAfterCodegen)
 				{
-					IOPrepare(io, value);
-					io	<< value.insBeforeCodegen
-						<< value.insAfterCodegen
-						<< value.variableNames
-						<< value.functionByName
-						<< value.functions
-						<< value.instructions
-						;
-					if (value.typeImpl)
-					{
-						GetGlobalTypeManager()->RemoveTypeLoader(value.typeImpl);
-					}
+					WriteCount(output, 1);
+					MemoryStream debugStream;
+					WriteDebugInfo(debugStream, insBeforeCodegen);
+					WriteDebugInfo(debugStream, insAfterCodegen);
+					CopyToStream(debugStream, output);
+				}
+				else
+				{
+					WriteCount(output, 0);
 				}
-			};
-		}
-	}
 
-	namespace workflow
-	{
-		namespace runtime
-		{
+				if (typeImpl)
+				{
+					GetGlobalTypeManager()->RemoveTypeLoader(typeImpl);
+				}
+			}
 
-/***********************************************************************
-WfInstructionDebugInfo
-***********************************************************************/
+			void WfAssembly::Initialize()
+			{
+				if (insBeforeCodegen) insBeforeCodegen->Initialize();
+				if (insAfterCodegen) insAfterCodegen->Initialize();
+			}
 
-			void WfInstructionDebugInfo::Initialize()
+			void WfAssembly::Serialize(stream::IStream& output, bool includeDebugInfo)
 			{
-				for (vint i = 0; i < instructionCodeMapping.Count(); i++)
+				LoadAllInstructions();
+				if (includeDebugInfo)
 				{
-					const auto& range = instructionCodeMapping[i];
-					if (range.codeIndex != -1)
+					LoadDebugInfo();
+				}
+				WriteCompact(output, includeDebugInfo);
+			}
+
+			void WfAssembly::SerializeLegacy(stream::IStream& output)
+			{
+				LoadAllInstructions();
+				LoadDebugInfo();
+				WfWriter writer(output);
+				Serialization<WfAssembly>::IO(writer, *this);
+			}
+
+			void WfAssembly::LoadFunctionInstructions(vint functionIndex)
+			{
+				if (!lazyData) return;
+				SPIN_LOCK(lazyData->lock)
+				{
+					if (0 <= functionIndex && functionIndex < lazyData->functionChunks.Count())
 					{
-						codeInstructionMapping.Add(Tuple<vint, vint>(range.codeIndex, range.start.row), i);
+						vint chunkIndex = lazyData->functionChunks[functionIndex];
+						if (chunkIndex != -1)
+						{
+							lazyData->LoadChunk(chunkIndex);
+						}
 					}
 				}
 			}
 
-/***********************************************************************
-WfAssembly
-***********************************************************************/
-
-			WfAssembly::WfAssembly()
+			void WfAssembly::LoadAllInstructions()
 			{
+				if (!lazyData) return;
+				SPIN_LOCK(lazyData->lock)
+				{
+					if (!lazyData->instructionsMerged)
+					{
+						// decoded chunks are kept, because runtime contexts may still point to their instructions
+						lazyData->instructionsMerged = true;
+						for (vint i = 0; i < lazyData->chunks.Count(); i++)
+						{
+							lazyData->LoadChunk(i);
+							auto chunk = lazyData->chunks[i];
+							for (vint j = 0; j < chunk->count; j++)
+							{
+								instructions.Add(chunk->instructions[j]);
+							}
+						}
+					}
+				}
 			}
 
-			WfAssembly::WfAssembly(stream::IStream& input)
+			void WfAssembly::LoadDebugInfo()
 			{
-				stream::internal::WfReader reader(input);
-				stream::internal::Serialization<WfAssembly>::IO(reader, *this);
-				Initialize();
+				if (!lazyData) return;
+				SPIN_LOCK(lazyData->lock)
+				{
+					if (!lazyData->debugInfoLoaded)
+					{
+						lazyData->debugInfoLoaded = true;
+						if (lazyData->hasDebugInfo)
+						{
+							MemoryWrapperStream memoryStream(&lazyData->debugInfo[0], lazyData->debugInfo.Count());
+							insBeforeCodegen = ReadDebugInfo(memoryStream);
+							insAfterCodegen = ReadDebugInfo(memoryStream);
+							lazyData->debugInfo.Resize(0);
+						}
+						else
+						{
+							// instructions are mapped to no code, so that call stacks and debuggers still work
+							insBeforeCodegen = new WfInstructionDebugInfo;
+							insAfterCodegen = new WfInstructionDebugInfo;
+							vint instructionCount = GetInstructionCount();
+							for (vint i = 0; i < instructionCount; i++)
+							{
+								insBeforeCodegen->instructionCodeMapping.Add(parsing::ParsingTextRange());
+								insAfterCodegen->instructionCodeMapping.Add(parsing::ParsingTextRange());
+							}
+						}
+						Initialize();
+					}
+				}
 			}
 
-			void WfAssembly::Initialize()
+			vint WfAssembly::GetInstructionCount()
 			{
-				insBeforeCodegen->Initialize();
-				insAfterCodegen->Initialize();
+				if (lazyData && !lazyData->instructionsMerged)
+				{
+					return lazyData->instructionCount;
+				}
+				return instructions.Count();
 			}
 
-			void WfAssembly::Serialize(stream::IStream& output)
+			WfInstruction& WfAssembly::GetInstruction(vint index)
 			{
-				stream::internal::WfWriter writer(output);
-				stream::internal::Serialization<WfAssembly>::IO(writer, *this);
+				if (lazyData && !lazyData->instructionsMerged)
+				{
+					vint chunkIndex = lazyData->FindChunk(index);
+					CHECK_ERROR(chunkIndex != -1, L"vl::workflow::runtime::WfAssembly::GetInstruction(vint)#Index out of range.");
+					auto chunk = lazyData->chunks[chunkIndex];
+					if (!chunk->loaded)
+					{
+						SPIN_LOCK(lazyData->lock)
+						{
+							lazyData->LoadChunk(chunkIndex);
+						}
+					}
+					return chunk->instructions[index - chunk->first];
+				}
+				return instructions[index];
 			}
 		}
 	}
@@ -2466,6 +3420,7 @@ InstructionLocation
 				if (assembly != il.assembly) return true;
 				if (stackFrameIndex != il.stackFrameIndex) return stackFrameIndex > il.stackFrameIndex;
 
+				assembly->LoadDebugInfo();
 				auto debugInfo = (beforeCodegen ? assembly->insBeforeCodegen : assembly->insAfterCodegen);
 				auto& range1 = debugInfo->instructionCodeMapping[instruction];
 				auto& range2 = debugInfo->instructionCodeMapping[il.instruction];
@@ -2482,6 +3437,7 @@ InstructionLocation
 				if (assembly != il.assembly) return true;
 				if (stackFrameIndex != il.stackFrameIndex) return true;
 
+				assembly->LoadDebugInfo();
 				auto debugInfo = (beforeCodegen ? assembly->insBeforeCodegen : assembly->insAfterCodegen);
 				auto& range1 = debugInfo->instructionCodeMapping[instruction];
 				auto& range2 = debugInfo->instructionCodeMapping[il.instruction];
@@ -2864,6 +3820,7 @@ WfDebugger
 
 			vint WfDebugger::AddCodeLineBreakPoint(WfAssembly* assembly, vint codeIndex, vint row, bool beforeCodegen)
 			{
+				assembly->LoadDebugInfo();
 				auto& codeInsMap = (beforeCodegen ? assembly->insBeforeCodegen : assembly->insAfterCodegen)->codeInstructionMapping;
 				Tuple<vint, vint> key(codeIndex, row);
 				vint index = codeInsMap.Keys().IndexOf(key);
@@ -3034,6 +3991,7 @@ WfDebugger
 
 				auto& stackFrame = context->stackFrames[callStackIndex];
 				auto ins = stackFrame.nextInstructionIndex;
+				context->globalContext->assembly->LoadDebugInfo();
 				auto debugInfo = (beforeCodegen ? context->globalContext->assembly->insBeforeCodegen : context->globalContext->assembly->insAfterCodegen);
 				return debugInfo->instructionCodeMapping[ins];
 			}
@@ -3857,15 +4815,25 @@ WfRuntimeThreadContext
 							}
 						}
 
-						Array<Value> arguments(ins.countParameter);
+						ArgumentArray largeArguments;
+						auto& arguments = ins.countParameter < SmallArgumentCount ? smallArguments[ins.countParameter] : largeArguments;
+						if (arguments.Count() != ins.countParameter)
+						{
+							arguments.Resize(ins.countParameter);
+						}
 						for (vint i = 0; i < ins.countParameter; i++)
 						{
-							Value argument;
-							CONTEXT_ACTION(PopValue(argument), L"failed to pop a value from the stack.");
-							arguments[ins.countParameter - i - 1] = argument;
+							CONTEXT_ACTION(PopValue(arguments[ins.countParameter - i - 1]), L"failed to pop a value from the stack.");
 						}
 
-						Value result = ins.methodParameter->Invoke(thisValue, arguments);
+						auto callSiteCache = globalContext->decodedInstructions[stackFrame.nextInstructionIndex - 1].callSiteCache.Obj();
+						Value result = callSiteCache
+							? callSiteCache->Invoke(ins.methodParameter, thisValue, arguments)
+							: ins.methodParameter->Invoke(thisValue, arguments);
+						for (vint i = 0; i < arguments.Count(); i++)
+						{
+							arguments[i] = Value();
+						}
 						CONTEXT_ACTION(PushValue(result), L"failed to push a value to the stack.");
 						return WfRuntimeExecutionAction::ExecuteInstruction;
 					}
@@ -4285,7 +5253,7 @@ WfRuntimeThreadContext
 								INTERNAL_ERROR(L"empty stack frame.");
 							}
 							auto& stackFrame = GetCurrentStackFrame();
-							if (stackFrame.nextInstructionIndex < 0 || stackFrame.nextInstructionIndex >= globalContext->assembly->instructions.Count())
+							if (stackFrame.nextInstructionIndex < 0 || stackFrame.nextInstructionIndex >= globalContext->assembly->GetInstructionCount())
 							{
 								INTERNAL_ERROR(L"illegal instruction index.");
 							}
@@ -4294,7 +5262,7 @@ WfRuntimeThreadContext
 							CALL_DEBUGGER(callback->BreakIns(globalContext->assembly.Obj(), insIndex));
 
 							stackFrame.nextInstructionIndex++;
-							auto& ins = globalContext->assembly->instructions[insIndex];
+							auto& ins = globalContext->assembly->GetInstruction(insIndex);
 							return ExecuteInternal(ins, stackFrame, callback);
 						}
 						break;
@@ -4344,6 +5312,122 @@ WfRuntimeThreadContext
 				}
 			}
 
+			WfRuntimeExecutionAction WfRuntimeThreadContext::ExecuteFast()
+			{
+				// instructions that only touch the stack and variables are executed here without checking
+				// all other instructions, and unwrapping the stack after an exception, go through the checked path
+				try
+				{
+					if ((status == WfRuntimeExecutionStatus::Ready || status == WfRuntimeExecutionStatus::Executing) && globalContext->decodedInstructions.Count() > 0)
+					{
+						auto decodedInstructions = &globalContext->decodedInstructions[0];
+						auto& globalVariables = globalContext->globalVariables->variables;
+						while (stackFrames.Count() > 0)
+						{
+							auto& stackFrame = stackFrames[stackFrames.Count() - 1];
+							auto& ins = decodedInstructions[stackFrame.nextInstructionIndex++];
+							switch (ins.code)
+							{
+							case WfInsCode::LoadValue:
+								stack.Add(ins.instruction->valueParameter);
+								break;
+							case WfInsCode::LoadLocalVar:
+								{
+									Value operand = stack[stackFrame.stackBase + ins.indexParameter];
+									stack.Add(MoveValue(operand));
+								}
+								break;
+							case WfInsCode::LoadCapturedVar:
+								stack.Add(stackFrame.capturedVariables->variables[ins.indexParameter]);
+								break;
+							case WfInsCode::LoadGlobalVar:
+								stack.Add(globalVariables[ins.indexParameter]);
+								break;
+							case WfInsCode::StoreLocalVar:
+								{
+									vint top = stack.Count() - 1;
+									stack[stackFrame.stackBase + ins.indexParameter] = MoveValue(stack[top]);
+									stack.RemoveAt(top);
+								}
+								break;
+							case WfInsCode::StoreCapturedVar:
+								{
+									vint top = stack.Count() - 1;
+									stackFrame.capturedVariables->variables[ins.indexParameter] = MoveValue(stack[top]);
+									stack.RemoveAt(top);
+								}
+								break;
+							case WfInsCode::StoreGlobalVar:
+								{
+									vint top = stack.Count() - 1;
+									globalVariables[ins.indexParameter] = MoveValue(stack[top]);
+									stack.RemoveAt(top);
+								}
+								break;
+							case WfInsCode::Duplicate:
+								{
+									Value operand = stack[stack.Count() - 1 - ins.countParameter];
+									stack.Add(MoveValue(operand));
+								}
+								break;
+							case WfInsCode::Pop:
+								stack.RemoveAt(stack.Count() - 1);
+								break;
+							case WfInsCode::Jump:
+								stackFrame.nextInstructionIndex = ins.indexParameter;
+								break;
+							case WfInsCode::JumpIf:
+								{
+									vint top = stack.Count() - 1;
+									bool condition = UnboxValue<bool>(stack[top]);
+									stack.RemoveAt(top);
+									if (condition)
+									{
+										stackFrame.nextInstructionIndex = ins.indexParameter;
+									}
+								}
+								break;
+							default:
+								{
+									auto action = ExecuteInternal(*ins.instruction, stackFrame, nullptr);
+									if (action == WfRuntimeExecutionAction::Nop)
+									{
+										return action;
+									}
+									if (status != WfRuntimeExecutionStatus::Ready && status != WfRuntimeExecutionStatus::Executing)
+									{
+										return action;
+									}
+								}
+							}
+						}
+					}
+					return Execute(nullptr);
+				}
+				catch (const WfRuntimeException& ex)
+				{
+					if (ex.GetInfo())
+					{
+						RaiseException(ex.GetInfo());
+					}
+					else
+					{
+						RaiseException(ex.Message(), ex.IsFatal());
+					}
+					return WfRuntimeExecutionAction::ExecuteInstruction;
+				}
+				catch (const Exception& ex)
+				{
+					RaiseException(ex.Message(), false);
+					return WfRuntimeExecutionAction::ExecuteInstruction;
+				}
+				catch (const Error& ex)
+				{
+					RaiseException(ex.Description(), false);
+					return WfRuntimeExecutionAction::ExecuteInstruction;
+				}
+			}
+
 #undef INTERNAL_ERROR
 #undef CONTEXT_ACTION
 #undef CALL_DEBUGGER
@@ -4838,8 +5922,20 @@ WfEvent
 
 			Ptr<IEventHandler> WfEvent::AttachInternal(DescriptableObject* thisObject, Ptr<IValueFunctionProxy> handler)
 			{
-				auto record = GetEventRecord(thisObject, true);
 				auto result = MakePtr<EventHandlerImpl>(handler);
+				if (slotOwner)
+				{
+					auto instance = Description<WfClassInstance>::GetAssociatedInstance(thisObject);
+					auto& handlers = instance->eventSlots[instance->classType->GetEventSlotOffset(slotOwner) + slotIndex];
+					if (!handlers)
+					{
+						handlers = new WfClassInstance::EventHandlerList;
+					}
+					handlers->Add(result);
+					return result;
+				}
+
+				auto record = GetEventRecord(thisObject, true);
 				record->handlers.Add(this, result);
 				return result;
 			}
@@ -4848,6 +5944,19 @@ WfEvent
 			{
 				auto impl = handler.Cast<EventHandlerImpl>();
 				if (!impl)return false;
+
+				if (slotOwner)
+				{
+					auto instance = Description<WfClassInstance>::GetAssociatedInstance(thisObject);
+					auto handlers = instance->eventSlots[instance->classType->GetEventSlotOffset(slotOwner) + slotIndex];
+					if (handlers && handlers->Remove(impl.Obj()))
+					{
+						impl->isAttached = false;
+						return true;
+					}
+					return false;
+				}
+
 				auto record = GetEventRecord(thisObject, true);
 				if (record->handlers.Remove(this, impl.Obj()))
 				{
@@ -4859,6 +5968,19 @@ WfEvent
 
 			void WfEvent::InvokeInternal(DescriptableObject* thisObject, Ptr<IValueList> arguments)
 			{
+				if (slotOwner)
+				{
+					auto instance = Description<WfClassInstance>::GetAssociatedInstance(thisObject);
+					if (auto handlers = instance->eventSlots[instance->classType->GetEventSlotOffset(slotOwner) + slotIndex])
+					{
+						FOREACH(Ptr<EventHandlerImpl>, handler, *handlers.Obj())
+						{
+							handler->proxy->Invoke(arguments);
+						}
+					}
+					return;
+				}
+
 				auto record = GetEventRecord(thisObject, false);
 				if (record)
 				{
@@ -4911,12 +6033,25 @@ WfField
 
 			Value WfField::GetValueInternal(const Value& thisObject)
 			{
+				if (slotOwner)
+				{
+					auto instance = Description<WfClassInstance>::GetAssociatedInstance(thisObject.GetRawPtr());
+					return instance->fieldSlots[instance->classType->GetFieldSlotOffset(slotOwner) + slotIndex];
+				}
+
 				auto record = GetFieldRecord(thisObject.GetRawPtr(), true);
 				return record->values.Get(this);
 			}
 
 			void WfField::SetValueInternal(Value& thisObject, const Value& newValue)
 			{
+				if (slotOwner)
+				{
+					auto instance = Description<WfClassInstance>::GetAssociatedInstance(thisObject.GetRawPtr());
+					instance->fieldSlots[instance->classType->GetFieldSlotOffset(slotOwner) + slotIndex] = newValue;
+					return;
+				}
+
 				auto record = GetFieldRecord(thisObject.GetRawPtr(), true);
 				record->values.Set(this, newValue);
 			}
@@ -5112,6 +6247,16 @@ WfCustomType
 				return expandedBaseTypes;
 			}
 
+			vint WfCustomType::GetFieldSlotCount()
+			{
+				return fieldSlotCount;
+			}
+
+			vint WfCustomType::GetEventSlotCount()
+			{
+				return eventSlotCount;
+			}
+
 			void WfCustomType::AddBaseType(ITypeDescriptor* type)
 			{
 				TypeDescriptorImpl::AddBaseType(type);
@@ -5134,6 +6279,11 @@ WfCustomType
 
 			void WfCustomType::AddMember(Ptr<WfField> value)
 			{
+				if (auto classType = dynamic_cast<WfClass*>(this))
+				{
+					value->slotOwner = classType;
+					value->slotIndex = fieldSlotCount++;
+				}
 				AddProperty(value);
 			}
 
@@ -5144,6 +6294,12 @@ WfCustomType
 
 			void WfCustomType::AddMember(Ptr<WfEvent> value)
 			{
+				// only instances of classes have slots, events of interfaces are stored in internal properties
+				if (auto classType = dynamic_cast<WfClass*>(this))
+				{
+					value->slotOwner = classType;
+					value->slotIndex = eventSlotCount++;
+				}
 				AddEvent(value);
 			}
 
@@ -5151,6 +6307,44 @@ WfCustomType
 WfClass
 ***********************************************************************/
 
+			void WfClass::ComputeSlotLayout()
+			{
+				if (slotLayoutComputed) return;
+				slotLayoutComputed = true;
+
+				// fields and events of all Workflow base classes are stored in the same instance
+				// base classes are placed first in the same order as in their own instances,
+				// so with single inheritance every class is at its own offset in all derived classes
+				vint count = GetBaseTypeDescriptorCount();
+				for (vint i = 0; i < count; i++)
+				{
+					if (auto baseClass = dynamic_cast<WfClass*>(GetBaseTypeDescriptor(i)))
+					{
+						baseClass->ComputeSlotLayout();
+						FOREACH(WfClass*, layoutClass, baseClass->slotLayoutClasses)
+						{
+							if (!slotLayoutClasses.Contains(layoutClass))
+							{
+								slotLayoutClasses.Add(layoutClass);
+								fieldSlotOffsets.Add(layoutClass, instanceFieldSlotCount);
+								eventSlotOffsets.Add(layoutClass, instanceEventSlotCount);
+								compatibleSlotLayout &= layoutClass->ownFieldSlotOffset == instanceFieldSlotCount && layoutClass->ownEventSlotOffset == instanceEventSlotCount;
+								instanceFieldSlotCount += layoutClass->GetFieldSlotCount();
+								instanceEventSlotCount += layoutClass->GetEventSlotCount();
+							}
+						}
+					}
+				}
+
+				ownFieldSlotOffset = instanceFieldSlotCount;
+				ownEventSlotOffset = instanceEventSlotCount;
+				slotLayoutClasses.Add(this);
+				fieldSlotOffsets.Add(this, instanceFieldSlotCount);
+				eventSlotOffsets.Add(this, instanceEventSlotCount);
+				instanceFieldSlotCount += fieldSlotCount;
+				instanceEventSlotCount += eventSlotCount;
+			}
+
 			WfClass::WfClass(const WString& typeName)
 				:WfCustomType(TypeDescriptorFlags::Class, typeName)
 			{
@@ -5160,6 +6354,28 @@ WfClass
 			{
 			}
 
+			vint WfClass::GetInstanceFieldSlotCount()
+			{
+				return instanceFieldSlotCount;
+			}
+
+			vint WfClass::GetInstanceEventSlotCount()
+			{
+				return instanceEventSlotCount;
+			}
+
+			vint WfClass::GetFieldSlotOffset(WfClass* ownerType)
+			{
+				if (compatibleSlotLayout) return ownerType->ownFieldSlotOffset;
+				return fieldSlotOffsets[ownerType];
+			}
+
+			vint WfClass::GetEventSlotOffset(WfClass* ownerType)
+			{
+				if (compatibleSlotLayout) return ownerType->ownEventSlotOffset;
+				return eventSlotOffsets[ownerType];
+			}
+
 /***********************************************************************
 WfInterface
 ***********************************************************************/
@@ -5354,6 +6570,8 @@ WfClassInstance
 			{
 				classType = dynamic_cast<WfClass*>(_typeDescriptor);
 				InitializeAggregation(classType->GetExpandedBaseTypes().Count());
+				fieldSlots.Resize(classType->GetInstanceFieldSlotCount());
+				eventSlots.Resize(classType->GetInstanceEventSlotCount());
 			}
 
 			WfClassInstance::~WfClassInstance()
@@ -5445,6 +6663,14 @@ WfTypeImpl
 				{
 					td->SetGlobalContext(globalContext);
 				}
+				if (globalContext)
+				{
+					// slot layouts are ready before any instance is created, base classes from other assemblies are already loaded
+					FOREACH(Ptr<WfClass>, td, classes)
+					{
+						td->ComputeSlotLayout();
+					}
+				}
 				FOREACH(Ptr<WfInterface>, td, interfaces)
 				{
 					td->SetGlobalContext(globalContext);
@@ -5501,4 +6727,25 @@ WfTypeImpl
 			}
 		}
 	}
+
+	namespace reflection
+	{
+		using namespace workflow::typeimpl;
+
+/***********************************************************************
+Description<WfClassInstance>
+***********************************************************************/
+
+		Description<WfClassInstance>::Description(description::ITypeDescriptor* _associatedTypeDescriptor)
+		{
+			association.typeDescriptor = _associatedTypeDescriptor;
+			association.instance = static_cast<WfClassInstance*>(this);
+			typeDescriptor = &association.typeDescriptor;
+		}
+
+		WfClassInstance* Description<WfClassInstance>::GetAssociatedInstance(DescriptableObject* object)
+		{
+			return reinterpret_cast<Association*>(object->typeDescriptor)->instance;
+		}
+	}
 }
@@ -288,6 +288,7 @@ namespace vl
 	{
 		namespace typeimpl
 		{
+			class WfClass;
 			class WfClassInstance;
 			class WfInterfaceInstance;
 		}
@@ -295,24 +296,37 @@ namespace vl
 
 	namespace reflection
 	{
-#define DEFINE_DESCRIPTION(TYPE)\
-		template<>\
-		class Description<workflow::typeimpl::TYPE> : public virtual DescriptableObject\
-		{\
-		private:\
-			description::ITypeDescriptor*				associatedTypeDescriptor;\
-		public:\
-			Description(description::ITypeDescriptor* _associatedTypeDescriptor)\
-				:associatedTypeDescriptor(_associatedTypeDescriptor)\
-			{\
-				typeDescriptor = &associatedTypeDescriptor;\
-			}\
-		};\
-
-		DEFINE_DESCRIPTION(WfClassInstance)
-		DEFINE_DESCRIPTION(WfInterfaceInstance)
-
-#undef DEFINE_DESCRIPTION
+		template<>
+		class Description<workflow::typeimpl::WfClassInstance> : public virtual DescriptableObject
+		{
+		private:
+			struct Association
+			{
+				description::ITypeDescriptor*			typeDescriptor;
+				workflow::typeimpl::WfClassInstance*	instance;
+			};
+
+			Association									association;
+		public:
+			Description(description::ITypeDescriptor* _associatedTypeDescriptor);
+
+			// The type descriptor of an object points to the association, so the instance is found without a dynamic_cast
+			// the object must be a WfClassInstance, which is known when its type descriptor is a WfClass
+			static workflow::typeimpl::WfClassInstance*	GetAssociatedInstance(DescriptableObject* object);
+		};
+
+		template<>
+		class Description<workflow::typeimpl::WfInterfaceInstance> : public virtual DescriptableObject
+		{
+		private:
+			description::ITypeDescriptor*				associatedTypeDescriptor;
+		public:
+			Description(description::ITypeDescriptor* _associatedTypeDescriptor)
+				:associatedTypeDescriptor(_associatedTypeDescriptor)
+			{
+				typeDescriptor = &associatedTypeDescriptor;
+			}
+		};
 	}
 
 	namespace workflow
@@ -440,6 +454,8 @@ Event
 
 			class WfEvent : public reflection::description::EventInfoImpl
 			{
+				friend class WfCustomType;
+				friend class WfClassInstance;
 				typedef reflection::description::ITypeDescriptor			ITypeDescriptor;
 				typedef reflection::description::ITypeInfo					ITypeInfo;
 				typedef reflection::description::IEventHandler				IEventHandler;
@@ -473,6 +489,8 @@ Event
 
 				static const wchar_t*					EventRecordInternalPropertyName;
 			protected:
+				WfClass*								slotOwner = nullptr;
+				vint									slotIndex = -1;
 
 				Ptr<EventRecord>						GetEventRecord(DescriptableObject* thisObject, bool createIfNotExist);
 				Ptr<IEventHandler>						AttachInternal(DescriptableObject* thisObject, Ptr<IValueFunctionProxy> handler)override;
@@ -493,6 +511,7 @@ Field
 
 			class WfField : public reflection::description::FieldInfoImpl
 			{
+				friend class WfCustomType;
 				typedef reflection::description::ITypeDescriptor			ITypeDescriptor;
 				typedef reflection::description::ITypeInfo					ITypeInfo;
 				typedef reflection::description::Value						Value;
@@ -506,6 +525,8 @@ Field
 
 				static const wchar_t*					FieldRecordInternalPropertyName;
 			protected:
+				WfClass*								slotOwner = nullptr;
+				vint									slotIndex = -1;
 				
 				Ptr<FieldRecord>						GetFieldRecord(DescriptableObject* thisObject, bool createIfNotExist);
 				Value									GetValueInternal(const Value& thisObject)override;
@@ -588,6 +609,8 @@ Custom Type
 				runtime::WfRuntimeGlobalContext*		globalContext = nullptr;
 				bool									baseTypeExpanded = false;
 				TypeDescriptorList						expandedBaseTypes;
+				vint									fieldSlotCount = 0;
+				vint									eventSlotCount = 0;
 				
 				void									SetGlobalContext(runtime::WfRuntimeGlobalContext* _globalContext, IMethodGroupInfo* group);
 				void									SetGlobalContext(runtime::WfRuntimeGlobalContext* _globalContext);
@@ -598,6 +621,8 @@ Custom Type
 				
 				runtime::WfRuntimeGlobalContext*		GetGlobalContext();
 				const TypeDescriptorList&				GetExpandedBaseTypes();
+				vint									GetFieldSlotCount();
+				vint									GetEventSlotCount();
 
 				void									AddBaseType(ITypeDescriptor* type);
 				void									AddMember(const WString& name, Ptr<WfMethodBase> value);
@@ -611,11 +636,29 @@ Custom Type
 			class WfClass : public WfCustomType
 			{
 				friend class WfTypeImpl;
+				typedef collections::Dictionary<WfClass*, vint>				SlotOffsetMap;
+			protected:
+				bool									slotLayoutComputed = false;
+				collections::List<WfClass*>				slotLayoutClasses;
+				SlotOffsetMap							fieldSlotOffsets;
+				SlotOffsetMap							eventSlotOffsets;
+				vint									ownFieldSlotOffset = 0;
+				vint									ownEventSlotOffset = 0;
+				bool									compatibleSlotLayout = true;
+				vint									instanceFieldSlotCount = 0;
+				vint									instanceEventSlotCount = 0;
+
+				void									ComputeSlotLayout();
 			public:
 				vint									destructorFunctionIndex = -1;
 
 				WfClass(const WString& typeName);
 				~WfClass();
+
+				vint									GetInstanceFieldSlotCount();
+				vint									GetInstanceEventSlotCount();
+				vint									GetFieldSlotOffset(WfClass* ownerType);
+				vint									GetEventSlotOffset(WfClass* ownerType);
 			};
 
 			class WfInterface : public WfCustomType
@@ -717,10 +760,15 @@ Instance
 
 			class WfClassInstance : public Object, public reflection::Description<WfClassInstance>
 			{
+				friend class WfField;
+				friend class WfEvent;
 				typedef reflection::description::ITypeDescriptor			ITypeDescriptor;
 				typedef reflection::description::Value						Value;
+				typedef collections::List<Ptr<WfEvent::EventHandlerImpl>>	EventHandlerList;
 			protected:
 				WfClass*								classType = nullptr;
+				collections::Array<Value>				fieldSlots;
+				collections::Array<Ptr<EventHandlerList>>	eventSlots;
 
 			public:
 				WfClassInstance(ITypeDescriptor* _typeDescriptor);
@@ -859,9 +907,20 @@ Assembly
 				void												Initialize();
 			};
 
-			/// <summary>Representing a Workflow assembly.</summary>
+			/// <summary>
+			/// Representing a Workflow assembly.
+			/// An assembly deserialized from the compact binary format only decodes metadata at the beginning.
+			/// Instructions of a function are decoded when the function is called for the first time, debug informations are decoded when they are required by a debugger or a call stack.
+			/// </summary>
 			class WfAssembly : public Object, public reflection::Description<WfAssembly>
 			{
+			protected:
+				class LazyData;
+
+				Ptr<LazyData>										lazyData;
+
+				void												ReadCompact(stream::IStream& input);
+				void												WriteCompact(stream::IStream& output, bool includeDebugInfo);
 			public:
 				/// <summary>Debug informations using the module code.</summary>
 				Ptr<WfInstructionDebugInfo>							insBeforeCodegen;
@@ -873,7 +932,7 @@ Assembly
 				collections::Group<WString, vint>					functionByName;
 				/// <summary>Functions.</summary>
 				collections::List<Ptr<WfAssemblyFunction>>			functions;
-				/// <summary>Instructions.</summary>
+				/// <summary>Instructions. For an assembly deserialized from the compact binary format, it is empty until <see cref="LoadAllInstructions"/> is called, use <see cref="GetInstruction"/> instead.</summary>
 				collections::List<WfInstruction>					instructions;
 				/// <summary>Custom types.</summary>
 				Ptr<typeimpl::WfTypeImpl>							typeImpl;
@@ -885,9 +944,28 @@ Assembly
 				WfAssembly(stream::IStream& input);
 				
 				void												Initialize();
-				/// <summary>Serialize an assembly.</summary>
+				/// <summary>Serialize an assembly in the compact binary format.</summary>
+				/// <param name="output">Serialized binary data.</param>
+				/// <param name="includeDebugInfo">Set to false to skip <see cref="insBeforeCodegen"/> and <see cref="insAfterCodegen"/>. Call stacks and debuggers will not be able to map instructions to code.</param>
+				void												Serialize(stream::IStream& output, bool includeDebugInfo = true);
+				/// <summary>Serialize an assembly in the previous binary format, which is fully decoded at loading.</summary>
 				/// <param name="output">Serialized binary data.</param>
-				void												Serialize(stream::IStream& output);
+				void												SerializeLegacy(stream::IStream& output);
+
+				/// <summary>Decode instructions of a function if they are not decoded yet.</summary>
+				/// <param name="functionIndex">The index of the function in <see cref="functions"/>.</param>
+				void												LoadFunctionInstructions(vint functionIndex);
+				/// <summary>Decode all instructions that are not decoded yet and fill <see cref="instructions"/>.</summary>
+				void												LoadAllInstructions();
+				/// <summary>Decode <see cref="insBeforeCodegen"/> and <see cref="insAfterCodegen"/> if they are not decoded yet.</summary>
+				void												LoadDebugInfo();
+				/// <summary>Get the number of instructions, including instructions that are not decoded yet.</summary>
+				/// <returns>The number of instructions.</returns>
+				vint												GetInstructionCount();
+				/// <summary>Get an instruction. Only instructions of the function that contains it are decoded.</summary>
+				/// <returns>The instruction.</returns>
+				/// <param name="index">The index of the instruction.</param>
+				WfInstruction&										GetInstruction(vint index);
 			};
 		}
 	}
@@ -1436,17 +1514,36 @@ RuntimeEnvironment
 				VariableArray					variables;
 			};
 
+			/// <summary>A pre-decoded instruction for the fast execution path, which is used when no debugger callback is attached.</summary>
+			struct WfRuntimeDecodedInstruction
+			{
+				WfInsCode						code = WfInsCode::Nop;
+				vint							indexParameter = -1;
+				vint							countParameter = 0;
+				WfInstruction*					instruction = nullptr;
+				Ptr<reflection::description::MethodCallSiteCache>	callSiteCache;
+			};
+
 			/// <summary>Global context for executing a Workflow program. After the context is prepared, use [M:vl.workflow.runtime.LoadFunction] to call any functions inside the assembly. Function "&lt;initialize&gt;" should be the first to execute.</summary>
 			class WfRuntimeGlobalContext : public Object, public reflection::Description<WfRuntimeGlobalContext>
 			{
+			protected:
+				collections::Array<std::atomic<bool>>	preparedFunctions;
+				SpinLock						prepareLock;
+
 			public:
 				Ptr<WfAssembly>					assembly;
 				Ptr<WfRuntimeVariableContext>	globalVariables;
+				collections::Array<WfRuntimeDecodedInstruction>	decodedInstructions;
 				
 				/// <summary>Create a global context for executing a Workflow program.</summary>
 				/// <param name="_assembly">The assembly.</param>
 				WfRuntimeGlobalContext(Ptr<WfAssembly> _assembly);
 				~WfRuntimeGlobalContext();
+
+				/// <summary>Decode instructions of a function for execution. It is called before a function is called.</summary>
+				/// <param name="functionIndex">The index of the function.</param>
+				void							PrepareFunction(vint functionIndex);
 			};
 
 			struct WfRuntimeStackFrame
@@ -1629,6 +1726,10 @@ RuntimeThreadContext
 				typedef collections::List<reflection::description::Value>		VariableList;
 				typedef collections::List<WfRuntimeStackFrame>					StackFrameList;
 				typedef collections::List<WfRuntimeTrapFrame>					TrapFrameList;
+				typedef collections::Array<reflection::description::Value>		ArgumentArray;
+				static const vint				SmallArgumentCount = reflection::description::MethodCallSiteCache::MaxArgumentCount + 1;
+			protected:
+				ArgumentArray					smallArguments[SmallArgumentCount];		// reused argument arrays for invoking methods, indexed by the argument count
 			public:
 
 				Ptr<WfRuntimeGlobalContext>		globalContext;
@@ -1662,6 +1763,7 @@ RuntimeThreadContext
 
 				WfRuntimeExecutionAction		ExecuteInternal(WfInstruction& ins, WfRuntimeStackFrame& stackFrame, IWfDebuggerCallback* callback);
 				WfRuntimeExecutionAction		Execute(IWfDebuggerCallback* callback);
+				WfRuntimeExecutionAction		ExecuteFast();
 				void							ExecuteToEnd();
 			};
 
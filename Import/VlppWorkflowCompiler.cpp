@@ -177,6 +177,37 @@ WfLexicalScopeName
 				declarations.Clear();
 			}
 
+			void WfLexicalScopeName::ResetNonTypeDescriptorNames(WfLexicalScopeManager* manager)
+			{
+				FOREACH(Ptr<WfLexicalScopeName>, name, children.Values())
+				{
+					name->ResetNonTypeDescriptorNames(manager);
+				}
+
+				if (!imported && typeDescriptor)
+				{
+					manager->typeNames.Remove(typeDescriptor);
+					typeDescriptor = nullptr;
+				}
+				declarations.Clear();
+			}
+
+			void WfLexicalScopeName::RemoveEmptyNames()
+			{
+				for (vint i = children.Count() - 1; i >= 0; i--)
+				{
+					auto subScopeName = children.Values()[i];
+					if (!subScopeName->imported && subScopeName->declarations.Count() == 0)
+					{
+						children.Remove(children.Keys()[i]);
+					}
+					else
+					{
+						subScopeName->RemoveEmptyNames();
+					}
+				}
+			}
+
 			WString WfLexicalScopeName::GetFriendlyName()
 			{
 				if (parent)
@@ -372,6 +403,214 @@ ResolveExpressionResult
 				return !(*this == result);
 			}
 
+/***********************************************************************
+WfLexicalScopeManager::IncrementalState
+***********************************************************************/
+
+			void AddIncrementalName(SortedList<WString>& names, const WString& name)
+			{
+				if (name != L"" && !names.Contains(name))
+				{
+					names.Add(name);
+				}
+			}
+
+			void CollectDeclaredNames(WfDeclaration* declaration, SortedList<WString>& names, SortedList<WString>& namespaceNames)
+			{
+				if (auto nsDecl = dynamic_cast<WfNamespaceDeclaration*>(declaration))
+				{
+					AddIncrementalName(namespaceNames, declaration->name.value);
+					FOREACH(Ptr<WfDeclaration>, subDecl, nsDecl->declarations)
+					{
+						CollectDeclaredNames(subDecl.Obj(), names, namespaceNames);
+					}
+					return;
+				}
+
+				AddIncrementalName(names, declaration->name.value);
+				if (auto classDecl = dynamic_cast<WfClassDeclaration*>(declaration))
+				{
+					FOREACH(Ptr<WfClassMember>, member, classDecl->members)
+					{
+						CollectDeclaredNames(member->declaration.Obj(), names, namespaceNames);
+					}
+				}
+				else if (auto enumDecl = dynamic_cast<WfEnumDeclaration*>(declaration))
+				{
+					FOREACH(Ptr<WfEnumItem>, item, enumDecl->items)
+					{
+						AddIncrementalName(names, item->name.value);
+					}
+				}
+				else if (auto structDecl = dynamic_cast<WfStructDeclaration*>(declaration))
+				{
+					FOREACH(Ptr<WfStructMember>, member, structDecl->members)
+					{
+						AddIncrementalName(names, member->name.value);
+					}
+				}
+			}
+
+			void CollectReferencedNames(const WString& code, SortedList<WString>& names)
+			{
+				// every identifier is counted, including those in strings and comments, which only makes more modules re-analyzed
+				auto reading = code.Buffer();
+				while (*reading)
+				{
+					auto begin = reading;
+					while ((L'a' <= *reading && *reading <= L'z') || (L'A' <= *reading && *reading <= L'Z') || *reading == L'_' || (reading != begin && L'0' <= *reading && *reading <= L'9'))
+					{
+						reading++;
+					}
+
+					if (reading == begin)
+					{
+						reading++;
+					}
+					else
+					{
+						AddIncrementalName(names, WString(begin, (vint)(reading - begin)));
+					}
+				}
+			}
+
+			void AddIncrementalNames(SortedList<WString>& changedNames, SortedList<WString>& names, SortedList<WString>* excludedNames = nullptr)
+			{
+				FOREACH(WString, name, names)
+				{
+					if (!excludedNames || !excludedNames->Contains(name))
+					{
+						AddIncrementalName(changedNames, name);
+					}
+				}
+			}
+
+			bool HasIncrementalNames(SortedList<WString>& names, SortedList<WString>& changedNames)
+			{
+				FOREACH(WString, name, names)
+				{
+					if (changedNames.Contains(name))
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			class WfLexicalScopeManager::IncrementalState : public Object
+			{
+			public:
+				class AnalyzedModule : public Object
+				{
+				public:
+					Ptr<WfModule>							module;
+					vint									codeIndex = -1;
+					WString									code;				// source code, or the printed syntax tree
+					SortedList<WString>						declaredNames;		// names of all declarations and members in this module, except namespaces
+					SortedList<WString>						namespaceNames;		// names of all namespaces in this module
+					SortedList<WString>						referencedNames;	// all identifiers in this module
+				};
+
+				List<Ptr<AnalyzedModule>>					modules;
+				bool										scheduleBindings = false;
+				bool										resultsCopied = false;
+
+				NodeScopeMap								nodeScopes;
+				ExpressionResolvingMap						expressionResolvings;
+				LambdaCaptureMap							lambdaCaptures;
+				InterfaceMethodImplementationMap			interfaceMethodImpls;
+				DeclarationTypeMap							declarationTypes;
+				DeclarationMemberInfoMap					declarationMemberInfos;
+				BaseConstructorCallResolvingMap				baseConstructorCallResolvings;
+
+				void CollectModules(WfLexicalScopeManager* manager)
+				{
+					scheduleBindings = manager->scheduleBindings;
+					FOREACH_INDEXER(Ptr<WfModule>, module, index, manager->modules)
+					{
+						auto analyzedModule = MakePtr<AnalyzedModule>();
+						analyzedModule->module = module;
+						analyzedModule->codeIndex = module->codeRange.codeIndex;
+						analyzedModule->code = manager->moduleCodes[index];
+						if (analyzedModule->code == L"")
+						{
+							stream::MemoryStream stream;
+							{
+								stream::StreamWriter writer(stream);
+								WfPrint(module, L"", writer);
+							}
+							stream.SeekFromBegin(0);
+							stream::StreamReader reader(stream);
+							analyzedModule->code = reader.ReadToEnd();
+						}
+
+						FOREACH(Ptr<WfDeclaration>, declaration, module->declarations)
+						{
+							CollectDeclaredNames(declaration.Obj(), analyzedModule->declaredNames, analyzedModule->namespaceNames);
+						}
+						CollectReferencedNames(analyzedModule->code, analyzedModule->referencedNames);
+						modules.Add(analyzedModule);
+					}
+				}
+
+				void CopyResults(WfLexicalScopeManager* manager)
+				{
+					resultsCopied = true;
+					CopyFrom(nodeScopes, manager->nodeScopes);
+					CopyFrom(expressionResolvings, manager->expressionResolvings);
+					CopyFrom(lambdaCaptures, manager->lambdaCaptures);
+					CopyFrom(interfaceMethodImpls, manager->interfaceMethodImpls);
+					CopyFrom(declarationTypes, manager->declarationTypes);
+					CopyFrom(declarationMemberInfos, manager->declarationMemberInfos);
+					CopyFrom(baseConstructorCallResolvings, manager->baseConstructorCallResolvings);
+				}
+
+				WfModule* GetOwnerModule(ParsingTreeCustomBase* node)
+				{
+					vint index = nodeScopes.Keys().IndexOf(node);
+					if (index == -1)
+					{
+						return nullptr;
+					}
+
+					auto scope = nodeScopes.Values()[index].Obj();
+					while (scope->parentScope)
+					{
+						scope = scope->parentScope.Obj();
+					}
+					return dynamic_cast<WfModule*>(scope->ownerNode.Obj());
+				}
+
+				template<typename TMap, typename TGetNode>
+				bool RestoreResults(TMap& from, TMap& to, SortedList<WfModule*>& keptModules, const TGetNode& getNode)
+				{
+					for (vint i = 0; i < from.Count(); i++)
+					{
+						auto owner = GetOwnerModule(getNode(from.Keys()[i]));
+						if (!owner)
+						{
+							return false;
+						}
+						if (keptModules.Contains(owner))
+						{
+							to.Add(from.Keys()[i], from.Values()[i]);
+						}
+					}
+					return true;
+				}
+
+				bool RestoreResults(WfLexicalScopeManager* manager, SortedList<WfModule*>& keptModules)
+				{
+					return RestoreResults(nodeScopes, manager->nodeScopes, keptModules, [](ParsingTreeCustomBase* node) { return node; })
+						&& RestoreResults(expressionResolvings, manager->expressionResolvings, keptModules, [](const Ptr<WfExpression>& node) { return node.Obj(); })
+						&& RestoreResults(lambdaCaptures, manager->lambdaCaptures, keptModules, [](ParsingTreeCustomBase* node) { return node; })
+						&& RestoreResults(interfaceMethodImpls, manager->interfaceMethodImpls, keptModules, [](WfFunctionDeclaration* node) { return node; })
+						&& RestoreResults(declarationTypes, manager->declarationTypes, keptModules, [](const Ptr<WfDeclaration>& node) { return node.Obj(); })
+						&& RestoreResults(declarationMemberInfos, manager->declarationMemberInfos, keptModules, [](const Ptr<WfDeclaration>& node) { return node.Obj(); })
+						&& RestoreResults(baseConstructorCallResolvings, manager->baseConstructorCallResolvings, keptModules, [](const BaseConstructorCallKey& key) { return key.key; });
+				}
+			};
+
 /***********************************************************************
 WfLexicalScopeManager
 ***********************************************************************/
@@ -420,11 +659,28 @@ WfLexicalScopeManager
 
 			void WfLexicalScopeManager::Clear(bool keepTypeDescriptorNames, bool deleteModules)
 			{
+				if (!keepTypeDescriptorNames)
+				{
+					incrementalState = nullptr;
+				}
+				else if (incrementalState && !incrementalState->resultsCopied)
+				{
+					incrementalState->CopyResults(this);
+				}
+
 				if (globalName)
 				{
 					if (keepTypeDescriptorNames)
 					{
-						globalName->RemoveNonTypeDescriptorNames(this);
+						if (incrementalState)
+						{
+							// names are kept for results to reuse, empty names are removed after building global names
+							globalName->ResetNonTypeDescriptorNames(this);
+						}
+						else
+						{
+							globalName->RemoveNonTypeDescriptorNames(this);
+						}
 					}
 					else
 					{
@@ -454,8 +710,166 @@ WfLexicalScopeManager
 				attributeValues.Clear();
 			}
 
-			void WfLexicalScopeManager::Rebuild(bool keepTypeDescriptorNames)
+			bool WfLexicalScopeManager::RebuildIncrementally(Ptr<IncrementalState> currentState)
+			{
+				auto previousState = incrementalState;
+				if (!previousState->resultsCopied)
+				{
+					return false;
+				}
+				if (previousState->scheduleBindings != currentState->scheduleBindings)
+				{
+					// bind expressions in kept modules were expanded with the other option
+					return false;
+				}
+
+				Dictionary<vint, Ptr<IncrementalState::AnalyzedModule>> previousModules;
+				FOREACH(Ptr<IncrementalState::AnalyzedModule>, previousModule, previousState->modules)
+				{
+					if (previousModule->codeIndex != -1 && !previousModules.Keys().Contains(previousModule->codeIndex))
+					{
+						previousModules.Add(previousModule->codeIndex, previousModule);
+					}
+				}
+
+				// a module is changed if its code is changed, it depends on changed modules if it refers to any name declared in them
+				// a namespace is changed only if it appears or disappears in all modules, because names for namespaces are kept
+				vint count = modules.Count();
+				Array<Ptr<IncrementalState::AnalyzedModule>> keptModules(count);
+				SortedList<IncrementalState::AnalyzedModule*> matchedModules;
+				SortedList<WString> changedNames, previousNamespaceNames, currentNamespaceNames;
+
+				for (vint i = 0; i < count; i++)
+				{
+					auto currentModule = currentState->modules[i];
+					AddIncrementalNames(currentNamespaceNames, currentModule->namespaceNames);
+					vint index = previousModules.Keys().IndexOf(currentModule->codeIndex);
+					if (index != -1 && previousModules.Values()[index]->code == currentModule->code)
+					{
+						keptModules[i] = previousModules.Values()[index];
+						matchedModules.Add(keptModules[i].Obj());
+					}
+					else
+					{
+						AddIncrementalNames(changedNames, currentModule->declaredNames);
+						if (index != -1)
+						{
+							auto previousModule = previousModules.Values()[index];
+							matchedModules.Add(previousModule.Obj());
+							AddIncrementalNames(changedNames, previousModule->declaredNames);
+						}
+					}
+				}
+
+				FOREACH(Ptr<IncrementalState::AnalyzedModule>, previousModule, previousState->modules)
+				{
+					AddIncrementalNames(previousNamespaceNames, previousModule->namespaceNames);
+					if (!matchedModules.Contains(previousModule.Obj()))
+					{
+						AddIncrementalNames(changedNames, previousModule->declaredNames);
+					}
+				}
+				AddIncrementalNames(changedNames, currentNamespaceNames, &previousNamespaceNames);
+				AddIncrementalNames(changedNames, previousNamespaceNames, &currentNamespaceNames);
+
+				while (true)
+				{
+					bool modified = false;
+					for (vint i = 0; i < count; i++)
+					{
+						if (keptModules[i] && HasIncrementalNames(keptModules[i]->referencedNames, changedNames))
+						{
+							// types in re-analyzed modules are created again, so names from them are also changed
+							keptModules[i] = nullptr;
+							AddIncrementalNames(changedNames, currentState->modules[i]->declaredNames);
+							modified = true;
+						}
+					}
+					if (!modified) break;
+				}
+
+				// syntax trees that are analyzed before are used for modules that keep their results
+				List<Ptr<WfModule>> originalModules;
+				CopyFrom(originalModules, modules);
+				SortedList<WfModule*> keptModuleNodes;
+				for (vint i = 0; i < count; i++)
+				{
+					if (keptModules[i])
+					{
+						modules[i] = keptModules[i]->module;
+						currentState->modules[i]->module = keptModules[i]->module;
+						keptModuleNodes.Add(keptModules[i]->module.Obj());
+					}
+				}
+
+				auto restoreModules = [&]()
+				{
+					for (vint i = 0; i < count; i++)
+					{
+						modules[i] = originalModules[i];
+						currentState->modules[i]->module = originalModules[i];
+					}
+					return false;
+				};
+
+				if (!previousState->RestoreResults(this, keptModuleNodes))
+				{
+					return restoreModules();
+				}
+
+				for (vint i = 0; i < count; i++)
+				{
+					if (!keptModules[i])
+					{
+						ValidateModuleStructure(this, modules[i]);
+					}
+				}
+				if (errors.Count() > 0) return restoreModules();
+
+				BuildGlobalNameFromModules(this);
+				globalName->RemoveEmptyNames();
+				for (vint i = 0; i < count; i++)
+				{
+					if (!keptModules[i])
+					{
+						BuildScopeForModule(this, modules[i]);
+					}
+				}
+				ValidateScopeName(this, globalName);
+				CheckScopes_DuplicatedSymbol(this);
+				if (errors.Count() > 0) return restoreModules();
+
+				for (vint i = 0; i < count; i++)
+				{
+					if (!keptModules[i])
+					{
+						CompleteScopeForModule(this, modules[i]);
+					}
+				}
+				CheckScopes_BaseType(this);
+				CheckScopes_SymbolType(this);
+				if (errors.Count() > 0) return restoreModules();
+
+				for (vint i = 0; i < count; i++)
+				{
+					if (!keptModules[i])
+					{
+						ValidateModuleSemantic(this, modules[i]);
+					}
+				}
+				if (errors.Count() > 0) return restoreModules();
+				return true;
+			}
+
+			void WfLexicalScopeManager::Rebuild(bool keepTypeDescriptorNames, bool incremental)
 			{
+				Ptr<IncrementalState> currentState;
+				if (incremental)
+				{
+					currentState = new IncrementalState;
+					currentState->CollectModules(this);
+				}
+
 				Clear(keepTypeDescriptorNames, false);
 				if (!globalName)
 				{
@@ -463,6 +877,19 @@ WfLexicalScopeManager
 					BuildGlobalNameFromTypeDescriptors(this);
 				}
 
+				if (incrementalState)
+				{
+					if (currentState && RebuildIncrementally(currentState))
+					{
+						incrementalState = currentState;
+						return;
+					}
+
+					// results could not be reused, analyze all modules again
+					incrementalState = nullptr;
+					Clear(keepTypeDescriptorNames, false);
+				}
+
 				vint errorCount = errors.Count();
 
 #define EXIT_IF_ERRORS_EXIST\
@@ -479,6 +906,7 @@ WfLexicalScopeManager
 				
 				EXIT_IF_ERRORS_EXIST;
 				BuildGlobalNameFromModules(this);
+				globalName->RemoveEmptyNames();
 				FOREACH(Ptr<WfModule>, module, modules)
 				{
 					BuildScopeForModule(this, module);
@@ -500,6 +928,8 @@ WfLexicalScopeManager
 					ValidateModuleSemantic(this, module);
 				}
 
+				EXIT_IF_ERRORS_EXIST;
+				incrementalState = currentState;
 #undef EXIT_IF_ERRORS_EXIST
 			}
 
@@ -850,11 +1280,10 @@ WfLexicalScopeManager
 				auto typeInfo = attributes[{att->category.value, att->name.value}];
 				GenerateExpressionInstructions(context, att->value, typeInfo);
 				attributeAssembly->instructions.Add(WfInstruction::Return());
+				attributeAssembly->functions[0]->lastInstruction = attributeAssembly->instructions.Count() - 1;
 
-				if (!attributeGlobalContext)
-				{
-					attributeGlobalContext = MakePtr<WfRuntimeGlobalContext>(attributeAssembly);
-				}
+				// instructions are decoded by the global context, so it is created again for new instructions
+				attributeGlobalContext = MakePtr<WfRuntimeGlobalContext>(attributeAssembly);
 				auto func = LoadFunction<Value()>(attributeGlobalContext, L"<get-attribute-value>");
 				auto value = func();
 				attributeValues.Add(att, value);
@@ -1062,6 +1491,7 @@ BuildGlobalNameFromModules
 				Ptr<WfClassDeclaration>			classDecl;
 				Ptr<WfCustomType>				td;
 				Ptr<WfClassMember>				member;
+				bool							reused = false;
 
 				BuildClassMemberVisitor(WfLexicalScopeManager* _manager, Ptr<WfLexicalScopeName> _scopeName, Ptr<WfClassDeclaration> _classDecl, Ptr<WfCustomType> _td, Ptr<WfClassMember> _member)
 					:manager(_manager)
@@ -1086,9 +1516,19 @@ BuildGlobalNameFromModules
 					return typeName;
 				}
 
+				static Ptr<ITypeDescriptor> GetReusedType(WfLexicalScopeManager* manager, Ptr<WfDeclaration> declaration)
+				{
+					// types of modules that are not changed are kept in incremental rebuilding, with all members
+					vint index = manager->declarationTypes.Keys().IndexOf(declaration.Obj());
+					return index == -1 ? nullptr : manager->declarationTypes.Values()[index];
+				}
+
 				static void AddCustomType(WfLexicalScopeManager* manager, Ptr<WfLexicalScopeName> scopeName, Ptr<WfDeclaration> declaration, Ptr<ITypeDescriptor> td)
 				{
-					manager->declarationTypes.Add(declaration, td);
+					if (!manager->declarationTypes.Keys().Contains(declaration.Obj()))
+					{
+						manager->declarationTypes.Add(declaration, td);
+					}
 
 					if (!scopeName->typeDescriptor)
 					{
@@ -1100,21 +1540,26 @@ BuildGlobalNameFromModules
 				static void BuildClass(WfLexicalScopeManager* manager, Ptr<WfLexicalScopeName> scopeName, Ptr<WfClassDeclaration> declaration)
 				{
 					WString typeName = GetTypeName(manager, scopeName);
-					Ptr<WfCustomType> td;
-					switch (declaration->kind)
+					Ptr<WfCustomType> td = GetReusedType(manager, declaration).Cast<WfCustomType>();
+					bool reused = td;
+					if (!reused)
 					{
-					case WfClassKind::Class:
-						td = MakePtr<WfClass>(typeName);
-						break;
-					case WfClassKind::Interface:
-						td = MakePtr<WfInterface>(typeName);
-						break;
+						switch (declaration->kind)
+						{
+						case WfClassKind::Class:
+							td = MakePtr<WfClass>(typeName);
+							break;
+						case WfClassKind::Interface:
+							td = MakePtr<WfInterface>(typeName);
+							break;
+						}
 					}
 					AddCustomType(manager, scopeName, declaration, td);
 
 					FOREACH(Ptr<WfClassMember>, member, declaration->members)
 					{
 						BuildClassMemberVisitor visitor(manager, scopeName, declaration, td, member);
+						visitor.reused = reused;
 						member->declaration->Accept(&visitor);
 					}
 				}
@@ -1125,6 +1570,7 @@ BuildGlobalNameFromModules
 
 				void Visit(WfFunctionDeclaration* node)override
 				{
+					if (reused) return;
 					if (member->kind == WfClassMemberKind::Static)
 					{
 						auto info = MakePtr<WfStaticMethod>();
@@ -1155,6 +1601,7 @@ BuildGlobalNameFromModules
 
 				void Visit(WfVariableDeclaration* node)override
 				{
+					if (reused) return;
 					auto info = MakePtr<WfField>(td.Obj(), node->name.value);
 					td->AddMember(info);
 					manager->declarationMemberInfos.Add(node, info);
@@ -1162,6 +1609,7 @@ BuildGlobalNameFromModules
 
 				void Visit(WfEventDeclaration* node)override
 				{
+					if (reused) return;
 					auto info = MakePtr<WfEvent>(td.Obj(), node->name.value);
 					td->AddMember(info);
 					manager->declarationMemberInfos.Add(node, info);
@@ -1169,6 +1617,7 @@ BuildGlobalNameFromModules
 
 				void Visit(WfPropertyDeclaration* node)override
 				{
+					if (reused) return;
 					auto info = MakePtr<WfProperty>(td.Obj(), node->name.value);
 					td->AddMember(info);
 					manager->declarationMemberInfos.Add(node, info);
@@ -1176,6 +1625,7 @@ BuildGlobalNameFromModules
 
 				void Visit(WfConstructorDeclaration* node)override
 				{
+					if (reused) return;
 					Ptr<ITypeInfo> typeInfo;
 					{
 						auto elementType = MakePtr<TypeDescriptorTypeInfo>(td.Obj(), TypeInfoHint::Normal);
@@ -1268,13 +1718,21 @@ BuildGlobalNameFromModules
 
 				void Visit(WfEnumDeclaration* node)override
 				{
-					auto td = MakePtr<WfEnum>(node->kind == WfEnumKind::Flag, BuildClassMemberVisitor::GetTypeName(manager, scopeName));
+					auto td = BuildClassMemberVisitor::GetReusedType(manager, node);
+					if (!td)
+					{
+						td = MakePtr<WfEnum>(node->kind == WfEnumKind::Flag, BuildClassMemberVisitor::GetTypeName(manager, scopeName));
+					}
 					BuildClassMemberVisitor::AddCustomType(manager, scopeName, node, td);
 				}
 
 				void Visit(WfStructDeclaration* node)override
 				{
-					auto td = MakePtr<WfStruct>(BuildClassMemberVisitor::GetTypeName(manager, scopeName));
+					auto td = BuildClassMemberVisitor::GetReusedType(manager, node);
+					if (!td)
+					{
+						td = MakePtr<WfStruct>(BuildClassMemberVisitor::GetTypeName(manager, scopeName));
+					}
 					BuildClassMemberVisitor::AddCustomType(manager, scopeName, node, td);
 				}
 			};
@@ -3631,137 +4089,596 @@ GenerateAssembly
 				WfCodegenContext context(assembly, manager);
 				FOREACH_INDEXER(Ptr<WfModule>, module, index, manager->GetModules())
 				{
-					auto codeBeforeCodegen = manager->GetModuleCodes()[index];
+					auto codeBeforeCodegen = manager->GetModuleCodes()[index];
+
+					auto recorderBefore = new ParsingGeneratedLocationRecorder(context.nodePositionsBeforeCodegen);
+					auto recorderAfter = new ParsingGeneratedLocationRecorder(context.nodePositionsAfterCodegen);
+					auto recorderOriginal = new ParsingOriginalLocationRecorder(recorderBefore);
+					auto recorderMultiple = new ParsingMultiplePrintNodeRecorder;
+					recorderMultiple->AddRecorder(recorderOriginal);
+					recorderMultiple->AddRecorder(recorderAfter);
+
+					stream::MemoryStream memoryStream;
+					{
+						stream::StreamWriter streamWriter(memoryStream);
+						ParsingWriter parsingWriter(streamWriter, recorderMultiple, index);
+						WfPrint(module, L"", parsingWriter);
+					}
+
+					memoryStream.SeekFromBegin(0);
+					auto codeAfterCodegen = stream::StreamReader(memoryStream).ReadToEnd();
+
+					assembly->insBeforeCodegen->moduleCodes.Add(codeBeforeCodegen);
+					assembly->insAfterCodegen->moduleCodes.Add(codeAfterCodegen);
+				}
+
+				if (manager->declarationTypes.Count() > 0)
+				{
+					assembly->typeImpl = new WfTypeImpl;
+					FOREACH(Ptr<ITypeDescriptor>, td, manager->declarationTypes.Values())
+					{
+						if (auto tdClass = td.Cast<WfClass>())
+						{
+							assembly->typeImpl->classes.Add(tdClass);
+						}
+						else if (auto tdInterface = td.Cast<WfInterface>())
+						{
+							assembly->typeImpl->interfaces.Add(tdInterface);
+						}
+						else if (auto tdStruct = td.Cast<WfStruct>())
+						{
+							assembly->typeImpl->structs.Add(tdStruct);
+						}
+						else if (auto tdEnum = td.Cast<WfEnum>())
+						{
+							assembly->typeImpl->enums.Add(tdEnum);
+						}
+					}
+				}
+
+				FOREACH(Ptr<WfModule>, module, manager->GetModules())
+				{
+					FOREACH(Ptr<WfDeclaration>, decl, module->declarations)
+					{
+						GenerateGlobalDeclarationMetadata(context, decl);
+					}
+				}
+
+				{
+					auto meta = MakePtr<WfAssemblyFunction>();
+					meta->name = L"<initialize>";
+					vint functionIndex = assembly->functions.Add(meta);
+					assembly->functionByName.Add(meta->name, functionIndex);
+
+					auto functionContext = MakePtr<WfCodegenFunctionContext>();
+					functionContext->function = meta;
+					context.functionContext = functionContext;
+					
+					meta->firstInstruction = assembly->instructions.Count();
+					FOREACH(Ptr<WfModule>, module, manager->GetModules())
+					{
+						FOREACH(Ptr<WfDeclaration>, decl, module->declarations)
+						{
+							GenerateInitializeInstructions(context, decl);
+						}
+					}
+
+					// define node for INSTRUCTION
+					parsing::ParsingTreeCustomBase* node = nullptr;
+					INSTRUCTION(Ins::LoadValue(Value()));
+					INSTRUCTION(Ins::Return());
+
+					meta->lastInstruction = assembly->instructions.Count() - 1;
+
+					context.functionContext = 0;
+					GenerateClosureInstructions(context, functionContext);
+				}
+
+				FOREACH(Ptr<WfModule>, module, manager->GetModules())
+				{
+					FOREACH(Ptr<WfDeclaration>, decl, module->declarations)
+					{
+						GenerateDeclarationInstructions(context, decl);
+					}
+				}
+
+				assembly->Initialize();
+				return assembly;
+			}
+
+#undef INSTRUCTION
+
+/***********************************************************************
+Compile
+***********************************************************************/
+
+			Ptr<runtime::WfAssembly> Compile(Ptr<parsing::tabling::ParsingTable> table, WfLexicalScopeManager* manager, collections::List<WString>& moduleCodes, collections::List<Ptr<parsing::ParsingError>>& errors)
+			{
+				manager->Clear(true, true);
+				FOREACH(WString, code, moduleCodes)
+				{
+					manager->AddModule(code);
+				}
+
+				if (manager->errors.Count() > 0)
+				{
+					CopyFrom(errors, manager->errors);
+					return 0;
+				}
+
+				manager->Rebuild(true);
+				if (manager->errors.Count() > 0)
+				{
+					CopyFrom(errors, manager->errors);
+					return 0;
+				}
+
+				return GenerateAssembly(manager);
+			}
+
+			Ptr<runtime::WfAssembly> Compile(Ptr<parsing::tabling::ParsingTable> table, collections::List<WString>& moduleCodes, collections::List<Ptr<parsing::ParsingError>>& errors)
+			{
+				WfLexicalScopeManager manager(table);
+				return Compile(table, &manager, moduleCodes, errors);
+			}
+
+/***********************************************************************
+OptimizeAssembly
+***********************************************************************/
+
+			class WfAssemblyOptimizer : public Object
+			{
+			protected:
+				WfAssembly*							assembly;
+				collections::Array<bool>			removed;
+				collections::Array<bool>			targets;
+
+				static bool IsLabel(WfInsCode code)
+				{
+					return code == WfInsCode::Jump || code == WfInsCode::JumpIf || code == WfInsCode::InstallTry;
+				}
+
+				static bool IsPurePush(WfInsCode code)
+				{
+					switch (code)
+					{
+					case WfInsCode::LoadValue:
+					case WfInsCode::LoadFunction:
+					case WfInsCode::LoadException:
+					case WfInsCode::LoadLocalVar:
+					case WfInsCode::LoadCapturedVar:
+					case WfInsCode::LoadGlobalVar:
+					case WfInsCode::LoadClosureContext:
+					case WfInsCode::Duplicate:
+						return true;
+					default:
+						return false;
+					}
+				}
+
+				static bool IsStore(WfInsCode code)
+				{
+					return code == WfInsCode::StoreLocalVar || code == WfInsCode::StoreCapturedVar || code == WfInsCode::StoreGlobalVar;
+				}
+
+				template<typename T>
+				static bool UnboxConstant(const WfInstruction& ins, T& value)
+				{
+					if (ins.code == WfInsCode::LoadValue && ins.valueParameter.GetTypeDescriptor() == GetTypeDescriptor<T>())
+					{
+						value = UnboxValue<T>(ins.valueParameter);
+						return true;
+					}
+					return false;
+				}
+
+				template<typename T>
+				static bool FoldUnary(const WfInstruction& operand, WfInsCode code, Value& result)
+				{
+					T value;
+					if (!UnboxConstant(operand, value)) return false;
+					switch (code)
+					{
+					case WfInsCode::OpNot:		result = BoxValue<T>(~value); return true;
+					case WfInsCode::OpPositive:	result = BoxValue<T>(+value); return true;
+					case WfInsCode::OpNegative:	result = BoxValue<T>(-value); return true;
+					default:					return false;
+					}
+				}
+
+				template<typename T>
+				static bool FoldBinary(const WfInstruction& first, const WfInstruction& second, WfInsCode code, Value& result)
+				{
+					T a, b;
+					if (!UnboxConstant(first, a) || !UnboxConstant(second, b)) return false;
+					switch (code)
+					{
+					case WfInsCode::OpAdd:		result = BoxValue<T>(a + b); return true;
+					case WfInsCode::OpSub:		result = BoxValue<T>(a - b); return true;
+					case WfInsCode::OpMul:		result = BoxValue<T>(a * b); return true;
+					default:					return false;
+					}
+				}
 
-					auto recorderBefore = new ParsingGeneratedLocationRecorder(context.nodePositionsBeforeCodegen);
-					auto recorderAfter = new ParsingGeneratedLocationRecorder(context.nodePositionsAfterCodegen);
-					auto recorderOriginal = new ParsingOriginalLocationRecorder(recorderBefore);
-					auto recorderMultiple = new ParsingMultiplePrintNodeRecorder;
-					recorderMultiple->AddRecorder(recorderOriginal);
-					recorderMultiple->AddRecorder(recorderAfter);
+				template<typename T>
+				static bool FoldBitwise(const WfInstruction& first, const WfInstruction& second, WfInsCode code, Value& result)
+				{
+					T a, b;
+					if (!UnboxConstant(first, a) || !UnboxConstant(second, b)) return false;
+					switch (code)
+					{
+					case WfInsCode::OpAnd:		result = BoxValue<T>(a & b); return true;
+					case WfInsCode::OpOr:		result = BoxValue<T>(a | b); return true;
+					case WfInsCode::OpXor:		result = BoxValue<T>(a ^ b); return true;
+					default:					return false;
+					}
+				}
 
-					stream::MemoryStream memoryStream;
+				static bool FoldUnary(const WfInstruction& operand, const WfInstruction& op, Value& result)
+				{
+					if (op.code != WfInsCode::OpNot && op.code != WfInsCode::OpPositive && op.code != WfInsCode::OpNegative) return false;
+					bool signedOnly = op.code == WfInsCode::OpNegative;
+					switch (op.typeParameter)
 					{
-						stream::StreamWriter streamWriter(memoryStream);
-						ParsingWriter parsingWriter(streamWriter, recorderMultiple, index);
-						WfPrint(module, L"", parsingWriter);
+					case WfInsType::Bool:
+						{
+							bool value;
+							if (op.code != WfInsCode::OpNot || !UnboxConstant(operand, value)) return false;
+							result = BoxValue(!value);
+							return true;
+						}
+					case WfInsType::I4:	return FoldUnary<vint32_t>(operand, op.code, result);
+					case WfInsType::I8:	return FoldUnary<vint64_t>(operand, op.code, result);
+					case WfInsType::U4:	return !signedOnly && FoldUnary<vuint32_t>(operand, op.code, result);
+					case WfInsType::U8:	return !signedOnly && FoldUnary<vuint64_t>(operand, op.code, result);
+					default:			return false;
 					}
+				}
 
-					memoryStream.SeekFromBegin(0);
-					auto codeAfterCodegen = stream::StreamReader(memoryStream).ReadToEnd();
+				static bool FoldBinary(const WfInstruction& first, const WfInstruction& second, const WfInstruction& op, Value& result)
+				{
+					switch (op.code)
+					{
+					case WfInsCode::OpAdd:
+					case WfInsCode::OpSub:
+					case WfInsCode::OpMul:
+						switch (op.typeParameter)
+						{
+						case WfInsType::I4:	return FoldBinary<vint32_t>(first, second, op.code, result);
+						case WfInsType::I8:	return FoldBinary<vint64_t>(first, second, op.code, result);
+						case WfInsType::U4:	return FoldBinary<vuint32_t>(first, second, op.code, result);
+						case WfInsType::U8:	return FoldBinary<vuint64_t>(first, second, op.code, result);
+						case WfInsType::F4:	return FoldBinary<float>(first, second, op.code, result);
+						case WfInsType::F8:	return FoldBinary<double>(first, second, op.code, result);
+						default:			return false;
+						}
+					case WfInsCode::OpAnd:
+					case WfInsCode::OpOr:
+					case WfInsCode::OpXor:
+						switch (op.typeParameter)
+						{
+						case WfInsType::Bool:
+							{
+								bool a, b;
+								if (!UnboxConstant(first, a) || !UnboxConstant(second, b)) return false;
+								result = BoxValue(
+									op.code == WfInsCode::OpAnd ? a && b :
+									op.code == WfInsCode::OpOr ? a || b :
+									a != b);
+								return true;
+							}
+						case WfInsType::I4:	return FoldBitwise<vint32_t>(first, second, op.code, result);
+						case WfInsType::I8:	return FoldBitwise<vint64_t>(first, second, op.code, result);
+						case WfInsType::U4:	return FoldBitwise<vuint32_t>(first, second, op.code, result);
+						case WfInsType::U8:	return FoldBitwise<vuint64_t>(first, second, op.code, result);
+						default:			return false;
+						}
+					default:
+						return false;
+					}
+				}
 
-					assembly->insBeforeCodegen->moduleCodes.Add(codeBeforeCodegen);
-					assembly->insAfterCodegen->moduleCodes.Add(codeAfterCodegen);
+				void Remove(vint index)
+				{
+					removed[index] = true;
 				}
 
-				if (manager->declarationTypes.Count() > 0)
+				void FindTargets()
 				{
-					assembly->typeImpl = new WfTypeImpl;
-					FOREACH(Ptr<ITypeDescriptor>, td, manager->declarationTypes.Values())
+					for (vint i = 0; i < targets.Count(); i++)
 					{
-						if (auto tdClass = td.Cast<WfClass>())
+						targets[i] = false;
+					}
+					FOREACH(Ptr<WfAssemblyFunction>, function, assembly->functions)
+					{
+						if (0 <= function->firstInstruction && function->firstInstruction < targets.Count())
 						{
-							assembly->typeImpl->classes.Add(tdClass);
+							targets[function->firstInstruction] = true;
 						}
-						else if (auto tdInterface = td.Cast<WfInterface>())
+					}
+					for (vint i = 0; i < assembly->instructions.Count(); i++)
+					{
+						auto& ins = assembly->instructions[i];
+						if (IsLabel(ins.code) && 0 <= ins.indexParameter && ins.indexParameter < targets.Count())
 						{
-							assembly->typeImpl->interfaces.Add(tdInterface);
+							targets[ins.indexParameter] = true;
 						}
-						else if (auto tdStruct = td.Cast<WfStruct>())
+					}
+				}
+
+				bool ThreadJumps(vint first, vint last)
+				{
+					bool modified = false;
+					for (vint i = first; i <= last; i++)
+					{
+						auto& ins = assembly->instructions[i];
+						if (ins.code != WfInsCode::Jump && ins.code != WfInsCode::JumpIf) continue;
+
+						// follow a chain of unconditional jumps, the number of steps is limited to stop at loops
+						vint target = ins.indexParameter;
+						for (vint step = 0; step <= last - first; step++)
 						{
-							assembly->typeImpl->structs.Add(tdStruct);
+							if (target < first || target > last || target == i) break;
+							auto& targetIns = assembly->instructions[target];
+							if (targetIns.code != WfInsCode::Jump || targetIns.indexParameter == target) break;
+							target = targetIns.indexParameter;
 						}
-						else if (auto tdEnum = td.Cast<WfEnum>())
+
+						if (target != ins.indexParameter)
 						{
-							assembly->typeImpl->enums.Add(tdEnum);
+							ins.indexParameter = target;
+							modified = true;
+						}
+
+						if (ins.code == WfInsCode::Jump && first <= target && target <= last && assembly->instructions[target].code == WfInsCode::Return)
+						{
+							ins = WfInstruction::Return();
+							modified = true;
 						}
 					}
+					return modified;
 				}
 
-				FOREACH(Ptr<WfModule>, module, manager->GetModules())
+				bool Peephole(vint first, vint last)
 				{
-					FOREACH(Ptr<WfDeclaration>, decl, module->declarations)
+					bool modified = false;
+					auto& instructions = assembly->instructions;
+					for (vint i = first; i <= last; i++)
 					{
-						GenerateGlobalDeclarationMetadata(context, decl);
+						if (removed[i]) continue;
+						auto& ins = instructions[i];
+						bool hasNext = i + 1 <= last && !targets[i + 1] && !removed[i + 1];
+						bool hasNext2 = hasNext && i + 2 <= last && !targets[i + 2] && !removed[i + 2];
+
+						if (ins.code == WfInsCode::Nop)
+						{
+							Remove(i);
+							modified = true;
+						}
+						else if ((ins.code == WfInsCode::Jump || ins.code == WfInsCode::JumpIf) && ins.indexParameter == i + 1)
+						{
+							// a jump to the next instruction
+							if (ins.code == WfInsCode::Jump)
+							{
+								Remove(i);
+							}
+							else
+							{
+								ins = WfInstruction::Pop();
+							}
+							modified = true;
+						}
+						else if (hasNext && instructions[i + 1].code == WfInsCode::JumpIf && ins.code == WfInsCode::LoadValue && ins.valueParameter.GetTypeDescriptor() == GetTypeDescriptor<bool>())
+						{
+							// a conditional jump on a constant
+							if (UnboxValue<bool>(ins.valueParameter))
+							{
+								ins = WfInstruction::Jump(instructions[i + 1].indexParameter);
+							}
+							else
+							{
+								Remove(i);
+							}
+							Remove(i + 1);
+							modified = true;
+							i++;
+						}
+						else if (hasNext && instructions[i + 1].code == WfInsCode::Pop && IsPurePush(ins.code))
+						{
+							// a value that is pushed and then discarded
+							Remove(i);
+							Remove(i + 1);
+							modified = true;
+							i++;
+						}
+						else if (hasNext2 && ins.code == WfInsCode::Duplicate && ins.countParameter == 0 && IsStore(instructions[i + 1].code) && instructions[i + 2].code == WfInsCode::Pop)
+						{
+							// an assignment whose value is discarded
+							Remove(i);
+							Remove(i + 2);
+							modified = true;
+							i += 2;
+						}
+						else if (hasNext)
+						{
+							Value result;
+							if (hasNext2 && FoldBinary(ins, instructions[i + 1], instructions[i + 2], result))
+							{
+								ins.valueParameter = result;
+								Remove(i + 1);
+								Remove(i + 2);
+								modified = true;
+								i += 2;
+							}
+							else if (FoldUnary(ins, instructions[i + 1], result))
+							{
+								ins.valueParameter = result;
+								Remove(i + 1);
+								modified = true;
+								i++;
+							}
+						}
 					}
+					return modified;
 				}
 
+				bool RemoveUnreachable(vint first, vint last)
 				{
-					auto meta = MakePtr<WfAssemblyFunction>();
-					meta->name = L"<initialize>";
-					vint functionIndex = assembly->functions.Add(meta);
-					assembly->functionByName.Add(meta->name, functionIndex);
+					collections::Array<bool> reachable(last - first + 1);
+					for (vint i = 0; i < reachable.Count(); i++)
+					{
+						reachable[i] = false;
+					}
 
-					auto functionContext = MakePtr<WfCodegenFunctionContext>();
-					functionContext->function = meta;
-					context.functionContext = functionContext;
-					
-					meta->firstInstruction = assembly->instructions.Count();
-					FOREACH(Ptr<WfModule>, module, manager->GetModules())
+					collections::List<vint> tasks;
+					tasks.Add(first);
+					while (tasks.Count() > 0)
 					{
-						FOREACH(Ptr<WfDeclaration>, decl, module->declarations)
+						vint index = tasks[tasks.Count() - 1];
+						tasks.RemoveAt(tasks.Count() - 1);
+						if (index < first || index > last || reachable[index - first]) continue;
+						reachable[index - first] = true;
+
+						auto& ins = assembly->instructions[index];
+						if (IsLabel(ins.code))
 						{
-							GenerateInitializeInstructions(context, decl);
+							tasks.Add(ins.indexParameter);
+						}
+						if (ins.code != WfInsCode::Jump && ins.code != WfInsCode::Return && ins.code != WfInsCode::RaiseException)
+						{
+							tasks.Add(index + 1);
 						}
 					}
 
-					// define node for INSTRUCTION
-					parsing::ParsingTreeCustomBase* node = nullptr;
-					INSTRUCTION(Ins::LoadValue(Value()));
-					INSTRUCTION(Ins::Return());
-
-					meta->lastInstruction = assembly->instructions.Count() - 1;
-
-					context.functionContext = 0;
-					GenerateClosureInstructions(context, functionContext);
+					bool modified = false;
+					for (vint i = first; i <= last; i++)
+					{
+						if (!reachable[i - first] && !removed[i])
+						{
+							Remove(i);
+							modified = true;
+						}
+					}
+					return modified;
 				}
 
-				FOREACH(Ptr<WfModule>, module, manager->GetModules())
+				void CompactDebugInfo(Ptr<WfInstructionDebugInfo> debugInfo)
 				{
-					FOREACH(Ptr<WfDeclaration>, decl, module->declarations)
+					if (!debugInfo) return;
+					if (debugInfo->instructionCodeMapping.Count() == removed.Count())
 					{
-						GenerateDeclarationInstructions(context, decl);
+						vint count = 0;
+						for (vint i = 0; i < removed.Count(); i++)
+						{
+							if (!removed[i])
+							{
+								debugInfo->instructionCodeMapping[count++] = debugInfo->instructionCodeMapping[i];
+							}
+						}
+						while (debugInfo->instructionCodeMapping.Count() > count)
+						{
+							debugInfo->instructionCodeMapping.RemoveAt(debugInfo->instructionCodeMapping.Count() - 1);
+						}
 					}
+
+					// rebuild the code to instruction mapping every time, even when no instruction is removed
+					debugInfo->codeInstructionMapping.Clear();
+					debugInfo->Initialize();
 				}
 
-				assembly->Initialize();
-				return assembly;
-			}
+				vint Compact()
+				{
+					auto& instructions = assembly->instructions;
 
-#undef INSTRUCTION
+					// a removed instruction is mapped to the next remaining one, so that jumps to it are still valid
+					collections::Array<vint> newIndices(instructions.Count() + 1);
+					vint count = 0;
+					for (vint i = 0; i < instructions.Count(); i++)
+					{
+						newIndices[i] = count;
+						if (!removed[i]) count++;
+					}
+					newIndices[instructions.Count()] = count;
 
-/***********************************************************************
-Compile
-***********************************************************************/
+					FOREACH(Ptr<WfAssemblyFunction>, function, assembly->functions)
+					{
+						if (0 <= function->firstInstruction && function->firstInstruction <= function->lastInstruction && function->lastInstruction < instructions.Count())
+						{
+							function->lastInstruction = newIndices[function->lastInstruction + 1] - 1;
+							function->firstInstruction = newIndices[function->firstInstruction];
+						}
+					}
 
-			Ptr<runtime::WfAssembly> Compile(Ptr<parsing::tabling::ParsingTable> table, WfLexicalScopeManager* manager, collections::List<WString>& moduleCodes, collections::List<Ptr<parsing::ParsingError>>& errors)
-			{
-				manager->Clear(true, true);
-				FOREACH(WString, code, moduleCodes)
-				{
-					manager->AddModule(code);
+					vint removedCount = instructions.Count() - count;
+					count = 0;
+					for (vint i = 0; i < instructions.Count(); i++)
+					{
+						if (!removed[i])
+						{
+							auto ins = instructions[i];
+							if (IsLabel(ins.code) && 0 <= ins.indexParameter && ins.indexParameter <= instructions.Count())
+							{
+								ins.indexParameter = newIndices[ins.indexParameter];
+							}
+							instructions[count++] = ins;
+						}
+					}
+					while (instructions.Count() > count)
+					{
+						instructions.RemoveAt(instructions.Count() - 1);
+					}
+
+					CompactDebugInfo(assembly->insBeforeCodegen);
+					CompactDebugInfo(assembly->insAfterCodegen);
+					return removedCount;
 				}
 
-				if (manager->errors.Count() > 0)
+			public:
+				WfAssemblyOptimizer(WfAssembly* _assembly)
+					:assembly(_assembly)
 				{
-					CopyFrom(errors, manager->errors);
-					return 0;
 				}
 
-				manager->Rebuild(true);
-				if (manager->errors.Count() > 0)
+				vint Optimize()
 				{
-					CopyFrom(errors, manager->errors);
-					return 0;
-				}
+					// instructions are renumbered, so nothing could be left for lazy loading
+					assembly->LoadAllInstructions();
+					assembly->LoadDebugInfo();
 
-				return GenerateAssembly(manager);
-			}
+					vint removedCount = 0;
+					for (vint iteration = 0; iteration < 16; iteration++)
+					{
+						removed.Resize(assembly->instructions.Count());
+						targets.Resize(assembly->instructions.Count());
+						for (vint i = 0; i < removed.Count(); i++)
+						{
+							removed[i] = false;
+						}
+						FindTargets();
 
-			Ptr<runtime::WfAssembly> Compile(Ptr<parsing::tabling::ParsingTable> table, collections::List<WString>& moduleCodes, collections::List<Ptr<parsing::ParsingError>>& errors)
+						bool modified = false;
+						FOREACH(Ptr<WfAssemblyFunction>, function, assembly->functions)
+						{
+							vint first = function->firstInstruction;
+							vint last = function->lastInstruction;
+							if (first < 0 || first > last || last >= assembly->instructions.Count()) continue;
+
+							modified = ThreadJumps(first, last) || modified;
+							modified = RemoveUnreachable(first, last) || modified;
+							modified = Peephole(first, last) || modified;
+						}
+
+						if (!modified) break;
+						removedCount += Compact();
+					}
+					return removedCount;
+				}
+			};
+
+			vint OptimizeAssembly(Ptr<runtime::WfAssembly> assembly)
 			{
-				WfLexicalScopeManager manager(table);
-				return Compile(table, &manager, moduleCodes, errors);
+				WfAssemblyOptimizer optimizer(assembly.Obj());
+				return optimizer.Optimize();
 			}
 		}
 	}
@@ -5732,7 +6649,41 @@ ExpandBindExpression
 
 								auto stat = MakePtr<WfExpressionStatement>();
 								stat->expression = call;
-								block->statements.Add(stat);
+
+								if (manager->scheduleBindings)
+								{
+									// if (!system::SubscriptionScheduler::Schedule(this)) { <bind-activator>(); }
+									auto system = MakePtr<WfTopQualifiedExpression>();
+									system->name.value = L"system";
+
+									auto scheduler = MakePtr<WfChildExpression>();
+									scheduler->parent = system;
+									scheduler->name.value = L"SubscriptionScheduler";
+
+									auto schedule = MakePtr<WfChildExpression>();
+									schedule->parent = scheduler;
+									schedule->name.value = L"Schedule";
+
+									auto scheduleCall = MakePtr<WfCallExpression>();
+									scheduleCall->function = schedule;
+									scheduleCall->arguments.Add(MakePtr<WfThisExpression>());
+
+									auto notExpr = MakePtr<WfUnaryExpression>();
+									notExpr->op = WfUnaryOperator::Not;
+									notExpr->operand = scheduleCall;
+
+									auto ifBlock = MakePtr<WfBlockStatement>();
+									ifBlock->statements.Add(stat);
+
+									auto ifStat = MakePtr<WfIfStatement>();
+									ifStat->expression = notExpr;
+									ifStat->trueBranch = ifBlock;
+									block->statements.Add(ifStat);
+								}
+								else
+								{
+									block->statements.Add(stat);
+								}
 							}
 
 							newSubscription->members.Add(CreateNormalMember(func));
@@ -18382,6 +19333,7 @@ namespace vl
 			using namespace collections;
 			using namespace stream;
 			using namespace filesystem;
+			using namespace reflection::description;
 
 /***********************************************************************
 WfCppInput
@@ -18427,11 +19379,74 @@ GenerateCppFiles
 				writer.WriteLine(L"***********************************************************************/");
 			}
 
+			typedef Func<void(StreamWriter&)>		CppFileGenerator;
+
+			void LoadCppGenerationMetadata(WfCppConfig& config)
+			{
+				// type descriptors and attribute values are loaded on demand, which is not thread-safe
+				auto typeManager = GetGlobalTypeManager();
+				vint count = typeManager->GetTypeDescriptorCount();
+				for (vint i = 0; i < count; i++)
+				{
+					auto td = typeManager->GetTypeDescriptor(i);
+					td->GetValueType();
+					td->GetBaseTypeDescriptorCount();
+				}
+
+				FOREACH(Ptr<ITypeDescriptor>, td, config.manager->declarationTypes.Values())
+				{
+					td->GetValueType();
+					td->GetBaseTypeDescriptorCount();
+				}
+
+				for (vint i = 0; i < config.classDecls.Count(); i++)
+				{
+					FOREACH(Ptr<WfClassDeclaration>, decl, config.classDecls.GetByIndex(i))
+					{
+						FOREACH(Ptr<WfAttribute>, attribute, config.manager->GetAttributes(decl->attributes, L"cpp", L"Friend"))
+						{
+							config.manager->GetAttributeValue(attribute);
+						}
+					}
+				}
+			}
+
+			void GenerateCppFilesInParallel(WfCppConfig& config, List<CppFileGenerator>& generators, Array<WString>& contents, Array<bool>& generated)
+			{
+				// WfCppConfig is read-only after construction, so every file can be generated independently
+				LoadCppGenerationMetadata(config);
+
+				TaskGroup group;
+				for (vint i = 0; i < generators.Count(); i++)
+				{
+					group.RunLambda([&generators, &contents, &generated, i]()
+					{
+						try
+						{
+							contents[i] = GenerateToStream(generators[i]);
+							generated[i] = true;
+						}
+						catch (...)
+						{
+						}
+					});
+				}
+				group.Join();
+			}
+
 			Ptr<WfCppOutput> GenerateCppFiles(Ptr<WfCppInput> input, analyzer::WfLexicalScopeManager* manager)
 			{
 				WfCppConfig config(manager, input->assemblyName, input->assemblyNamespace);
 				auto output = MakePtr<WfCppOutput>();
 
+				List<WString> fileNames;
+				List<CppFileGenerator> generators;
+				auto addFile = [&](const WString& fileName, const CppFileGenerator& generator)
+				{
+					fileNames.Add(fileName);
+					generators.Add(generator);
+				};
+
 				bool multiFile = false;
 				switch (input->multiFile)
 				{
@@ -18445,7 +19460,7 @@ GenerateCppFiles
 					multiFile = config.topLevelClassDeclsForFiles.Count() > 1;
 				}
 
-				output->cppFiles.Add(input->defaultFileName + L".h", GenerateToStream([&](StreamWriter& writer)
+				addFile(input->defaultFileName + L".h", [&](StreamWriter& writer)
 				{
 					GenerateCppComment(writer, input->comment);
 					writer.WriteLine(L"");
@@ -18469,9 +19484,9 @@ GenerateCppFiles
 					config.WriteHeader(writer, multiFile);
 					writer.WriteLine(L"");
 					writer.WriteLine(L"#endif");
-				}));
+				});
 
-				output->cppFiles.Add(input->defaultFileName + L".cpp", GenerateToStream([&](StreamWriter& writer)
+				addFile(input->defaultFileName + L".cpp", [&](StreamWriter& writer)
 				{
 					GenerateCppComment(writer, input->comment);
 					writer.WriteLine(L"");
@@ -18485,11 +19500,11 @@ GenerateCppFiles
 					}
 					writer.WriteLine(L"");
 					config.WriteCpp(writer, multiFile);
-				}));
+				});
 
 				if (multiFile)
 				{
-					output->cppFiles.Add(input->includeFileName + L".h", GenerateToStream([&](StreamWriter& writer)
+					addFile(input->includeFileName + L".h", [&](StreamWriter& writer)
 					{
 						GenerateCppComment(writer, input->comment);
 						writer.WriteLine(L"");
@@ -18514,13 +19529,13 @@ GenerateCppFiles
 
 						writer.WriteLine(L"");
 						writer.WriteLine(L"#endif");
-					}));
+					});
 
 					FOREACH(WString, fileName, config.topLevelClassDeclsForFiles.Keys())
 					{
 						if (fileName != L"")
 						{
-							output->cppFiles.Add(fileName + L".h", GenerateToStream([&](StreamWriter& writer)
+							addFile(fileName + L".h", [&, fileName](StreamWriter& writer)
 							{
 								GenerateCppComment(writer, input->comment);
 								writer.WriteLine(L"");
@@ -18585,20 +19600,41 @@ GenerateCppFiles
 								config.WriteSubHeader(writer, fileName);
 								writer.WriteLine(L"");
 								writer.WriteLine(L"#endif");
-							}));
+							});
 
-							output->cppFiles.Add(fileName + L".cpp", GenerateToStream([&](StreamWriter& writer)
+							addFile(fileName + L".cpp", [&, fileName](StreamWriter& writer)
 							{
 								GenerateCppComment(writer, input->comment);
 								writer.WriteLine(L"");
 								writer.WriteLine(L"#include \"" + input->includeFileName + L".h\"");
 								writer.WriteLine(L"");
 								config.WriteSubCpp(writer, fileName);
-							}));
+							});
 						}
 					}
 				}
 
+				Array<WString> contents(fileNames.Count());
+				Array<bool> generated(fileNames.Count());
+				for (vint i = 0; i < generated.Count(); i++)
+				{
+					generated[i] = false;
+				}
+
+				if (input->parallel && fileNames.Count() > 1)
+				{
+					GenerateCppFilesInParallel(config, generators, contents, generated);
+				}
+
+				FOREACH_INDEXER(WString, fileName, index, fileNames)
+				{
+					if (!generated[index])
+					{
+						// files that failed in the thread pool are generated again here, so that errors are thrown to the caller
+						contents[index] = GenerateToStream(generators[index]);
+					}
+					output->cppFiles.Add(fileName, contents[index]);
+				}
 				return output;
 			}
 
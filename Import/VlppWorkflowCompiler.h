@@ -2026,6 +2026,8 @@ Scope Manager
 
 				Ptr<WfLexicalScopeName>						AccessChild(const WString& name, bool imported);
 				void										RemoveNonTypeDescriptorNames(WfLexicalScopeManager* manager);
+				void										ResetNonTypeDescriptorNames(WfLexicalScopeManager* manager);
+				void										RemoveEmptyNames();
 				WString										GetFriendlyName();
 			};
 
@@ -2092,9 +2094,14 @@ Scope Manager
 				typedef collections::Dictionary<Ptr<WfAttribute>, Value>									AttributeValueMap;
 
 			protected:
+				class IncrementalState;
+
 				ModuleList									modules;
 				ModuleCodeList								moduleCodes;
 				vint										usedCodeIndex = 0;
+				Ptr<IncrementalState>						incrementalState;				// modules and results from the last incremental rebuilding
+
+				bool										RebuildIncrementally(Ptr<IncrementalState> currentState);
 
 				AttributeValueMap							attributeValues;				// cached value for attribute
 				Ptr<runtime::WfAssembly>					attributeAssembly;				// shared assembly for evaluating attribute value
@@ -2103,6 +2110,7 @@ Scope Manager
 			public:
 				Ptr<parsing::tabling::ParsingTable>			parsingTable;
 				AttributeTypeMap							attributes;
+				bool										scheduleBindings = false;		// set to true to let bind expressions call system::SubscriptionScheduler::Schedule before re-evaluating
 
 				ParsingErrorList							errors;							// compile errors
 
@@ -2144,7 +2152,12 @@ Scope Manager
 				void										Clear(bool keepTypeDescriptorNames, bool deleteModules);
 				/// <summary>Compile.</summary>
 				/// <param name="keepTypeDescriptorNames">Set to false to delete all cache of reflectable C++ types before compiling.</param>
-				void										Rebuild(bool keepTypeDescriptorNames);
+				/// <param name="incremental">
+				/// Set to true to reuse results from the last incremental compiling, which is kept even after calling <see cref="Clear"/> with keepTypeDescriptorNames set to true.
+				/// A module keeps its results if its code index and source code (or printed syntax tree) are not changed, and it refers to no name declared in changed or re-analyzed modules.
+				/// Results are the same as compiling without this option. If any error is found, all modules are compiled again to report errors in the same way.
+				/// </param>
+				void										Rebuild(bool keepTypeDescriptorNames, bool incremental = false);
 
 				bool										ResolveMember(ITypeDescriptor* typeDescriptor, const WString& name, bool preferStatic, collections::SortedList<ITypeDescriptor*>& searchedTypes, collections::List<ResolveExpressionResult>& results);
 				bool										ResolveName(WfLexicalScope* scope, const WString& name, collections::List<ResolveExpressionResult>& results);
@@ -2424,6 +2437,11 @@ Code Generation
 			/// <param name="errors">Container to get all compileing errors.</param>
 			extern Ptr<runtime::WfAssembly>					Compile(Ptr<parsing::tabling::ParsingTable> table, collections::List<WString>& moduleCodes, collections::List<Ptr<parsing::ParsingError>>& errors);
 
+			/// <summary>Optimize instructions in an assembly, by folding constants, removing unreachable instructions, threading jumps, and removing values that are pushed and immediately popped. It should be called before creating any [T:vl.workflow.runtime.WfRuntimeGlobalContext] for this assembly. Debug information is updated for remaining instructions.</summary>
+			/// <returns>The number of removed instructions.</returns>
+			/// <param name="assembly">The assembly to optimize.</param>
+			extern vint										OptimizeAssembly(Ptr<runtime::WfAssembly> assembly);
+
 /***********************************************************************
 Error Messages
 ***********************************************************************/
@@ -2780,6 +2798,7 @@ GenerateCppFiles
 				WString											defaultFileName;
 				collections::List<WString>						normalIncludes;
 				collections::List<WString>						reflectionIncludes;
+				bool											parallel = true;			// generate files in the thread pool, the result is the same as serial generation
 
 				WfCppInput(const WString& _assemblyName);
 			};
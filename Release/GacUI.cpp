@@ -45066,7 +45066,7 @@ GuiResource
 			SaveResourceFolderToBinary(writer, typeNames);
 		}
 
-		void GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, collections::List<WString>& errors)
+		void GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, collections::List<WString>& errors, bool optimizeWorkflow)
 		{
 			if (GetFolder(L"Precompiled"))
 			{
@@ -45078,6 +45078,7 @@ GuiResource
 			context.rootResource = this;
 			context.resolver = new GuiResourcePathResolver(this, workingDirectory);
 			context.targetFolder = new GuiResourceFolder;
+			context.optimizeWorkflow = optimizeWorkflow;
 			
 			auto manager = GetResourceResolverManager();
 			vint maxPass = manager->GetMaxPrecompilePassIndex();
@@ -3541,7 +3541,8 @@ Resource
 			/// <summary>Precompile this resource to improve performance.</summary>
 			/// <param name="callback">A callback to receive progress.</param>
 			/// <param name="errors">All collected errors during precompiling a resource.</param>
-			void									Precompile(IGuiResourcePrecompileCallback* callback, collections::List<WString>& errors);
+			/// <param name="optimizeWorkflow">Set to true to optimize instructions in compiled Workflow assemblies.</param>
+			void									Precompile(IGuiResourcePrecompileCallback* callback, collections::List<WString>& errors, bool optimizeWorkflow = false);
 
 			/// <summary>Initialize a precompiled resource.</summary>
 			/// <param name="usage">In which role an application is initializing this resource.</param>
@@ -3673,6 +3674,8 @@ Resource Type Resolver
 			Ptr<GuiResourcePathResolver>						resolver;
 			/// <summary>Additional properties for resource item contents</summary>
 			PropertyMap											additionalProperties;
+			/// <summary>Set to true to optimize instructions in compiled Workflow assemblies.</summary>
+			bool												optimizeWorkflow = false;
 		};
 
 		/// <summary>
@@ -1764,6 +1764,10 @@ namespace vl
 				if (manager->errors.Count() == 0)
 				{
 					compiled->assembly = GenerateAssembly(manager);
+					if (context.optimizeWorkflow)
+					{
+						OptimizeAssembly(compiled->assembly);
+					}
 					compiled->Initialize(true);
 				}
 				else
@@ -55,6 +55,133 @@ namespace vl
 			compiled->codes.Add(module);
 		}
 
+		class WorkflowCodeListingWriter : public TextWriter
+		{
+		protected:
+			TextWriter*								writer;
+			vint									row = 0;
+			bool									lineStart = true;
+
+		public:
+			WorkflowCodeListingWriter(TextWriter* _writer)
+				:writer(_writer)
+			{
+			}
+
+			void WriteChar(wchar_t c)override
+			{
+				if (!writer) return;
+				if (lineStart)
+				{
+					lineStart = false;
+					auto rowHeader = itow(++row);
+					for (vint i = rowHeader.Length(); i < 6; i++)
+					{
+						writer->WriteChar(L' ');
+					}
+					writer->WriteString(rowHeader);
+					writer->WriteString(L" : ");
+				}
+
+				switch (c)
+				{
+				case L'\r':
+					break;
+				case L'\n':
+					writer->WriteString(L"\r\n");
+					lineStart = true;
+					break;
+				default:
+					writer->WriteChar(c);
+				}
+			}
+
+			void WriteString(const wchar_t* string, vint charCount)override
+			{
+				for (vint i = 0; i < charCount; i++)
+				{
+					WriteChar(string[i]);
+				}
+			}
+
+			void Finish()
+			{
+				if (writer && !lineStart)
+				{
+					writer->WriteString(L"\r\n");
+					lineStart = true;
+				}
+			}
+		};
+
+		void Workflow_UpdateModuleLocations(List<Ptr<WfModule>>& modules)
+		{
+			auto updateLocations = [](Ptr<WfModule> module, vint index)
+			{
+				WorkflowCodeListingWriter writer(nullptr);
+				auto recorder = MakePtr<ParsingUpdateLocationRecorder>();
+				ParsingWriter parsingWriter(writer, recorder, index);
+				WfPrint(module, L"", parsingWriter);
+			};
+
+			if (modules.Count() < 2)
+			{
+				FOREACH_INDEXER(Ptr<WfModule>, module, index, modules)
+				{
+					updateLocations(module, index);
+				}
+				return;
+			}
+
+			Semaphore semaphore;
+			semaphore.Create(0, modules.Count());
+			FOREACH_INDEXER(Ptr<WfModule>, module, index, modules)
+			{
+				ThreadPoolLite::QueueLambda([&semaphore, &updateLocations, module, index]()
+				{
+					updateLocations(module, index);
+					semaphore.Release();
+				});
+			}
+			for (vint i = 0; i < modules.Count(); i++)
+			{
+				semaphore.Wait();
+			}
+		}
+
+		void Workflow_GenerateModuleCodes(Ptr<GuiInstanceCompiledWorkflow> compiled, List<WString>& codes)
+		{
+			auto addCode = [&codes](const Func<void(TextWriter&)>& print)
+			{
+				MemoryStream stream;
+				{
+					StreamWriter writer(stream);
+					WorkflowCodeListingWriter listingWriter(&writer);
+					print(listingWriter);
+					listingWriter.Finish();
+				}
+				stream.SeekFromBegin(0);
+				codes.Add(StreamReader(stream).ReadToEnd());
+			};
+
+			FOREACH(Ptr<WfModule>, module, compiled->modules)
+			{
+				addCode([=](TextWriter& writer)
+				{
+					ParsingWriter parsingWriter(writer);
+					WfPrint(module, L"", parsingWriter);
+				});
+			}
+
+			FOREACH(WString, code, compiled->codes)
+			{
+				addCode([=](TextWriter& writer)
+				{
+					writer.WriteString(code);
+				});
+			}
+		}
+
 		void Workflow_GenerateAssembly(GuiResourcePrecompileContext& context, const WString& path, GuiResourceError::List& errors, bool keepMetadata)
 		{
 			auto compiled = Workflow_GetModule(context, path);
@@ -65,51 +192,17 @@ namespace vl
 
 			if (!compiled->assembly)
 			{
-				List<WString> codes;
 				auto manager = Workflow_GetSharedManager();
 				manager->Clear(false, true);
 
-				auto addCode = [&codes](TextReader& reader)
-				{
-					vint row = 0;
-					WString code;
-					while (!reader.IsEnd())
-					{
-						auto rowHeader = itow(++row);
-						while (rowHeader.Length() < 6)
-						{
-							rowHeader = L" " + rowHeader;
-						}
-						code += rowHeader + L" : " + reader.ReadLine() + L"\r\n";
-					}
-					codes.Add(code);
-				};
-
-				FOREACH_INDEXER(Ptr<WfModule>, module, index, compiled->modules)
+				Workflow_UpdateModuleLocations(compiled->modules);
+				FOREACH(Ptr<WfModule>, module, compiled->modules)
 				{
-					{
-						MemoryStream stream;
-						{
-							StreamWriter writer(stream);
-							auto recorder = MakePtr<ParsingUpdateLocationRecorder>();
-							ParsingWriter parsingWriter(writer, recorder, index);
-							WfPrint(module, L"", parsingWriter);
-						}
-						stream.SeekFromBegin(0);
-						{
-							StreamReader reader(stream);
-							addCode(reader);
-						}
-					}
 					manager->AddModule(module);
 				}
 
 				FOREACH(WString, code, compiled->codes)
 				{
-					{
-						StringReader reader(code);
-						addCode(reader);
-					}
 					manager->AddModule(code);
 				}
 
@@ -121,10 +214,16 @@ namespace vl
 				if (manager->errors.Count() == 0)
 				{
 					compiled->assembly = GenerateAssembly(manager);
+					if (context.optimizeWorkflow)
+					{
+						OptimizeAssembly(compiled->assembly);
+					}
 					compiled->Initialize(true);
 				}
 				else
 				{
+					List<WString> codes;
+					Workflow_GenerateModuleCodes(compiled, codes);
 					CHECK_FAIL(L"Temporary assert");
 					/*
 					errors.Add(L"Failed to compile workflow scripts in: " + path);
@@ -662,6 +662,7 @@ GuiWorkflowSharedManagerPlugin
 		{
 		protected:
 			Ptr<WfLexicalScopeManager>		workflowManager;
+			bool							scheduleBindings = false;
 
 		public:
 			GuiWorkflowSharedManagerPlugin()
@@ -687,6 +688,7 @@ GuiWorkflowSharedManagerPlugin
 				if (!workflowManager)
 				{
 					workflowManager = new WfLexicalScopeManager(GetParserManager()->GetParsingTable(L"WORKFLOW"));
+					workflowManager->scheduleBindings = scheduleBindings;
 				}
 				return workflowManager.Obj();
 			}
@@ -695,6 +697,11 @@ GuiWorkflowSharedManagerPlugin
 			{
 				auto result = workflowManager;
 				workflowManager = nullptr;
+				if (result)
+				{
+					// options are kept for the next manager
+					scheduleBindings = result->scheduleBindings;
+				}
 				return result;
 			}
 		};
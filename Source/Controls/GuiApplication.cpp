@@ -1,6 +1,11 @@
 #include "GuiApplication.h"
 #include "Styles/GuiWin7Styles.h"
 #include "Styles/GuiWin8Styles.h"
+#include <typeinfo>
+#if defined VCZH_GCC
+#include <cxxabi.h>
+#include <stdlib.h>
+#endif
 
 extern void GuiMain();
 
@@ -15,6 +20,552 @@ namespace vl
 			using namespace theme;
 			using namespace description;
 
+/***********************************************************************
+GuiBindingScheduler
+***********************************************************************/
+
+			const wchar_t* const BindingSchedulerRecordProperty = L"GuiBindingScheduler::Record";
+
+			GuiBindingScheduler::Record::~Record()
+			{
+				if (scheduler)
+				{
+					scheduler->RemoveRecord(this);
+				}
+			}
+
+			GuiBindingScheduler::Record* GuiBindingScheduler::GetRecord(description::IValueSubscription* subscription)
+			{
+				// the record is stored in the subscription, so that it is deleted with the subscription
+				if (auto record = subscription->GetInternalProperty(BindingSchedulerRecordProperty).Cast<Record>())
+				{
+					if (record->scheduler == this)
+					{
+						return record.Obj();
+					}
+				}
+
+				auto record = MakePtr<Record>();
+				record->scheduler = this;
+				record->subscription = subscription;
+				records.Add(record.Obj());
+				subscription->SetInternalProperty(BindingSchedulerRecordProperty, record);
+				return record.Obj();
+			}
+
+			void GuiBindingScheduler::RemoveRecord(Record* record)
+			{
+				records.Remove(record);
+				FOREACH(Record*, dependent, records)
+				{
+					dependent->sources.Remove(record);
+				}
+				if (evaluatingRecord == record)
+				{
+					evaluatingRecord = nullptr;
+				}
+			}
+
+			vint GuiBindingScheduler::SelectDirtyRecord()
+			{
+				// take the first subscription that does not depend on any pending subscription
+				// if all pending subscriptions depend on each other, take the first one
+				for (vint i = 0; i < dirtyRecords.Count(); i++)
+				{
+					auto record = dirtyRecords[i].record;
+					if (!From(record->sources).Any([](Record* source) { return source->dirty; }))
+					{
+						return i;
+					}
+				}
+				return 0;
+			}
+
+			void GuiBindingScheduler::DetachRecords()
+			{
+				List<Record*> detaching;
+				CopyFrom(detaching, records);
+				records.Clear();
+				FOREACH(Record*, record, detaching)
+				{
+					record->scheduler = nullptr;
+					record->sources.Clear();
+					record->subscription->SetInternalProperty(BindingSchedulerRecordProperty, nullptr);
+				}
+			}
+
+			GuiBindingScheduler::GuiBindingScheduler()
+			{
+			}
+
+			GuiBindingScheduler::~GuiBindingScheduler()
+			{
+				SetEnabled(false);
+				DetachRecords();
+			}
+
+			bool GuiBindingScheduler::Schedule(description::IValueSubscription* subscription)
+			{
+				if (!enabled) return false;
+				scheduledCount++;
+
+				auto record = GetRecord(subscription);
+				if (evaluatingRecord && evaluatingRecord != record && !record->sources.Contains(evaluatingRecord))
+				{
+					// the subscription observes values written by the one being evaluated
+					record->sources.Add(evaluatingRecord);
+				}
+
+				if (!record->dirty)
+				{
+					record->dirty = true;
+					DirtyRecord dirtyRecord;
+					dirtyRecord.subscription = subscription;
+					dirtyRecord.record = record;
+					dirtyRecords.Add(dirtyRecord);
+				}
+				return true;
+			}
+
+			bool GuiBindingScheduler::GetEnabled()
+			{
+				return enabled;
+			}
+
+			void GuiBindingScheduler::SetEnabled(bool value)
+			{
+				if (enabled == value) return;
+				if (value)
+				{
+					enabled = true;
+					SubscriptionScheduler::SetScheduler(this);
+				}
+				else
+				{
+					FlushBindings();
+					enabled = false;
+					if (SubscriptionScheduler::GetScheduler() == this)
+					{
+						SubscriptionScheduler::SetScheduler(nullptr);
+					}
+				}
+			}
+
+			void GuiBindingScheduler::FlushBindings()
+			{
+				if (flushing || dirtyRecords.Count() == 0) return;
+				flushing = true;
+				try
+				{
+					while (dirtyRecords.Count() > 0)
+					{
+						vint selected = SelectDirtyRecord();
+						auto subscription = dirtyRecords[selected].subscription;
+						evaluatingRecord = dirtyRecords[selected].record;
+						dirtyRecords.RemoveAt(selected);
+						evaluatingRecord->dirty = false;
+						if (subscription->Update())
+						{
+							evaluatedCount++;
+						}
+						evaluatingRecord = nullptr;
+					}
+				}
+				catch (...)
+				{
+					FOREACH(DirtyRecord, dirtyRecord, dirtyRecords)
+					{
+						dirtyRecord.record->dirty = false;
+					}
+					dirtyRecords.Clear();
+					evaluatingRecord = nullptr;
+					flushing = false;
+					throw;
+				}
+				flushing = false;
+			}
+
+			vint GuiBindingScheduler::GetScheduledCount()
+			{
+				return scheduledCount;
+			}
+
+			vint GuiBindingScheduler::GetEvaluatedCount()
+			{
+				return evaluatedCount;
+			}
+
+			vint GuiBindingScheduler::GetSavedCount()
+			{
+				return scheduledCount - evaluatedCount;
+			}
+
+			void GuiBindingScheduler::ResetCounters()
+			{
+				scheduledCount = 0;
+				evaluatedCount = 0;
+			}
+
+/***********************************************************************
+GuiProducerQueue
+***********************************************************************/
+
+			// producer queues waiting for the application to be created, only accessed in the main thread
+			List<GuiProducerQueue*>* waitingProducerQueues = nullptr;
+
+			void AddWaitingProducerQueue(GuiProducerQueue* queue)
+			{
+				if (!waitingProducerQueues)
+				{
+					waitingProducerQueues = new List<GuiProducerQueue*>;
+				}
+				waitingProducerQueues->Add(queue);
+			}
+
+			void RemoveWaitingProducerQueue(GuiProducerQueue* queue)
+			{
+				if (waitingProducerQueues)
+				{
+					waitingProducerQueues->Remove(queue);
+					if (waitingProducerQueues->Count() == 0)
+					{
+						delete waitingProducerQueues;
+						waitingProducerQueues = nullptr;
+					}
+				}
+			}
+
+			GuiProducerQueue::GuiProducerQueue(const Func<void()>& _beginBatch, const Func<void()>& _endBatch, vint _capacity)
+				:beginBatch(_beginBatch)
+				, endBatch(_endBatch)
+				, capacity(_capacity)
+				, pendingChanges(new ChangeList)
+				, drainingChanges(new ChangeList)
+			{
+				if (auto application = GetApplication())
+				{
+					application->RegisterProducerQueue(this);
+				}
+				else
+				{
+					AddWaitingProducerQueue(this);
+				}
+			}
+
+			GuiProducerQueue::~GuiProducerQueue()
+			{
+				if (registered)
+				{
+					if (auto application = GetApplication())
+					{
+						application->UnregisterProducerQueue(this);
+					}
+				}
+				else
+				{
+					RemoveWaitingProducerQueue(this);
+				}
+			}
+
+			bool GuiProducerQueue::TryPost(const Func<void()>& change)
+			{
+				SPIN_LOCK(pendingLock)
+				{
+					if (pendingChanges->Count() >= capacity)
+					{
+						return false;
+					}
+					pendingChanges->Add(change);
+				}
+				return true;
+			}
+
+			void GuiProducerQueue::Post(const Func<void()>& change)
+			{
+				if (TryPost(change)) return;
+
+				if (GetCurrentController()->AsyncService()->IsInMainThread())
+				{
+					// the main thread cannot wait for itself
+					SPIN_LOCK(pendingLock)
+					{
+						pendingChanges->Add(change);
+					}
+					return;
+				}
+
+				CS_LOCK(waitingLock)
+				{
+					waitingProducers++;
+					while (!TryPost(change))
+					{
+						drainedCondition.SleepWith(waitingLock);
+					}
+					waitingProducers--;
+				}
+			}
+
+			vint GuiProducerQueue::GetPendingCount()
+			{
+				SPIN_LOCK(pendingLock)
+				{
+					return pendingChanges->Count();
+				}
+				return 0;
+			}
+
+			vint GuiProducerQueue::GetCapacity()
+			{
+				return capacity;
+			}
+
+			vint GuiProducerQueue::Drain()
+			{
+				if (draining) return 0;
+				SPIN_LOCK(pendingLock)
+				{
+					if (pendingChanges->Count() == 0) return 0;
+					auto changes = pendingChanges;
+					pendingChanges = drainingChanges;
+					drainingChanges = changes;
+				}
+
+				CS_LOCK(waitingLock)
+				{
+					if (waitingProducers > 0)
+					{
+						drainedCondition.WakeAllPendings();
+					}
+				}
+
+				vint count = drainingChanges->Count();
+				draining = true;
+				if (beginBatch)
+				{
+					beginBatch();
+				}
+				try
+				{
+					FOREACH(Func<void()>, change, *drainingChanges.Obj())
+					{
+						change();
+					}
+				}
+				catch (...)
+				{
+					drainingChanges->Clear();
+					if (endBatch)
+					{
+						endBatch();
+					}
+					draining = false;
+					throw;
+				}
+				drainingChanges->Clear();
+				if (endBatch)
+				{
+					endBatch();
+				}
+				draining = false;
+				return count;
+			}
+
+/***********************************************************************
+GuiTaskScheduler
+***********************************************************************/
+
+			bool GuiTaskScheduler::PopTask(Func<void()>& task, Priority& priority, bool budgetSpent, vint& urgentQuota)
+			{
+				SPIN_LOCK(taskLock)
+				{
+					for (vint i = 0; i < PriorityCount; i++)
+					{
+						if (budgetSpent && (i >= Normal || urgentQuota == 0)) break;
+						if (tasks[i].Count() > 0)
+						{
+							task = tasks[i][0];
+							tasks[i].RemoveAt(0);
+							priority = (Priority)i;
+							if (i < Normal && urgentQuota > 0)
+							{
+								urgentQuota--;
+							}
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+
+			void GuiTaskScheduler::RequestFrame()
+			{
+				bool wake = false;
+				SPIN_LOCK(taskLock)
+				{
+					if (!wakeRequested)
+					{
+						wakeRequested = true;
+						wake = true;
+					}
+				}
+
+				if (wake)
+				{
+					auto schedulerAlive = alive;
+					controller->AsyncService()->InvokeInMainThread([=]()
+					{
+						if (*schedulerAlive.Obj())
+						{
+							RunFrame();
+						}
+					});
+				}
+			}
+
+			GuiTaskScheduler::GuiTaskScheduler(INativeController* _controller)
+				:controller(_controller)
+				, alive(new bool(true))
+			{
+			}
+
+			GuiTaskScheduler::~GuiTaskScheduler()
+			{
+				*alive.Obj() = false;
+			}
+
+			void GuiTaskScheduler::Invoke(const Func<void()>& proc, Priority priority)
+			{
+				SPIN_LOCK(taskLock)
+				{
+					tasks[priority].Add(proc);
+				}
+				RequestFrame();
+			}
+
+			void GuiTaskScheduler::InvokeWhenIdle(const Func<void()>& proc)
+			{
+				Invoke(proc, Idle);
+			}
+
+			Ptr<INativeDelay> GuiTaskScheduler::DelayInvoke(const Func<void()>& proc, vint milliseconds, Priority priority)
+			{
+				auto schedulerAlive = alive;
+				return controller->AsyncService()->DelayExecuteInMainThread([=]()
+				{
+					if (*schedulerAlive.Obj())
+					{
+						Invoke(proc, priority);
+					}
+				}, milliseconds);
+			}
+
+			vint GuiTaskScheduler::RunFrame()
+			{
+				// a task could run a nested message loop, e.g. showing a modal window
+				// RunFrame is called again in that loop, so that queued tasks keep running like they did before the scheduler
+				// input and render tasks still run after the budget is spent, but only those queued before this frame
+				// so that tasks queuing more tasks of the same priority cannot keep the frame running
+				vint urgentQuota = 0;
+				SPIN_LOCK(taskLock)
+				{
+					wakeRequested = false;
+					urgentQuota = tasks[Input].Count() + tasks[Render].Count();
+				}
+
+				vint executed = 0;
+				vint64_t frameStart = GuiStartupTrace::GetMicroseconds();
+				bool budgetSpent = false;
+				Func<void()> task;
+				Priority priority;
+				while (PopTask(task, priority, budgetSpent, urgentQuota))
+				{
+					vint64_t taskStart = GuiStartupTrace::GetMicroseconds();
+					task();
+					vint64_t taskEnd = GuiStartupTrace::GetMicroseconds();
+
+					executed++;
+					executedCount++;
+					if (taskEnd - taskStart > longestTaskDuration)
+					{
+						longestTaskDuration = taskEnd - taskStart;
+						longestTaskPriority = priority;
+					}
+					if (taskEnd - frameStart >= frameBudget * 1000)
+					{
+						budgetSpent = true;
+					}
+				}
+
+				if (budgetSpent && GetTotalQueueDepth() > 0)
+				{
+					// remaining tasks run in the next frame, after messages that are already waiting
+					// the frame is requested now instead of waiting for the global timer, whose message has the lowest priority
+					deferredFrameCount++;
+					RequestFrame();
+				}
+				return executed;
+			}
+
+			vint GuiTaskScheduler::GetFrameBudget()
+			{
+				return frameBudget;
+			}
+
+			void GuiTaskScheduler::SetFrameBudget(vint value)
+			{
+				frameBudget = value < 0 ? 0 : value;
+			}
+
+			vint GuiTaskScheduler::GetQueueDepth(Priority priority)
+			{
+				SPIN_LOCK(taskLock)
+				{
+					return tasks[priority].Count();
+				}
+				return 0;
+			}
+
+			vint GuiTaskScheduler::GetTotalQueueDepth()
+			{
+				vint depth = 0;
+				SPIN_LOCK(taskLock)
+				{
+					for (vint i = 0; i < PriorityCount; i++)
+					{
+						depth += tasks[i].Count();
+					}
+				}
+				return depth;
+			}
+
+			vint GuiTaskScheduler::GetExecutedCount()
+			{
+				return executedCount;
+			}
+
+			vint GuiTaskScheduler::GetDeferredFrameCount()
+			{
+				return deferredFrameCount;
+			}
+
+			vint64_t GuiTaskScheduler::GetLongestTaskDuration()
+			{
+				return longestTaskDuration;
+			}
+
+			GuiTaskScheduler::Priority GuiTaskScheduler::GetLongestTaskPriority()
+			{
+				return longestTaskPriority;
+			}
+
+			void GuiTaskScheduler::ResetCounters()
+			{
+				executedCount = 0;
+				deferredFrameCount = 0;
+				longestTaskDuration = 0;
+				longestTaskPriority = Normal;
+			}
+
 /***********************************************************************
 GuiApplication
 ***********************************************************************/
@@ -59,14 +610,37 @@ GuiApplication
 				}
 			}
 
+			void GuiApplication::GlobalTimer()
+			{
+				for (vint i = producerQueues.Count() - 1; i >= 0; i--)
+				{
+					if (i < producerQueues.Count())
+					{
+						producerQueues[i]->Drain();
+					}
+				}
+				taskScheduler.RunFrame();
+				bindingScheduler.FlushBindings();
+			}
+
 			GuiApplication::GuiApplication()
-				:mainWindow(0)
+				:taskScheduler(GetCurrentController())
+				,mainWindow(0)
 				,sharedTooltipOwnerWindow(0)
 				,sharedTooltipOwner(0)
 				,sharedTooltipControl(0)
 				,sharedTooltipHovering(false)
 				,sharedTooltipClosing(false)
 			{
+				if (waitingProducerQueues)
+				{
+					FOREACH(GuiProducerQueue*, queue, *waitingProducerQueues)
+					{
+						RegisterProducerQueue(queue);
+					}
+					delete waitingProducerQueues;
+					waitingProducerQueues = nullptr;
+				}
 				GetCurrentController()->CallbackService()->InstallListener(this);
 			}
 
@@ -77,6 +651,13 @@ GuiApplication
 					delete sharedTooltipControl;
 					sharedTooltipControl=0;
 				}
+				bindingScheduler.SetEnabled(false);
+				FOREACH(GuiProducerQueue*, queue, producerQueues)
+				{
+					queue->registered = false;
+					AddWaitingProducerQueue(queue);
+				}
+				producerQueues.Clear();
 				GetCurrentController()->CallbackService()->UninstallListener(this);
 			}
 
@@ -90,6 +671,21 @@ GuiApplication
 				windows.Remove(window);
 			}
 
+			void GuiApplication::RegisterProducerQueue(GuiProducerQueue* queue)
+			{
+				if (!producerQueues.Contains(queue))
+				{
+					producerQueues.Add(queue);
+					queue->registered = true;
+				}
+			}
+
+			void GuiApplication::UnregisterProducerQueue(GuiProducerQueue* queue)
+			{
+				producerQueues.Remove(queue);
+				queue->registered = false;
+			}
+
 			void GuiApplication::RegisterPopupOpened(GuiPopup* popup)
 			{
 				vint index=openingPopups.IndexOf(popup);
@@ -254,6 +850,21 @@ GuiApplication
 				return L"";
 			}
 
+			GuiBindingScheduler* GuiApplication::GetBindingScheduler()
+			{
+				return &bindingScheduler;
+			}
+
+			void GuiApplication::FlushBindings()
+			{
+				bindingScheduler.FlushBindings();
+			}
+
+			GuiTaskScheduler* GuiApplication::GetTaskScheduler()
+			{
+				return &taskScheduler;
+			}
+
 			bool GuiApplication::IsInMainThread()
 			{
 				return GetCurrentController()->AsyncService()->IsInMainThread();
@@ -269,6 +880,16 @@ GuiApplication
 				GetCurrentController()->AsyncService()->InvokeInMainThread(proc);
 			}
 
+			void GuiApplication::ScheduleInMainThread(const Func<void()>& proc, GuiTaskScheduler::Priority priority)
+			{
+				taskScheduler.Invoke(proc, priority);
+			}
+
+			void GuiApplication::ScheduleWhenIdle(const Func<void()>& proc)
+			{
+				taskScheduler.InvokeWhenIdle(proc);
+			}
+
 			bool GuiApplication::InvokeInMainThreadAndWait(const Func<void()>& proc, vint milliseconds)
 			{
 				return GetCurrentController()->AsyncService()->InvokeInMainThreadAndWait(proc, milliseconds);
@@ -303,6 +924,22 @@ GuiApplication
 GuiPluginManager
 ***********************************************************************/
 
+			WString GetPluginTraceName(IGuiPlugin* plugin, const WString& function)
+			{
+				if (!GuiStartupTrace::IsEnabled()) return WString::Empty;
+				const char* typeName = typeid(*plugin).name();
+#if defined VCZH_GCC
+				int status = 0;
+				if (char* demangled = abi::__cxa_demangle(typeName, nullptr, nullptr, &status))
+				{
+					WString name = atow(demangled);
+					free(demangled);
+					return name + L"::" + function;
+				}
+#endif
+				return atow(typeName) + L"::" + function;
+			}
+
 			class GuiPluginManager : public Object, public IGuiPluginManager
 			{
 			protected:
@@ -335,10 +972,12 @@ GuiPluginManager
 						loaded=true;
 						FOREACH(Ptr<IGuiPlugin>, plugin, plugins)
 						{
+							GuiStartupTrace::Scope scope(L"Plugin", GetPluginTraceName(plugin.Obj(), L"Load"));
 							plugin->Load();
 						}
 						FOREACH(Ptr<IGuiPlugin>, plugin, plugins)
 						{
+							GuiStartupTrace::Scope scope(L"Plugin", GetPluginTraceName(plugin.Obj(), L"AfterLoad"));
 							plugin->AfterLoad();
 						}
 					}
@@ -423,7 +1062,10 @@ GuiApplicationMain
 				GetCurrentController()->InputService()->StartTimer();
 
 #ifndef VCZH_DEBUG_NO_REFLECTION
-				GetGlobalTypeManager()->Load();
+				{
+					GuiStartupTrace::Scope scope(L"TypeLoader", L"ITypeManager::Load");
+					GetGlobalTypeManager()->Load();
+				}
 #endif
 				GetPluginManager()->Load();
 				theme::SetCurrentTheme(theme.Obj());
@@ -434,6 +1076,7 @@ GuiApplicationMain
 					GuiMain();
 				}
 				application = nullptr;
+				GuiStartupTrace::Finish();
 
 				theme::SetCurrentTheme(0);
 				DestroyPluginManager();
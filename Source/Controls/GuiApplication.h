@@ -18,6 +18,238 @@ namespace vl
 		namespace controls
 		{
 
+/***********************************************************************
+Binding Scheduler
+***********************************************************************/
+
+			/// <summary>
+			/// Defers re-evaluations of bind expressions to the next UI frame, so that a subscription re-evaluates at most once no matter how many values it observes are changed.
+			/// When a re-evaluation changes values observed by other subscriptions, they depend on it, and a subscription is not evaluated before any pending subscription it depends on.
+			/// Dependencies are remembered as long as both subscriptions are alive.
+			/// It is disabled by default, and bind expressions re-evaluate immediately.
+			/// Bind expressions only call the scheduler when they are compiled with [F:vl.workflow.analyzer.WfLexicalScopeManager.scheduleBindings] set to true.
+			/// </summary>
+			class GuiBindingScheduler : public Object, public description::IValueSubscriptionScheduler
+			{
+			protected:
+				class Record : public Object
+				{
+				public:
+					GuiBindingScheduler*						scheduler = nullptr;
+					description::IValueSubscription*			subscription = nullptr;		// valid as long as the record exists, because the subscription owns the record
+					collections::SortedList<Record*>			sources;					// subscriptions whose re-evaluations scheduled this one
+					bool										dirty = false;
+
+					~Record();
+				};
+
+				struct DirtyRecord
+				{
+					Ptr<description::IValueSubscription>		subscription;				// keeps the subscription alive until it is evaluated
+					Record*										record = nullptr;
+				};
+
+				bool											enabled = false;
+				bool											flushing = false;
+				Record*											evaluatingRecord = nullptr;
+				collections::SortedList<Record*>				records;
+				collections::List<DirtyRecord>					dirtyRecords;
+				vint											scheduledCount = 0;
+				vint											evaluatedCount = 0;
+
+				Record*											GetRecord(description::IValueSubscription* subscription);
+				void											RemoveRecord(Record* record);
+				vint											SelectDirtyRecord();
+				void											DetachRecords();
+
+			public:
+				GuiBindingScheduler();
+				~GuiBindingScheduler();
+
+				bool											Schedule(description::IValueSubscription* subscription)override;
+
+				/// <summary>Test if the scheduler is enabled.</summary>
+				/// <returns>Returns true if the scheduler is enabled.</returns>
+				bool											GetEnabled();
+				/// <summary>Enable or disable the scheduler. Pending re-evaluations are flushed when it is disabled.</summary>
+				/// <param name="value">Set to true to enable the scheduler.</param>
+				void											SetEnabled(bool value);
+				/// <summary>Re-evaluate all pending subscriptions now. It is called before rendering every UI frame.</summary>
+				void											FlushBindings();
+
+				/// <summary>Get the number of re-evaluation requests from bind expressions.</summary>
+				/// <returns>The number of re-evaluation requests.</returns>
+				vint											GetScheduledCount();
+				/// <summary>Get the number of actual re-evaluations.</summary>
+				/// <returns>The number of actual re-evaluations.</returns>
+				vint											GetEvaluatedCount();
+				/// <summary>Get the number of re-evaluations saved by merging requests.</summary>
+				/// <returns>The number of saved re-evaluations.</returns>
+				vint											GetSavedCount();
+				/// <summary>Reset all counters.</summary>
+				void											ResetCounters();
+			};
+
+/***********************************************************************
+Producer Queue
+***********************************************************************/
+
+			/// <summary>
+			/// Collects changes posted from any thread, and applies them in the main thread once per UI frame.
+			/// It replaces one [M:vl.presentation.controls.GuiApplication.InvokeInMainThread] call per change for data feeds with high rates.
+			/// Changes are applied between the begin and end batch callbacks, which usually call BeginBatchUpdate and EndBatchUpdate of an item provider or a node root provider, so that all changes in a frame are notified as one range.
+			/// When the main thread falls behind and the queue reaches its capacity, <see cref="TryPost"/> fails and <see cref="Post"/> waits until changes are applied.
+			/// </summary>
+			class GuiProducerQueue : public Object, private NotCopyable
+			{
+				friend class GuiApplication;
+				typedef collections::List<Func<void()>>			ChangeList;
+			public:
+				/// <summary>The default capacity.</summary>
+				static const vint								DefaultCapacity = 65536;
+
+			protected:
+				Func<void()>									beginBatch;
+				Func<void()>									endBatch;
+				vint											capacity;
+				bool											registered = false;
+				bool											draining = false;
+
+				SpinLock										pendingLock;
+				Ptr<ChangeList>									pendingChanges;
+				Ptr<ChangeList>									drainingChanges;
+
+				CriticalSection									waitingLock;
+				ConditionVariable								drainedCondition;
+				vint											waitingProducers = 0;
+
+			public:
+				/// <summary>Create a producer queue in the main thread. It is drained automatically every UI frame. If it is created before the application starts, it is registered when the application is created.</summary>
+				/// <param name="_beginBatch">The callback before applying changes. It could be null.</param>
+				/// <param name="_endBatch">The callback after applying changes. It could be null.</param>
+				/// <param name="_capacity">The maximum number of changes waiting to be applied.</param>
+				GuiProducerQueue(const Func<void()>& _beginBatch = Func<void()>(), const Func<void()>& _endBatch = Func<void()>(), vint _capacity = DefaultCapacity);
+				~GuiProducerQueue();
+
+				/// <summary>Post a change from any thread without waiting.</summary>
+				/// <returns>Returns false if the queue is full, in which case the change is discarded.</returns>
+				/// <param name="change">The change to apply in the main thread.</param>
+				bool											TryPost(const Func<void()>& change);
+				/// <summary>Post a change from any thread. If the queue is full, it waits for the main thread to apply pending changes. When it is called in the main thread, the change is queued regardless of the capacity.</summary>
+				/// <param name="change">The change to apply in the main thread.</param>
+				void											Post(const Func<void()>& change);
+				/// <summary>Get the number of changes waiting to be applied.</summary>
+				/// <returns>The number of changes waiting to be applied.</returns>
+				vint											GetPendingCount();
+				/// <summary>Get the maximum number of changes waiting to be applied.</summary>
+				/// <returns>The maximum number of changes waiting to be applied.</returns>
+				vint											GetCapacity();
+				/// <summary>Apply all pending changes in the main thread.</summary>
+				/// <returns>The number of applied changes.</returns>
+				vint											Drain();
+			};
+
+/***********************************************************************
+Task Scheduler
+***********************************************************************/
+
+			/// <summary>
+			/// Runs tasks in the main thread by priority, within a time budget per UI frame.
+			/// When the budget is spent, input and render tasks that were waiting before the frame still run, other tasks are deferred to the next frame.
+			/// The next frame is requested immediately, so deferred tasks do not wait for the global timer.
+			/// Idle tasks only run when no other task is waiting.
+			/// [M:vl.presentation.controls.GuiApplication.InvokeInMainThread] and [M:vl.presentation.controls.GuiApplication.DelayExecuteInMainThread] do not use the scheduler, they keep the order of the native async service.
+			/// </summary>
+			class GuiTaskScheduler : public Object, private NotCopyable
+			{
+			public:
+				/// <summary>Priority of a task.</summary>
+				enum Priority
+				{
+					/// <summary>Tasks for responding to user input.</summary>
+					Input = 0,
+					/// <summary>Tasks for updating what will be rendered in this frame.</summary>
+					Render = 1,
+					/// <summary>Ordinary tasks.</summary>
+					Normal = 2,
+					/// <summary>Tasks that run only when there is nothing else to do.</summary>
+					Idle = 3,
+				};
+
+				/// <summary>The default time budget for a frame in milliseconds.</summary>
+				static const vint								DefaultFrameBudget = 8;
+				static const vint								PriorityCount = 4;
+
+			protected:
+				typedef collections::List<Func<void()>>			TaskList;
+
+				INativeController*								controller;
+				Ptr<bool>										alive;
+				SpinLock										taskLock;
+				TaskList										tasks[PriorityCount];
+				bool											wakeRequested = false;
+				vint											frameBudget = DefaultFrameBudget;
+
+				vint											executedCount = 0;
+				vint											deferredFrameCount = 0;
+				vint64_t										longestTaskDuration = 0;
+				Priority										longestTaskPriority = Normal;
+
+				bool											PopTask(Func<void()>& task, Priority& priority, bool budgetSpent, vint& urgentQuota);
+				void											RequestFrame();
+			public:
+				/// <summary>Create a task scheduler.</summary>
+				/// <param name="_controller">The native controller to wake up the main thread. A stand-in controller could be used in unit tests.</param>
+				GuiTaskScheduler(INativeController* _controller);
+				~GuiTaskScheduler();
+
+				/// <summary>Queue a task from any thread.</summary>
+				/// <param name="proc">The task.</param>
+				/// <param name="priority">The priority of the task.</param>
+				void											Invoke(const Func<void()>& proc, Priority priority = Normal);
+				/// <summary>Queue a task from any thread, which runs only when no other task is waiting.</summary>
+				/// <param name="proc">The task.</param>
+				void											InvokeWhenIdle(const Func<void()>& proc);
+				/// <summary>Queue a task after a period of time. The returned delay controls when the task is queued, not when it runs.</summary>
+				/// <returns>The delay execution controller for this task.</returns>
+				/// <param name="proc">The task.</param>
+				/// <param name="milliseconds">Time to delay.</param>
+				/// <param name="priority">The priority of the task.</param>
+				Ptr<INativeDelay>								DelayInvoke(const Func<void()>& proc, vint milliseconds, Priority priority = Normal);
+				/// <summary>Run tasks in the main thread until all tasks are done or the time budget is spent. It is called every UI frame, and after tasks are queued. It is also called in nested message loops, like the one for a modal window.</summary>
+				/// <returns>The number of executed tasks.</returns>
+				vint											RunFrame();
+
+				/// <summary>Get the time budget for a frame.</summary>
+				/// <returns>The time budget in milliseconds.</returns>
+				vint											GetFrameBudget();
+				/// <summary>Set the time budget for a frame.</summary>
+				/// <param name="value">The time budget in milliseconds.</param>
+				void											SetFrameBudget(vint value);
+
+				/// <summary>Get the number of waiting tasks of a priority.</summary>
+				/// <returns>The number of waiting tasks.</returns>
+				/// <param name="priority">The priority.</param>
+				vint											GetQueueDepth(Priority priority);
+				/// <summary>Get the number of all waiting tasks.</summary>
+				/// <returns>The number of all waiting tasks.</returns>
+				vint											GetTotalQueueDepth();
+				/// <summary>Get the number of executed tasks.</summary>
+				/// <returns>The number of executed tasks.</returns>
+				vint											GetExecutedCount();
+				/// <summary>Get the number of frames that deferred tasks because the time budget is spent.</summary>
+				/// <returns>The number of frames.</returns>
+				vint											GetDeferredFrameCount();
+				/// <summary>Get the duration of the longest task.</summary>
+				/// <returns>The duration in microseconds.</returns>
+				vint64_t										GetLongestTaskDuration();
+				/// <summary>Get the priority of the longest task.</summary>
+				/// <returns>The priority.</returns>
+				Priority										GetLongestTaskPriority();
+				/// <summary>Reset all counters.</summary>
+				void											ResetCounters();
+			};
+
 /***********************************************************************
 Application
 ***********************************************************************/
@@ -26,6 +258,7 @@ Application
 			class GuiApplication : public Object, private INativeControllerListener, public Description<GuiApplication>
 			{
 				friend void GuiApplicationInitialize();
+				friend class GuiProducerQueue;
 				friend class GuiWindow;
 				friend class GuiPopup;
 				friend class Ptr<GuiApplication>;
@@ -36,7 +269,11 @@ Application
 				void											RightButtonDown(Point position)override;
 				void											RightButtonUp(Point position)override;
 				void											ClipboardUpdated()override;
+				void											GlobalTimer()override;
 			protected:
+				GuiBindingScheduler								bindingScheduler;
+				GuiTaskScheduler								taskScheduler;
+				collections::List<GuiProducerQueue*>			producerQueues;
 				GuiWindow*										mainWindow;
 				GuiWindow*										sharedTooltipOwnerWindow;
 				GuiControl*										sharedTooltipOwner;
@@ -51,6 +288,8 @@ Application
 
 				void											RegisterWindow(GuiWindow* window);
 				void											UnregisterWindow(GuiWindow* window);
+				void											RegisterProducerQueue(GuiProducerQueue* queue);
+				void											UnregisterProducerQueue(GuiProducerQueue* queue);
 				void											RegisterPopupOpened(GuiPopup* popup);
 				void											RegisterPopupClosed(GuiPopup* popup);
 				void											OnMouseDown(Point location);
@@ -87,16 +326,31 @@ Application
 				/// <summary>Get the folder of the current executable.</summary>
 				/// <returns>The folder of the current executable.</returns>
 				WString											GetExecutableFolder();
+				/// <summary>Get the scheduler for re-evaluations of bind expressions.</summary>
+				/// <returns>The scheduler.</returns>
+				GuiBindingScheduler*							GetBindingScheduler();
+				/// <summary>Re-evaluate all bind expressions that are deferred by the binding scheduler.</summary>
+				void											FlushBindings();
+				/// <summary>Get the scheduler for prioritized tasks in the main thread.</summary>
+				/// <returns>The scheduler.</returns>
+				GuiTaskScheduler*								GetTaskScheduler();
 
 				/// <summary>Test is the current thread the main thread for GUI.</summary>
 				/// <returns>Returns true if the current thread is the main thread for GUI.</returns>
 				bool											IsInMainThread();
-				/// <summary>Invoke a specified function asynchronously.</summary>
+				/// <summary>Invoke a specified function asynchronously. The function runs in a thread pool instead of the main thread, so it is not scheduled by <see cref="GuiTaskScheduler"/>.</summary>
 				/// <param name="proc">The specified function.</param>
 				void											InvokeAsync(const Func<void()>& proc);
 				/// <summary>Invoke a specified function in the main thread.</summary>
 				/// <param name="proc">The specified function.</param>
 				void											InvokeInMainThread(const Func<void()>& proc);
+				/// <summary>Invoke a specified function in the main thread by priority, within the time budget of UI frames. See <see cref="GuiTaskScheduler"/> for details.</summary>
+				/// <param name="proc">The specified function.</param>
+				/// <param name="priority">The priority of the function.</param>
+				void											ScheduleInMainThread(const Func<void()>& proc, GuiTaskScheduler::Priority priority);
+				/// <summary>Invoke a specified function in the main thread when no other scheduled function is waiting.</summary>
+				/// <param name="proc">The specified function.</param>
+				void											ScheduleWhenIdle(const Func<void()>& proc);
 				/// <summary>Invoke a specified function in the main thread and wait for the function to complete or timeout.</summary>
 				/// <returns>Return true if the function complete. Return false if the function has not completed during a specified period of time.</returns>
 				/// <param name="proc">The specified function.</param>
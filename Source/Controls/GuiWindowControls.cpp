@@ -23,9 +23,10 @@ GuiControlHost
 			{
 			}
 
-			GuiControl* GuiControlHost::GetTooltipOwner(Point location)
+			GuiControl* GuiControlHost::GetTooltipOwner()
 			{
-				GuiGraphicsComposition* composition=this->GetBoundsComposition()->FindComposition(location);
+				// the hovered composition is updated when mouse moves are delivered, so the window is not hit-tested for every mouse position
+				GuiGraphicsComposition* composition=host->GetHoveredComposition();
 				if(composition)
 				{
 					GuiControl* control=composition->GetRelatedControl();
@@ -77,7 +78,7 @@ GuiControlHost
 					{
 						tooltipOpenDelay=GetApplication()->DelayExecuteInMainThread([this]()
 						{
-							GuiControl* owner=GetTooltipOwner(tooltipLocation);
+							GuiControl* owner=GetTooltipOwner();
 							if(owner)
 							{
 								Point offset=owner->GetBoundsComposition()->GetGlobalBounds().LeftTop();
@@ -107,7 +108,7 @@ GuiControlHost
 			{
 				if(!info.left && !info.middle && !info.right)
 				{
-					GuiControl* tooltipControl=GetTooltipOwner(tooltipLocation);
+					GuiControl* tooltipControl=GetTooltipOwner();
 					MoveIntoTooltipControl(tooltipControl, Point(info.x, info.y));
 				}
 			}
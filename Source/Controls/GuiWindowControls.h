@@ -41,7 +41,7 @@ Control Host
 				Ptr<INativeDelay>								tooltipCloseDelay;
 				Point											tooltipLocation;
 				
-				GuiControl*										GetTooltipOwner(Point location);
+				GuiControl*										GetTooltipOwner();
 				void											MoveIntoTooltipControl(GuiControl* tooltipControl, Point location);
 				void											MouseMoving(const NativeWindowMouseInfo& info)override;
 				void											MouseLeaved()override;
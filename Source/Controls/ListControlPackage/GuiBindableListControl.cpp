@@ -77,60 +77,376 @@ namespace vl
 			}
 
 /***********************************************************************
-GuiBindableTextList::ItemSource
+BindableItemSource
 ***********************************************************************/
 
-			GuiBindableTextList::ItemSource::ItemSource()
+			namespace list
 			{
-			}
+				description::Value BindableItemSource::ReadKey(const description::Value& item)
+				{
+					return ReadProperty(item, keyProperty);
+				}
 
-			GuiBindableTextList::ItemSource::~ItemSource()
-			{
-				SetItemSource(nullptr);
-			}
+				bool BindableItemSource::IsContentChanged(const description::Value& oldItem, const description::Value& newItem)
+				{
+					if (contentProperty)
+					{
+						return ReadProperty(oldItem, contentProperty) != ReadProperty(newItem, contentProperty);
+					}
+					return oldItem != newItem;
+				}
 
-			Ptr<description::IValueEnumerable> GuiBindableTextList::ItemSource::GetItemSource()
-			{
-				return itemSource;
-			}
+				void BindableItemSource::ResetSnapshot()
+				{
+					snapshot = nullptr;
+					snapshotKeys.Clear();
 
-			void GuiBindableTextList::ItemSource::SetItemSource(Ptr<description::IValueEnumerable> _itemSource)
-			{
-				vint oldCount = 0;
-				if (itemSource)
+					if (keyProperty && boundItemSource)
+					{
+						snapshot = IValueList::Create();
+						vint count = boundItemSource->GetCount();
+						for (vint i = 0; i < count; i++)
+						{
+							auto item = boundItemSource->Get(i);
+							snapshot->Add(item);
+							snapshotKeys.Add(ReadKey(item));
+						}
+						items = snapshot;
+					}
+					else
+					{
+						items = boundItemSource;
+					}
+				}
+
+				void BindableItemSource::ReplaceSnapshot(vint start, vint oldCount, vint newCount)
 				{
-					oldCount = itemSource->GetCount();
+					for (vint i = 0; i < oldCount; i++)
+					{
+						snapshot->RemoveAt(start);
+						snapshotKeys.RemoveAt(start);
+					}
+					for (vint i = 0; i < newCount; i++)
+					{
+						auto item = boundItemSource->Get(start + i);
+						snapshot->Insert(start + i, item);
+						snapshotKeys.Insert(start + i, ReadKey(item));
+					}
 				}
-				if (itemChangedEventHandler)
+
+				bool BindableItemSource::DiffSnapshot()
 				{
-					auto ol = itemSource.Cast<IValueObservableList>();
-					ol->ItemChanged.Remove(itemChangedEventHandler);
+					List<Value> oldItems, newItems, newKeys;
+					CopyFrom(oldItems, GetLazyList<Value>(snapshot));
+					{
+						vint count = boundItemSource->GetCount();
+						for (vint i = 0; i < count; i++)
+						{
+							auto item = boundItemSource->Get(i);
+							newItems.Add(item);
+							newKeys.Add(ReadKey(item));
+						}
+					}
+
+					vint oldCount = oldItems.Count();
+					vint newCount = newItems.Count();
+					vint prefix = 0;
+					while (prefix < oldCount && prefix < newCount && snapshotKeys[prefix] == newKeys[prefix])
+					{
+						prefix++;
+					}
+					vint suffix = 0;
+					while (suffix < oldCount - prefix && suffix < newCount - prefix && snapshotKeys[oldCount - suffix - 1] == newKeys[newCount - suffix - 1])
+					{
+						suffix++;
+					}
+
+					// find the shortest edit script of keys between the common prefix and suffix, using Myers' algorithm
+					// trace stores V[-d..d] of each step d from offset d*d
+					vint n = oldCount - prefix - suffix;
+					vint m = newCount - prefix - suffix;
+					vint maxD = n + m < MaxEditDistance ? n + m : MaxEditDistance;
+					Array<vint> v(maxD * 2 + 3);
+					List<vint> trace;
+					vint offset = maxD + 1;
+					vint editDistance = -1;
+					v[offset + 1] = 0;
+
+					for (vint d = 0; d <= maxD && editDistance == -1; d++)
+					{
+						for (vint k = -d; k <= d; k += 2)
+						{
+							vint x = k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1])
+								? v[offset + k + 1]
+								: v[offset + k - 1] + 1
+								;
+							vint y = x - k;
+							while (x < n && y < m && snapshotKeys[prefix + x] == newKeys[prefix + y])
+							{
+								x++;
+								y++;
+							}
+							v[offset + k] = x;
+							if (x >= n && y >= m)
+							{
+								editDistance = d;
+								break;
+							}
+						}
+						for (vint k = -d; k <= d; k++)
+						{
+							trace.Add(v[offset + k]);
+						}
+					}
+					if (editDistance == -1)
+					{
+						return false;
+					}
+
+					// collect matched items in reverse order as (old index, new index)
+					List<Pair<vint, vint>> matches;
+					for (vint i = 0; i < suffix; i++)
+					{
+						matches.Add(Pair<vint, vint>(oldCount - i - 1, newCount - i - 1));
+					}
+					{
+						vint x = n;
+						vint y = m;
+						for (vint d = editDistance; d > 0; d--)
+						{
+							vint previous = (d - 1) * (d - 1) + d - 1;
+							vint k = x - y;
+							vint previousK = k == -d || (k != d && trace[previous + k - 1] < trace[previous + k + 1]) ? k + 1 : k - 1;
+							vint previousX = trace[previous + previousK];
+							vint previousY = previousX - previousK;
+							while (x > previousX && y > previousY)
+							{
+								x--;
+								y--;
+								matches.Add(Pair<vint, vint>(prefix + x, prefix + y));
+							}
+							x = previousX;
+							y = previousY;
+						}
+						while (x > 0 && y > 0)
+						{
+							x--;
+							y--;
+							matches.Add(Pair<vint, vint>(prefix + x, prefix + y));
+						}
+					}
+					for (vint i = prefix - 1; i >= 0; i--)
+					{
+						matches.Add(Pair<vint, vint>(i, i));
+					}
+
+					// apply the edit script to the snapshot, merging adjacent changes into one notification
+					vint pendingStart = -1;
+					vint pendingOldCount = 0;
+					vint pendingNewCount = 0;
+
+					auto flush = [&]()
+					{
+						if (pendingStart == -1) return;
+						for (vint i = 0; i < pendingOldCount; i++)
+						{
+							snapshot->RemoveAt(pendingStart);
+							snapshotKeys.RemoveAt(pendingStart);
+						}
+						for (vint i = 0; i < pendingNewCount; i++)
+						{
+							snapshot->Insert(pendingStart + i, newItems[pendingStart + i]);
+							snapshotKeys.Insert(pendingStart + i, newKeys[pendingStart + i]);
+						}
+						callback(pendingStart, pendingOldCount, pendingNewCount);
+						pendingStart = -1;
+						pendingOldCount = 0;
+						pendingNewCount = 0;
+					};
+
+					auto change = [&](vint start, vint changedOldCount, vint changedNewCount)
+					{
+						if (changedOldCount == 0 && changedNewCount == 0) return;
+						if (pendingStart == -1)
+						{
+							pendingStart = start;
+						}
+						pendingOldCount += changedOldCount;
+						pendingNewCount += changedNewCount;
+					};
+
+					vint oldIndex = 0;
+					vint newIndex = 0;
+					for (vint i = matches.Count() - 1; i >= -1; i--)
+					{
+						vint matchedOld = i == -1 ? oldCount : matches[i].key;
+						vint matchedNew = i == -1 ? newCount : matches[i].value;
+						change(newIndex, matchedOld - oldIndex, matchedNew - newIndex);
+						if (i != -1)
+						{
+							if (IsContentChanged(oldItems[matchedOld], newItems[matchedNew]))
+							{
+								change(matchedNew, 1, 1);
+							}
+							else
+							{
+								// the item is not changed, but the snapshot should still hold the item from the new item source
+								flush();
+								snapshot->Set(matchedNew, newItems[matchedNew]);
+							}
+						}
+						oldIndex = matchedOld + 1;
+						newIndex = matchedNew + 1;
+					}
+					flush();
+					return true;
 				}
 
-				itemSource = nullptr;
-				itemChangedEventHandler = nullptr;
+				BindableItemSource::BindableItemSource(const ItemChangedCallback& _callback)
+					:callback(_callback)
+				{
+				}
+
+				BindableItemSource::~BindableItemSource()
+				{
+					if (itemChangedEventHandler)
+					{
+						auto ol = boundItemSource.Cast<IValueObservableList>();
+						ol->ItemChanged.Remove(itemChangedEventHandler);
+					}
+				}
 
-				if (_itemSource)
+				Ptr<description::IValueEnumerable> BindableItemSource::GetItemSource()
 				{
-					if (auto ol = _itemSource.Cast<IValueObservableList>())
+					return boundItemSource;
+				}
+
+				void BindableItemSource::SetItemSource(Ptr<description::IValueEnumerable> _itemSource)
+				{
+					vint oldCount = 0;
+					if (items)
+					{
+						oldCount = items->GetCount();
+					}
+					if (itemChangedEventHandler)
+					{
+						auto ol = boundItemSource.Cast<IValueObservableList>();
+						ol->ItemChanged.Remove(itemChangedEventHandler);
+					}
+
+					bool diffing = snapshot;
+					boundItemSource = nullptr;
+					itemChangedEventHandler = nullptr;
+
+					if (_itemSource)
 					{
-						itemSource = ol;
-						itemChangedEventHandler = ol->ItemChanged.Add([this](vint start, vint oldCount, vint newCount)
+						if (auto ol = _itemSource.Cast<IValueObservableList>())
+						{
+							boundItemSource = ol;
+							itemChangedEventHandler = ol->ItemChanged.Add([this](vint start, vint oldCount, vint newCount)
+							{
+								if (snapshot)
+								{
+									ReplaceSnapshot(start, oldCount, newCount);
+								}
+								callback(start, oldCount, newCount);
+							});
+						}
+						else if (auto rl = _itemSource.Cast<IValueReadonlyList>())
 						{
-							InvokeOnItemModified(start, oldCount, newCount);
-						});
+							boundItemSource = rl;
+						}
+						else
+						{
+							boundItemSource = IValueList::Create(GetLazyList<Value>(_itemSource));
+						}
 					}
-					else if (auto rl = _itemSource.Cast<IValueReadonlyList>())
+
+					if (!diffing || !boundItemSource || !DiffSnapshot())
 					{
-						itemSource = rl;
+						ResetSnapshot();
+						callback(0, oldCount, items ? items->GetCount() : 0);
 					}
-					else
+				}
+
+				Ptr<description::IValueReadonlyList> BindableItemSource::GetItems()
+				{
+					return items;
+				}
+
+				ItemProperty<description::Value> BindableItemSource::GetKeyProperty()
+				{
+					return keyProperty;
+				}
+
+				void BindableItemSource::SetKeyProperty(const ItemProperty<description::Value>& value)
+				{
+					if (keyProperty != value)
 					{
-						itemSource = IValueList::Create(GetLazyList<Value>(_itemSource));
+						keyProperty = value;
+						ResetSnapshot();
+						vint count = items ? items->GetCount() : 0;
+						callback(0, count, count);
 					}
 				}
 
-				InvokeOnItemModified(0, oldCount, itemSource ? itemSource->GetCount() : 0);
+				ItemProperty<description::Value> BindableItemSource::GetContentProperty()
+				{
+					return contentProperty;
+				}
+
+				void BindableItemSource::SetContentProperty(const ItemProperty<description::Value>& value)
+				{
+					contentProperty = value;
+				}
+			}
+
+/***********************************************************************
+GuiBindableTextList::ItemSource
+***********************************************************************/
+
+			GuiBindableTextList::ItemSource::ItemSource()
+				:bindableItemSource([this](vint start, vint oldCount, vint newCount)
+				{
+					itemSource = bindableItemSource.GetItems();
+					InvokeOnItemModified(start, oldCount, newCount);
+				})
+			{
+			}
+
+			GuiBindableTextList::ItemSource::~ItemSource()
+			{
+				SetItemSource(nullptr);
+			}
+
+			Ptr<description::IValueEnumerable> GuiBindableTextList::ItemSource::GetItemSource()
+			{
+				return bindableItemSource.GetItemSource();
+			}
+
+			void GuiBindableTextList::ItemSource::SetItemSource(Ptr<description::IValueEnumerable> _itemSource)
+			{
+				bindableItemSource.SetItemSource(_itemSource);
+			}
+
+			ItemProperty<description::Value> GuiBindableTextList::ItemSource::GetKeyProperty()
+			{
+				return bindableItemSource.GetKeyProperty();
+			}
+
+			void GuiBindableTextList::ItemSource::SetKeyProperty(const ItemProperty<description::Value>& value)
+			{
+				bindableItemSource.SetKeyProperty(value);
+			}
+
+			ItemProperty<description::Value> GuiBindableTextList::ItemSource::GetContentProperty()
+			{
+				return bindableItemSource.GetContentProperty();
+			}
+
+			void GuiBindableTextList::ItemSource::SetContentProperty(const ItemProperty<description::Value>& value)
+			{
+				bindableItemSource.SetContentProperty(value);
 			}
 
 			description::Value GuiBindableTextList::ItemSource::Get(vint index)
@@ -252,6 +568,8 @@ GuiBindableTextList
 
 				TextPropertyChanged.SetAssociatedComposition(boundsComposition);
 				TextPropertyChanged.SetAssociatedComposition(boundsComposition);
+				KeyPropertyChanged.SetAssociatedComposition(boundsComposition);
+				ContentPropertyChanged.SetAssociatedComposition(boundsComposition);
 			}
 
 			GuiBindableTextList::~GuiBindableTextList()
@@ -298,6 +616,34 @@ GuiBindableTextList
 				}
 			}
 
+			ItemProperty<description::Value> GuiBindableTextList::GetKeyProperty()
+			{
+				return itemSource->GetKeyProperty();
+			}
+
+			void GuiBindableTextList::SetKeyProperty(const ItemProperty<description::Value>& value)
+			{
+				if (itemSource->GetKeyProperty() != value)
+				{
+					itemSource->SetKeyProperty(value);
+					KeyPropertyChanged.Execute(GetNotifyEventArguments());
+				}
+			}
+
+			ItemProperty<description::Value> GuiBindableTextList::GetContentProperty()
+			{
+				return itemSource->GetContentProperty();
+			}
+
+			void GuiBindableTextList::SetContentProperty(const ItemProperty<description::Value>& value)
+			{
+				if (itemSource->GetContentProperty() != value)
+				{
+					itemSource->SetContentProperty(value);
+					ContentPropertyChanged.Execute(GetNotifyEventArguments());
+				}
+			}
+
 			description::Value GuiBindableTextList::GetSelectedItem()
 			{
 				vint index = GetSelectedItemIndex();
@@ -312,6 +658,11 @@ GuiBindableListView::ItemSource
 			GuiBindableListView::ItemSource::ItemSource()
 				:columns(this)
 				, dataColumns(this)
+				, bindableItemSource([this](vint start, vint oldCount, vint newCount)
+				{
+					itemSource = bindableItemSource.GetItems();
+					InvokeOnItemModified(start, oldCount, newCount);
+				})
 			{
 			}
 
@@ -322,46 +673,32 @@ GuiBindableListView::ItemSource
 
 			Ptr<description::IValueEnumerable> GuiBindableListView::ItemSource::GetItemSource()
 			{
-				return itemSource;
+				return bindableItemSource.GetItemSource();
 			}
 
 			void GuiBindableListView::ItemSource::SetItemSource(Ptr<description::IValueEnumerable> _itemSource)
 			{
-				vint oldCount = 0;
-				if (itemSource)
-				{
-					oldCount = itemSource->GetCount();
-				}
-				if (itemChangedEventHandler)
-				{
-					auto ol = itemSource.Cast<IValueObservableList>();
-					ol->ItemChanged.Remove(itemChangedEventHandler);
-				}
+				bindableItemSource.SetItemSource(_itemSource);
+			}
 
-				itemSource = nullptr;
-				itemChangedEventHandler = nullptr;
+			ItemProperty<description::Value> GuiBindableListView::ItemSource::GetKeyProperty()
+			{
+				return bindableItemSource.GetKeyProperty();
+			}
 
-				if (_itemSource)
-				{
-					if (auto ol = _itemSource.Cast<IValueObservableList>())
-					{
-						itemSource = ol;
-						itemChangedEventHandler = ol->ItemChanged.Add([this](vint start, vint oldCount, vint newCount)
-						{
-							InvokeOnItemModified(start, oldCount, newCount);
-						});
-					}
-					else if (auto rl = _itemSource.Cast<IValueReadonlyList>())
-					{
-						itemSource = rl;
-					}
-					else
-					{
-						itemSource = IValueList::Create(GetLazyList<Value>(_itemSource));
-					}
-				}
+			void GuiBindableListView::ItemSource::SetKeyProperty(const ItemProperty<description::Value>& value)
+			{
+				bindableItemSource.SetKeyProperty(value);
+			}
 
-				InvokeOnItemModified(0, oldCount, itemSource ? itemSource->GetCount() : 0);
+			ItemProperty<description::Value> GuiBindableListView::ItemSource::GetContentProperty()
+			{
+				return bindableItemSource.GetContentProperty();
+			}
+
+			void GuiBindableListView::ItemSource::SetContentProperty(const ItemProperty<description::Value>& value)
+			{
+				bindableItemSource.SetContentProperty(value);
 			}
 
 			description::Value GuiBindableListView::ItemSource::Get(vint index)
@@ -637,6 +974,8 @@ GuiBindableListView
 
 				LargeImagePropertyChanged.SetAssociatedComposition(boundsComposition);
 				SmallImagePropertyChanged.SetAssociatedComposition(boundsComposition);
+				KeyPropertyChanged.SetAssociatedComposition(boundsComposition);
+				ContentPropertyChanged.SetAssociatedComposition(boundsComposition);
 			}
 
 			GuiBindableListView::~GuiBindableListView()
@@ -693,6 +1032,34 @@ GuiBindableListView
 				}
 			}
 
+			ItemProperty<description::Value> GuiBindableListView::GetKeyProperty()
+			{
+				return itemSource->GetKeyProperty();
+			}
+
+			void GuiBindableListView::SetKeyProperty(const ItemProperty<description::Value>& value)
+			{
+				if (itemSource->GetKeyProperty() != value)
+				{
+					itemSource->SetKeyProperty(value);
+					KeyPropertyChanged.Execute(GetNotifyEventArguments());
+				}
+			}
+
+			ItemProperty<description::Value> GuiBindableListView::GetContentProperty()
+			{
+				return itemSource->GetContentProperty();
+			}
+
+			void GuiBindableListView::SetContentProperty(const ItemProperty<description::Value>& value)
+			{
+				if (itemSource->GetContentProperty() != value)
+				{
+					itemSource->SetContentProperty(value);
+					ContentPropertyChanged.Execute(GetNotifyEventArguments());
+				}
+			}
+
 			description::Value GuiBindableListView::GetSelectedItem()
 			{
 				vint index = GetSelectedItemIndex();
@@ -1174,6 +1541,11 @@ GuiBindableDataProvider
 
 				BindableDataProvider::BindableDataProvider(const description::Value& _viewModelContext)
 					:viewModelContext(_viewModelContext)
+					, bindableItemSource([this](vint start, vint oldCount, vint newCount)
+					{
+						itemSource = bindableItemSource.GetItems();
+						commandExecutor->OnDataProviderItemModified(start, oldCount, newCount);
+					})
 				{
 				}
 
@@ -1184,46 +1556,32 @@ GuiBindableDataProvider
 
 				Ptr<description::IValueEnumerable> BindableDataProvider::GetItemSource()
 				{
-					return itemSource;
+					return bindableItemSource.GetItemSource();
 				}
 
 				void BindableDataProvider::SetItemSource(Ptr<description::IValueEnumerable> _itemSource)
 				{
-					vint oldCount = 0;
-					if (itemSource)
-					{
-						oldCount = itemSource->GetCount();
-					}
-					if (itemChangedEventHandler)
-					{
-						auto ol = itemSource.Cast<IValueObservableList>();
-						ol->ItemChanged.Remove(itemChangedEventHandler);
-					}
+					bindableItemSource.SetItemSource(_itemSource);
+				}
 
-					itemSource = nullptr;
-					itemChangedEventHandler = nullptr;
+				ItemProperty<description::Value> BindableDataProvider::GetKeyProperty()
+				{
+					return bindableItemSource.GetKeyProperty();
+				}
 
-					if (_itemSource)
-					{
-						if (auto ol = _itemSource.Cast<IValueObservableList>())
-						{
-							itemSource = ol;
-							itemChangedEventHandler = ol->ItemChanged.Add([this](vint start, vint oldCount, vint newCount)
-							{
-								commandExecutor->OnDataProviderItemModified(start, oldCount, newCount);
-							});
-						}
-						else if (auto rl = _itemSource.Cast<IValueReadonlyList>())
-						{
-							itemSource = rl;
-						}
-						else
-						{
-							itemSource = IValueList::Create(GetLazyList<Value>(_itemSource));
-						}
-					}
+				void BindableDataProvider::SetKeyProperty(const ItemProperty<description::Value>& value)
+				{
+					bindableItemSource.SetKeyProperty(value);
+				}
 
-					commandExecutor->OnDataProviderItemModified(0, oldCount, itemSource ? itemSource->GetCount() : 0);
+				ItemProperty<description::Value> BindableDataProvider::GetContentProperty()
+				{
+					return bindableItemSource.GetContentProperty();
+				}
+
+				void BindableDataProvider::SetContentProperty(const ItemProperty<description::Value>& value)
+				{
+					bindableItemSource.SetContentProperty(value);
 				}
 
 				vint BindableDataProvider::GetRowCount()
@@ -1318,6 +1676,9 @@ GuiBindableDataGrid
 				:GuiVirtualDataGrid(_styleProvider, new BindableDataProvider(_viewModelContext))
 			{
 				bindableDataProvider = GetStructuredDataProvider()->GetStructuredDataProvider().Cast<BindableDataProvider>();
+
+				KeyPropertyChanged.SetAssociatedComposition(boundsComposition);
+				ContentPropertyChanged.SetAssociatedComposition(boundsComposition);
 			}
 
 			GuiBindableDataGrid::~GuiBindableDataGrid()
@@ -1334,6 +1695,34 @@ GuiBindableDataGrid
 				bindableDataProvider->SetItemSource(_itemSource);
 			}
 
+			ItemProperty<description::Value> GuiBindableDataGrid::GetKeyProperty()
+			{
+				return bindableDataProvider->GetKeyProperty();
+			}
+
+			void GuiBindableDataGrid::SetKeyProperty(const ItemProperty<description::Value>& value)
+			{
+				if (bindableDataProvider->GetKeyProperty() != value)
+				{
+					bindableDataProvider->SetKeyProperty(value);
+					KeyPropertyChanged.Execute(GetNotifyEventArguments());
+				}
+			}
+
+			ItemProperty<description::Value> GuiBindableDataGrid::GetContentProperty()
+			{
+				return bindableDataProvider->GetContentProperty();
+			}
+
+			void GuiBindableDataGrid::SetContentProperty(const ItemProperty<description::Value>& value)
+			{
+				if (bindableDataProvider->GetContentProperty() != value)
+				{
+					bindableDataProvider->SetContentProperty(value);
+					ContentPropertyChanged.Execute(GetNotifyEventArguments());
+				}
+			}
+
 			bool GuiBindableDataGrid::InsertBindableColumn(vint index, Ptr<list::BindableDataColumn> column)
 			{
 				return bindableDataProvider->InsertBindableColumn(index, column);
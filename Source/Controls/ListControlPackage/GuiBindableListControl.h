@@ -21,6 +21,72 @@ namespace vl
 		namespace controls
 		{
 
+/***********************************************************************
+BindableItemSource
+***********************************************************************/
+
+			namespace list
+			{
+				/// <summary>
+				/// The item source shared by bindable list controls.
+				/// When a key property is set, items are served from a snapshot of the item source.
+				/// Assigning a new item source compares keys of old and new items, and only notifies inserted, removed and changed items instead of the whole list.
+				/// Items with the same key are compared by the content property, or by themselves when there is no content property.
+				/// Boxed values are compared by their content, objects are compared by their identity.
+				/// </summary>
+				class BindableItemSource : public Object, private NotCopyable
+				{
+				public:
+					/// <summary>Callback for item changing. The new items are ready when it is called.</summary>
+					typedef Func<void(vint, vint, vint)>			ItemChangedCallback;
+
+					/// <summary>Maximum number of inserted and removed items to diff, a larger difference notifies the whole list instead.</summary>
+					static const vint								MaxEditDistance = 1024;
+
+				protected:
+					ItemChangedCallback								callback;
+					ItemProperty<description::Value>				keyProperty;
+					ItemProperty<description::Value>				contentProperty;
+					Ptr<description::IValueReadonlyList>			boundItemSource;
+					Ptr<EventHandler>								itemChangedEventHandler;
+					Ptr<description::IValueReadonlyList>			items;
+					Ptr<description::IValueList>					snapshot;
+					collections::List<description::Value>			snapshotKeys;
+
+					description::Value								ReadKey(const description::Value& item);
+					bool											IsContentChanged(const description::Value& oldItem, const description::Value& newItem);
+					void											ResetSnapshot();
+					void											ReplaceSnapshot(vint start, vint oldCount, vint newCount);
+					bool											DiffSnapshot();
+				public:
+					BindableItemSource(const ItemChangedCallback& _callback);
+					~BindableItemSource();
+
+					/// <summary>Get the item source assigned by <see cref="SetItemSource"/>.</summary>
+					/// <returns>The item source.</returns>
+					Ptr<description::IValueEnumerable>				GetItemSource();
+					/// <summary>Set the item source.</summary>
+					/// <param name="_itemSource">The item source.</param>
+					void											SetItemSource(Ptr<description::IValueEnumerable> _itemSource);
+					/// <summary>Get the items to display, which is consistent with all notified changes.</summary>
+					/// <returns>The items to display.</returns>
+					Ptr<description::IValueReadonlyList>			GetItems();
+
+					/// <summary>Get the key property to identify an item when diffing item sources.</summary>
+					/// <returns>The key property.</returns>
+					ItemProperty<description::Value>				GetKeyProperty();
+					/// <summary>Set the key property to identify an item when diffing item sources. Set to null to disable diffing.</summary>
+					/// <param name="value">The key property.</param>
+					void											SetKeyProperty(const ItemProperty<description::Value>& value);
+					/// <summary>Get the content property to decide whether an item is changed when it keeps the same key.</summary>
+					/// <returns>The content property.</returns>
+					ItemProperty<description::Value>				GetContentProperty();
+					/// <summary>Set the content property to decide whether an item is changed when it keeps the same key. Set to null to compare items themselves.</summary>
+					/// <param name="value">The content property.</param>
+					void											SetContentProperty(const ItemProperty<description::Value>& value);
+				};
+			}
+
 /***********************************************************************
 GuiBindableTextList
 ***********************************************************************/
@@ -35,8 +101,8 @@ GuiBindableTextList
 					, protected list::TextItemStyleProvider::ITextItemView
 				{
 				protected:
-					Ptr<EventHandler>								itemChangedEventHandler;
 					Ptr<description::IValueReadonlyList>			itemSource;
+					list::BindableItemSource						bindableItemSource;
 
 				public:
 					ItemProperty<WString>							textProperty;
@@ -48,6 +114,10 @@ GuiBindableTextList
 
 					Ptr<description::IValueEnumerable>				GetItemSource();
 					void											SetItemSource(Ptr<description::IValueEnumerable> _itemSource);
+					ItemProperty<description::Value>				GetKeyProperty();
+					void											SetKeyProperty(const ItemProperty<description::Value>& value);
+					ItemProperty<description::Value>				GetContentProperty();
+					void											SetContentProperty(const ItemProperty<description::Value>& value);
 
 					description::Value								Get(vint index);
 					void											UpdateBindingProperties();
@@ -88,6 +158,10 @@ GuiBindableTextList
 				compositions::GuiNotifyEvent						TextPropertyChanged;
 				/// <summary>Checked property name changed event.</summary>
 				compositions::GuiNotifyEvent						CheckedPropertyChanged;
+				/// <summary>Key property name changed event.</summary>
+				compositions::GuiNotifyEvent						KeyPropertyChanged;
+				/// <summary>Content property name changed event.</summary>
+				compositions::GuiNotifyEvent						ContentPropertyChanged;
 
 				/// <summary>Get the item source.</summary>
 				/// <returns>The item source.</returns>
@@ -110,6 +184,19 @@ GuiBindableTextList
 				/// <param name="value">The checked property name.</param>
 				void												SetCheckedProperty(const WritableItemProperty<bool>& value);
 
+				/// <summary>Get the key property name to identify an item when a new item source is assigned.</summary>
+				/// <returns>The key property name.</returns>
+				ItemProperty<description::Value>					GetKeyProperty();
+				/// <summary>Set the key property name to identify an item when a new item source is assigned. When it is not null, only inserted, removed and changed items are updated after assigning a new item source.</summary>
+				/// <param name="value">The key property name.</param>
+				void												SetKeyProperty(const ItemProperty<description::Value>& value);
+				/// <summary>Get the content property name to decide whether an item with the same key is changed when a new item source is assigned.</summary>
+				/// <returns>The content property name.</returns>
+				ItemProperty<description::Value>					GetContentProperty();
+				/// <summary>Set the content property name to decide whether an item with the same key is changed when a new item source is assigned. When it is null, items themselves are compared, which means objects are compared by identity.</summary>
+				/// <param name="value">The content property name.</param>
+				void												SetContentProperty(const ItemProperty<description::Value>& value);
+
 				/// <summary>Get the selected item.</summary>
 				/// <returns>Returns the selected item. If there are multiple selected items, or there is no selected item, null will be returned.</returns>
 				description::Value									GetSelectedItem();
@@ -135,8 +222,8 @@ GuiBindableListView
 					list::ListViewDataColumns						dataColumns;
 					list::ListViewColumns							columns;
 					ColumnItemViewCallbackList						columnItemViewCallbacks;
-					Ptr<EventHandler>								itemChangedEventHandler;
 					Ptr<description::IValueReadonlyList>			itemSource;
+					list::BindableItemSource						bindableItemSource;
 
 				public:
 					ItemProperty<Ptr<GuiImageData>>					largeImageProperty;
@@ -148,6 +235,10 @@ GuiBindableListView
 
 					Ptr<description::IValueEnumerable>				GetItemSource();
 					void											SetItemSource(Ptr<description::IValueEnumerable> _itemSource);
+					ItemProperty<description::Value>				GetKeyProperty();
+					void											SetKeyProperty(const ItemProperty<description::Value>& value);
+					ItemProperty<description::Value>				GetContentProperty();
+					void											SetContentProperty(const ItemProperty<description::Value>& value);
 					
 					description::Value								Get(vint index);
 					void											UpdateBindingProperties();
@@ -223,6 +314,10 @@ GuiBindableListView
 				compositions::GuiNotifyEvent						LargeImagePropertyChanged;
 				/// <summary>Small image property name changed event.</summary>
 				compositions::GuiNotifyEvent						SmallImagePropertyChanged;
+				/// <summary>Key property name changed event.</summary>
+				compositions::GuiNotifyEvent						KeyPropertyChanged;
+				/// <summary>Content property name changed event.</summary>
+				compositions::GuiNotifyEvent						ContentPropertyChanged;
 				
 				/// <summary>Get the large image property name to get the large image from an item.</summary>
 				/// <returns>The large image property name.</returns>
@@ -238,6 +333,19 @@ GuiBindableListView
 				/// <param name="value">The small image property name.</param>
 				void												SetSmallImageProperty(const ItemProperty<Ptr<GuiImageData>>& value);
 
+				/// <summary>Get the key property name to identify an item when a new item source is assigned.</summary>
+				/// <returns>The key property name.</returns>
+				ItemProperty<description::Value>					GetKeyProperty();
+				/// <summary>Set the key property name to identify an item when a new item source is assigned. When it is not null, only inserted, removed and changed items are updated after assigning a new item source.</summary>
+				/// <param name="value">The key property name.</param>
+				void												SetKeyProperty(const ItemProperty<description::Value>& value);
+				/// <summary>Get the content property name to decide whether an item with the same key is changed when a new item source is assigned.</summary>
+				/// <returns>The content property name.</returns>
+				ItemProperty<description::Value>					GetContentProperty();
+				/// <summary>Set the content property name to decide whether an item with the same key is changed when a new item source is assigned. When it is null, items themselves are compared, which means objects are compared by identity.</summary>
+				/// <param name="value">The content property name.</param>
+				void												SetContentProperty(const ItemProperty<description::Value>& value);
+
 				/// <summary>Get the selected item.</summary>
 				/// <returns>Returns the selected item. If there are multiple selected items, or there is no selected item, null will be returned.</returns>
 				description::Value									GetSelectedItem();
@@ -449,7 +557,7 @@ GuiBindableDataGrid
 				protected:
 					description::Value								viewModelContext;
 					Ptr<description::IValueReadonlyList>			itemSource;
-					Ptr<EventHandler>								itemChangedEventHandler;
+					BindableItemSource								bindableItemSource;
 
 				public:
 					BindableDataProvider(const description::Value& _viewModelContext);
@@ -457,6 +565,10 @@ GuiBindableDataGrid
 
 					Ptr<description::IValueEnumerable>				GetItemSource();
 					void											SetItemSource(Ptr<description::IValueEnumerable> _itemSource);
+					ItemProperty<description::Value>				GetKeyProperty();
+					void											SetKeyProperty(const ItemProperty<description::Value>& value);
+					ItemProperty<description::Value>				GetContentProperty();
+					void											SetContentProperty(const ItemProperty<description::Value>& value);
 
 					vint											GetRowCount()override;
 					description::Value								GetRowValue(vint row);
@@ -483,12 +595,30 @@ GuiBindableDataGrid
 				GuiBindableDataGrid(IStyleProvider* _styleProvider, const description::Value& _viewModelContext = description::Value());
 				~GuiBindableDataGrid();
 
+				/// <summary>Key property name changed event.</summary>
+				compositions::GuiNotifyEvent						KeyPropertyChanged;
+				/// <summary>Content property name changed event.</summary>
+				compositions::GuiNotifyEvent						ContentPropertyChanged;
+
 				/// <summary>Get the item source.</summary>
 				/// <returns>The item source.</returns>
 				Ptr<description::IValueEnumerable>					GetItemSource();
 				/// <summary>Set the item source.</summary>
 				/// <param name="_itemSource">The item source. Null is acceptable if you want to clear all data.</param>
 				void												SetItemSource(Ptr<description::IValueEnumerable> _itemSource);
+
+				/// <summary>Get the key property name to identify an item when a new item source is assigned.</summary>
+				/// <returns>The key property name.</returns>
+				ItemProperty<description::Value>					GetKeyProperty();
+				/// <summary>Set the key property name to identify an item when a new item source is assigned. When it is not null, only inserted, removed and changed items are updated after assigning a new item source.</summary>
+				/// <param name="value">The key property name.</param>
+				void												SetKeyProperty(const ItemProperty<description::Value>& value);
+				/// <summary>Get the content property name to decide whether an item with the same key is changed when a new item source is assigned.</summary>
+				/// <returns>The content property name.</returns>
+				ItemProperty<description::Value>					GetContentProperty();
+				/// <summary>Set the content property name to decide whether an item with the same key is changed when a new item source is assigned. When it is null, items themselves are compared, which means objects are compared by identity.</summary>
+				/// <param name="value">The content property name.</param>
+				void												SetContentProperty(const ItemProperty<description::Value>& value);
 				
 				/// <summary>Insert a column.</summary>
 				/// <returns>Returns true if this operation succeeded.</returns>
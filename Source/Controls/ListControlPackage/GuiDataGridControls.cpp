@@ -19,6 +19,11 @@ DataGridItemProvider
 
 				void DataGridItemProvider::InvokeOnItemModified(vint start, vint count, vint newCount)
 				{
+					if (batchUpdateCounter > 0)
+					{
+						batchUpdateRange.Merge(start, count, newCount);
+						return;
+					}
 					for(vint i=0;i<itemProviderCallbacks.Count();i++)
 					{
 						itemProviderCallbacks[i]->OnItemModified(start, count, newCount);
@@ -63,6 +68,21 @@ DataGridItemProvider
 					dataProvider->SortByColumn(column, ascending);
 				}
 
+				void DataGridItemProvider::BeginBatchUpdate()
+				{
+					batchUpdateCounter++;
+				}
+
+				void DataGridItemProvider::EndBatchUpdate()
+				{
+					if (batchUpdateCounter > 0 && --batchUpdateCounter == 0 && !batchUpdateRange.IsEmpty())
+					{
+						auto range = batchUpdateRange;
+						batchUpdateRange.Clear();
+						InvokeOnItemModified(range.start, range.count, range.newCount);
+					}
+				}
+
 // ===================== GuiListControl::IItemProvider =====================
 
 				bool DataGridItemProvider::AttachCallback(GuiListControl::IItemProviderCallback* value)
@@ -42,6 +42,8 @@ Datagrid ItemProvider
 					IDataProvider*																dataProvider;
 					collections::List<GuiListControl::IItemProviderCallback*>					itemProviderCallbacks;
 					collections::List<ListViewColumnItemArranger::IColumnItemViewCallback*>		columnItemViewCallbacks;
+					vint																		batchUpdateCounter = 0;
+					ItemModificationRange														batchUpdateRange;
 
 					void												InvokeOnItemModified(vint start, vint count, vint newCount);
 					void												InvokeOnColumnChanged();
@@ -56,6 +58,11 @@ Datagrid ItemProvider
 					IDataProvider*										GetDataProvider();
 					void												SortByColumn(vint column, bool ascending=true);
 
+					/// <summary>Start merging row modifications from the data provider. Callbacks are not notified until the paired <see cref="EndBatchUpdate"/> is called.</summary>
+					void												BeginBatchUpdate();
+					/// <summary>Stop merging row modifications, and notify callbacks once with a range that covers all merged modifications.</summary>
+					void												EndBatchUpdate();
+
 					// ===================== GuiListControl::IItemProvider =====================
 
 					bool												AttachCallback(GuiListControl::IItemProviderCallback* value)override;
@@ -211,6 +211,12 @@ StructuredDataProvider
 
 				void StructuredDataProvider::OnDataProviderItemModified(vint start, vint count, vint newCount)
 				{
+					if (batchUpdateCounter > 0)
+					{
+						batchUpdateRange.Merge(start, count, newCount);
+						return;
+					}
+
 					// optimized for cell editing
 					if(!currentSorter && !currentFilter)
 					{
@@ -333,6 +339,21 @@ StructuredDataProvider
 					ReorderRows(true);
 				}
 
+				void StructuredDataProvider::BeginBatchUpdate()
+				{
+					batchUpdateCounter++;
+				}
+
+				void StructuredDataProvider::EndBatchUpdate()
+				{
+					if (batchUpdateCounter > 0 && --batchUpdateCounter == 0 && !batchUpdateRange.IsEmpty())
+					{
+						auto range = batchUpdateRange;
+						batchUpdateRange.Clear();
+						OnDataProviderItemModified(range.start, range.count, range.newCount);
+					}
+				}
+
 				StructuredDataProvider::StructuredDataProvider(Ptr<IStructuredDataProvider> provider)
 					:structuredDataProvider(provider)
 					,commandExecutor(0)
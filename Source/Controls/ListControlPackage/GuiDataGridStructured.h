@@ -155,6 +155,8 @@ Structured DataSource Extensions
 					Ptr<IStructuredDataFilter>							currentFilter;
 					Ptr<IStructuredDataSorter>							currentSorter;
 					collections::List<vint>								reorderedRows;
+					vint												batchUpdateCounter = 0;
+					ItemModificationRange								batchUpdateRange;
 					
 					void												OnDataProviderColumnChanged()override;
 					void												OnDataProviderItemModified(vint start, vint count, vint newCount)override;
@@ -177,6 +179,10 @@ Structured DataSource Extensions
 					/// <summary>Set the additional filter. This filter will be composed with inherent filters of all column to be the final filter.</summary>
 					/// <param name="value">The additional filter.</param>
 					void												SetAdditionalFilter(Ptr<IStructuredDataFilter> value);
+					/// <summary>Start merging row modifications from the structured data provider. Filtering, sorting and notifying are delayed until the paired <see cref="EndBatchUpdate"/> is called.</summary>
+					void												BeginBatchUpdate();
+					/// <summary>Stop merging row modifications, and process all merged modifications once.</summary>
+					void												EndBatchUpdate();
 
 					void												SetCommandExecutor(IDataProviderCommandExecutor* value)override;
 					vint												GetColumnCount()override;
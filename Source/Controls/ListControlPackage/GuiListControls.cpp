@@ -1810,8 +1810,46 @@ ItemStyleControllerBase
 ItemProviderBase
 ***********************************************************************/
 
+				bool ItemModificationRange::IsEmpty()const
+				{
+					return start == -1;
+				}
+
+				void ItemModificationRange::Merge(vint _start, vint _count, vint _newCount)
+				{
+					if (start == -1)
+					{
+						start = _start;
+						count = _count;
+						newCount = _newCount;
+					}
+					else
+					{
+						// positions of the new modification are based on items after all merged modifications
+						vint end = start + newCount > _start + _count ? start + newCount : _start + _count;
+						vint mergedStart = start < _start ? start : _start;
+						vint oldEnd = end - newCount + count;
+						vint newEnd = end - _count + _newCount;
+						start = mergedStart;
+						count = oldEnd - mergedStart;
+						newCount = newEnd - mergedStart;
+					}
+				}
+
+				void ItemModificationRange::Clear()
+				{
+					start = -1;
+					count = 0;
+					newCount = 0;
+				}
+
 				void ItemProviderBase::InvokeOnItemModified(vint start, vint count, vint newCount)
 				{
+					if (batchUpdateCounter > 0)
+					{
+						batchUpdateRange.Merge(start, count, newCount);
+						return;
+					}
 					for(vint i=0;i<callbacks.Count();i++)
 					{
 						callbacks[i]->OnItemModified(start, count, newCount);
@@ -1858,6 +1896,21 @@ ItemProviderBase
 						return true;
 					}
 				}
+
+				void ItemProviderBase::BeginBatchUpdate()
+				{
+					batchUpdateCounter++;
+				}
+
+				void ItemProviderBase::EndBatchUpdate()
+				{
+					if (batchUpdateCounter > 0 && --batchUpdateCounter == 0 && !batchUpdateRange.IsEmpty())
+					{
+						auto range = batchUpdateRange;
+						batchUpdateRange.Clear();
+						InvokeOnItemModified(range.start, range.count, range.newCount);
+					}
+				}
 			}
 		}
 	}
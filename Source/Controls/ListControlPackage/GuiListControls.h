@@ -650,11 +650,35 @@ Predefined ItemProvider
 
 			namespace list
 			{
+				/// <summary>A range that covers multiple item modifications, which are applied one after another.</summary>
+				struct ItemModificationRange
+				{
+					/// <summary>The start position of the range, -1 if there is no modification.</summary>
+					vint										start = -1;
+					/// <summary>The number of items in the range before modifications.</summary>
+					vint										count = 0;
+					/// <summary>The number of items in the range after modifications.</summary>
+					vint										newCount = 0;
+
+					/// <summary>Test if there is no modification.</summary>
+					/// <returns>Returns true if there is no modification.</returns>
+					bool										IsEmpty()const;
+					/// <summary>Extend the range to cover a modification that happens after all merged modifications.</summary>
+					/// <param name="_start">The start position of the modification.</param>
+					/// <param name="_count">The number of items before the modification.</param>
+					/// <param name="_newCount">The number of items after the modification.</param>
+					void										Merge(vint _start, vint _count, vint _newCount);
+					/// <summary>Clear the range.</summary>
+					void										Clear();
+				};
+
 				/// <summary>Item provider base. This class provider common functionalities for item providers.</summary>
 				class ItemProviderBase : public Object, public virtual GuiListControl::IItemProvider, public Description<ItemProviderBase>
 				{
 				protected:
 					collections::List<GuiListControl::IItemProviderCallback*>	callbacks;
+					vint										batchUpdateCounter = 0;
+					ItemModificationRange						batchUpdateRange;
 
 					virtual void								InvokeOnItemModified(vint start, vint count, vint newCount);
 				public:
@@ -664,6 +688,11 @@ Predefined ItemProvider
 
 					bool										AttachCallback(GuiListControl::IItemProviderCallback* value);
 					bool										DetachCallback(GuiListControl::IItemProviderCallback* value);
+
+					/// <summary>Start merging item modifications. Callbacks are not notified until the paired <see cref="EndBatchUpdate"/> is called.</summary>
+					void										BeginBatchUpdate();
+					/// <summary>Stop merging item modifications, and notify callbacks once with a range that covers all merged modifications.</summary>
+					void										EndBatchUpdate();
 				};
 
 				template<typename T>
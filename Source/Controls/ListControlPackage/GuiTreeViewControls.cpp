@@ -247,6 +247,14 @@ NodeItemProvider
 				{
 					root->AttachCallback(this);
 					nodeItemPrimaryTextView=dynamic_cast<INodeItemPrimaryTextView*>(root->RequestView(INodeItemPrimaryTextView::Identifier));
+					if (auto rootBase = root.Cast<NodeRootProviderBase>())
+					{
+						rootBase->itemProviders.Add(this);
+						if (rootBase->batchUpdateCounter > 0)
+						{
+							BeginBatchUpdate();
+						}
+					}
 				}
 
 				NodeItemProvider::~NodeItemProvider()
@@ -255,6 +263,10 @@ NodeItemProvider
 					{
 						root->ReleaseView(nodeItemPrimaryTextView);
 					}
+					if (auto rootBase = root.Cast<NodeRootProviderBase>())
+					{
+						rootBase->itemProviders.Remove(this);
+					}
 					root->DetachCallback(this);
 				}
 
@@ -715,6 +727,28 @@ NodeRootProviderBase
 				{
 				}
 
+				void NodeRootProviderBase::BeginBatchUpdate()
+				{
+					if (batchUpdateCounter++ == 0)
+					{
+						FOREACH(NodeItemProvider*, itemProvider, itemProviders)
+						{
+							itemProvider->BeginBatchUpdate();
+						}
+					}
+				}
+
+				void NodeRootProviderBase::EndBatchUpdate()
+				{
+					if (batchUpdateCounter > 0 && --batchUpdateCounter == 0)
+					{
+						FOREACH(NodeItemProvider*, itemProvider, itemProviders)
+						{
+							itemProvider->EndBatchUpdate();
+						}
+					}
+				}
+
 /***********************************************************************
 MemoryNodeRootProvider
 ***********************************************************************/
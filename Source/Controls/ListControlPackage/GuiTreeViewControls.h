@@ -382,7 +382,11 @@ GuiVirtualTreeListControl Predefined NodeProvider
 				/// <summary>A general implementation for <see cref="INodeRootProvider"/>.</summary>
 				class NodeRootProviderBase : public virtual INodeRootProvider, protected virtual INodeProviderCallback, public Description<NodeRootProviderBase>
 				{
+					friend class NodeItemProvider;
+
 					collections::List<INodeProviderCallback*>			callbacks;
+					collections::List<NodeItemProvider*>				itemProviders;
+					vint												batchUpdateCounter = 0;
 				protected:
 					void							OnAttached(INodeRootProvider* provider)override;
 					void							OnBeforeItemModified(INodeProvider* parentNode, vint start, vint count, vint newCount)override;
@@ -400,6 +404,11 @@ GuiVirtualTreeListControl Predefined NodeProvider
 					bool							DetachCallback(INodeProviderCallback* value)override;
 					IDescriptable*					RequestView(const WString& identifier)override;
 					void							ReleaseView(IDescriptable* view)override;
+
+					/// <summary>Start merging node modifications. Item providers created from this root do not notify list controls until the paired <see cref="EndBatchUpdate"/> is called.</summary>
+					void							BeginBatchUpdate();
+					/// <summary>Stop merging node modifications, and notify list controls once with a range that covers all modified visible nodes.</summary>
+					void							EndBatchUpdate();
 				};
 				
 				/// <summary>An in-memory <see cref="INodeRootProvider"/> implementation.</summary>
@@ -73,7 +73,7 @@ GuiTextBoxColorizerBase
 				{
 					isColorizerRunning=true;
 					colorizerRunningEvent.Enter();
-					ThreadPoolLite::Queue(&GuiTextBoxColorizerBase::ColorizerThreadProc, this);
+					TaskScheduler::QueueLambda([this](){ ColorizerThreadProc(this); }, TaskScheduler::Interactive);
 				}
 			}
 
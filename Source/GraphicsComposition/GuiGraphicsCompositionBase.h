@@ -43,6 +43,8 @@ Basic Construction
 				friend class controls::GuiControl;
 				friend class GuiGraphicsHost;
 			public:
+				GUI_POOLED_OBJECT
+
 				/// <summary>
 				/// Minimum size limitation.
 				/// </summary>
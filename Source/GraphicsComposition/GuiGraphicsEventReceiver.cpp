@@ -25,6 +25,7 @@ Event Receiver
 				,horizontalWheel(_sender)
 				,verticalWheel(_sender)
 				,mouseMove(_sender)
+				,rawMouseMove(_sender)
 				,mouseEnter(_sender)
 				,mouseLeave(_sender)
 				,previewKey(_sender)
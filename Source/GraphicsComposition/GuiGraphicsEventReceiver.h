@@ -10,6 +10,7 @@ Interfaces:
 #define VCZH_PRESENTATION_ELEMENTS_GUIGRAPHICSEVENTRECEIVER
 
 #include "../NativeWindow/GuiNativeWindow.h"
+#include "GuiGraphicsObjectPool.h"
 
 namespace vl
 {
@@ -62,6 +63,8 @@ Event
 				class FunctionHandler : public Object, public IGuiGraphicsEventHandler
 				{
 				public:
+					GUI_POOLED_OBJECT
+
 					bool					isAttached = true;
 					FunctionType			handler;
 
@@ -83,6 +86,8 @@ Event
 			protected:
 				struct HandlerNode
 				{
+					GUI_POOLED_OBJECT
+
 					Ptr<FunctionHandler>								handler;
 					Ptr<HandlerNode>									next;
 				};
@@ -425,6 +430,8 @@ Event Receiver
 			protected:
 				GuiGraphicsComposition*			sender;
 			public:
+				GUI_POOLED_OBJECT
+
 				GuiGraphicsEventReceiver(GuiGraphicsComposition* _sender);
 				~GuiGraphicsEventReceiver();
 
@@ -452,8 +459,10 @@ Event Receiver
 				GuiMouseEvent					horizontalWheel;
 				/// <summary>Vertical wheel scrolling event.</summary>
 				GuiMouseEvent					verticalWheel;
-				/// <summary>Mouse move event.</summary>
+				/// <summary>Mouse move event. Mouse positions received in the same frame are merged, this event is raised at most once per frame using the latest position.</summary>
 				GuiMouseEvent					mouseMove;
+				/// <summary>Raw mouse move event. This event is raised for every mouse position merged into a <see cref="mouseMove"/> event from the oldest to the latest, before <see cref="mouseMove"/> and on the same compositions.</summary>
+				GuiMouseEvent					rawMouseMove;
 				/// <summary>Mouse enter event.</summary>
 				GuiNotifyEvent					mouseEnter;
 				/// <summary>Mouse leave event.</summary>
@@ -0,0 +1,288 @@
+#include "GuiGraphicsObjectPool.h"
+#include <stdlib.h>
+#include <new>
+#if defined VCZH_MSVC
+#include <malloc.h>
+#endif
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace compositions
+		{
+			using namespace collections;
+
+/***********************************************************************
+Helpers
+***********************************************************************/
+
+			namespace object_pool
+			{
+				const vint								BlockAlignment = 16;
+				const vint								MaxBlockSize = 1024;
+				const vint								SizeClassCount = MaxBlockSize / BlockAlignment;
+				const vint								SlabSize = 65536;
+
+				struct SizeClass;
+
+				struct Slab
+				{
+					SizeClass*							owner;
+					Slab*								previous;
+					Slab*								next;
+					void*								freeBlocks;
+					char*								unusedBlocks;
+					char*								end;
+					vint								liveCount;
+					bool								partial;
+				};
+
+				struct SizeClass
+				{
+					vint								blockSize = 0;
+					Slab*								partialSlabs = nullptr;
+					vint								emptySlabCount = 0;
+				};
+
+				bool									poolEnabled = false;
+				SpinLock								poolLock;
+				SizeClass								sizeClasses[SizeClassCount];
+				// slabs are aligned to SlabSize, so the slab of a block is found by clearing lower bits of its address
+				SortedList<Slab*>						slabs;
+				vint									slabCount = 0;
+				vint									liveObjectCount = 0;
+
+				const vint								SlabHeaderSize = (sizeof(Slab) + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+
+				void LinkPartial(SizeClass& sizeClass, Slab* slab)
+				{
+					slab->partial = true;
+					slab->previous = nullptr;
+					slab->next = sizeClass.partialSlabs;
+					if (slab->next)
+					{
+						slab->next->previous = slab;
+					}
+					sizeClass.partialSlabs = slab;
+				}
+
+				void UnlinkPartial(SizeClass& sizeClass, Slab* slab)
+				{
+					slab->partial = false;
+					if (slab->previous)
+					{
+						slab->previous->next = slab->next;
+					}
+					else
+					{
+						sizeClass.partialSlabs = slab->next;
+					}
+					if (slab->next)
+					{
+						slab->next->previous = slab->previous;
+					}
+					slab->previous = nullptr;
+					slab->next = nullptr;
+				}
+
+				Slab* GetSlab(void* block)
+				{
+					auto slab = (Slab*)((size_t)block & ~(size_t)(SlabSize - 1));
+					return slabs.Contains(slab) ? slab : nullptr;
+				}
+
+				Slab* CreateSlab(SizeClass& sizeClass)
+				{
+#if defined VCZH_MSVC
+					auto slab = (Slab*)_aligned_malloc(SlabSize, SlabSize);
+#elif defined VCZH_GCC
+					void* memory = nullptr;
+					auto slab = posix_memalign(&memory, SlabSize, SlabSize) == 0 ? (Slab*)memory : nullptr;
+#endif
+					if (!slab) return nullptr;
+					slabs.Add(slab);
+					slab->owner = &sizeClass;
+					slab->previous = nullptr;
+					slab->next = nullptr;
+					slab->freeBlocks = nullptr;
+					slab->unusedBlocks = (char*)slab + SlabHeaderSize;
+					slab->end = (char*)slab + SlabSize;
+					slab->liveCount = 0;
+					slab->partial = false;
+					slabCount++;
+					sizeClass.emptySlabCount++;
+					LinkPartial(sizeClass, slab);
+					return slab;
+				}
+
+				void DestroySlab(SizeClass& sizeClass, Slab* slab)
+				{
+					if (slab->partial)
+					{
+						UnlinkPartial(sizeClass, slab);
+					}
+					sizeClass.emptySlabCount--;
+					slabCount--;
+					slabs.Remove(slab);
+					if (slabs.Count() == 0)
+					{
+						slabs.Clear();
+					}
+#if defined VCZH_MSVC
+					_aligned_free(slab);
+#elif defined VCZH_GCC
+					free(slab);
+#endif
+				}
+
+				void* AllocateFromSlab(SizeClass& sizeClass)
+				{
+					auto slab = sizeClass.partialSlabs;
+					if (!slab)
+					{
+						slab = CreateSlab(sizeClass);
+						if (!slab) return nullptr;
+					}
+
+					void* block = nullptr;
+					if (slab->freeBlocks)
+					{
+						block = slab->freeBlocks;
+						slab->freeBlocks = *(void**)block;
+					}
+					else
+					{
+						block = slab->unusedBlocks;
+						slab->unusedBlocks += sizeClass.blockSize;
+					}
+
+					if (slab->liveCount++ == 0)
+					{
+						sizeClass.emptySlabCount--;
+					}
+					if (!slab->freeBlocks && slab->unusedBlocks + sizeClass.blockSize > slab->end)
+					{
+						UnlinkPartial(sizeClass, slab);
+					}
+					liveObjectCount++;
+					return block;
+				}
+
+				void FreeToSlab(Slab* slab, void* block)
+				{
+					auto& sizeClass = *slab->owner;
+					*(void**)block = slab->freeBlocks;
+					slab->freeBlocks = block;
+					liveObjectCount--;
+
+					if (!slab->partial)
+					{
+						LinkPartial(sizeClass, slab);
+					}
+					if (--slab->liveCount == 0)
+					{
+						sizeClass.emptySlabCount++;
+						if (sizeClass.emptySlabCount > 1)
+						{
+							// keep only one spare slab, return others to the heap
+							DestroySlab(sizeClass, slab);
+						}
+					}
+				}
+			}
+			using namespace object_pool;
+
+/***********************************************************************
+GuiObjectPool
+***********************************************************************/
+
+			void* GuiObjectPool::Allocate(vint size)
+			{
+				vint blockSize = size <= 0 ? BlockAlignment : (size + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+				void* block = nullptr;
+				if (blockSize <= MaxBlockSize)
+				{
+					SPIN_LOCK(poolLock)
+					{
+						if (poolEnabled)
+						{
+							auto& sizeClass = sizeClasses[blockSize / BlockAlignment - 1];
+							sizeClass.blockSize = blockSize;
+							block = AllocateFromSlab(sizeClass);
+						}
+					}
+				}
+
+				if (!block)
+				{
+					block = malloc(size <= 0 ? 1 : size);
+					if (!block) throw std::bad_alloc();
+				}
+				return block;
+			}
+
+			void GuiObjectPool::Free(void* block)
+			{
+				if (!block) return;
+				// a block in a slab keeps the slab alive, so there is nothing to look up when there is no slab
+				if (slabCount > 0)
+				{
+					SPIN_LOCK(poolLock)
+					{
+						if (auto slab = GetSlab(block))
+						{
+							FreeToSlab(slab, block);
+							return;
+						}
+					}
+				}
+				free(block);
+			}
+
+			bool GuiObjectPool::GetEnabled()
+			{
+				return poolEnabled;
+			}
+
+			void GuiObjectPool::SetEnabled(bool value)
+			{
+				SPIN_LOCK(poolLock)
+				{
+					poolEnabled = value;
+				}
+			}
+
+			void GuiObjectPool::Trim()
+			{
+				SPIN_LOCK(poolLock)
+				{
+					for (vint i = 0; i < SizeClassCount; i++)
+					{
+						auto& sizeClass = sizeClasses[i];
+						auto slab = sizeClass.partialSlabs;
+						while (slab)
+						{
+							auto next = slab->next;
+							if (slab->liveCount == 0)
+							{
+								DestroySlab(sizeClass, slab);
+							}
+							slab = next;
+						}
+					}
+				}
+			}
+
+			vint GuiObjectPool::GetSlabCount()
+			{
+				return slabCount;
+			}
+
+			vint GuiObjectPool::GetLiveObjectCount()
+			{
+				return liveObjectCount;
+			}
+		}
+	}
+}
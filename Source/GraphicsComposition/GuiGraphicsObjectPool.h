@@ -0,0 +1,80 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Composition System
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_COMPOSITION_GUIGRAPHICSOBJECTPOOL
+#define VCZH_PRESENTATION_COMPOSITION_GUIGRAPHICSOBJECTPOOL
+
+#include "../NativeWindow/GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+		namespace compositions
+		{
+
+/***********************************************************************
+Object Pool
+***********************************************************************/
+
+			/// <summary>
+			/// Slab allocator for small objects that are created in large numbers with every window, like compositions, event receivers and event handlers.
+			/// Objects of similar sizes are packed into 64KB slabs, and a slab is returned to the heap as soon as all objects in it are deleted, except one spare slab for each size.
+			/// It is disabled by default. Objects allocated before enabling or after disabling it are still deleted correctly.
+			/// Blocks carry no header, objects allocated while it is disabled cost the same as allocating them from the heap.
+			/// </summary>
+			class GuiObjectPool
+			{
+			public:
+				/// <summary>Allocate memory for an object.</summary>
+				/// <returns>The allocated memory.</returns>
+				/// <param name="size">The size of the object.</param>
+				static void*							Allocate(vint size);
+				/// <summary>Free memory allocated by <see cref="Allocate"/>.</summary>
+				/// <param name="block">The memory to free.</param>
+				static void								Free(void* block);
+
+				/// <summary>Test if the pool is enabled.</summary>
+				/// <returns>Returns true if the pool is enabled.</returns>
+				static bool								GetEnabled();
+				/// <summary>Enable or disable the pool for new objects.</summary>
+				/// <param name="value">Set to true to enable the pool.</param>
+				static void								SetEnabled(bool value);
+				/// <summary>Return all spare slabs to the heap.</summary>
+				static void								Trim();
+
+				/// <summary>Get the number of slabs.</summary>
+				/// <returns>The number of slabs.</returns>
+				static vint								GetSlabCount();
+				/// <summary>Get the number of living objects in slabs.</summary>
+				/// <returns>The number of living objects in slabs.</returns>
+				static vint								GetLiveObjectCount();
+			};
+
+#define GUI_POOLED_OBJECT\
+			static void* operator new(size_t size)\
+			{\
+				return vl::presentation::compositions::GuiObjectPool::Allocate((vl::vint)size);\
+			}\
+			static void operator delete(void* block)\
+			{\
+				vl::presentation::compositions::GuiObjectPool::Free(block);\
+			}\
+			static void* operator new(size_t size, void* place)\
+			{\
+				return place;\
+			}\
+			static void operator delete(void* block, void* place)\
+			{\
+			}
+
+		}
+	}
+}
+
+#endif
@@ -332,6 +332,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::MouseCapture(const NativeWindowMouseInfo& info)
 			{
+				FlushMouseMove();
 				if(nativeWindow && (info.left || info.middle || info.right))
 				{
 					if(!nativeWindow->IsCapturing() && !info.nonClient)
@@ -460,6 +461,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::OnMouseInput(const NativeWindowMouseInfo& info, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent)
 			{
+				FlushMouseMove();
 				GuiGraphicsComposition* composition=0;
 				if(mouseCaptureComposition)
 				{
@@ -480,6 +482,171 @@ GuiGraphicsHost
 				}
 			}
 
+			GuiGraphicsComposition* GuiGraphicsHost::FindHoveredComposition(Point location, vint& retainedCount)
+			{
+				retainedCount=0;
+				if(mouseEnterCompositions.Count()==0 || mouseEnterCompositions[0]!=windowComposition)
+				{
+					return windowComposition->FindComposition(location);
+				}
+				if(!windowComposition->GetVisible() || !Rect(Point(0, 0), windowComposition->GetBounds().GetSize()).Contains(location))
+				{
+					return 0;
+				}
+
+				// Keep the hovered compositions from the root which FindComposition would still choose.
+				// A composition is kept only if it contains the location, and no sibling above it contains the location.
+				GuiGraphicsComposition* current=windowComposition;
+				Point currentLocation=location;
+				retainedCount=1;
+				for(vint i=1;i<mouseEnterCompositions.Count();i++)
+				{
+					GuiGraphicsComposition* composition=mouseEnterCompositions[i];
+					if(composition->GetParent()!=current) break;
+					const CompositionList& children=current->Children();
+					vint index=children.IndexOf(composition);
+					if(index==-1) break;
+
+					Rect bounds=current->GetBounds();
+					Rect clientArea=current->GetClientArea();
+					Point clientLocation(currentLocation.x-(clientArea.x1-bounds.x1), currentLocation.y-(clientArea.y1-bounds.y1));
+					bool covered=false;
+					for(vint j=children.Count()-1;j>index;j--)
+					{
+						GuiGraphicsComposition* child=children[j];
+						if(child->GetVisible() && child->GetBounds().Contains(clientLocation))
+						{
+							covered=true;
+							break;
+						}
+					}
+					if(covered) break;
+
+					Rect childBounds=composition->GetBounds();
+					if(!composition->GetVisible() || !childBounds.Contains(clientLocation)) break;
+					current=composition;
+					currentLocation=Point(clientLocation.x-childBounds.x1, clientLocation.y-childBounds.y1);
+					retainedCount++;
+				}
+				return current->FindComposition(currentLocation);
+			}
+
+			void GuiGraphicsHost::FlushMouseMove()
+			{
+				if(mouseMoveInfos.Count()==0) return;
+				List<NativeWindowMouseInfo> infos;
+				CopyFrom(infos, mouseMoveInfos);
+				mouseMoveInfos.Clear();
+				if(!nativeWindow) return;
+				NativeWindowMouseInfo info=infos[infos.Count()-1];
+
+				vint retainedCount=0;
+				GuiGraphicsComposition* hitComposition=FindHoveredComposition(Point(info.x, info.y), retainedCount);
+
+				CompositionList newCompositions;
+				for(vint i=0;i<retainedCount;i++)
+				{
+					newCompositions.Add(mouseEnterCompositions[i]);
+				}
+				{
+					GuiGraphicsComposition* retainedComposition=retainedCount==0?0:mouseEnterCompositions[retainedCount-1];
+					vint retainedEnd=newCompositions.Count();
+					GuiGraphicsComposition* composition=hitComposition;
+					while(composition && composition!=retainedComposition)
+					{
+						newCompositions.Add(composition);
+						composition=composition->GetParent();
+					}
+					for(vint i=retainedEnd, j=newCompositions.Count()-1;i<j;i++, j--)
+					{
+						GuiGraphicsComposition* temp=newCompositions[i];
+						newCompositions.Set(i, newCompositions[j]);
+						newCompositions.Set(j, temp);
+					}
+				}
+
+				vint firstDifferentIndex=mouseEnterCompositions.Count();
+				for(vint i=retainedCount;i<mouseEnterCompositions.Count();i++)
+				{
+					if(i==newCompositions.Count())
+					{
+						firstDifferentIndex=newCompositions.Count();
+						break;
+					}
+					if(mouseEnterCompositions[i]!=newCompositions[i])
+					{
+						firstDifferentIndex=i;
+						break;
+					}
+				}
+
+				for(vint i=mouseEnterCompositions.Count()-1;i>=firstDifferentIndex;i--)
+				{
+					GuiGraphicsComposition* composition=mouseEnterCompositions[i];
+					if(composition->HasEventReceiver())
+					{
+						composition->GetEventReceiver()->mouseLeave.Execute(GuiEventArgs(composition));
+					}
+				}
+
+				CopyFrom(mouseEnterCompositions, newCompositions);
+				for(vint i=firstDifferentIndex;i<mouseEnterCompositions.Count();i++)
+				{
+					GuiGraphicsComposition* composition=mouseEnterCompositions[i];
+					if(composition->HasEventReceiver())
+					{
+						composition->GetEventReceiver()->mouseEnter.Execute(GuiEventArgs(composition));
+					}
+				}
+
+				INativeCursor* cursor=0;
+				if(newCompositions.Count()>0)
+				{
+					cursor=newCompositions[newCompositions.Count()-1]->GetRelatedCursor();
+				}
+				if(cursor)
+				{
+					nativeWindow->SetWindowCursor(cursor);
+				}
+				else
+				{
+					nativeWindow->SetWindowCursor(GetCurrentController()->ResourceService()->GetDefaultSystemCursor());
+				}
+
+				GuiGraphicsComposition* composition=0;
+				if(mouseCaptureComposition)
+				{
+					composition=mouseCaptureComposition;
+				}
+				else if(mouseEnterCompositions.Count()>0 && mouseEnterCompositions[mouseEnterCompositions.Count()-1]==hitComposition)
+				{
+					composition=hitComposition;
+				}
+				else
+				{
+					// mouseEnter or mouseLeave handlers changed the composition tree
+					composition=windowComposition->FindComposition(Point(info.x, info.y));
+				}
+				if(composition)
+				{
+					Rect bounds=composition->GetGlobalBounds();
+					FOREACH(NativeWindowMouseInfo, rawInfo, infos)
+					{
+						GuiMouseEventArgs arguments;
+						(NativeWindowMouseInfo&)arguments=rawInfo;
+						arguments.x-=bounds.x1;
+						arguments.y-=bounds.y1;
+						RaiseMouseEvent(arguments, composition, &GuiGraphicsEventReceiver::rawMouseMove);
+					}
+
+					GuiMouseEventArgs arguments;
+					(NativeWindowMouseInfo&)arguments=info;
+					arguments.x-=bounds.x1;
+					arguments.y-=bounds.y1;
+					RaiseMouseEvent(arguments, composition, &GuiGraphicsEventReceiver::mouseMove);
+				}
+			}
+
 			INativeWindowListener::HitTestResult GuiGraphicsHost::HitTest(Point location)
 			{
 				Rect bounds=nativeWindow->GetBounds();
@@ -624,65 +791,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::MouseMoving(const NativeWindowMouseInfo& info)
 			{
-				CompositionList newCompositions;
-				{
-					GuiGraphicsComposition* composition=windowComposition->FindComposition(Point(info.x, info.y));
-					while(composition)
-					{
-						newCompositions.Insert(0, composition);
-						composition=composition->GetParent();
-					}
-				}
-
-				vint firstDifferentIndex=mouseEnterCompositions.Count();
-				for(vint i=0;i<mouseEnterCompositions.Count();i++)
-				{
-					if(i==newCompositions.Count())
-					{
-						firstDifferentIndex=newCompositions.Count();
-						break;
-					}
-					if(mouseEnterCompositions[i]!=newCompositions[i])
-					{
-						firstDifferentIndex=i;
-						break;
-					}
-				}
-
-				for(vint i=mouseEnterCompositions.Count()-1;i>=firstDifferentIndex;i--)
-				{
-					GuiGraphicsComposition* composition=mouseEnterCompositions[i];
-					if(composition->HasEventReceiver())
-					{
-						composition->GetEventReceiver()->mouseLeave.Execute(GuiEventArgs(composition));
-					}
-				}
-
-				CopyFrom(mouseEnterCompositions, newCompositions);
-				for(vint i=firstDifferentIndex;i<mouseEnterCompositions.Count();i++)
-				{
-					GuiGraphicsComposition* composition=mouseEnterCompositions[i];
-					if(composition->HasEventReceiver())
-					{
-						composition->GetEventReceiver()->mouseEnter.Execute(GuiEventArgs(composition));
-					}
-				}
-
-				INativeCursor* cursor=0;
-				if(newCompositions.Count()>0)
-				{
-					cursor=newCompositions[newCompositions.Count()-1]->GetRelatedCursor();
-				}
-				if(cursor)
-				{
-					nativeWindow->SetWindowCursor(cursor);
-				}
-				else
-				{
-					nativeWindow->SetWindowCursor(GetCurrentController()->ResourceService()->GetDefaultSystemCursor());
-				}
-
-				OnMouseInput(info, &GuiGraphicsEventReceiver::mouseMove);
+				mouseMoveInfos.Add(info);
 			}
 
 			void GuiGraphicsHost::MouseEntered()
@@ -691,6 +800,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::MouseLeaved()
 			{
+				FlushMouseMove();
 				for(vint i=mouseEnterCompositions.Count()-1;i>=0;i--)
 				{
 					GuiGraphicsComposition* composition=mouseEnterCompositions[i];
@@ -704,6 +814,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::KeyDown(const NativeWindowKeyInfo& info)
 			{
+				FlushMouseMove();
 				if (!info.ctrl && !info.shift && currentAltHost)
 				{
 					if (info.code == VKEY_ESCAPE)
@@ -750,6 +861,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::KeyUp(const NativeWindowKeyInfo& info)
 			{
+				FlushMouseMove();
 				if (!info.ctrl && !info.shift && info.code == supressAltKey)
 				{
 					supressAltKey = 0;
@@ -764,6 +876,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::SysKeyDown(const NativeWindowKeyInfo& info)
 			{
+				FlushMouseMove();
 				if (!info.ctrl && !info.shift && info.code == VKEY_MENU && !currentAltHost)
 				{
 					if (auto window = dynamic_cast<GuiWindow*>(windowComposition->Children()[0]->GetRelatedControlHost()))
@@ -791,6 +904,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::SysKeyUp(const NativeWindowKeyInfo& info)
 			{
+				FlushMouseMove();
 				if (!info.ctrl && !info.shift && info.code == VKEY_MENU && nativeWindow)
 				{
 					if (nativeWindow)
@@ -807,6 +921,7 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::Char(const NativeWindowCharInfo& info)
 			{
+				FlushMouseMove();
 				if (!currentAltHost && !supressAltKey)
 				{
 					if(focusedComposition && focusedComposition->HasEventReceiver())
@@ -818,6 +933,8 @@ GuiGraphicsHost
 
 			void GuiGraphicsHost::GlobalTimer()
 			{
+				FlushMouseMove();
+
 				if(animationManager.HasAnimation())
 				{
 					animationManager.Play();
@@ -976,6 +1093,11 @@ GuiGraphicsHost
 				return &animationManager;
 			}
 
+			GuiGraphicsComposition* GuiGraphicsHost::GetHoveredComposition()
+			{
+				return mouseEnterCompositions.Count()==0?0:mouseEnterCompositions[mouseEnterCompositions.Count()-1];
+			}
+
 			void GuiGraphicsHost::DisconnectComposition(GuiGraphicsComposition* composition)
 			{
 				DisconnectCompositionInternal(composition);
@@ -184,6 +184,7 @@ Host
 				GuiGraphicsAnimationManager				animationManager;
 				GuiGraphicsComposition*					mouseCaptureComposition;
 				CompositionList							mouseEnterCompositions;
+				collections::List<NativeWindowMouseInfo>	mouseMoveInfos;
 
 				IGuiAltActionHost*						currentAltHost;
 				AltActionMap							currentActiveAltActions;
@@ -207,6 +208,8 @@ Host
 				void									OnKeyInput(const NativeWindowKeyInfo& info, GuiGraphicsComposition* composition, GuiKeyEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
 				void									RaiseMouseEvent(GuiMouseEventArgs& arguments, GuiGraphicsComposition* composition, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
 				void									OnMouseInput(const NativeWindowMouseInfo& info, GuiMouseEvent GuiGraphicsEventReceiver::* eventReceiverEvent);
+				GuiGraphicsComposition*					FindHoveredComposition(Point location, vint& retainedCount);
+				void									FlushMouseMove();
 				
 			private:
 				INativeWindowListener::HitTestResult	HitTest(Point location)override;
@@ -276,6 +279,9 @@ Host
 				/// <summary>Get the animation manager.</summary>
 				/// <returns>The animation manager.</returns>
 				GuiGraphicsAnimationManager*			GetAnimationManager();
+				/// <summary>Get the composition under the mouse. Mouse moves are merged and delivered at most once per frame, this composition is updated when <see cref="GuiGraphicsEventReceiver::mouseMove"/> is raised.</summary>
+				/// <returns>The composition under the mouse. Returns null if the mouse is not in the window.</returns>
+				GuiGraphicsComposition*					GetHoveredComposition();
 				/// <summary>Notify that a composition is going to disconnect from this graphics host. Generally this happens when a composition's parent line changes.</summary>
 				/// <param name="composition">The composition to disconnect</param>
 				void									DisconnectComposition(GuiGraphicsComposition* composition);
@@ -584,6 +584,7 @@ Type Declaration
 				CLASS_MEMBER_GUIEVENT_COMPOSITION(horizontalWheel)
 				CLASS_MEMBER_GUIEVENT_COMPOSITION(verticalWheel)
 				CLASS_MEMBER_GUIEVENT_COMPOSITION(mouseMove)
+				CLASS_MEMBER_GUIEVENT_COMPOSITION(rawMouseMove)
 				CLASS_MEMBER_GUIEVENT_COMPOSITION(mouseEnter)
 				CLASS_MEMBER_GUIEVENT_COMPOSITION(mouseLeave)
 				
@@ -1709,6 +1709,8 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_FAST(ItemSource)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(TextProperty)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(CheckedProperty)
+				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(KeyProperty)
+				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(ContentProperty)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(SelectedItem, SelectionChanged)
 			END_CLASS_MEMBER(GuiBindableTextList)
 
@@ -1721,6 +1723,8 @@ Type Declaration
 				CLASS_MEMBER_PROPERTY_FAST(ItemSource)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(LargeImageProperty)
 				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(SmallImageProperty)
+				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(KeyProperty)
+				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(ContentProperty)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(SelectedItem, SelectionChanged)
 			END_CLASS_MEMBER(GuiBindableListView)
 
@@ -1756,6 +1760,8 @@ Type Declaration
 				CLASS_MEMBER_METHOD(ClearBindableColumns, NO_PARAMETER)
 				CLASS_MEMBER_METHOD(GetBindableColumn, { L"index" })
 				CLASS_MEMBER_PROPERTY_FAST(ItemSource)
+				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(KeyProperty)
+				CLASS_MEMBER_PROPERTY_GUIEVENT_FAST(ContentProperty)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(SelectedRowValue, SelectedCellChanged)
 				CLASS_MEMBER_PROPERTY_EVENT_READONLY_FAST(SelectedCellValue, SelectedCellChanged)
 			END_CLASS_MEMBER(GuiBindableDataGrid)
@@ -11,6 +11,7 @@ namespace vl
 	{
 		namespace description
 		{
+			using namespace presentation;
 			using namespace presentation::controls;
 
 			class GuiReflectionPlugin : public Object, public IGuiPlugin
@@ -18,16 +19,18 @@ namespace vl
 			public:
 				void Load()override
 				{
-					LoadPredefinedTypes();
-					LoadParsingTypes();
-					XmlLoadTypes();
-					JsonLoadTypes();
-					LoadGuiBasicTypes();
-					LoadGuiElementTypes();
-					LoadGuiCompositionTypes();
-					LoadGuiControlTypes();
-					LoadGuiTemplateTypes();
-					LoadGuiEventTypes();
+#define LOAD_TYPES(FUNCTION) { GuiStartupTrace::Scope scope(L"TypeLoader", L ## #FUNCTION); FUNCTION(); }
+					LOAD_TYPES(LoadPredefinedTypes)
+					LOAD_TYPES(LoadParsingTypes)
+					LOAD_TYPES(XmlLoadTypes)
+					LOAD_TYPES(JsonLoadTypes)
+					LOAD_TYPES(LoadGuiBasicTypes)
+					LOAD_TYPES(LoadGuiElementTypes)
+					LOAD_TYPES(LoadGuiCompositionTypes)
+					LOAD_TYPES(LoadGuiControlTypes)
+					LOAD_TYPES(LoadGuiTemplateTypes)
+					LOAD_TYPES(LoadGuiEventTypes)
+#undef LOAD_TYPES
 				}
 				
 				void AfterLoad()override
@@ -11,6 +11,7 @@ namespace vl
 		using namespace parsing::xml;
 		using namespace parsing::json;
 		using namespace regex;
+		using namespace stream;
 
 /***********************************************************************
 IGuiParserManager
@@ -23,11 +24,50 @@ IGuiParserManager
 			return parserManager;
 		}
 
+/***********************************************************************
+GuiXmlParser
+***********************************************************************/
+
+		class GuiXmlParser : public Object, public IGuiParser<XmlDocument>
+		{
+		public:
+			Ptr<XmlDocument> TypedParse(const WString& text, collections::List<Ptr<parsing::ParsingError>>& errors)override
+			{
+				// XmlReader does not need the parsing table, which is still registered for other tools
+				return XmlParseDocument(text, errors);
+			}
+		};
+
+/***********************************************************************
+GuiJsonParser
+***********************************************************************/
+
+		class GuiJsonParser : public Object, public IGuiParser<JsonNode>
+		{
+		public:
+			Ptr<JsonNode> TypedParse(const WString& text, collections::List<Ptr<parsing::ParsingError>>& errors)override
+			{
+				return JsonParse(text, errors);
+			}
+		};
+
+/***********************************************************************
+GuiParserManager
+***********************************************************************/
+
 		class GuiParserManager : public Object, public IGuiParserManager, public IGuiPlugin
 		{
 		protected:
-			Dictionary<WString, Ptr<Table>>				tables;
-			Dictionary<WString, Func<Ptr<Table>()>>		loaders;
+			class TableRecord : public Object
+			{
+			public:
+				Func<Ptr<Table>()>						loader;
+				Ptr<Table>								table;
+				bool									loaded = false;
+				CriticalSection							lock;
+			};
+
+			Dictionary<WString, Ptr<TableRecord>>		tables;
 			SpinLock									lock;
 
 			Dictionary<WString, Ptr<IGuiGeneralParser>>	parsers;
@@ -45,8 +85,8 @@ IGuiParserManager
 				parserManager=this;
 				SetParsingTable(L"XML", &XmlLoadTable);
 				SetParsingTable(L"JSON", &JsonLoadTable);
-				SetTableParser(L"XML", L"XML", &XmlParseDocument);
-				SetTableParser(L"JSON", L"JSON", &JsonParse);
+				SetParser(L"XML", new GuiXmlParser);
+				SetParser(L"JSON", new GuiJsonParser);
 			}
 
 			void AfterLoad()override
@@ -58,34 +98,83 @@ IGuiParserManager
 				parserManager=0;
 			}
 
-			Ptr<Table> GetParsingTable(const WString& name)override
+			Ptr<TableRecord> GetTableRecord(const WString& name)
 			{
 				SPIN_LOCK(lock)
 				{
-					vint index=tables.Keys().IndexOf(name);
-					if(index!=-1)
+					vint index = tables.Keys().IndexOf(name);
+					if (index != -1)
 					{
 						return tables.Values()[index];
 					}
+				}
+				return nullptr;
+			}
 
-					index=loaders.Keys().IndexOf(name);
-					if(index!=-1)
+			Ptr<Table> GetParsingTable(const WString& name)override
+			{
+				if (auto record = GetTableRecord(name))
+				{
+					// Decoding a table takes a while, only threads that need the same table wait for each other
+					CS_LOCK(record->lock)
 					{
-						Ptr<Table> table=loaders.Values()[index]();
-						tables.Add(name, table);
-						return table;
+						if (!record->loaded)
+						{
+							GuiStartupTrace::Scope scope(L"ParsingTable", name);
+							record->table = record->loader();
+							record->loader = {};
+							record->loaded = true;
+						}
+						return record->table;
 					}
 				}
-				return 0;
+				return nullptr;
 			}
 
 			bool SetParsingTable(const WString& name, Func<Ptr<Table>()> loader)override
 			{
-				if(loaders.Keys().Contains(name)) return false;
-				loaders.Add(name, loader);
+				SPIN_LOCK(lock)
+				{
+					if (tables.Keys().Contains(name)) return false;
+					auto record = MakePtr<TableRecord>();
+					record->loader = loader;
+					tables.Add(name, record);
+				}
 				return true;
 			}
 
+			bool SetPredecodedParsingTable(const WString& name, const void* buffer, vint size)override
+			{
+				auto loader = [=]()
+				{
+					MemoryWrapperStream stream((void*)buffer, size);
+					Ptr<Table> table = new Table(stream);
+					table->Initialize();
+					return table;
+				};
+
+				if (auto record = GetTableRecord(name))
+				{
+					CS_LOCK(record->lock)
+					{
+						if (record->loaded) return false;
+						record->loader = loader;
+					}
+					return true;
+				}
+				return SetParsingTable(name, loader);
+			}
+
+			bool SavePredecodedParsingTable(const WString& name, stream::IStream& stream)override
+			{
+				if (auto table = GetParsingTable(name))
+				{
+					table->Serialize(stream);
+					return true;
+				}
+				return false;
+			}
+
 			Ptr<IGuiGeneralParser> GetParser(const WString& name)override
 			{
 				vint index=parsers.Keys().IndexOf(name);
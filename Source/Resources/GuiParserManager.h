@@ -64,6 +64,17 @@ Parser Manager
 			/// <param name="name">The name.</param>
 			/// <param name="loader">The parsing table loader.</param>
 			virtual bool							SetParsingTable(const WString& name, Func<Ptr<Table>()> loader)=0;
+			/// <summary>Replace the loader of a parsing table that has not been loaded yet by a pre-decoded table, which is the output of [M:vl.parsing.tabling.ParsingTable.Serialize]. The buffer could be a memory-mapped file, skipping the LZW decompression in generated table loaders.</summary>
+			/// <returns>Returns true if this operation succeeded. Returns false if the table has already been loaded.</returns>
+			/// <param name="name">The name.</param>
+			/// <param name="buffer">The pre-decoded table. It is not copied, so it must be alive until the table is loaded.</param>
+			/// <param name="size">The size of the pre-decoded table in bytes.</param>
+			virtual bool							SetPredecodedParsingTable(const WString& name, const void* buffer, vint size)=0;
+			/// <summary>Save a parsing table as a pre-decoded table, which can be loaded using <see cref="SetPredecodedParsingTable"/>.</summary>
+			/// <returns>Returns true if this operation succeeded.</returns>
+			/// <param name="name">The name.</param>
+			/// <param name="stream">The stream to write.</param>
+			virtual bool							SavePredecodedParsingTable(const WString& name, stream::IStream& stream)=0;
 			/// <summary>Get a parser.</summary>
 			/// <returns>The parser.</returns>
 			/// <param name="name">The name.</param>
@@ -98,6 +109,7 @@ Strong Typed Table Parser
 		protected:
 			WString									name;
 			Ptr<Table>								table;
+			SpinLock								tableLock;
 			Func<ParserFunction>					function;
 		public:
 			GuiStrongTypedTableParser(const WString& _name, ParserFunction* _function)
@@ -108,9 +120,18 @@ Strong Typed Table Parser
 
 			Ptr<T> TypedParse(const WString& text, collections::List<Ptr<parsing::ParsingError>>& errors)override
 			{
+				Ptr<Table> table;
+				SPIN_LOCK(tableLock)
+				{
+					table = this->table;
+				}
 				if(!table)
 				{
 					table = GetParserManager()->GetParsingTable(name);
+					SPIN_LOCK(tableLock)
+					{
+						this->table = table;
+					}
 				}
 				if(table)
 				{
@@ -58,6 +58,30 @@ namespace vl
 			return false;
 		}
 
+		bool LoadXmlFile(const WString& filePath, Ptr<XmlDocument>& xml, List<Ptr<ParsingError>>& errors)
+		{
+			stream::FileStream fileStream(filePath, stream::FileStream::ReadOnly);
+			if (!fileStream.IsAvailable())
+			{
+				return false;
+			}
+
+			// XmlReader decodes UTF-8 block by block, other encodings are decoded to a string by BomDecoder
+			vuint8_t bom[3] = { 0 };
+			if (fileStream.Read(bom, sizeof(bom)) == sizeof(bom) && bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF)
+			{
+				xml = XmlParseDocument(fileStream, errors);
+			}
+			else
+			{
+				fileStream.SeekFromBegin(0);
+				WString text;
+				LoadTextFromStream(fileStream, text);
+				xml = XmlParseDocument(text, errors);
+			}
+			return true;
+		}
+
 		bool IsResourceUrl(const WString& text, WString& protocol, WString& path)
 		{
 			Pair<vint, vint> index = INVLOC.FindFirst(text, L"://", Locale::None);
@@ -461,19 +485,16 @@ GuiResourceFolder
 									auto fileAbsolutePath = containingFolder + fileContentPath;
 									folder->SetFileContentPath(fileContentPath, fileAbsolutePath);
 
-									WString text;
-									if (LoadTextFile(fileAbsolutePath, text))
+									Ptr<XmlDocument> xml;
+									List<Ptr<ParsingError>> parsingErrors;
+									if (LoadXmlFile(fileAbsolutePath, xml, parsingErrors))
 									{
-										if (auto parser = GetParserManager()->GetParser<XmlDocument>(L"XML"))
+										if (xml)
 										{
-											List<Ptr<ParsingError>> parsingErrors;
-											if (auto xml = parser->TypedParse(text, parsingErrors))
-											{
-												newContainingFolder = GetFolderPath(fileAbsolutePath);
-												newFolderXml = xml->rootElement;
-											}
-											GuiResourceError::Transform(fileAbsolutePath, errors, parsingErrors);
+											newContainingFolder = GetFolderPath(fileAbsolutePath);
+											newFolderXml = xml->rootElement;
 										}
+										GuiResourceError::Transform(fileAbsolutePath, errors, parsingErrors);
 									}
 									else
 									{
@@ -896,6 +917,14 @@ GuiResourceFolder
 			}
 		}
 
+		void GuiResourceFolder::UpdatePathIndex()
+		{
+			if (parent)
+			{
+				parent->UpdatePathIndex();
+			}
+		}
+
 		GuiResourceFolder::GuiResourceFolder()
 		{
 		}
@@ -921,6 +950,7 @@ GuiResourceFolder
 			items.Add(name, item);
 			item->parent=this;
 			item->name=name;
+			UpdatePathIndex();
 			return true;
 		}
 
@@ -929,12 +959,14 @@ GuiResourceFolder
 			Ptr<GuiResourceItem> item=GetItem(name);
 			if(!item) return 0;
 			items.Remove(name);
+			UpdatePathIndex();
 			return item;
 		}
 
 		void GuiResourceFolder::ClearItems()
 		{
 			items.Clear();
+			UpdatePathIndex();
 		}
 
 		const GuiResourceFolder::FolderList& GuiResourceFolder::GetFolders()
@@ -954,6 +986,7 @@ GuiResourceFolder
 			folders.Add(name, folder);
 			folder->parent=this;
 			folder->name=name;
+			UpdatePathIndex();
 			return true;
 		}
 
@@ -962,12 +995,14 @@ GuiResourceFolder
 			Ptr<GuiResourceFolder> folder=GetFolder(name);
 			if(!folder) return 0;
 			folders.Remove(name);
+			UpdatePathIndex();
 			return folder;
 		}
 
 		void GuiResourceFolder::ClearFolders()
 		{
 			folders.Clear();
+			UpdatePathIndex();
 		}
 
 		Ptr<DescriptableObject> GuiResourceFolder::GetValueByPath(const WString& path)
@@ -1090,6 +1125,78 @@ GuiResource
 			}
 		}
 
+		namespace resource_path_index
+		{
+			vint HashResourcePath(const wchar_t* path, vint length)
+			{
+				vuint hash = 0;
+				for (vint i = 0; i < length; i++)
+				{
+					wchar_t c = path[i] == L'\\' ? L'/' : path[i];
+					hash = hash * 31 + (vuint)c;
+				}
+				return (vint)hash;
+			}
+
+			bool IsSameResourcePath(const WString& normalizedPath, const wchar_t* path, vint length)
+			{
+				if (normalizedPath.Length() != length) return false;
+				const wchar_t* buffer = normalizedPath.Buffer();
+				for (vint i = 0; i < length; i++)
+				{
+					wchar_t c = path[i] == L'\\' ? L'/' : path[i];
+					if (buffer[i] != c) return false;
+				}
+				return true;
+			}
+		}
+		using namespace resource_path_index;
+
+		void GuiResource::UpdatePathIndex()
+		{
+			if (!pathIndexSuspended)
+			{
+				pathIndex.Clear();
+				BuildPathIndex(this, L"");
+			}
+		}
+
+		void GuiResource::BuildPathIndex(GuiResourceFolder* folder, const WString& prefix)
+		{
+			FOREACH(Ptr<GuiResourceItem>, item, folder->GetItems())
+			{
+				auto path = prefix + item->GetName();
+				pathIndex.Add(HashResourcePath(path.Buffer(), path.Length()), PathIndexEntry(path, item));
+			}
+
+			FOREACH(Ptr<GuiResourceFolder>, subFolder, folder->GetFolders())
+			{
+				auto path = prefix + subFolder->GetName() + L"/";
+				pathIndex.Add(HashResourcePath(path.Buffer(), path.Length()), PathIndexEntry(path, subFolder));
+				BuildPathIndex(subFolder.Obj(), path);
+			}
+		}
+
+		Ptr<GuiResourceNodeBase> GuiResource::GetNodeByPath(const WString& path)
+		{
+			const wchar_t* buffer = path.Buffer();
+			vint length = path.Length();
+			vint index = pathIndex.Keys().IndexOf(HashResourcePath(buffer, length));
+			if (index != -1)
+			{
+				const auto& entries = pathIndex.GetByIndex(index);
+				for (vint i = 0; i < entries.Count(); i++)
+				{
+					const auto& entry = entries[i];
+					if (IsSameResourcePath(entry.key, buffer, length))
+					{
+						return entry.value;
+					}
+				}
+			}
+			return nullptr;
+		}
+
 		GuiResource::GuiResource()
 		{
 		}
@@ -1105,32 +1212,31 @@ GuiResource
 
 		Ptr<GuiResource> GuiResource::LoadFromXml(Ptr<parsing::xml::XmlDocument> xml, const WString& filePath, const WString& workingDirectory, GuiResourceError::List& errors)
 		{
+			GuiStartupTrace::Scope scope(L"Resource", L"LoadFromXml: ", filePath);
 			Ptr<GuiResource> resource = new GuiResource;
 			resource->SetFileContentPath(filePath, filePath);
 			resource->workingDirectory = workingDirectory;
 			DelayLoadingList delayLoadings;
+			resource->pathIndexSuspended = true;
 			resource->LoadResourceFolderFromXml(delayLoadings, resource->workingDirectory, xml->rootElement, errors);
 
 			ProcessDelayLoading(resource, delayLoadings, errors);
+			resource->pathIndexSuspended = false;
+			resource->UpdatePathIndex();
 			return resource;
 		}
 
 		Ptr<GuiResource> GuiResource::LoadFromXml(const WString& filePath, GuiResourceError::List& errors)
 		{
 			Ptr<XmlDocument> xml;
-			if(auto parser=GetParserManager()->GetParser<XmlDocument>(L"XML"))
+			List<Ptr<ParsingError>> parsingErrors;
+			if(LoadXmlFile(filePath, xml, parsingErrors))
 			{
-				WString text;
-				if(LoadTextFile(filePath, text))
-				{
-					List<Ptr<ParsingError>> parsingErrors;
-					xml = parser->TypedParse(text, parsingErrors);
-					GuiResourceError::Transform(filePath, errors, parsingErrors);
-				}
-				else
-				{
-					errors.Add(GuiResourceError(filePath, ParsingTextPos(), L"Failed to load file \"" + filePath + L"\"."));
-				}
+				GuiResourceError::Transform(filePath, errors, parsingErrors);
+			}
+			else
+			{
+				errors.Add(GuiResourceError(filePath, ParsingTextPos(), L"Failed to load file \"" + filePath + L"\"."));
 			}
 			if(xml)
 			{
@@ -1152,6 +1258,7 @@ GuiResource
 
 		Ptr<GuiResource> GuiResource::LoadPrecompiledBinary(stream::IStream& stream, GuiResourceError::List& errors)
 		{
+			GuiStartupTrace::Scope scope(L"Resource", L"LoadPrecompiledBinary");
 			stream::internal::ContextFreeReader reader(stream);
 			auto resource = MakePtr<GuiResource>();
 
@@ -1159,9 +1266,12 @@ GuiResource
 			reader << typeNames;
 			
 			DelayLoadingList delayLoadings;
+			resource->pathIndexSuspended = true;
 			resource->LoadResourceFolderFromBinary(delayLoadings, reader, typeNames, errors);
 			
 			ProcessDelayLoading(resource, delayLoadings, errors);
+			resource->pathIndexSuspended = false;
+			resource->UpdatePathIndex();
 			return resource;
 		}
 
@@ -1183,7 +1293,7 @@ GuiResource
 			SaveResourceFolderToBinary(writer, typeNames);
 		}
 
-		void GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors)
+		void GuiResource::Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors, bool optimizeWorkflow)
 		{
 			if (GetFolder(L"Precompiled"))
 			{
@@ -1195,6 +1305,7 @@ GuiResource
 			context.rootResource = this;
 			context.resolver = new GuiResourcePathResolver(this, workingDirectory);
 			context.targetFolder = new GuiResourceFolder;
+			context.optimizeWorkflow = optimizeWorkflow;
 			
 			auto manager = GetResourceResolverManager();
 			vint maxPass = manager->GetMaxPrecompilePassIndex();
@@ -1241,6 +1352,7 @@ GuiResource
 				return;
 			}
 			
+			GuiStartupTrace::Scope scope(L"Resource", L"Initialize: ", GetFileContentPath());
 			GuiResourceInitializeContext context;
 			context.rootResource = this;
 			context.resolver = new GuiResourcePathResolver(this, workingDirectory);
@@ -1255,6 +1367,20 @@ GuiResource
 			}
 		}
 
+		Ptr<DescriptableObject> GuiResource::GetValueByPath(const WString& path)
+		{
+			if (auto item = GetNodeByPath(path).Cast<GuiResourceItem>())
+			{
+				return item->GetContent();
+			}
+			return nullptr;
+		}
+
+		Ptr<GuiResourceFolder> GuiResource::GetFolderByPath(const WString& path)
+		{
+			return GetNodeByPath(path).Cast<GuiResourceFolder>();
+		}
+
 		Ptr<DocumentModel> GuiResource::GetDocumentByPath(const WString& path)
 		{
 			Ptr<DocumentModel> result=GetValueByPath(path).Cast<DocumentModel>();
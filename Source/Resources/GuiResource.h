@@ -10,6 +10,7 @@ Interfaces:
 #define VCZH_PRESENTATION_RESOURCES_GUIRESOURCE
 
 #include "../NativeWindow/GuiNativeWindow.h"
+#include "GuiStartupTrace.h"
 
 namespace vl
 {
@@ -43,6 +44,12 @@ Helper Functions
 		/// <param name="stream">The stream containing text.</param>
 		/// <param name="text">The text file content, if succeeded.</param>
 		extern bool									LoadTextFromStream(stream::IStream& stream, WString& text);
+		/// <summary>Load an XML file. A UTF-8 file with a BOM is parsed directly from the file stream, other files are decoded to a string before parsing.</summary>
+		/// <returns>Returns true if the file is loaded, even if there are parsing errors.</returns>
+		/// <param name="filePath">The XML file path.</param>
+		/// <param name="xml">The XML document, or null if there is any parsing error.</param>
+		/// <param name="errors">Parsing errors.</param>
+		extern bool									LoadXmlFile(const WString& filePath, Ptr<parsing::xml::XmlDocument>& xml, collections::List<Ptr<parsing::ParsingError>>& errors);
 		/// <summary>Test is a text a resource url and extract the protocol and the path.</summary>
 		/// <returns>Returns true if the text is a resource url.</returns>
 		/// <param name="text">The text.</param>
@@ -274,6 +281,7 @@ Resource Structure
 			void									SaveResourceFolderToBinary(stream::internal::ContextFreeWriter& writer, collections::List<WString>& typeNames);
 			void									PrecompileResourceFolder(GuiResourcePrecompileContext& context, IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors);
 			void									InitializeResourceFolder(GuiResourceInitializeContext& context);
+			virtual void							UpdatePathIndex();
 		public:
 			/// <summary>Create a resource folder.</summary>
 			GuiResourceFolder();
@@ -320,11 +328,11 @@ Resource Structure
 			/// <summary>Get a contained resource object using a path like "Packages\Application\Name".</summary>
 			/// <returns>The containd resource object.</returns>
 			/// <param name="path">The path.</param>
-			Ptr<DescriptableObject>					GetValueByPath(const WString& path);
+			virtual Ptr<DescriptableObject>			GetValueByPath(const WString& path);
 			/// <summary>Get a resource folder using a path like "Packages\Application\Name\".</summary>
 			/// <returns>The resource folder.</returns>
 			/// <param name="path">The path.</param>
-			Ptr<GuiResourceFolder>					GetFolderByPath(const WString& path);
+			virtual Ptr<GuiResourceFolder>			GetFolderByPath(const WString& path);
 			/// <summary>Create a contained resource object using a path like "Packages\Application\Name".</summary>
 			/// <returns>Returns true if this operation succeeded.</returns>
 			/// <param name="path">The path.</param>
@@ -347,9 +355,17 @@ Resource
 		class GuiResource : public GuiResourceFolder, public Description<GuiResource>
 		{
 		protected:
+			typedef collections::Pair<WString, Ptr<GuiResourceNodeBase>>		PathIndexEntry;
+			typedef collections::Group<vint, PathIndexEntry>					PathIndex;
+
 			WString									workingDirectory;
+			PathIndex								pathIndex;
+			bool									pathIndexSuspended = false;
 
 			static void								ProcessDelayLoading(Ptr<GuiResource> resource, DelayLoadingList& delayLoadings, GuiResourceError::List& errors);
+			void									UpdatePathIndex()override;
+			void									BuildPathIndex(GuiResourceFolder* folder, const WString& prefix);
+			Ptr<GuiResourceNodeBase>				GetNodeByPath(const WString& path);
 		public:
 			/// <summary>Create a resource.</summary>
 			GuiResource();
@@ -394,11 +410,21 @@ Resource
 			/// <summary>Precompile this resource to improve performance.</summary>
 			/// <param name="callback">A callback to receive progress.</param>
 			/// <param name="errors">All collected errors during precompiling a resource.</param>
-			void									Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors);
+			/// <param name="optimizeWorkflow">Set to true to optimize instructions in compiled Workflow assemblies.</param>
+			void									Precompile(IGuiResourcePrecompileCallback* callback, GuiResourceError::List& errors, bool optimizeWorkflow = false);
 
 			/// <summary>Initialize a precompiled resource.</summary>
 			/// <param name="usage">In which role an application is initializing this resource.</param>
 			void									Initialize(GuiResourceUsage usage);
+
+			/// <summary>Get a contained resource object using a path like "Packages\Application\Name". The resource keeps an index of all full paths, which is updated whenever the resource is changed, so this function does not walk through folders.</summary>
+			/// <returns>The containd resource object.</returns>
+			/// <param name="path">The path.</param>
+			Ptr<DescriptableObject>					GetValueByPath(const WString& path)override;
+			/// <summary>Get a resource folder using a path like "Packages\Application\Name\". The resource keeps an index of all full paths, which is updated whenever the resource is changed, so this function does not walk through folders.</summary>
+			/// <returns>The resource folder.</returns>
+			/// <param name="path">The path.</param>
+			Ptr<GuiResourceFolder>					GetFolderByPath(const WString& path)override;
 			
 			/// <summary>Get a contained document model using a path like "Packages\Application\Name". If the path does not exists or the type does not match, an exception will be thrown.</summary>
 			/// <returns>The containd resource object.</returns>
@@ -526,6 +552,8 @@ Resource Type Resolver
 			Ptr<GuiResourcePathResolver>						resolver;
 			/// <summary>Additional properties for resource item contents</summary>
 			PropertyMap											additionalProperties;
+			/// <summary>Set to true to optimize instructions in compiled Workflow assemblies.</summary>
+			bool												optimizeWorkflow = false;
 		};
 
 		/// <summary>
@@ -270,20 +270,16 @@ Xml Type Resolver (Xml)
 
 			Ptr<DescriptableObject> ResolveResource(Ptr<GuiResourceItem> resource, const WString& path, GuiResourceError::List& errors)override
 			{
-				if (auto parser = GetParserManager()->GetParser<XmlDocument>(L"XML"))
+				Ptr<XmlDocument> xml;
+				List<Ptr<ParsingError>> parsingErrors;
+				if (LoadXmlFile(path, xml, parsingErrors))
 				{
-					WString text;
-					if (LoadTextFile(path, text))
-					{
-						List<Ptr<ParsingError>> parsingErrors;
-						auto xml = parser->TypedParse(text, parsingErrors);
-						GuiResourceError::Transform(resource, errors, parsingErrors);
-						return xml;
-					}
-					else
-					{
-						errors.Add(GuiResourceError(resource, L"Failed to load file \"" + path + L"\"."));
-					}
+					GuiResourceError::Transform(resource, errors, parsingErrors);
+					return xml;
+				}
+				else
+				{
+					errors.Add(GuiResourceError(resource, L"Failed to load file \"" + path + L"\"."));
 				}
 				return nullptr;
 			}
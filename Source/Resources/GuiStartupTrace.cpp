@@ -0,0 +1,217 @@
+#include "GuiStartupTrace.h"
+#include <chrono>
+#include <stdlib.h>
+#if defined VCZH_GCC && defined __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace vl
+{
+	namespace presentation
+	{
+		using namespace collections;
+		using namespace stream;
+		using namespace parsing;
+		using namespace parsing::json;
+
+/***********************************************************************
+Helpers
+***********************************************************************/
+
+		namespace startup_trace
+		{
+			bool									traceEnabled = false;
+			bool									environmentChecked = false;
+			WString									traceOutputPath;
+			List<GuiStartupTrace::Event>			traceEvents;
+			SpinLock								traceLock;
+
+			void CheckEnvironment()
+			{
+				if (!environmentChecked)
+				{
+					environmentChecked = true;
+					if (auto path = getenv("GACUI_STARTUP_TRACE"))
+					{
+						if (*path)
+						{
+							GuiStartupTrace::Enable(atow(path));
+						}
+					}
+				}
+			}
+
+			vint64_t GetHeapSize()
+			{
+#if defined VCZH_GCC && defined __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+				return (vint64_t)mallinfo2().uordblks;
+#else
+				return (vint64_t)mallinfo().uordblks;
+#endif
+#else
+				return 0;
+#endif
+			}
+
+			Ptr<JsonObjectField> CreateField(const WString& name, Ptr<JsonNode> value)
+			{
+				auto field = MakePtr<JsonObjectField>();
+				field->name.value = name;
+				field->value = value;
+				return field;
+			}
+
+			Ptr<JsonNode> CreateString(const WString& value)
+			{
+				auto node = MakePtr<JsonString>();
+				node->content.value = value;
+				return node;
+			}
+
+			Ptr<JsonNode> CreateNumber(vint64_t value)
+			{
+				auto node = MakePtr<JsonNumber>();
+				node->content.value = i64tow(value);
+				return node;
+			}
+		}
+		using namespace startup_trace;
+
+/***********************************************************************
+GuiStartupTrace::Scope
+***********************************************************************/
+
+		void GuiStartupTrace::Scope::Start(const wchar_t* category, const WString& name)
+		{
+			event.category = category;
+			event.name = name;
+			event.threadId = Thread::GetCurrentThreadId();
+			startHeapSize = GetHeapSize();
+			event.start = GetMicroseconds();
+		}
+
+		GuiStartupTrace::Scope::Scope(const wchar_t* category, const wchar_t* name)
+			:enabled(IsEnabled())
+		{
+			if (enabled)
+			{
+				Start(category, name);
+			}
+		}
+
+		GuiStartupTrace::Scope::Scope(const wchar_t* category, const WString& name)
+			:enabled(IsEnabled())
+		{
+			if (enabled)
+			{
+				Start(category, name);
+			}
+		}
+
+		GuiStartupTrace::Scope::Scope(const wchar_t* category, const wchar_t* prefix, const WString& name)
+			:enabled(IsEnabled())
+		{
+			if (enabled)
+			{
+				Start(category, prefix + name);
+			}
+		}
+
+		GuiStartupTrace::Scope::~Scope()
+		{
+			if (enabled)
+			{
+				event.duration = GetMicroseconds() - event.start;
+				event.heapGrowth = GetHeapSize() - startHeapSize;
+				SPIN_LOCK(traceLock)
+				{
+					traceEvents.Add(event);
+				}
+			}
+		}
+
+/***********************************************************************
+GuiStartupTrace
+***********************************************************************/
+
+		vint64_t GuiStartupTrace::GetMicroseconds()
+		{
+			using namespace std::chrono;
+			return (vint64_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+		}
+
+		void GuiStartupTrace::Enable(const WString& outputPath)
+		{
+			environmentChecked = true;
+			traceEnabled = true;
+			traceOutputPath = outputPath;
+		}
+
+		bool GuiStartupTrace::IsEnabled()
+		{
+			CheckEnvironment();
+			return traceEnabled;
+		}
+
+		void GuiStartupTrace::Finish()
+		{
+			if (!traceEnabled) return;
+			if (traceOutputPath != L"")
+			{
+				FileStream fileStream(traceOutputPath, FileStream::WriteOnly);
+				if (fileStream.IsAvailable())
+				{
+					Save(fileStream);
+				}
+			}
+
+			traceEnabled = false;
+			SPIN_LOCK(traceLock)
+			{
+				traceEvents.Clear();
+			}
+		}
+
+		void GuiStartupTrace::GetEvents(collections::List<Event>& events)
+		{
+			SPIN_LOCK(traceLock)
+			{
+				CopyFrom(events, traceEvents);
+			}
+		}
+
+		void GuiStartupTrace::Save(stream::IStream& stream)
+		{
+			List<Event> events;
+			GetEvents(events);
+
+			auto jsonEvents = MakePtr<JsonArray>();
+			FOREACH(Event, event, events)
+			{
+				auto args = MakePtr<JsonObject>();
+				args->fields.Add(CreateField(L"heapGrowth", CreateNumber(event.heapGrowth)));
+
+				auto jsonEvent = MakePtr<JsonObject>();
+				jsonEvent->fields.Add(CreateField(L"name", CreateString(event.name)));
+				jsonEvent->fields.Add(CreateField(L"cat", CreateString(event.category)));
+				jsonEvent->fields.Add(CreateField(L"ph", CreateString(L"X")));
+				jsonEvent->fields.Add(CreateField(L"ts", CreateNumber(event.start)));
+				jsonEvent->fields.Add(CreateField(L"dur", CreateNumber(event.duration)));
+				jsonEvent->fields.Add(CreateField(L"pid", CreateNumber(0)));
+				jsonEvent->fields.Add(CreateField(L"tid", CreateNumber(event.threadId)));
+				jsonEvent->fields.Add(CreateField(L"args", args));
+				jsonEvents->items.Add(jsonEvent);
+			}
+
+			auto json = MakePtr<JsonObject>();
+			json->fields.Add(CreateField(L"traceEvents", jsonEvents));
+			json->fields.Add(CreateField(L"displayTimeUnit", CreateString(L"ms")));
+
+			Utf8Encoder encoder;
+			EncoderStream encoderStream(stream, encoder);
+			StreamWriter writer(encoderStream);
+			JsonPrint(json, writer);
+		}
+	}
+}
\ No newline at end of file
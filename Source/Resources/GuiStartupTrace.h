@@ -0,0 +1,91 @@
+/***********************************************************************
+Vczh Library++ 3.0
+Developer: Zihan Chen(vczh)
+GacUI::Resource
+
+Interfaces:
+***********************************************************************/
+
+#ifndef VCZH_PRESENTATION_RESOURCES_GUISTARTUPTRACE
+#define VCZH_PRESENTATION_RESOURCES_GUISTARTUPTRACE
+
+#include "../NativeWindow/GuiNativeWindow.h"
+
+namespace vl
+{
+	namespace presentation
+	{
+
+/***********************************************************************
+Startup Trace
+***********************************************************************/
+
+		/// <summary>Records wall time and heap growth of startup activities (plugins, type loaders, parsing tables and resources), and saves them in the Chrome trace event format.</summary>
+		class GuiStartupTrace : public Object
+		{
+		public:
+			/// <summary>A recorded activity.</summary>
+			struct Event
+			{
+				/// <summary>The category of the activity, e.g. "Plugin", "TypeLoader", "ParsingTable" or "Resource".</summary>
+				WString								category;
+				/// <summary>The name of the activity.</summary>
+				WString								name;
+				/// <summary>The thread that performed the activity.</summary>
+				vint								threadId = 0;
+				/// <summary>The start time in microseconds.</summary>
+				vint64_t							start = 0;
+				/// <summary>The duration in microseconds.</summary>
+				vint64_t							duration = 0;
+				/// <summary>The heap growth in bytes during the activity, which is the change of the size of allocated heap memory, not the number of allocations. It is 0 if the platform does not support measuring it.</summary>
+				vint64_t							heapGrowth = 0;
+			};
+
+			/// <summary>Records an activity from the construction to the destruction of this object, when tracing is enabled.</summary>
+			class Scope : public Object, private NotCopyable
+			{
+			protected:
+				Event								event;
+				bool								enabled;
+				vint64_t							startHeapSize = 0;
+
+				void								Start(const wchar_t* category, const WString& name);
+			public:
+				/// <summary>Start recording an activity.</summary>
+				/// <param name="category">The category of the activity.</param>
+				/// <param name="name">The name of the activity.</param>
+				Scope(const wchar_t* category, const wchar_t* name);
+				/// <summary>Start recording an activity.</summary>
+				/// <param name="category">The category of the activity.</param>
+				/// <param name="name">The name of the activity.</param>
+				Scope(const wchar_t* category, const WString& name);
+				/// <summary>Start recording an activity. The name is only built when tracing is enabled.</summary>
+				/// <param name="category">The category of the activity.</param>
+				/// <param name="prefix">The first part of the name of the activity.</param>
+				/// <param name="name">The second part of the name of the activity.</param>
+				Scope(const wchar_t* category, const wchar_t* prefix, const WString& name);
+				~Scope();
+			};
+
+			/// <summary>Get the current time of the monotonic clock that recorded activities use. It could also be used to measure anything else.</summary>
+			/// <returns>The current time in microseconds.</returns>
+			static vint64_t							GetMicroseconds();
+			/// <summary>Start tracing. It should be called before [M:vl.presentation.controls.GuiApplicationMain] to cover plugin loading. Tracing is also enabled if the environment variable GACUI_STARTUP_TRACE is set to a file path.</summary>
+			/// <param name="outputPath">The file to write when the application exits. Set to empty to write nothing automatically.</param>
+			static void								Enable(const WString& outputPath = L"");
+			/// <summary>Test if tracing is enabled.</summary>
+			/// <returns>Returns true if tracing is enabled.</returns>
+			static bool								IsEnabled();
+			/// <summary>Stop tracing and write all recorded activities to the file specified in <see cref="Enable"/>.</summary>
+			static void								Finish();
+			/// <summary>Get all recorded activities.</summary>
+			/// <param name="events">All recorded activities.</param>
+			static void								GetEvents(collections::List<Event>& events);
+			/// <summary>Save all recorded activities in the Chrome trace event format.</summary>
+			/// <param name="stream">The stream to write.</param>
+			static void								Save(stream::IStream& stream);
+		};
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::list;
+
+namespace bindable_item_source_test
+{
+/***********************************************************************
+Stand-in List Control
+
+An item is a list of its key and its content, items are created for each item source and compared by their contents.
+Notifications are applied to a copy of the displayed items,
+which is what a list control does, so the copy must end up with the new item source.
+***********************************************************************/
+
+	class TestControl : public Object
+	{
+	public:
+		BindableItemSource			itemSource;
+		List<Value>					displayed;
+		WString						notifications;
+
+		TestControl()
+			:itemSource([this](vint start, vint oldCount, vint newCount) { OnItemChanged(start, oldCount, newCount); })
+		{
+			itemSource.SetKeyProperty([](const Value& item) { return item.GetSharedPtr().Cast<IValueList>()->Get(0); });
+			itemSource.SetContentProperty([](const Value& item) { return item.GetSharedPtr().Cast<IValueList>()->Get(1); });
+		}
+
+		void OnItemChanged(vint start, vint oldCount, vint newCount)
+		{
+			notifications += L"(" + itow(start) + L"," + itow(oldCount) + L"," + itow(newCount) + L")";
+			for (vint i = 0; i < oldCount; i++)
+			{
+				displayed.RemoveAt(start);
+			}
+			auto items = itemSource.GetItems();
+			for (vint i = 0; i < newCount; i++)
+			{
+				displayed.Insert(start + i, items->Get(start + i));
+			}
+		}
+
+		// Assign a new item source and return notifications, or "mismatch" if displayed items do not have the new keys and contents
+		// unchanged items are not notified, so displayed items could still be objects from the old item source
+		WString Assign(Ptr<IValueList> source)
+		{
+			notifications = L"";
+			itemSource.SetItemSource(source);
+			if (displayed.Count() != source->GetCount()) return L"mismatch";
+			for (vint i = 0; i < displayed.Count(); i++)
+			{
+				auto displayedItem = displayed[i].GetSharedPtr().Cast<IValueList>();
+				auto sourceItem = source->Get(i).GetSharedPtr().Cast<IValueList>();
+				if (displayedItem->Get(0) != sourceItem->Get(0) || displayedItem->Get(1) != sourceItem->Get(1)) return L"mismatch";
+			}
+			return notifications;
+		}
+	};
+
+	Value MakeItem(vint key, vint content)
+	{
+		auto item = IValueList::Create();
+		item->Add(BoxValue<vint>(key));
+		item->Add(BoxValue<vint>(content));
+		return BoxValue<Ptr<IValueList>>(item);
+	}
+
+	// Create an item source, the content of an item is the key multiplied by 10
+	Ptr<IValueList> MakeSource(const List<vint>& keys)
+	{
+		auto source = IValueList::Create();
+		FOREACH(vint, key, keys)
+		{
+			source->Add(MakeItem(key, key * 10));
+		}
+		return source;
+	}
+
+	// Create an item source from digits as keys
+	Ptr<IValueList> MakeSource(const WString& digits)
+	{
+		List<vint> keys;
+		for (vint i = 0; i < digits.Length(); i++)
+		{
+			keys.Add(digits[i] - L'0');
+		}
+		return MakeSource(keys);
+	}
+
+}
+using namespace bindable_item_source_test;
+
+TEST_CASE(TestBindableItemSource_Insert)
+{
+	TestControl control;
+	TEST_ASSERT(control.Assign(MakeSource(L"123")) == L"(0,0,3)");
+	TEST_ASSERT(control.Assign(MakeSource(L"14523")) == L"(1,0,2)");
+	TEST_ASSERT(control.Assign(MakeSource(L"0145236")) == L"(0,0,1)(6,0,1)");
+	TEST_ASSERT(control.Assign(MakeSource(L"017452836")) == L"(2,0,1)(6,0,1)");
+}
+
+TEST_CASE(TestBindableItemSource_Remove)
+{
+	TestControl control;
+	control.Assign(MakeSource(L"1234567"));
+	TEST_ASSERT(control.Assign(MakeSource(L"14567")) == L"(1,2,0)");
+	TEST_ASSERT(control.Assign(MakeSource(L"456")) == L"(0,1,0)(3,1,0)");
+	TEST_ASSERT(control.Assign(MakeSource(L"5")) == L"(0,1,0)(1,1,0)");
+	TEST_ASSERT(control.Assign(MakeSource(L"")) == L"(0,1,0)");
+}
+
+TEST_CASE(TestBindableItemSource_Move)
+{
+	TestControl control;
+	control.Assign(MakeSource(L"1234"));
+	TEST_ASSERT(control.Assign(MakeSource(L"1342")) == L"(1,1,0)(3,0,1)");
+	TEST_ASSERT(control.Assign(MakeSource(L"2134")) == L"(0,0,1)(4,1,0)");
+
+	// removing and inserting at the same place are notified together
+	TEST_ASSERT(control.Assign(MakeSource(L"2534")) == L"(1,1,1)");
+}
+
+TEST_CASE(TestBindableItemSource_Mixed)
+{
+	// random edits to a list with duplicated keys, displayed items must always follow the item source
+	TestControl control;
+	List<vint> keys;
+	vuint32_t seed = 1;
+	auto next = [&](vint range)
+	{
+		seed = seed * 1103515245 + 12345;
+		return (vint)(seed / 65536 % range);
+	};
+
+	bool followed = true;
+	for (vint round = 0; round < 200; round++)
+	{
+		vint edits = next(4) + 1;
+		for (vint i = 0; i < edits; i++)
+		{
+			switch (next(4))
+			{
+			case 0:
+			case 1:
+				keys.Insert(next(keys.Count() + 1), next(10));
+				break;
+			case 2:
+				if (keys.Count() > 0) keys.RemoveAt(next(keys.Count()));
+				break;
+			default:
+				if (keys.Count() > 1)
+				{
+					vint key = keys[next(keys.Count())];
+					keys.Remove(key);
+					keys.Insert(next(keys.Count() + 1), key);
+				}
+			}
+		}
+		followed &= control.Assign(MakeSource(keys)) != L"mismatch";
+	}
+	TEST_ASSERT(followed);
+}
+
+TEST_CASE(TestBindableItemSource_ContentProperty)
+{
+	TestControl control;
+	auto contentProperty = control.itemSource.GetContentProperty();
+	control.itemSource.SetContentProperty(ItemProperty<Value>());
+	control.Assign(MakeSource(L"1234"));
+
+	// without a content property, new objects with the same keys are all changed
+	TEST_ASSERT(control.Assign(MakeSource(L"1234")) == L"(0,4,4)");
+
+	// with a content property, only items with different contents are changed
+	control.itemSource.SetContentProperty(contentProperty);
+	auto source = MakeSource(L"1234");
+	source->Set(1, MakeItem(2, 21));
+	source->Set(3, MakeItem(4, 41));
+	TEST_ASSERT(control.Assign(source) == L"(1,1,1)(3,1,1)");
+
+	// unchanged items are still served from the new item source
+	source = MakeSource(L"1234");
+	source->Set(1, MakeItem(2, 21));
+	source->Set(3, MakeItem(4, 41));
+	TEST_ASSERT(control.Assign(source) == L"");
+	TEST_ASSERT(control.itemSource.GetItems()->Get(0) == source->Get(0));
+
+	// a matched item with a changed content is notified together with the edits around it
+	source = MakeSource(L"153");
+	source->Set(2, MakeItem(3, 31));
+	TEST_ASSERT(control.Assign(source) == L"(1,3,2)");
+}
+
+TEST_CASE(TestBindableItemSource_Fallback)
+{
+	TestControl control;
+	List<vint> keys;
+	for (vint i = 0; i < BindableItemSource::MaxEditDistance; i++)
+	{
+		keys.Add(i);
+	}
+	control.Assign(MakeSource(keys));
+
+	// more edits than MaxEditDistance notifies the whole list
+	List<vint> newKeys;
+	for (vint i = 0; i < BindableItemSource::MaxEditDistance; i++)
+	{
+		newKeys.Add(-i - 1);
+	}
+	vint count = BindableItemSource::MaxEditDistance;
+	TEST_ASSERT(control.Assign(MakeSource(newKeys)) == L"(0," + itow(count) + L"," + itow(count) + L")");
+
+	// without a key property, every assignment notifies the whole list
+	control.itemSource.SetKeyProperty(ItemProperty<Value>());
+	TEST_ASSERT(control.Assign(MakeSource(L"12")) == L"(0," + itow(count) + L",2)");
+	TEST_ASSERT(control.Assign(MakeSource(L"123")) == L"(0,2,3)");
+}
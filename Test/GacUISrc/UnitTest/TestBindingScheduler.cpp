@@ -0,0 +1,196 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+
+namespace binding_scheduler_test
+{
+/***********************************************************************
+Stand-in Subscription
+
+It behaves like the code generated for a bind expression compiled with scheduleBindings:
+when anything it observes is changed, it asks the scheduler first, and re-evaluates immediately if the scheduler refuses.
+***********************************************************************/
+
+	class TestSubscription : public Object, public virtual IValueSubscription
+	{
+	public:
+		WString						name;
+		List<WString>&				log;
+		Func<void()>				evaluate;
+		bool						closed = false;
+
+		TestSubscription(const WString& _name, List<WString>& _log)
+			:name(_name)
+			, log(_log)
+		{
+		}
+
+		Ptr<IValueListener> Subscribe(const Func<void(const Value&)>& callback)override
+		{
+			return nullptr;
+		}
+
+		bool Update()override
+		{
+			if (closed) return false;
+			log.Add(name);
+			if (evaluate)
+			{
+				evaluate();
+			}
+			return true;
+		}
+
+		bool Close()override
+		{
+			closed = true;
+			return true;
+		}
+
+		void Changed()
+		{
+			if (!SubscriptionScheduler::Schedule(this))
+			{
+				Update();
+			}
+		}
+	};
+
+	WString Join(List<WString>& log)
+	{
+		WString result;
+		FOREACH(WString, item, log)
+		{
+			result += item;
+		}
+		log.Clear();
+		return result;
+	}
+}
+using namespace binding_scheduler_test;
+
+TEST_CASE(TestBindingScheduler_Disabled)
+{
+	List<WString> log;
+	Ptr<TestSubscription> a = new TestSubscription(L"A", log);
+	GuiBindingScheduler scheduler;
+
+	// without the scheduler bind expressions re-evaluate immediately
+	a->Changed();
+	a->Changed();
+	TEST_ASSERT(Join(log) == L"AA");
+	TEST_ASSERT(scheduler.GetScheduledCount() == 0);
+}
+
+TEST_CASE(TestBindingScheduler_Merge)
+{
+	List<WString> log;
+	Ptr<TestSubscription> a = new TestSubscription(L"A", log);
+	Ptr<TestSubscription> b = new TestSubscription(L"B", log);
+	GuiBindingScheduler scheduler;
+	scheduler.SetEnabled(true);
+
+	a->Changed();
+	b->Changed();
+	a->Changed();
+	TEST_ASSERT(Join(log) == L"");
+	scheduler.FlushBindings();
+	TEST_ASSERT(Join(log) == L"AB");
+	TEST_ASSERT(scheduler.GetScheduledCount() == 3);
+	TEST_ASSERT(scheduler.GetEvaluatedCount() == 2);
+	TEST_ASSERT(scheduler.GetSavedCount() == 1);
+
+	// pending re-evaluations are flushed when the scheduler is disabled
+	b->Changed();
+	scheduler.SetEnabled(false);
+	TEST_ASSERT(Join(log) == L"B");
+	TEST_ASSERT(SubscriptionScheduler::GetScheduler() == nullptr);
+}
+
+TEST_CASE(TestBindingScheduler_DependencyOrder)
+{
+	// A writes values observed by C and D, D writes values observed by C
+	// C is scheduled before D, so it runs twice when no dependency is known
+	List<WString> log;
+	Ptr<TestSubscription> a = new TestSubscription(L"A", log);
+	Ptr<TestSubscription> c = new TestSubscription(L"C", log);
+	Ptr<TestSubscription> d = new TestSubscription(L"D", log);
+	a->evaluate = [&]() { c->Changed(); d->Changed(); };
+	d->evaluate = [&]() { c->Changed(); };
+
+	GuiBindingScheduler scheduler;
+	scheduler.SetEnabled(true);
+
+	a->Changed();
+	scheduler.FlushBindings();
+	TEST_ASSERT(Join(log) == L"ACDC");
+
+	// dependencies found in the last flush decide the order, whatever order they are scheduled
+	c->Changed();
+	a->Changed();
+	d->Changed();
+	scheduler.FlushBindings();
+	TEST_ASSERT(Join(log) == L"ADC");
+	scheduler.SetEnabled(false);
+}
+
+TEST_CASE(TestBindingScheduler_Cycle)
+{
+	// subscriptions that depend on each other still run in the order they are scheduled
+	List<WString> log;
+	Ptr<TestSubscription> a = new TestSubscription(L"A", log);
+	Ptr<TestSubscription> b = new TestSubscription(L"B", log);
+	vint rounds = 0;
+	a->evaluate = [&]() { if (rounds++ < 2) b->Changed(); };
+	b->evaluate = [&]() { if (rounds++ < 2) a->Changed(); };
+
+	GuiBindingScheduler scheduler;
+	scheduler.SetEnabled(true);
+	a->Changed();
+	scheduler.FlushBindings();
+	TEST_ASSERT(Join(log) == L"ABA");
+
+	rounds = 2;
+	b->Changed();
+	a->Changed();
+	scheduler.FlushBindings();
+	TEST_ASSERT(Join(log) == L"BA");
+	scheduler.SetEnabled(false);
+}
+
+TEST_CASE(TestBindingScheduler_Lifetime)
+{
+	List<WString> log;
+	Ptr<TestSubscription> a = new TestSubscription(L"A", log);
+	Ptr<TestSubscription> b = new TestSubscription(L"B", log);
+	a->evaluate = [&]() { b->Changed(); };
+
+	{
+		GuiBindingScheduler scheduler;
+		scheduler.SetEnabled(true);
+		a->Changed();
+		scheduler.FlushBindings();
+		TEST_ASSERT(Join(log) == L"AB");
+
+		// a pending subscription is kept alive until it is evaluated, and a deleted one is forgotten
+		b->Changed();
+		b = nullptr;
+		a->evaluate = Func<void()>();
+		scheduler.FlushBindings();
+		TEST_ASSERT(Join(log) == L"B");
+
+		// closed subscriptions are not counted
+		a->Close();
+		a->Changed();
+		scheduler.FlushBindings();
+		TEST_ASSERT(Join(log) == L"");
+		TEST_ASSERT(scheduler.GetEvaluatedCount() == 3);
+	}
+
+	// the record is removed from the subscription when the scheduler is deleted
+	TEST_ASSERT(!a->GetInternalProperty(L"GuiBindingScheduler::Record"));
+}
@@ -0,0 +1,144 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Import/VlppWorkflowCompiler.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::workflow;
+using namespace vl::workflow::analyzer;
+using namespace vl::workflow::cppcodegen;
+
+namespace cpp_codegen_test
+{
+	const vint ModuleCount = 24;
+	const vint FileCount = 6;
+
+	// every module has a class in one of FileCount files, and every class except the first one in a group of 6 inherits the previous one
+	WString MakeModule(vint index)
+	{
+		auto name = itow(index);
+		auto file = L"File" + itow(index % FileCount);
+		auto base = index % FileCount == 0 ? WString::Empty : L" : C" + itow(index - 1);
+		return
+			L"module m" + name + L";\r\n"
+			L"using system::*;\r\n"
+			L"namespace demo\r\n"
+			L"{\r\n"
+			L"	enum E" + name + L" { A = 0, B = 1, }\r\n"
+			L"	struct S" + name + L" { x : int; y : string; }\r\n"
+			L"	@cpp:File(\"" + file + L"\")\r\n"
+			L"	class C" + name + base + L"\r\n"
+			L"	{\r\n"
+			L"		var v" + name + L" : int = 0;\r\n"
+			L"		new(){}\r\n"
+			L"		func Get" + name + L"(): int { var f = func(a: int): int { return a + v" + name + L"; }; return f(1); }\r\n"
+			L"		class Inner { func X(): string { return \"" + name + L"\"; } }\r\n"
+			L"	}\r\n"
+			L"	func F" + name + L"(n: int): int\r\n"
+			L"	{\r\n"
+			L"		var l = {1 2 3};\r\n"
+			L"		var e = new Enumerable^ { override func CreateEnumerator(): Enumerator^ { return l.CreateEnumerator(); } };\r\n"
+			L"		var s = 0;\r\n"
+			L"		for (i in range [1, n]) { s = s + i; }\r\n"
+			L"		return s + (cast int l[0]);\r\n"
+			L"	}\r\n"
+			L"}\r\n";
+	}
+
+	bool IsSameOutput(Ptr<WfCppOutput> a, Ptr<WfCppOutput> b)
+	{
+		if (a->cppFiles.Count() != b->cppFiles.Count()) return false;
+		for (vint i = 0; i < a->cppFiles.Count(); i++)
+		{
+			if (a->cppFiles.Keys()[i] != b->cppFiles.Keys()[i]) return false;
+			if (a->cppFiles.Values()[i] != b->cppFiles.Values()[i]) return false;
+		}
+		return true;
+	}
+
+	void TestParallelGeneration(WfCppMultiFile multiFile)
+	{
+		auto table = WfLoadTable();
+		WfLexicalScopeManager manager(table);
+		for (vint i = 0; i < ModuleCount; i++)
+		{
+			manager.AddModule(MakeModule(i));
+		}
+		manager.Rebuild(true);
+		TEST_ASSERT(manager.errors.Count() == 0);
+
+		auto input = MakePtr<WfCppInput>(L"Demo");
+		input->multiFile = multiFile;
+		input->parallel = false;
+		auto serial = GenerateCppFiles(input, &manager);
+		TEST_ASSERT(serial->cppFiles.Count() > 0);
+		TEST_PRINT(L"Files: " + itow(serial->cppFiles.Count()));
+
+		// scheduling changes between runs, so parallel generation runs several times
+		input->parallel = true;
+		for (vint i = 0; i < 5; i++)
+		{
+			auto parallel = GenerateCppFiles(input, &manager);
+			TEST_ASSERT(IsSameOutput(serial, parallel));
+		}
+	}
+
+	const wchar_t* BindModule =
+		L"module bindtest;\r\n"
+		L"using system::*;\r\n"
+		L"namespace demo\r\n"
+		L"{\r\n"
+		L"	class Counter\r\n"
+		L"	{\r\n"
+		L"		var value : int = 0;\r\n"
+		L"		event ValueChanged();\r\n"
+		L"		func GetValue() : int { return value; }\r\n"
+		L"		func SetValue(v : int) : void { value = v; ValueChanged(); }\r\n"
+		L"		prop Value : int {GetValue, SetValue : ValueChanged}\r\n"
+		L"		new(){}\r\n"
+		L"	}\r\n"
+		L"	func Bind(counter : Counter^) : Subscription^ { return bind(counter.Value + 1); }\r\n"
+		L"}\r\n";
+
+	bool BindCallsScheduler(WfLexicalScopeManager& manager)
+	{
+		manager.Rebuild(true, true);
+		TEST_ASSERT(manager.errors.Count() == 0);
+
+		auto input = MakePtr<WfCppInput>(L"Demo");
+		auto output = GenerateCppFiles(input, &manager);
+		FOREACH(WString, code, output->cppFiles.Values())
+		{
+			if (INVLOC.FindFirst(code, L"SubscriptionScheduler::Schedule", Locale::None).key != -1)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+using namespace cpp_codegen_test;
+
+TEST_CASE(TestCppCodegen_ParallelMultiFile)
+{
+	TestParallelGeneration(WfCppMultiFile::Enabled);
+}
+
+TEST_CASE(TestCppCodegen_ParallelSingleFile)
+{
+	TestParallelGeneration(WfCppMultiFile::Disabled);
+}
+
+TEST_CASE(TestCppCodegen_ScheduleBindings)
+{
+	auto table = WfLoadTable();
+	WfLexicalScopeManager manager(table);
+	manager.AddModule(BindModule);
+	TEST_ASSERT(manager.GetModules().Count() == 1);
+
+	// bind expressions only ask the scheduler when the option is on
+	TEST_ASSERT(!BindCallsScheduler(manager));
+	manager.scheduleBindings = true;
+	TEST_ASSERT(BindCallsScheduler(manager));
+	manager.scheduleBindings = false;
+	TEST_ASSERT(!BindCallsScheduler(manager));
+}
@@ -0,0 +1,131 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+namespace graphics_host_test
+{
+	class TestGraphicsHost : public GuiGraphicsHost
+	{
+	public:
+		// mouse positions are queued like GuiGraphicsHost::MouseMoving, and delivered by Flush like GuiGraphicsHost::GlobalTimer
+		void Move(vint x, vint y)
+		{
+			NativeWindowMouseInfo info;
+			info.ctrl = false;
+			info.shift = false;
+			info.left = false;
+			info.middle = false;
+			info.right = false;
+			info.x = x;
+			info.y = y;
+			info.wheel = 0;
+			info.nonClient = false;
+			mouseMoveInfos.Add(info);
+		}
+
+		void Flush()
+		{
+			FlushMouseMove();
+		}
+
+		GuiGraphicsComposition* FindHovered(Point location, vint& retainedCount)
+		{
+			return FindHoveredComposition(location, retainedCount);
+		}
+	};
+
+	GuiBoundsComposition* AddComposition(GuiGraphicsComposition* parent, Rect bounds, const WString& name, WString& log)
+	{
+		auto composition = new GuiBoundsComposition;
+		composition->SetBounds(bounds);
+		parent->AddChild(composition);
+		composition->GetEventReceiver()->mouseEnter.AttachLambda([&log, name](GuiGraphicsComposition* sender, GuiEventArgs& arguments)
+		{
+			log += L"+" + name;
+		});
+		composition->GetEventReceiver()->mouseLeave.AttachLambda([&log, name](GuiGraphicsComposition* sender, GuiEventArgs& arguments)
+		{
+			log += L"-" + name;
+		});
+		return composition;
+	}
+
+	// Move the mouse to a position, and check the hovered composition, how many hovered compositions are kept, and mouseEnter and mouseLeave events
+	bool MoveTo(TestGraphicsHost& host, vint x, vint y, vint expectedRetainedCount, const WString& expectedLog, WString& log)
+	{
+		auto expected = host.GetMainComposition()->FindComposition(Point(x, y));
+		vint retainedCount = -1;
+		bool same = host.FindHovered(Point(x, y), retainedCount) == expected;
+		same &= retainedCount == expectedRetainedCount;
+
+		log = L"";
+		host.Move(x, y);
+		host.Flush();
+		same &= host.GetHoveredComposition() == expected;
+		same &= log == expectedLog;
+		return same;
+	}
+}
+using namespace graphics_host_test;
+
+TEST_CASE(TestGraphicsHost_HoverRetention)
+{
+	auto windowService = GetCurrentController()->WindowService();
+	auto window = windowService->CreateNativeWindow();
+	window->SetClientSize(Size(400, 200));
+	TEST_ASSERT(window->GetClientSize() == Size(400, 200));
+
+	WString log, moves;
+	{
+		TestGraphicsHost host;
+		host.SetNativeWindow(window);
+		auto root = host.GetMainComposition();
+
+		// a2 is added after a1, so it covers a1 where they overlap
+		auto a = AddComposition(root, Rect(0, 0, 200, 200), L"A", log);
+		auto a1 = AddComposition(a, Rect(10, 10, 100, 100), L"A1", log);
+		auto a1a = AddComposition(a1, Rect(20, 20, 50, 50), L"A1a", log);
+		auto a2 = AddComposition(a, Rect(50, 50, 150, 150), L"A2", log);
+		auto b = AddComposition(root, Rect(200, 0, 400, 200), L"B", log);
+
+		// only a1a receives every mouse position
+		a1a->GetEventReceiver()->rawMouseMove.AttachLambda([&](GuiGraphicsComposition* sender, GuiMouseEventArgs& arguments)
+		{
+			moves += L"raw(" + itow(arguments.x) + L"," + itow(arguments.y) + L")";
+		});
+		a1a->GetEventReceiver()->mouseMove.AttachLambda([&](GuiGraphicsComposition* sender, GuiMouseEventArgs& arguments)
+		{
+			moves += L"move(" + itow(arguments.x) + L"," + itow(arguments.y) + L")";
+		});
+		a->GetEventReceiver()->rawMouseMove.AttachLambda([&](GuiGraphicsComposition* sender, GuiMouseEventArgs& arguments)
+		{
+			moves += L"A";
+		});
+
+		bool same = true;
+		same &= MoveTo(host, 35, 35, 0, L"+A+A1+A1a", log);
+
+		// positions in the same frame are merged into one mouseMove
+		moves = L"";
+		host.Move(40, 40);
+		same &= MoveTo(host, 45, 45, 4, L"", log);
+		same &= moves == L"raw(10,10)Araw(15,15)Amove(15,15)";
+
+		// a1 is covered by a2, and becomes hovered again when it is not covered
+		same &= MoveTo(host, 70, 70, 2, L"-A1a-A1+A2", log);
+		same &= MoveTo(host, 20, 20, 2, L"-A2+A1", log);
+		same &= MoveTo(host, 300, 100, 1, L"-A1-A+B", log);
+
+		// a hidden composition is not kept
+		b->SetVisible(false);
+		same &= MoveTo(host, 300, 101, 1, L"-B", log);
+		same &= host.GetHoveredComposition() == root;
+		TEST_ASSERT(same);
+
+		host.SetNativeWindow(nullptr);
+	}
+	windowService->DestroyNativeWindow(window);
+}
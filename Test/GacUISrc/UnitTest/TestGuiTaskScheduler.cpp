@@ -0,0 +1,185 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+
+namespace gui_task_scheduler_test
+{
+/***********************************************************************
+Stand-in Controller
+
+Only the async service is implemented. Functions sent to the main thread are kept until the test runs them,
+which is what the native message loop does between messages.
+***********************************************************************/
+
+	class FakeAsyncService : public Object, public INativeAsyncService
+	{
+	public:
+		List<Func<void()>>			posted;
+
+		bool IsInMainThread()override
+		{
+			return true;
+		}
+
+		void InvokeAsync(const Func<void()>& proc)override
+		{
+			proc();
+		}
+
+		void InvokeInMainThread(const Func<void()>& proc)override
+		{
+			posted.Add(proc);
+		}
+
+		bool InvokeInMainThreadAndWait(const Func<void()>& proc, vint milliseconds)override
+		{
+			proc();
+			return true;
+		}
+
+		Ptr<INativeDelay> DelayExecute(const Func<void()>& proc, vint milliseconds)override
+		{
+			return nullptr;
+		}
+
+		Ptr<INativeDelay> DelayExecuteInMainThread(const Func<void()>& proc, vint milliseconds)override
+		{
+			return nullptr;
+		}
+
+		vint RunPosted()
+		{
+			List<Func<void()>> procs;
+			CopyFrom(procs, posted);
+			posted.Clear();
+			FOREACH(Func<void()>, proc, procs)
+			{
+				proc();
+			}
+			return procs.Count();
+		}
+	};
+
+	class FakeController : public Object, public INativeController
+	{
+	public:
+		FakeAsyncService			asyncService;
+
+		INativeCallbackService*		CallbackService()override	{ return nullptr; }
+		INativeResourceService*		ResourceService()override	{ return nullptr; }
+		INativeAsyncService*		AsyncService()override		{ return &asyncService; }
+		INativeClipboardService*	ClipboardService()override	{ return nullptr; }
+		INativeImageService*		ImageService()override		{ return nullptr; }
+		INativeScreenService*		ScreenService()override		{ return nullptr; }
+		INativeWindowService*		WindowService()override		{ return nullptr; }
+		INativeInputService*		InputService()override		{ return nullptr; }
+		INativeDialogService*		DialogService()override		{ return nullptr; }
+		WString						GetOSVersion()override		{ return L""; }
+		WString						GetExecutablePath()override	{ return L""; }
+	};
+
+	void SpinFor(vint64_t microseconds)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		while (GuiStartupTrace::GetMicroseconds() - start < microseconds);
+	}
+}
+using namespace gui_task_scheduler_test;
+
+TEST_CASE(TestGuiTaskScheduler_PriorityOrder)
+{
+	FakeController controller;
+	GuiTaskScheduler scheduler(&controller);
+	List<vint> order;
+
+	scheduler.Invoke([&]() { order.Add(3); }, GuiTaskScheduler::Idle);
+	scheduler.Invoke([&]() { order.Add(2); }, GuiTaskScheduler::Normal);
+	scheduler.Invoke([&]() { order.Add(1); }, GuiTaskScheduler::Render);
+	scheduler.Invoke([&]() { order.Add(0); }, GuiTaskScheduler::Input);
+	scheduler.Invoke([&]() { order.Add(2); }, GuiTaskScheduler::Normal);
+
+	// all tasks share one wake-up
+	TEST_ASSERT(controller.asyncService.posted.Count() == 1);
+	TEST_ASSERT(scheduler.GetTotalQueueDepth() == 5);
+	TEST_ASSERT(controller.asyncService.RunPosted() == 1);
+
+	TEST_ASSERT(order.Count() == 5);
+	TEST_ASSERT(order[0] == 0);
+	TEST_ASSERT(order[1] == 1);
+	TEST_ASSERT(order[2] == 2);
+	TEST_ASSERT(order[3] == 2);
+	TEST_ASSERT(order[4] == 3);
+	TEST_ASSERT(scheduler.GetTotalQueueDepth() == 0);
+	TEST_ASSERT(controller.asyncService.posted.Count() == 0);
+}
+
+TEST_CASE(TestGuiTaskScheduler_BudgetRequestsNextFrame)
+{
+	FakeController controller;
+	GuiTaskScheduler scheduler(&controller);
+	scheduler.SetFrameBudget(1);
+
+	vint executed = 0;
+	for (vint i = 0; i < 4; i++)
+	{
+		scheduler.Invoke([&]() { SpinFor(2000); executed++; }, GuiTaskScheduler::Normal);
+	}
+
+	// every frame runs one task and then requests another frame without waiting for the global timer
+	TEST_ASSERT(controller.asyncService.RunPosted() == 1);
+	TEST_ASSERT(executed == 1);
+	TEST_ASSERT(scheduler.GetDeferredFrameCount() == 1);
+	TEST_ASSERT(controller.asyncService.posted.Count() == 1);
+
+	vint frames = 1;
+	while (controller.asyncService.RunPosted() > 0)
+	{
+		frames++;
+	}
+	TEST_ASSERT(executed == 4);
+	TEST_ASSERT(frames == 4);
+	TEST_ASSERT(scheduler.GetTotalQueueDepth() == 0);
+}
+
+TEST_CASE(TestGuiTaskScheduler_InputIsBoundedPerFrame)
+{
+	FakeController controller;
+	GuiTaskScheduler scheduler(&controller);
+	scheduler.SetFrameBudget(0);
+
+	// an input task that keeps queuing itself must not keep one frame running forever
+	vint executed = 0;
+	Func<void()> repeat;
+	repeat = [&]()
+	{
+		executed++;
+		if (executed < 100)
+		{
+			scheduler.Invoke(repeat, GuiTaskScheduler::Input);
+		}
+	};
+	scheduler.Invoke(repeat, GuiTaskScheduler::Input);
+	scheduler.Invoke(repeat, GuiTaskScheduler::Input);
+
+	TEST_ASSERT(scheduler.RunFrame() == 2);
+	TEST_ASSERT(scheduler.GetQueueDepth(GuiTaskScheduler::Input) == 2);
+
+	while (controller.asyncService.RunPosted() > 0);
+	TEST_ASSERT(executed >= 100);
+	TEST_ASSERT(scheduler.GetTotalQueueDepth() == 0);
+}
+
+TEST_CASE(TestGuiTaskScheduler_DestroyedBeforeWake)
+{
+	FakeController controller;
+	vint executed = 0;
+	{
+		GuiTaskScheduler scheduler(&controller);
+		scheduler.Invoke([&]() { executed++; });
+	}
+	TEST_ASSERT(controller.asyncService.RunPosted() == 1);
+	TEST_ASSERT(executed == 0);
+}
@@ -0,0 +1,254 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::parsing;
+using namespace vl::parsing::json;
+using namespace vl::presentation;
+
+namespace json_parser_test
+{
+	const vint Rounds = 5;
+
+	// Compare values and code ranges of all nodes
+	bool SameNode(Ptr<JsonNode> a, Ptr<JsonNode> b)
+	{
+		if (!a || !b) return !a && !b;
+		if (a->codeRange != b->codeRange) return false;
+
+		if (auto objectA = a.Cast<JsonObject>())
+		{
+			auto objectB = b.Cast<JsonObject>();
+			if (!objectB || objectA->fields.Count() != objectB->fields.Count()) return false;
+			for (vint i = 0; i < objectA->fields.Count(); i++)
+			{
+				auto fieldA = objectA->fields[i];
+				auto fieldB = objectB->fields[i];
+				if (fieldA->codeRange != fieldB->codeRange) return false;
+				if (fieldA->name.value != fieldB->name.value || fieldA->name.codeRange != fieldB->name.codeRange) return false;
+				if (!SameNode(fieldA->value, fieldB->value)) return false;
+			}
+			return true;
+		}
+		else if (auto arrayA = a.Cast<JsonArray>())
+		{
+			auto arrayB = b.Cast<JsonArray>();
+			if (!arrayB || arrayA->items.Count() != arrayB->items.Count()) return false;
+			for (vint i = 0; i < arrayA->items.Count(); i++)
+			{
+				if (!SameNode(arrayA->items[i], arrayB->items[i])) return false;
+			}
+			return true;
+		}
+		else if (auto stringA = a.Cast<JsonString>())
+		{
+			auto stringB = b.Cast<JsonString>();
+			return stringB && stringA->content.value == stringB->content.value && stringA->content.codeRange == stringB->content.codeRange;
+		}
+		else if (auto numberA = a.Cast<JsonNumber>())
+		{
+			auto numberB = b.Cast<JsonNumber>();
+			return numberB && numberA->content.value == numberB->content.value && numberA->content.codeRange == numberB->content.codeRange;
+		}
+		else if (auto literalA = a.Cast<JsonLiteral>())
+		{
+			auto literalB = b.Cast<JsonLiteral>();
+			return literalB && literalA->value == literalB->value;
+		}
+		return false;
+	}
+
+	// A grid with the given number of rows
+	WString GenerateGrid(vint rows)
+	{
+		WString json = L"{\r\n  \"columns\": [\"id\", \"name\", \"price\", \"tags\", \"enabled\"],\r\n  \"rows\": [\r\n";
+		for (vint i = 0; i < rows; i++)
+		{
+			json += (i == 0 ? L"    " : L",\r\n    ");
+			json += L"{\"id\": " + itow(i)
+				+ L", \"name\": \"Item \\\"" + itow(i) + L"\\\"\\n\\u0041\""
+				+ L", \"price\": " + itow(i % 1000) + L"." + itow(i % 97) + L"e-" + itow(i % 3)
+				+ L", \"tags\": [\"a\", \"b\", -" + itow(i % 13) + L"]"
+				+ L", \"enabled\": " + (i % 3 == 0 ? L"true" : i % 3 == 1 ? L"false" : L"null")
+				+ L"}";
+		}
+		json += L"\r\n  ]\r\n}\r\n";
+		return json;
+	}
+
+	WString Nest(vint levels)
+	{
+		WString open, close;
+		for (vint i = 0; i < levels; i++)
+		{
+			open += i % 2 == 0 ? L"[" : L"{\"a\":";
+		}
+		for (vint i = levels - 1; i >= 0; i--)
+		{
+			close += i % 2 == 0 ? L"]" : L"}";
+		}
+		return open + (levels % 2 == 0 ? L"1" : L"") + close;
+	}
+
+	class CountingCallback : public Object, public virtual IJsonReaderCallback
+	{
+	public:
+		vint							objects = 0;
+		vint							arrays = 0;
+		vint							fields = 0;
+		vint							strings = 0;
+		vint							literals = 0;
+		double							sum = 0;
+
+		void OnBeginObject(const ParsingTextRange& range)override { objects++; }
+		void OnEndObject(const ParsingTextRange& range)override {}
+		void OnField(const wchar_t* name, vint length, const ParsingTextRange& range)override { fields++; }
+		void OnBeginArray(const ParsingTextRange& range)override { arrays++; }
+		void OnEndArray(const ParsingTextRange& range)override {}
+		void OnString(const wchar_t* value, vint length, const ParsingTextRange& range)override { strings++; }
+		void OnNumber(const wchar_t* text, vint length, const ParsingTextRange& range)override { sum += JsonParseNumber(text, length); }
+		void OnLiteral(JsonLiteral::JsonValue value, const ParsingTextRange& range)override { literals++; }
+	};
+
+	// Average time to run a parser in milliseconds
+	vint64_t Measure(const Func<void()>& parser)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < Rounds; i++)
+		{
+			parser();
+		}
+		return (GuiStartupTrace::GetMicroseconds() - start) / Rounds / 1000;
+	}
+}
+using namespace json_parser_test;
+
+TEST_CASE(TestJsonParser_SameNodes)
+{
+	auto table = JsonLoadTable();
+	List<WString> inputs;
+	inputs.Add(GenerateGrid(100));
+	inputs.Add(L"[]");
+	inputs.Add(L"{}");
+	inputs.Add(L" [ 0, -0, 1.5, -2.25e+3, 3E-2, 100e10, \"\", \"\\\\\\/\\b\\f\\n\\r\\t\" ] ");
+	inputs.Add(L"{\"a\":{\"b\":[[],[{}],[true,false,null]]},\r\n\"multi\r\nline\":\"x\"}");
+
+	bool same = true;
+	FOREACH(WString, input, inputs)
+	{
+		List<Ptr<ParsingError>> errors;
+		auto expected = JsonParse(input, table);
+		auto actual = JsonParse(input, errors);
+		same &= errors.Count() == 0;
+		same &= SameNode(expected, actual);
+		same &= JsonToString(expected) == JsonToString(actual);
+	}
+	TEST_ASSERT(same);
+}
+
+TEST_CASE(TestJsonParser_Errors)
+{
+	auto table = JsonLoadTable();
+	List<WString> inputs;
+	inputs.Add(L"");
+	inputs.Add(L"1");
+	inputs.Add(L"[1,]");
+	inputs.Add(L"[1 2]");
+	inputs.Add(L"{\"a\"}");
+	inputs.Add(L"{a:1}");
+	inputs.Add(L"[\"unclosed]");
+	inputs.Add(L"[tru]");
+	inputs.Add(L"[1] [2]");
+	inputs.Add(L"[[1]");
+
+	bool rejected = true;
+	FOREACH(WString, input, inputs)
+	{
+		List<Ptr<ParsingError>> tableErrors, errors;
+		auto expected = JsonParse(input, table, tableErrors);
+		auto actual = JsonParse(input, errors);
+		rejected &= !expected && tableErrors.Count() > 0;
+		rejected &= !actual && errors.Count() > 0;
+	}
+	TEST_ASSERT(rejected);
+}
+
+TEST_CASE(TestJsonParser_NestingLimit)
+{
+	{
+		List<Ptr<ParsingError>> errors;
+		TEST_ASSERT(JsonParse(Nest(JsonMaxNestingLevel), errors));
+		TEST_ASSERT(errors.Count() == 0);
+	}
+	{
+		List<Ptr<ParsingError>> errors;
+		TEST_ASSERT(!JsonParse(Nest(JsonMaxNestingLevel + 1), errors));
+		TEST_ASSERT(errors.Count() == 1);
+	}
+
+	// a deeply nested input is rejected instead of overflowing the stack
+	WString deep;
+	for (vint i = 0; i < 100000; i++)
+	{
+		deep += L"[";
+	}
+	{
+		List<Ptr<ParsingError>> errors;
+		TEST_ASSERT(!JsonParse(deep, errors));
+		TEST_ASSERT(errors.Count() == 1);
+	}
+	{
+		List<Ptr<ParsingError>> errors;
+		CountingCallback callback;
+		TEST_ASSERT(!JsonRead(deep, callback, errors));
+		TEST_ASSERT(errors.Count() == 1);
+		TEST_ASSERT(callback.arrays == JsonMaxNestingLevel);
+	}
+}
+
+TEST_CASE(TestJsonParser_Events)
+{
+	List<Ptr<ParsingError>> errors;
+	CountingCallback callback;
+	TEST_ASSERT(JsonRead(L"{\"a\":[1, 2.5, \"x\", true, null], \"b\":{\"c\":-4e1}}", callback, errors));
+	TEST_ASSERT(errors.Count() == 0);
+	TEST_ASSERT(callback.objects == 2);
+	TEST_ASSERT(callback.arrays == 1);
+	TEST_ASSERT(callback.fields == 3);
+	TEST_ASSERT(callback.strings == 1);
+	TEST_ASSERT(callback.literals == 2);
+	TEST_ASSERT(callback.sum == -36.5);
+}
+
+TEST_CASE(TestJsonParser_Benchmark)
+{
+	auto input = GenerateGrid(20000);
+	auto table = JsonLoadTable();
+	Ptr<JsonNode> node;
+
+	auto tableTime = Measure([&]()
+	{
+		node = JsonParse(input, table);
+	});
+	auto parseTime = Measure([&]()
+	{
+		List<Ptr<ParsingError>> errors;
+		node = JsonParse(input, errors);
+	});
+	auto readTime = Measure([&]()
+	{
+		List<Ptr<ParsingError>> errors;
+		CountingCallback callback;
+		JsonRead(input, callback, errors);
+	});
+	auto printTime = Measure([&]()
+	{
+		JsonToString(node);
+	});
+
+	TEST_PRINT(L"Parse a JSON grid of " + itow(input.Length()) + L" characters, average of " + itow(Rounds) + L" rounds:");
+	TEST_PRINT(L"    JsonParse with the parsing table: " + i64tow(tableTime) + L" ms");
+	TEST_PRINT(L"    JsonParse without the parsing table: " + i64tow(parseTime) + L" ms");
+	TEST_PRINT(L"    JsonRead: " + i64tow(readTime) + L" ms");
+	TEST_PRINT(L"    JsonToString: " + i64tow(printTime) + L" ms");
+}
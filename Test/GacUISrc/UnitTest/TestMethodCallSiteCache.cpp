@@ -0,0 +1,166 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Reflection/TypeDescriptors/GuiReflectionCompositions.h"
+#include "../../../Source/Reflection/TypeDescriptors/GuiReflectionControls.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+using namespace vl::presentation::controls;
+
+namespace method_call_site_cache_test
+{
+	const vint Calls = 1000000;
+
+	IMethodInfo* GetMethod(ITypeDescriptor* td, const WString& name)
+	{
+		return td->GetMethodGroupByName(name, false)->GetMethod(0);
+	}
+
+	template<typename TException>
+	bool Throws(const Func<void()>& proc)
+	{
+		try
+		{
+			proc();
+		}
+		catch (const TException&)
+		{
+			return true;
+		}
+		return false;
+	}
+
+	// Average time of a call in nanoseconds
+	double MeasureCalls(vint calls, const Func<void(vint)>& call)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < calls; i++)
+		{
+			call(i);
+		}
+		return (double)(GuiStartupTrace::GetMicroseconds() - start) * 1000 / calls;
+	}
+}
+using namespace method_call_site_cache_test;
+
+TEST_CASE(TestMethodCallSiteCache_OverloadResolution)
+{
+	auto composition = new GuiBoundsComposition;
+	auto showPopup = GetTypeDescriptor<GuiPopup>()->GetMethodGroupByName(L"ShowPopup", false);
+	TEST_ASSERT(showPopup && showPopup->GetMethodCount() == 3);
+
+	// more argument types than MaxEntryCount, so that entries are replaced
+	List<Ptr<Array<Value>>> argumentLists;
+	auto add = [&](const Value& a, const Value& b)
+	{
+		auto arguments = MakePtr<Array<Value>>(2);
+		arguments->Set(0, a);
+		arguments->Set(1, b);
+		argumentLists.Add(arguments);
+	};
+	add(BoxValue<Point>(Point(1, 2)), Value());
+	add(Value(), BoxValue<Point>(Point(1, 2)));
+	add(Value(), BoxValue<bool>(true));
+	add(Value::From(composition), BoxValue<Point>(Point(1, 2)));
+	add(BoxValue<Point>(Point(1, 2)), Value::From(composition));
+	TEST_ASSERT(argumentLists.Count() > MethodCallSiteCache::MaxEntryCount);
+
+	MethodCallSiteCache cache;
+	bool sameAsUncached = true;
+	SortedList<IMethodInfo*> selectedMethods;
+	for (vint round = 0; round < 3; round++)
+	{
+		FOREACH(Ptr<Array<Value>>, arguments, argumentLists)
+		{
+			auto expected = Value::SelectMethod(showPopup, *arguments.Obj());
+			sameAsUncached &= cache.SelectMethod(showPopup, *arguments.Obj()) == expected;
+			sameAsUncached &= cache.SelectMethod(showPopup, *arguments.Obj()) == expected;
+			if (!selectedMethods.Contains(expected))
+			{
+				selectedMethods.Add(expected);
+			}
+		}
+	}
+	TEST_ASSERT(sameAsUncached);
+	TEST_ASSERT(selectedMethods.Count() > 1);
+
+	argumentLists.Clear();
+	SafeDeleteComposition(composition);
+}
+
+TEST_CASE(TestMethodCallSiteCache_Invalidation)
+{
+	auto bounds = new GuiBoundsComposition;
+	auto table = new GuiTableComposition;
+	auto sideAligned = new GuiSideAlignedComposition;
+	auto setAlignment = GetMethod(GetTypeDescriptor<GuiBoundsComposition>(), L"SetAlignmentToParent");
+
+	MethodCallSiteCache cache;
+	Array<Value> arguments(1);
+	arguments[0] = BoxValue<Margin>(Margin(1, 2, 3, 4));
+	cache.Invoke(setAlignment, Value::From(bounds), arguments);
+	arguments[0] = BoxValue<Margin>(Margin(5, 6, 7, 8));
+	cache.Invoke(setAlignment, Value::From(bounds), arguments);
+	TEST_ASSERT(bounds->GetAlignmentToParent() == Margin(5, 6, 7, 8));
+
+	// a this object of a derived type is checked and accepted
+	cache.Invoke(setAlignment, Value::From(table), arguments);
+	TEST_ASSERT(table->GetAlignmentToParent() == Margin(5, 6, 7, 8));
+
+	// when types are changed, checks are not skipped
+	TEST_ASSERT(Throws<ArgumentTypeMismtatchException>([&]() { cache.Invoke(setAlignment, Value::From(sideAligned), arguments); }));
+	TEST_ASSERT(Throws<ArgumentNullException>([&]() { cache.Invoke(setAlignment, Value(), arguments); }));
+	arguments[0] = Value();
+	TEST_ASSERT(Throws<TypeDescriptorException>([&]() { cache.Invoke(setAlignment, Value::From(bounds), arguments); }));
+	Array<Value> noArguments;
+	TEST_ASSERT(Throws<TypeDescriptorException>([&]() { cache.Invoke(setAlignment, Value::From(bounds), noArguments); }));
+
+	// failed calls are not remembered
+	arguments[0] = BoxValue<Margin>(Margin(9, 9, 9, 9));
+	TEST_ASSERT(Throws<ArgumentTypeMismtatchException>([&]() { cache.Invoke(setAlignment, Value::From(sideAligned), arguments); }));
+	cache.Invoke(setAlignment, Value::From(bounds), arguments);
+	TEST_ASSERT(bounds->GetAlignmentToParent() == Margin(9, 9, 9, 9));
+
+	SafeDeleteComposition(bounds);
+	SafeDeleteComposition(table);
+	SafeDeleteComposition(sideAligned);
+}
+
+TEST_CASE(TestMethodCallSiteCache_Benchmark)
+{
+	auto composition = new GuiBoundsComposition;
+	Value thisObject = Value::From(composition);
+	auto setAlignment = GetMethod(GetTypeDescriptor<GuiBoundsComposition>(), L"SetAlignmentToParent");
+	auto getAlignment = GetMethod(GetTypeDescriptor<GuiBoundsComposition>(), L"GetAlignmentToParent");
+
+	MethodCallSiteCache setCache, getCache;
+	Array<Value> arguments(1), noArguments;
+	arguments[0] = BoxValue<Margin>(Margin(1, 2, 3, 4));
+
+	auto uncachedSet = MeasureCalls(Calls, [&](vint) { setAlignment->Invoke(thisObject, arguments); });
+	auto cachedSet = MeasureCalls(Calls, [&](vint) { setCache.Invoke(setAlignment, thisObject, arguments); });
+	auto uncachedGet = MeasureCalls(Calls, [&](vint) { getAlignment->Invoke(thisObject, noArguments); });
+	auto cachedGet = MeasureCalls(Calls, [&](vint) { getCache.Invoke(getAlignment, thisObject, noArguments); });
+
+	auto showPopup = GetTypeDescriptor<GuiPopup>()->GetMethodGroupByName(L"ShowPopup", false);
+	Array<Value> popupArguments(2);
+	popupArguments[0] = Value();
+	popupArguments[1] = BoxValue<Point>(Point(1, 2));
+	MethodCallSiteCache selectCache;
+	// Value::SelectMethod catches an exception for each rejected overload, so it runs fewer times
+	const vint Selections = Calls / 100;
+	auto uncachedSelect = MeasureCalls(Selections, [&](vint) { Value::SelectMethod(showPopup, popupArguments); });
+	auto cachedSelect = MeasureCalls(Selections, [&](vint) { selectCache.SelectMethod(showPopup, popupArguments); });
+
+	TEST_PRINT(L"Method calls through reflection, nanoseconds per call:");
+	TEST_PRINT(L"    SetAlignmentToParent: " + ftow(uncachedSet) + L" IMethodInfo::Invoke, " + ftow(cachedSet) + L" MethodCallSiteCache::Invoke");
+	TEST_PRINT(L"    GetAlignmentToParent: " + ftow(uncachedGet) + L" IMethodInfo::Invoke, " + ftow(cachedGet) + L" MethodCallSiteCache::Invoke");
+	TEST_PRINT(L"    ShowPopup overloads: " + ftow(uncachedSelect) + L" Value::SelectMethod, " + ftow(cachedSelect) + L" MethodCallSiteCache::SelectMethod");
+	TEST_ASSERT(composition->GetAlignmentToParent() == Margin(1, 2, 3, 4));
+
+	thisObject = Value();
+	SafeDeleteComposition(composition);
+}
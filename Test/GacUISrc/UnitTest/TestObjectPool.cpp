@@ -0,0 +1,186 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+using namespace vl::presentation::controls;
+
+namespace object_pool_test
+{
+	const vint Rounds = 10000;
+
+	// The pool is shared by the whole process, every test restores its state
+	class PoolScope : public Object
+	{
+	protected:
+		bool						enabled;
+	public:
+		PoolScope(bool value)
+			:enabled(GuiObjectPool::GetEnabled())
+		{
+			GuiObjectPool::SetEnabled(value);
+		}
+
+		~PoolScope()
+		{
+			GuiObjectPool::SetEnabled(enabled);
+			GuiObjectPool::Trim();
+		}
+	};
+
+	// Create and delete what a small dialog contains: a table of labels and buttons with event handlers
+	void OpenAndClose()
+	{
+		auto root = new GuiBoundsComposition;
+		auto table = new GuiTableComposition;
+		table->SetRowsAndColumns(4, 2);
+		root->AddChild(table);
+		for (vint row = 0; row < 4; row++)
+		{
+			for (vint column = 0; column < 2; column++)
+			{
+				auto cell = new GuiCellComposition;
+				table->AddChild(cell);
+				cell->SetSite(row, column, 1, 1);
+
+				auto content = new GuiBoundsComposition;
+				content->SetAlignmentToParent(Margin(2, 2, 2, 2));
+				content->GetEventReceiver()->leftButtonDown.AttachLambda([](GuiGraphicsComposition*, GuiMouseEventArgs&) {});
+				content->GetEventReceiver()->mouseEnter.AttachLambda([](GuiGraphicsComposition*, GuiEventArgs&) {});
+				cell->AddChild(content);
+
+				if (column == 1)
+				{
+					auto button = new GuiButton(theme::GetCurrentTheme()->CreateButtonStyle());
+					button->Clicked.AttachLambda([](GuiGraphicsComposition*, GuiEventArgs&) {});
+					content->AddChild(button->GetBoundsComposition());
+				}
+			}
+		}
+		SafeDeleteComposition(root);
+	}
+
+	// Time to open and close all rounds in milliseconds
+	vint64_t MeasureOpenAndClose()
+	{
+		OpenAndClose();
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < Rounds; i++)
+		{
+			OpenAndClose();
+		}
+		return (GuiStartupTrace::GetMicroseconds() - start) / 1000;
+	}
+}
+using namespace object_pool_test;
+
+TEST_CASE(TestObjectPool_AllocateAndFree)
+{
+	PoolScope scope(true);
+	vint slabCount = GuiObjectPool::GetSlabCount();
+	vint liveObjectCount = GuiObjectPool::GetLiveObjectCount();
+
+	// blocks larger than 1KB are allocated from the heap
+	List<char*> blocks;
+	List<vint> sizes;
+	vint pooledCount = 0;
+	bool aligned = true;
+	for (vint size = 1; size <= 1200; size += 7)
+	{
+		for (vint i = 0; i < 20; i++)
+		{
+			auto block = (char*)GuiObjectPool::Allocate(size);
+			if (size <= 1024)
+			{
+				aligned &= (size_t)block % 16 == 0;
+				pooledCount++;
+			}
+			memset(block, (int)(blocks.Count() % 251), size);
+			blocks.Add(block);
+			sizes.Add(size);
+		}
+	}
+	TEST_ASSERT(aligned);
+	TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() == liveObjectCount + pooledCount);
+	TEST_ASSERT(GuiObjectPool::GetSlabCount() > slabCount);
+
+	// blocks do not overlap
+	bool untouched = true;
+	for (vint i = 0; i < blocks.Count(); i++)
+	{
+		for (vint j = 0; j < sizes[i]; j++)
+		{
+			untouched &= blocks[i][j] == (char)(i % 251);
+		}
+	}
+	TEST_ASSERT(untouched);
+
+	// free blocks in a different order, and freed blocks are reused
+	for (vint i = 0; i < blocks.Count(); i += 2)
+	{
+		GuiObjectPool::Free(blocks[i]);
+	}
+	auto reused = GuiObjectPool::Allocate(sizes[0]);
+	TEST_ASSERT(blocks.Contains((char*)reused));
+	GuiObjectPool::Free(reused);
+	for (vint i = 1; i < blocks.Count(); i += 2)
+	{
+		GuiObjectPool::Free(blocks[i]);
+	}
+	TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() == liveObjectCount);
+
+	// empty slabs are returned to the heap except one spare slab for each size
+	GuiObjectPool::Trim();
+	TEST_ASSERT(GuiObjectPool::GetSlabCount() <= slabCount);
+}
+
+TEST_CASE(TestObjectPool_EnableDisable)
+{
+	PoolScope scope(false);
+	vint liveObjectCount = GuiObjectPool::GetLiveObjectCount();
+	auto heapComposition = new GuiBoundsComposition;
+	TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() == liveObjectCount);
+
+	GuiObjectPool::SetEnabled(true);
+	auto pooledComposition = new GuiBoundsComposition;
+	TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() > liveObjectCount);
+
+	// objects are deleted correctly whether the pool is enabled or not
+	GuiObjectPool::SetEnabled(false);
+	SafeDeleteComposition(heapComposition);
+	SafeDeleteComposition(pooledComposition);
+	TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() == liveObjectCount);
+
+	// placement new is not hidden by the pool
+	GuiObjectPool::SetEnabled(true);
+	auto memory = GuiObjectPool::Allocate(sizeof(GuiBoundsComposition));
+	auto placedComposition = new(memory) GuiBoundsComposition;
+	placedComposition->SetAlignmentToParent(Margin(1, 2, 3, 4));
+	TEST_ASSERT(placedComposition->GetAlignmentToParent() == Margin(1, 2, 3, 4));
+	placedComposition->~GuiBoundsComposition();
+	GuiObjectPool::Free(memory);
+	TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() == liveObjectCount);
+}
+
+TEST_CASE(TestObjectPool_Benchmark)
+{
+	vint64_t heapTime = 0;
+	vint64_t poolTime = 0;
+	vint slabCount = 0;
+	{
+		PoolScope scope(false);
+		heapTime = MeasureOpenAndClose();
+	}
+	{
+		PoolScope scope(true);
+		vint liveObjectCount = GuiObjectPool::GetLiveObjectCount();
+		poolTime = MeasureOpenAndClose();
+		slabCount = GuiObjectPool::GetSlabCount();
+		TEST_ASSERT(GuiObjectPool::GetLiveObjectCount() == liveObjectCount);
+	}
+
+	TEST_PRINT(L"Open and close a dialog " + itow(Rounds) + L" times:");
+	TEST_PRINT(L"    Heap: " + i64tow(heapTime) + L" ms");
+	TEST_PRINT(L"    Pool: " + i64tow(poolTime) + L" ms, " + itow(slabCount) + L" slabs left before trimming");
+}
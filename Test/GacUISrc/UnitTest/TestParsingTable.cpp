@@ -0,0 +1,84 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Compiler/GuiInstanceLoader.h"
+#include "../../../Source/Resources/GuiParserManager.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::parsing::tabling;
+using namespace vl::parsing::xml;
+using namespace vl::parsing::json;
+using namespace vl::workflow;
+using namespace vl::presentation;
+
+namespace parsing_table_test
+{
+	const vint Rounds = 10;
+
+	typedef Func<Ptr<ParsingTable>()>			TableLoader;
+
+	// Average time to load a table in microseconds
+	vint64_t MeasureLoader(const TableLoader& loader)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < Rounds; i++)
+		{
+			loader();
+		}
+		return (GuiStartupTrace::GetMicroseconds() - start) / Rounds;
+	}
+
+	void MeasureTable(const WString& name, const TableLoader& loader)
+	{
+		MemoryStream predecoded;
+		loader()->Serialize(predecoded);
+		void* buffer = predecoded.GetInternalBuffer();
+		vint size = (vint)predecoded.Size();
+
+		vint64_t generated = MeasureLoader(loader);
+		vint64_t direct = MeasureLoader([=]()
+		{
+			// the same as the loader created by SetPredecodedParsingTable
+			MemoryWrapperStream stream(buffer, size);
+			Ptr<ParsingTable> table = new ParsingTable(stream);
+			table->Initialize();
+			return table;
+		});
+
+		TEST_PRINT(L"    " + name + L": " + i64tow(generated) + L" us generated loader, " + i64tow(direct) + L" us pre-decoded (" + itow(size) + L" bytes)");
+	}
+}
+using namespace parsing_table_test;
+
+TEST_CASE(TestParsingTable_LoadTime)
+{
+	TEST_PRINT(L"Parsing table load time, average of " + itow(Rounds) + L" rounds:");
+	MeasureTable(L"XML", &XmlLoadTable);
+	MeasureTable(L"JSON", &JsonLoadTable);
+	MeasureTable(L"WORKFLOW", &WfLoadTable);
+	MeasureTable(L"INSTANCE-QUERY", &GuiIqLoadTable);
+}
+
+TEST_CASE(TestParsingTable_Predecoded)
+{
+	auto manager = GetParserManager();
+	MemoryStream predecoded;
+	TEST_ASSERT(manager->SavePredecodedParsingTable(L"XML", predecoded));
+	TEST_ASSERT(!manager->SavePredecodedParsingTable(L"UnitTest-NotExists", predecoded));
+
+	auto buffer = predecoded.GetInternalBuffer();
+	auto size = (vint)predecoded.Size();
+	TEST_ASSERT(manager->SetPredecodedParsingTable(L"UnitTest-XML", buffer, size));
+	auto table = manager->GetParsingTable(L"UnitTest-XML");
+	TEST_ASSERT(table);
+	TEST_ASSERT(manager->GetParsingTable(L"UnitTest-XML") == table);
+
+	// a table cannot be replaced after it is loaded
+	TEST_ASSERT(!manager->SetPredecodedParsingTable(L"UnitTest-XML", buffer, size));
+
+	WString input = L"<Resource><Folder name=\"A\"><Text name=\"B\">&lt;text&gt;</Text></Folder><!--comment--></Resource>";
+	auto expected = XmlParseDocument(input, XmlLoadTable());
+	auto actual = XmlParseDocument(input, table);
+	TEST_ASSERT(expected && actual);
+	TEST_ASSERT(XmlToString(actual) == XmlToString(expected));
+}
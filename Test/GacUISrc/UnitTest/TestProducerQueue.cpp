@@ -0,0 +1,233 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+using namespace vl::presentation::controls;
+using namespace vl::presentation::controls::list;
+using namespace vl::presentation::controls::tree;
+
+namespace producer_queue_test
+{
+/***********************************************************************
+Stand-in List Control
+
+Every notification is recorded, so a test can see how many times a list control would refresh.
+***********************************************************************/
+
+	class TestListProvider : public ListProvider<vint>
+	{
+	public:
+		IDescriptable* RequestView(const WString& identifier)override
+		{
+			return nullptr;
+		}
+
+		void ReleaseView(IDescriptable* view)override
+		{
+		}
+	};
+
+	class TestCallback : public Object, public virtual GuiListControl::IItemProviderCallback
+	{
+	public:
+		WString						notifications;
+
+		void OnAttached(GuiListControl::IItemProvider* provider)override
+		{
+		}
+
+		void OnItemModified(vint start, vint count, vint newCount)override
+		{
+			notifications += L"(" + itow(start) + L"," + itow(count) + L"," + itow(newCount) + L")";
+		}
+
+		WString Take()
+		{
+			auto result = notifications;
+			notifications = L"";
+			return result;
+		}
+	};
+
+	WString RangeToString(const ItemModificationRange& range)
+	{
+		return L"(" + itow(range.start) + L"," + itow(range.count) + L"," + itow(range.newCount) + L")";
+	}
+}
+using namespace producer_queue_test;
+
+TEST_CASE(TestProducerQueue_MergeRanges)
+{
+	ItemModificationRange range;
+	TEST_ASSERT(range.IsEmpty());
+	range.Merge(2, 0, 3);
+	range.Merge(5, 0, 1);
+	TEST_ASSERT(RangeToString(range) == L"(2,0,4)");
+	range.Merge(0, 1, 0);
+	TEST_ASSERT(RangeToString(range) == L"(0,2,5)");
+	range.Clear();
+	TEST_ASSERT(range.IsEmpty());
+
+	// random modifications to a list of unique items, items outside of the merged range must not be changed
+	vuint32_t seed = 1;
+	auto next = [&](vint range)
+	{
+		seed = seed * 1103515245 + 12345;
+		return (vint)(seed / 65536 % range);
+	};
+
+	bool covered = true;
+	for (vint round = 0; round < 500; round++)
+	{
+		List<vint> original, items;
+		for (vint i = 0; i < 20; i++)
+		{
+			original.Add(i);
+			items.Add(i);
+		}
+
+		ItemModificationRange merged;
+		vint newItem = 100;
+		vint modifications = next(5) + 1;
+		for (vint i = 0; i < modifications; i++)
+		{
+			vint start = next(items.Count() + 1);
+			vint count = next(items.Count() - start + 1);
+			vint newCount = next(4);
+			for (vint j = 0; j < count; j++)
+			{
+				items.RemoveAt(start);
+			}
+			for (vint j = 0; j < newCount; j++)
+			{
+				items.Insert(start + j, newItem++);
+			}
+			merged.Merge(start, count, newCount);
+		}
+
+		covered &= !merged.IsEmpty();
+		covered &= original.Count() - merged.count == items.Count() - merged.newCount;
+		for (vint i = 0; i < merged.start; i++)
+		{
+			covered &= original[i] == items[i];
+		}
+		for (vint i = merged.start + merged.count; i < original.Count(); i++)
+		{
+			covered &= original[i] == items[i - merged.count + merged.newCount];
+		}
+	}
+	TEST_ASSERT(covered);
+}
+
+TEST_CASE(TestProducerQueue_Capacity)
+{
+	List<vint> applied;
+	WString batches;
+	GuiProducerQueue queue([&]() { batches += L"["; }, [&]() { batches += L"]"; }, 2);
+
+	TEST_ASSERT(queue.TryPost([&]() { applied.Add(1); }));
+	TEST_ASSERT(queue.TryPost([&]() { applied.Add(2); }));
+	TEST_ASSERT(!queue.TryPost([&]() { applied.Add(3); }));
+
+	// the main thread cannot wait for itself, so Post ignores the capacity
+	queue.Post([&]() { applied.Add(4); });
+	TEST_ASSERT(queue.GetPendingCount() == 3);
+	TEST_ASSERT(applied.Count() == 0);
+
+	TEST_ASSERT(queue.Drain() == 3);
+	TEST_ASSERT(queue.Drain() == 0);
+	TEST_ASSERT(batches == L"[]");
+	TEST_ASSERT(applied.Count() == 3);
+	TEST_ASSERT(applied[0] == 1);
+	TEST_ASSERT(applied[1] == 2);
+	TEST_ASSERT(applied[2] == 4);
+}
+
+TEST_CASE(TestProducerQueue_BlockedProducer)
+{
+	// a producer waiting for a full queue is released when the main thread applies changes
+	vint applied = 0;
+	volatile vint posted = 0;
+	GuiProducerQueue queue(Func<void()>(), Func<void()>(), 1);
+	TEST_ASSERT(queue.TryPost([&]() { applied++; }));
+
+	auto thread = Thread::CreateAndStart([&]()
+	{
+		queue.Post([&]() { applied++; });
+		INCRC(&posted);
+	}, false);
+	Thread::Sleep(100);
+	TEST_ASSERT(posted == 0);
+
+	TEST_ASSERT(queue.Drain() == 1);
+	thread->Wait();
+	delete thread;
+	TEST_ASSERT(posted == 1);
+	TEST_ASSERT(queue.Drain() == 1);
+	TEST_ASSERT(applied == 2);
+}
+
+TEST_CASE(TestProducerQueue_ListBatch)
+{
+	TestListProvider provider;
+	TestCallback callback;
+	provider.AttachCallback(&callback);
+	provider.Add(1);
+	provider.Add(2);
+	TEST_ASSERT(callback.Take() == L"(0,0,1)(1,0,1)");
+
+	GuiProducerQueue queue([&]() { provider.BeginBatchUpdate(); }, [&]() { provider.EndBatchUpdate(); });
+	queue.Post([&]() { provider.Add(3); });
+	queue.Post([&]() { provider.Insert(0, 0); });
+	queue.Post([&]() { provider.RemoveAt(1); });
+	TEST_ASSERT(callback.Take() == L"");
+	TEST_ASSERT(queue.Drain() == 3);
+	TEST_ASSERT(callback.Take() == L"(0,2,3)");
+	TEST_ASSERT(provider.Count() == 3);
+
+	provider.DetachCallback(&callback);
+}
+
+TEST_CASE(TestProducerQueue_TreeBatch)
+{
+	Ptr<MemoryNodeRootProvider> root = new MemoryNodeRootProvider;
+	TestCallback callback;
+	{
+		NodeItemProvider provider(root);
+		provider.AttachCallback(&callback);
+
+		// visible nodes: a c b
+		Ptr<MemoryNodeProvider> a = new MemoryNodeProvider;
+		Ptr<MemoryNodeProvider> b = new MemoryNodeProvider;
+		Ptr<MemoryNodeProvider> c = new MemoryNodeProvider;
+		root->BeginBatchUpdate();
+		root->Children().Add(a);
+		root->Children().Add(b);
+		a->Children().Add(c);
+		a->SetExpanding(true);
+		TEST_ASSERT(callback.Take() == L"");
+		root->EndBatchUpdate();
+		TEST_ASSERT(callback.Take() == L"(0,0,3)");
+		TEST_ASSERT(provider.Count() == 3);
+
+		// visible nodes: a
+		GuiProducerQueue queue([&]() { root->BeginBatchUpdate(); }, [&]() { root->EndBatchUpdate(); });
+		queue.Post([&]() { root->Children().RemoveAt(1); });
+		queue.Post([&]() { a->SetExpanding(false); });
+		TEST_ASSERT(queue.Drain() == 2);
+		TEST_ASSERT(callback.Take() == L"(1,2,0)");
+		TEST_ASSERT(provider.Count() == 1);
+
+		// without batching, every modification is notified
+		root->Children().Add(b);
+		a->SetExpanding(true);
+		TEST_ASSERT(callback.Take() == L"(1,0,1)(1,0,1)");
+		provider.DetachCallback(&callback);
+	}
+
+	// item providers are forgotten when they are deleted
+	root->BeginBatchUpdate();
+	root->Children().Clear();
+	root->EndBatchUpdate();
+}
@@ -0,0 +1,573 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::regex;
+using namespace vl::stream;
+using namespace vl::presentation;
+
+namespace regex_test
+{
+	const vint Rounds = 5;
+
+	// Greedy matching gives the longest match for every token, so the backtracking interpretor could check the DFA tables
+	// "/" is an escaping character like "\" in Regex, and "." is not a wildcard
+	const wchar_t* TokenCodes[] =
+	{
+		L"\\/\\*([^*]|\\*+[^*\\/])*\\*+\\/",
+		L"\\/\\/[^\\r\\n]*",
+		L"[a-zA-Z_]\\w*",
+		L"\\d+(.\\d+)?",
+		L"\"([^\"\\\\\\r\\n]|\\\\[^\\r\\n])*\"",
+		L"\\s+",
+		L"[+\\-*\\/=<>!&|;,(){}\\[\\].]",
+	};
+	const vint TokenCount = sizeof(TokenCodes) / sizeof(*TokenCodes);
+
+	// Non-ASCII characters only appear in comments and strings, so every character belongs to a token
+	WString GenerateCode(vint lines, vuint32_t seed)
+	{
+		auto next = [&](vint range)
+		{
+			seed = seed * 1103515245 + 12345;
+			return (vint)(seed / 65536 % range);
+		};
+		const wchar_t* words[] = { L"if", L"value", L"_x1", L"GetItem", L"i" };
+		const wchar_t* texts[] = { L"plain", L"\\\"quoted\\\"", L"\x00E9\x00E8", L"\x03B4\x03C9", L"\x4E2D\x6587", L"tab\\t" };
+		const wchar_t* operators[] = { L"+", L"-", L"*", L"/", L"==", L"<", L"&&", L";", L",", L"(", L")", L"{", L"}", L"[", L"]", L"." };
+
+		// the code is large, a stream avoids copying it again for every token
+		MemoryStream stream;
+		{
+			StreamWriter writer(stream);
+			for (vint i = 0; i < lines; i++)
+			{
+				vint items = next(12);
+				for (vint j = 0; j < items; j++)
+				{
+					switch (next(8))
+					{
+					case 0: case 1: case 2:
+						writer.WriteString(words[next(5)]);
+						writer.WriteString(L" ");
+						break;
+					case 3:
+						writer.WriteString(itow(next(1000)) + (next(2) == 0 ? L"" : L"." + itow(next(100))));
+						break;
+					case 4:
+						writer.WriteString(WString(L"\"") + texts[next(6)] + L"\"");
+						break;
+					case 5:
+						writer.WriteString(WString(L"/* ") + texts[next(6)] + (next(2) == 0 ? L" **/" : L"\r\n * */"));
+						break;
+					default:
+						writer.WriteString(operators[next(16)]);
+					}
+				}
+				if (next(4) == 0)
+				{
+					writer.WriteString(WString(L" // ") + texts[next(6)]);
+				}
+				writer.WriteString(L"\r\n");
+			}
+		}
+		stream.SeekFromBegin(0);
+		StreamReader reader(stream);
+		return reader.ReadToEnd();
+	}
+
+	// Find the longest token at every position, using the backtracking interpretor instead of DFA tables
+	void ReferenceTokenize(const WString& code, List<Pair<vint, vint>>& tokens)
+	{
+		List<Ptr<Regex>> regexes;
+		for (vint i = 0; i < TokenCount; i++)
+		{
+			regexes.Add(new Regex(TokenCodes[i], false));
+		}
+
+		vint start = 0;
+		while (start < code.Length())
+		{
+			auto rest = code.Sub(start, code.Length() - start);
+			vint token = -1;
+			vint length = 0;
+			for (vint i = 0; i < TokenCount; i++)
+			{
+				if (auto match = regexes[i]->MatchHead(rest))
+				{
+					if (match->Result().Length() > length)
+					{
+						token = i;
+						length = match->Result().Length();
+					}
+				}
+			}
+			if (token == -1) break;
+			tokens.Add(Pair<vint, vint>(token, length));
+			start += length;
+		}
+	}
+
+	struct ColorizerArgument
+	{
+		Array<vint>*					colors;
+		vint							offset;
+	};
+
+	void ColorizerProc(void* argument, vint start, vint length, vint token)
+	{
+		auto colorizerArgument = (ColorizerArgument*)argument;
+		for (vint i = 0; i < length; i++)
+		{
+			colorizerArgument->colors->Set(colorizerArgument->offset + start + i, token);
+		}
+	}
+
+	// Colorize line by line like GuiTextBoxRegexColorizer, the state is passed to the next line
+	void Colorize(RegexLexerColorizer& colorizer, const WString& code, Array<vint>& colors)
+	{
+		colors.Resize(code.Length());
+		for (vint i = 0; i < colors.Count(); i++)
+		{
+			colors[i] = -1;
+		}
+
+		ColorizerArgument argument;
+		argument.colors = &colors;
+		colorizer.Reset(colorizer.GetStartState());
+		vint lineStart = 0;
+		while (lineStart < code.Length())
+		{
+			vint lineEnd = lineStart;
+			while (lineEnd < code.Length() && code[lineEnd] != L'\n')
+			{
+				lineEnd++;
+			}
+			if (lineEnd < code.Length())
+			{
+				lineEnd++;
+			}
+			argument.offset = lineStart;
+			colorizer.Colorize(code.Buffer() + lineStart, lineEnd - lineStart, &ColorizerProc, &argument);
+			lineStart = lineEnd;
+		}
+	}
+
+	// Colorize a line character by character with the walker, this is how RegexLexerColorizer worked before it runs the DFA tables directly
+	void ReferenceColorizeLine(const RegexLexerWalker& walker, const wchar_t* input, vint length, vint& currentState, Array<vint>& colors, vint offset)
+	{
+		vint start = 0;
+		vint stop = 0;
+		vint state = -1;
+		vint token = -1;
+		vint index = 0;
+		bool finalState = false;
+
+		while (index < length)
+		{
+			vint currentToken = -1;
+			bool previousTokenStop = false;
+			finalState = false;
+			walker.Walk(input[index], currentState, currentToken, finalState, previousTokenStop);
+
+			if (previousTokenStop)
+			{
+				if (stop > start)
+				{
+					for (vint i = start; i < stop; i++) colors[offset + i] = token;
+					currentState = state;
+					start = stop;
+					index = stop - 1;
+					state = -1;
+					token = -1;
+					finalState = false;
+				}
+				else if (stop < index)
+				{
+					stop = index + 1;
+					for (vint i = start; i < stop; i++) colors[offset + i] = -1;
+					start = index + 1;
+					state = -1;
+					token = -1;
+				}
+			}
+			if (finalState)
+			{
+				stop = index + 1;
+				state = currentState;
+				token = currentToken;
+			}
+			index++;
+		}
+		if (start < length)
+		{
+			vint lastToken = finalState ? token : walker.GetRelatedToken(currentState);
+			for (vint i = start; i < length; i++) colors[offset + i] = lastToken;
+		}
+	}
+
+	// Check the compressed tables against the DFA that they are built from
+	bool SameAsDfa(const WString& code, const WString& input)
+	{
+		using namespace regex_internal;
+
+		CharRange::List subsets;
+		auto expression = ParseRegexExpression(code)->Merge();
+		expression->CollectCharSet(subsets);
+		expression->ApplyCharSet(subsets);
+		Dictionary<State*, State*> nfaStateMap;
+		Group<State*, State*> dfaStateMap;
+		auto nfa = EpsilonNfaToNfa(expression->GenerateEpsilonNfa(), PureEpsilonChecker, nfaStateMap);
+		auto dfa = NfaToDfa(nfa, dfaStateMap);
+		PureInterpretor pure(dfa, subsets);
+
+		// every transition of every state
+		bool same = pure.GetStartState() == dfa->states.IndexOf(dfa->startState);
+		Array<vint> targets(0x10000);
+		for (vint i = 0; i < dfa->states.Count(); i++)
+		{
+			auto state = dfa->states[i].Obj();
+			same &= pure.IsFinalState(i) == state->finalState;
+
+			for (vint c = 0; c < targets.Count(); c++)
+			{
+				targets[c] = -1;
+			}
+			FOREACH(Transition*, transition, state->transitions)
+			{
+				vint target = dfa->states.IndexOf(transition->target);
+				for (vint c = transition->range.begin; c <= transition->range.end && c < targets.Count(); c++)
+				{
+					targets[c] = target;
+				}
+			}
+			for (vint c = 0; c < targets.Count(); c++)
+			{
+				same &= pure.Transit((wchar_t)c, i) == targets[c];
+			}
+		}
+
+		// running over the input at once is the same as transiting one character at a time
+		for (vint start = 0; start < input.Length(); start += 7)
+		{
+			vint state = pure.GetStartState();
+			vint finalLength = -1;
+			vint lastFinalState = -1;
+			vint consumed = pure.Run(input.Buffer() + start, input.Length() - start, state, finalLength, lastFinalState);
+
+			vint expectedState = pure.GetStartState();
+			vint expectedConsumed = 0;
+			vint expectedFinalLength = -1;
+			vint expectedLastFinalState = -1;
+			while (start + expectedConsumed < input.Length())
+			{
+				vint next = pure.Transit(input[start + expectedConsumed], expectedState);
+				if (next == -1) break;
+				expectedState = next;
+				expectedConsumed++;
+				if (pure.IsFinalState(expectedState))
+				{
+					expectedFinalLength = expectedConsumed;
+					expectedLastFinalState = expectedState;
+				}
+			}
+			same &= consumed == expectedConsumed;
+			same &= state == expectedState;
+			same &= finalLength == expectedFinalLength;
+			same &= lastFinalState == expectedLastFinalState;
+		}
+		return same;
+	}
+
+	// Compare a cursor on text[start, end) with Regex::Search on a copy of the same characters, characters after end are not zero
+	bool SameAsSearch(const Regex& regex, RegexCursor& cursor, const WString& text, vint start, vint end)
+	{
+		RegexMatch::List matches;
+		regex.Search(text.Sub(start, end - start), matches);
+		bool same = regex.Test(text.Buffer() + start, text.Buffer() + end) == (matches.Count() > 0);
+
+		cursor.Reset(text.Buffer() + start, text.Buffer() + end);
+		FOREACH(Ptr<RegexMatch>, match, matches)
+		{
+			if (!cursor.Next()) return false;
+			same &= cursor.GetMatch().start == match->Result().Start();
+			same &= cursor.GetMatch().length == match->Result().Length();
+
+			vint captureCount = match->Captures().Count();
+			for (vint i = 0; i < match->Groups().Count(); i++)
+			{
+				captureCount += match->Groups().GetByIndex(i).Count();
+			}
+			if (cursor.GetCaptureCount() != captureCount) return false;
+
+			vint unnamed = 0;
+			Dictionary<WString, vint> named;
+			for (vint i = 0; i < cursor.GetCaptureCount(); i++)
+			{
+				auto capture = cursor.GetCapture(i);
+				RegexString expected;
+				if (capture.capture == -1)
+				{
+					expected = match->Captures()[unnamed++];
+				}
+				else
+				{
+					auto name = cursor.GetCaptureName(capture.capture);
+					vint index = named.Keys().Contains(name) ? named[name] : 0;
+					named.Set(name, index + 1);
+					expected = match->Groups()[name][index];
+				}
+				same &= capture.start == expected.Start();
+				same &= capture.length == expected.Length();
+			}
+		}
+		same &= !cursor.Next();
+		return same;
+	}
+
+	Ptr<RegexLexer> CreateLexer()
+	{
+		List<WString> codes;
+		for (vint i = 0; i < TokenCount; i++)
+		{
+			codes.Add(TokenCodes[i]);
+		}
+		return new RegexLexer(codes);
+	}
+
+	// Average time to run a function in milliseconds
+	vint64_t Measure(const Func<void()>& function)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < Rounds; i++)
+		{
+			function();
+		}
+		return (GuiStartupTrace::GetMicroseconds() - start) / Rounds / 1000;
+	}
+}
+using namespace regex_test;
+
+TEST_CASE(TestRegex_LexerTokens)
+{
+	auto lexer = CreateLexer();
+	auto code = GenerateCode(500, 1);
+	List<Pair<vint, vint>> expected;
+	ReferenceTokenize(code, expected);
+
+	List<RegexToken> tokens;
+	lexer->Parse(code).ReadToEnd(tokens);
+	TEST_ASSERT(tokens.Count() == expected.Count());
+
+	bool same = true;
+	vint start = 0;
+	for (vint i = 0; i < tokens.Count(); i++)
+	{
+		same &= tokens[i].start == start;
+		same &= tokens[i].token == expected[i].key;
+		same &= tokens[i].length == expected[i].value;
+		start += expected[i].value;
+	}
+	TEST_ASSERT(same);
+	TEST_ASSERT(start == code.Length());
+}
+
+TEST_CASE(TestRegex_CompressedTables)
+{
+	// char sets cover pages that are shared, partly used and not used
+	const wchar_t* patterns[] = { L"[a-zA-Z_]\\w*", L"\\d+(.\\d+)?", L"[\x00E9\x03B4-\x03C9\x4E00-\x9FA5]+x", L"[^\\r\\n]*\\r\\n", L"\\/\\*([^*]|\\*+[^*\\/])*\\*+\\/" };
+	auto code = GenerateCode(100, 2);
+
+	bool same = true;
+	for (vint i = 0; i < sizeof(patterns) / sizeof(*patterns); i++)
+	{
+		same &= SameAsDfa(patterns[i], code);
+	}
+	TEST_ASSERT(same);
+}
+
+TEST_CASE(TestRegex_ColorizerColors)
+{
+	auto lexer = CreateLexer();
+	auto code = GenerateCode(500, 2);
+
+	// multiple-line comments are colorized across lines
+	auto colorizer = lexer->Colorize();
+	Array<vint> colors;
+	Colorize(colorizer, code, colors);
+
+	auto walker = lexer->Walk();
+	Array<vint> expected(code.Length());
+	vint state = walker.GetStartState();
+	vint lineStart = 0;
+	while (lineStart < code.Length())
+	{
+		vint lineEnd = lineStart;
+		while (lineEnd < code.Length() && code[lineEnd++] != L'\n');
+		ReferenceColorizeLine(walker, code.Buffer() + lineStart, lineEnd - lineStart, state, expected, lineStart);
+		lineStart = lineEnd;
+	}
+	TEST_ASSERT(colorizer.GetCurrentState() == state);
+
+	bool same = true;
+	for (vint i = 0; i < code.Length(); i++)
+	{
+		same &= colors[i] == expected[i];
+	}
+	TEST_ASSERT(same);
+}
+
+TEST_CASE(TestRegex_PureAndRichSearch)
+{
+	auto code = GenerateCode(200, 3);
+	const wchar_t* patterns[] = { L"[a-zA-Z_]\\w*", L"\\d+(.\\d+)?", L"[\x00E9\x00E8\x03B4\x03C9\x4E2D\x6587]+", L"\\/\\*([^*]|\\*+[^*\\/])*\\*+\\/" };
+
+	bool same = true;
+	for (vint i = 0; i < sizeof(patterns) / sizeof(*patterns); i++)
+	{
+		Regex pure(patterns[i], true);
+		Regex rich(patterns[i], false);
+		TEST_ASSERT(pure.IsPureMatch());
+		TEST_ASSERT(!rich.IsPureMatch());
+
+		RegexMatch::List pureMatches, richMatches;
+		pure.Search(code, pureMatches);
+		rich.Search(code, richMatches);
+		same &= pureMatches.Count() > 0;
+		same &= pureMatches.Count() == richMatches.Count();
+		for (vint j = 0; j < pureMatches.Count() && j < richMatches.Count(); j++)
+		{
+			same &= pureMatches[j]->Result().Start() == richMatches[j]->Result().Start();
+			same &= pureMatches[j]->Result().Length() == richMatches[j]->Result().Length();
+		}
+	}
+	TEST_ASSERT(same);
+}
+
+TEST_CASE(TestRegex_CursorRanges)
+{
+	// every range of the text is matched, ranges end in the middle of numbers, back references and look-ahead
+	const wchar_t* text = L"ab-abc 12.5 x-x 7-7y ab1 cd-cd.34 z9";
+	const wchar_t* patterns[] =
+	{
+		L"\\d+",
+		L"\\w+$",
+		L"^\\w+",
+		L"(<int>\\d+)(.(<frac>\\d+))?",
+		L"(<a>\\w+)-(<$a>)",
+		L"(?[a-z])(?\\w)*-(<$0>)",
+		L"[a-z]+(=\\d)",
+	};
+
+	WString input = text;
+	bool same = true;
+	for (vint i = 0; i < sizeof(patterns) / sizeof(*patterns); i++)
+	{
+		// one cursor is reset for all ranges, so buffers of the backtracking interpretor are reused after failed and successful matches
+		Regex regex(patterns[i]);
+		RegexCursor cursor(regex);
+		for (vint start = 0; start <= input.Length(); start++)
+		{
+			for (vint end = start; end <= input.Length(); end++)
+			{
+				same &= SameAsSearch(regex, cursor, input, start, end);
+			}
+		}
+	}
+	TEST_ASSERT(same);
+}
+
+TEST_CASE(TestRegex_CursorBoundaries)
+{
+	WString input = L"ab-ab1 12";
+
+	// "$" matches at the end of the range
+	{
+		Regex regex(L"\\w+$");
+		RegexCursor cursor(regex, input.Buffer(), input.Buffer() + 2);
+		TEST_ASSERT(cursor.Next());
+		TEST_ASSERT(cursor.GetMatch().start == 0);
+		TEST_ASSERT(cursor.GetMatch().length == 2);
+		TEST_ASSERT(!cursor.Next());
+	}
+
+	// a back reference does not match characters after the end of the range
+	{
+		Regex regex(L"(<a>\\w+)-(<$a>)");
+		RegexCursor cursor(regex, input.Buffer(), input.Buffer() + 4);
+		TEST_ASSERT(!cursor.Next());
+		cursor.Reset(input.Buffer(), input.Buffer() + 5);
+		TEST_ASSERT(cursor.Next());
+		TEST_ASSERT(cursor.GetMatch().length == 5);
+		TEST_ASSERT(cursor.GetCaptureCount() == 1);
+		TEST_ASSERT(cursor.GetCaptureName(cursor.GetCapture(0).capture) == L"a");
+		TEST_ASSERT(cursor.GetCapture(0).length == 2);
+	}
+
+	// numbers are not extended after the end of the range, in both interpretors
+	{
+		Regex pure(L"\\d+", true);
+		Regex rich(L"\\d+", false);
+		RegexCursor pureCursor(pure, input.Buffer() + 7, input.Buffer() + 8);
+		RegexCursor richCursor(rich, input.Buffer() + 7, input.Buffer() + 8);
+		TEST_ASSERT(pureCursor.Next() && pureCursor.GetMatch().length == 1);
+		TEST_ASSERT(richCursor.Next() && richCursor.GetMatch().length == 1);
+	}
+
+	// the cursor steps over empty matches, only the backtracking interpretor reports them
+	{
+		Regex regex(L"\\d*", false);
+		WString empty = L"a1";
+		RegexCursor cursor(regex, empty);
+		TEST_ASSERT(cursor.Next());
+		TEST_ASSERT(cursor.GetMatch().start == 0 && cursor.GetMatch().length == 0);
+		TEST_ASSERT(cursor.Next());
+		TEST_ASSERT(cursor.GetMatch().start == 1 && cursor.GetMatch().length == 1);
+		TEST_ASSERT(!cursor.Next());
+	}
+}
+
+TEST_CASE(TestRegex_Benchmark)
+{
+	auto code = GenerateCode(50000, 4);
+	Ptr<RegexLexer> lexer;
+	vint tokenCount = 0;
+
+	auto createTime = Measure([&]()
+	{
+		lexer = CreateLexer();
+	});
+	auto parseTime = Measure([&]()
+	{
+		List<RegexToken> tokens;
+		lexer->Parse(code).ReadToEnd(tokens);
+		tokenCount = tokens.Count();
+	});
+	auto colorizer = lexer->Colorize();
+	auto colorizeTime = Measure([&]()
+	{
+		Array<vint> colors;
+		Colorize(colorizer, code, colors);
+	});
+
+	auto walker = lexer->Walk();
+	auto walkTime = Measure([&]()
+	{
+		Array<vint> colors(code.Length());
+		vint state = walker.GetStartState();
+		vint lineStart = 0;
+		while (lineStart < code.Length())
+		{
+			vint lineEnd = lineStart;
+			while (lineEnd < code.Length() && code[lineEnd++] != L'\n');
+			ReferenceColorizeLine(walker, code.Buffer() + lineStart, lineEnd - lineStart, state, colors, lineStart);
+			lineStart = lineEnd;
+		}
+	});
+
+	TEST_PRINT(L"Tokenize " + itow(code.Length()) + L" characters into " + itow(tokenCount) + L" tokens, average of " + itow(Rounds) + L" rounds:");
+	TEST_PRINT(L"    Create the lexer: " + i64tow(createTime) + L" ms");
+	TEST_PRINT(L"    RegexLexer::Parse: " + i64tow(parseTime) + L" ms");
+	TEST_PRINT(L"    RegexLexerColorizer line by line: " + i64tow(colorizeTime) + L" ms");
+	TEST_PRINT(L"    RegexLexerWalker character by character: " + i64tow(walkTime) + L" ms");
+}
@@ -128,4 +128,57 @@ TEST_CASE(TestResource_WrongDoc)
 TEST_CASE(TestResource_WrongInstanceStyle)
 {
 	LoadResource(L"Resource.WrongInstanceStyle.xml", true);
-}
\ No newline at end of file
+}
+
+namespace resource_path_index_test
+{
+	Ptr<GuiResourceItem> CreateTextItem(const WString& text)
+	{
+		auto item = MakePtr<GuiResourceItem>();
+		item->SetContent(L"Text", MakePtr<GuiTextData>(text));
+		return item;
+	}
+
+	WString GetText(Ptr<GuiResourceFolder> folder, const WString& path)
+	{
+		if (auto data = folder->GetValueByPath(path).Cast<GuiTextData>())
+		{
+			return data->GetText();
+		}
+		return L"<null>";
+	}
+}
+using namespace resource_path_index_test;
+
+TEST_CASE(TestResource_PathIndex)
+{
+	auto resource = MakePtr<GuiResource>();
+	Ptr<GuiResourceFolder> root = resource;
+
+	auto a = MakePtr<GuiResourceFolder>();
+	auto b = MakePtr<GuiResourceFolder>();
+	TEST_ASSERT(resource->AddFolder(L"A", a));
+	TEST_ASSERT(a->AddFolder(L"B", b));
+	TEST_ASSERT(a->AddItem(L"X", CreateTextItem(L"x")));
+	TEST_ASSERT(b->AddItem(L"Y", CreateTextItem(L"y")));
+
+	// lookups through a GuiResourceFolder pointer must use the index as well
+	TEST_ASSERT(GetText(root, L"A/X") == L"x");
+	TEST_ASSERT(GetText(root, L"A\\B\\Y") == L"y");
+	TEST_ASSERT(root->GetFolderByPath(L"A/B/") == b);
+	TEST_ASSERT(root->GetFolderByPath(L"A\\") == a);
+	TEST_ASSERT(GetText(root, L"A/B/Z") == L"<null>");
+	TEST_ASSERT(!root->GetFolderByPath(L"A/X/"));
+
+	// the index is updated when any folder in the tree is changed
+	TEST_ASSERT(b->RemoveItem(L"Y"));
+	TEST_ASSERT(GetText(root, L"A/B/Y") == L"<null>");
+	TEST_ASSERT(resource->CreateValueByPath(L"A/C/Z", L"Text", MakePtr<GuiTextData>(L"z")));
+	TEST_ASSERT(GetText(root, L"A/C/Z") == L"z");
+	TEST_ASSERT(root->GetFolderByPath(L"A/C/"));
+	a->RemoveFolder(L"B");
+	TEST_ASSERT(!root->GetFolderByPath(L"A/B/"));
+
+	// sub folders still walk through their own children
+	TEST_ASSERT(GetText(a, L"C/Z") == L"z");
+}
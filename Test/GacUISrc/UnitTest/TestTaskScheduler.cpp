@@ -0,0 +1,263 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::presentation;
+
+namespace task_scheduler_test
+{
+/***********************************************************************
+LockedQueuePool
+
+The thread pool that ThreadPoolLite used on Linux before TaskScheduler:
+one linked list of heap allocated tasks behind one spin lock, and 4 threads per processor.
+***********************************************************************/
+
+	class LockedQueuePool : public Object
+	{
+	protected:
+		struct Task
+		{
+			Func<void()>			proc;
+			Ptr<Task>				next;
+		};
+
+		SpinLock					lock;
+		Semaphore					semaphore;
+		Ptr<Task>					taskBegin;
+		Ptr<Task>*					taskEnd = nullptr;
+		volatile bool				stopping = false;
+		List<Thread*>				threads;
+
+		void Run()
+		{
+			while (true)
+			{
+				Ptr<Task> task;
+				semaphore.Wait();
+				SPIN_LOCK(lock)
+				{
+					if (taskBegin)
+					{
+						task = taskBegin;
+						taskBegin = task->next;
+					}
+					if (!taskBegin)
+					{
+						taskEnd = &taskBegin;
+					}
+				}
+
+				if (task)
+				{
+					task->proc();
+				}
+				else if (stopping)
+				{
+					return;
+				}
+			}
+		}
+	public:
+		LockedQueuePool()
+		{
+			semaphore.Create(0, 65536);
+			taskEnd = &taskBegin;
+			for (vint i = 0; i < Thread::GetCPUCount() * 4; i++)
+			{
+				threads.Add(Thread::CreateAndStart([=]() { Run(); }, false));
+			}
+		}
+
+		~LockedQueuePool()
+		{
+			stopping = true;
+			semaphore.Release(threads.Count());
+			FOREACH(Thread*, thread, threads)
+			{
+				thread->Wait();
+				delete thread;
+			}
+		}
+
+		void Queue(const Func<void()>& proc)
+		{
+			auto task = MakePtr<Task>();
+			task->proc = proc;
+			SPIN_LOCK(lock)
+			{
+				*taskEnd = task;
+				taskEnd = &task->next;
+			}
+			semaphore.Release();
+		}
+	};
+
+/***********************************************************************
+Benchmark
+***********************************************************************/
+
+	const vint ProducerCount = 4;
+	const vint TasksPerProducer = 50000;
+
+	// Queue tiny tasks from several threads at the same time, and return the time to finish all of them
+	vint64_t RunContention(const Func<void(const Func<void()>&)>& queue)
+	{
+		volatile vint executed = 0;
+		EventObject finished;
+		finished.CreateManualUnsignal(false);
+		auto task = [&]()
+		{
+			if (INCRC(&executed) == ProducerCount * TasksPerProducer)
+			{
+				finished.Signal();
+			}
+		};
+
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		List<Thread*> producers;
+		for (vint i = 0; i < ProducerCount; i++)
+		{
+			producers.Add(Thread::CreateAndStart([&]()
+			{
+				for (vint j = 0; j < TasksPerProducer; j++)
+				{
+					queue(task);
+				}
+			}, false));
+		}
+		FOREACH(Thread*, producer, producers)
+		{
+			producer->Wait();
+			delete producer;
+		}
+		finished.Wait();
+		return (GuiStartupTrace::GetMicroseconds() - start) / 1000;
+	}
+}
+using namespace task_scheduler_test;
+
+TEST_CASE(TestTaskScheduler_ContentionBenchmark)
+{
+	vint64_t lockedQueue = 0;
+	{
+		LockedQueuePool pool;
+		lockedQueue = RunContention([&](const Func<void()>& proc) { pool.Queue(proc); });
+	}
+
+	vint64_t scheduler = RunContention([](const Func<void()>& proc) { TaskScheduler::Queue(proc); });
+
+	TEST_PRINT(L"Tasks: " + itow(ProducerCount * TasksPerProducer) + L" from " + itow(ProducerCount) + L" threads");
+	TEST_PRINT(L"    Locked queue: " + i64tow(lockedQueue) + L" ms");
+	TEST_PRINT(L"    TaskScheduler: " + i64tow(scheduler) + L" ms");
+}
+
+TEST_CASE(TestTaskScheduler_NestedBenchmark)
+{
+	// Every task forks more tasks, which stay in the local queue of the worker
+	const vint Width = 16;
+	const vint Depth = 4;
+	volatile vint executed = 0;
+
+	Func<void(vint)> fork;
+	fork = [&](vint depth)
+	{
+		INCRC(&executed);
+		if (depth == Depth) return;
+		TaskGroup group;
+		for (vint i = 0; i < Width; i++)
+		{
+			group.Run([&, depth]() { fork(depth + 1); });
+		}
+	};
+
+	vint64_t start = GuiStartupTrace::GetMicroseconds();
+	{
+		TaskGroup group;
+		group.Run([&]() { fork(0); });
+	}
+	vint64_t duration = (GuiStartupTrace::GetMicroseconds() - start) / 1000;
+
+	vint expected = 0;
+	for (vint i = 0, count = 1; i <= Depth; i++, count *= Width)
+	{
+		expected += count;
+	}
+	TEST_ASSERT(executed == expected);
+	TEST_PRINT(L"Nested tasks: " + itow(expected) + L" in " + i64tow(duration) + L" ms");
+}
+
+TEST_CASE(TestTaskScheduler_BlockingTasks)
+{
+	// Tasks that wait for each other need as many threads as ThreadPoolLite used to have
+	vint count = Thread::GetCPUCount() * 3;
+	volatile vint started = 0;
+	volatile vint finished = 0;
+	EventObject allStarted;
+	allStarted.CreateManualUnsignal(false);
+
+	for (vint i = 0; i < count; i++)
+	{
+		TEST_ASSERT(ThreadPoolLite::Queue([&]()
+		{
+			if (INCRC(&started) == count)
+			{
+				allStarted.Signal();
+			}
+			allStarted.Wait();
+			INCRC(&finished);
+		}));
+	}
+
+	vint64_t start = GuiStartupTrace::GetMicroseconds();
+	while (finished < count && GuiStartupTrace::GetMicroseconds() - start < 10000000)
+	{
+		Thread::Sleep(1);
+	}
+	bool allFinished = finished == count;
+
+	// release blocked tasks before leaving, they reference local variables
+	allStarted.Signal();
+	while (finished < count)
+	{
+		Thread::Sleep(1);
+	}
+	TEST_ASSERT(allFinished);
+}
+
+TEST_CASE(TestTaskScheduler_QueueWhileStopping)
+{
+	// Stop is called while a task is running, and then the task queues more tasks
+	for (vint i = 0; i < 2; i++)
+	{
+		bool discardPendingTasks = i == 1;
+		volatile vint started = 0;
+		volatile bool queuedFromWorker = false;
+		volatile bool queuedFromOtherThread = true;
+		volatile vint executed = 0;
+
+		TEST_ASSERT(TaskScheduler::Queue([&]()
+		{
+			started = 1;
+			Thread::Sleep(200);
+			queuedFromWorker = TaskScheduler::Queue([&]() { INCRC(&executed); });
+
+			auto thread = Thread::CreateAndStart([&]()
+			{
+				queuedFromOtherThread = TaskScheduler::Queue([&]() { INCRC(&executed); });
+			}, false);
+			thread->Wait();
+			delete thread;
+		}));
+
+		while (!started)
+		{
+			Thread::Sleep(1);
+		}
+		TEST_ASSERT(TaskScheduler::Stop(discardPendingTasks));
+
+		TEST_ASSERT(!queuedFromOtherThread);
+		TEST_ASSERT(queuedFromWorker == !discardPendingTasks);
+		TEST_ASSERT(executed == (discardPendingTasks ? 0 : 1));
+	}
+}
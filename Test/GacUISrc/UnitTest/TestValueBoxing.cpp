@@ -0,0 +1,293 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Source/Reflection/TypeDescriptors/GuiReflectionCompositions.h"
+
+using namespace vl;
+using namespace vl::reflection;
+using namespace vl::reflection::description;
+using namespace vl::presentation;
+using namespace vl::presentation::compositions;
+
+namespace value_boxing_test
+{
+/***********************************************************************
+Allocation Counter
+
+Allocations are counted through the debug CRT allocation hook, which is only installed while a counter exists.
+Without the debug CRT, allocations are not counted and the count is -1.
+***********************************************************************/
+
+#if defined VCZH_MSVC && defined _DEBUG
+#define VALUE_BOXING_COUNT_ALLOCATIONS
+#endif
+
+	class AllocationCounter : public Object
+	{
+#ifdef VALUE_BOXING_COUNT_ALLOCATIONS
+	protected:
+		static volatile vint			count;
+		static _CRT_ALLOC_HOOK			previousHook;
+
+		static int __cdecl Hook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+		{
+			if (allocType == _HOOK_ALLOC)
+			{
+				INCRC(&count);
+			}
+			return previousHook ? previousHook(allocType, userData, size, blockType, requestNumber, fileName, lineNumber) : 1;
+		}
+
+	public:
+		AllocationCounter()
+		{
+			count = 0;
+			previousHook = _CrtSetAllocHook(&Hook);
+		}
+
+		~AllocationCounter()
+		{
+			_CrtSetAllocHook(previousHook);
+			previousHook = nullptr;
+		}
+
+		vint GetCount()
+		{
+			return count;
+		}
+#else
+	public:
+		vint GetCount()
+		{
+			return -1;
+		}
+#endif
+	};
+
+#ifdef VALUE_BOXING_COUNT_ALLOCATIONS
+	volatile vint AllocationCounter::count = 0;
+	_CRT_ALLOC_HOOK AllocationCounter::previousHook = nullptr;
+#endif
+
+	bool CanCountAllocations()
+	{
+		return AllocationCounter().GetCount() != -1;
+	}
+
+	const vint Rounds = 10000;
+
+	struct Measurement
+	{
+		vint			allocations = 0;
+		vint64_t		microseconds = 0;
+	};
+
+	// Run one round to fill caches, and then measure all rounds
+	Measurement Measure(const Func<void(vint)>& round)
+	{
+		round(0);
+		Measurement result;
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		{
+			AllocationCounter counter;
+			for (vint i = 0; i < Rounds; i++)
+			{
+				round(i);
+			}
+			result.allocations = counter.GetCount();
+		}
+		result.microseconds = GuiStartupTrace::GetMicroseconds() - start;
+		return result;
+	}
+
+	void PrintMeasurement(const WString& name, const Measurement& measurement)
+	{
+		auto allocations = measurement.allocations == -1 ? WString(L"allocations not counted") : ftow((double)measurement.allocations / Rounds) + L" allocations per round";
+		TEST_PRINT(L"    " + name + L": " + allocations + L", " + i64tow(measurement.microseconds) + L" us");
+	}
+
+	template<typename T>
+	Value HeapBox(const T& value)
+	{
+		// the way every value type was boxed before small values were stored inline
+		return Value::From(new IValueType::TypedBox<T>(value), GetTypeDescriptor<T>());
+	}
+}
+using namespace value_boxing_test;
+
+TEST_CASE(TestValueBoxing_InlineStorage)
+{
+	TEST_ASSERT(Value::InlineStorage<vint>::Result);
+	TEST_ASSERT(Value::InlineStorage<double>::Result);
+	TEST_ASSERT(Value::InlineStorage<Color>::Result);
+	TEST_ASSERT(Value::InlineStorage<Point>::Result);
+	TEST_ASSERT(Value::InlineStorage<Size>::Result);
+	TEST_ASSERT(Value::InlineStorage<Rect>::Result == (sizeof(Rect) <= 16));
+	TEST_ASSERT(!Value::InlineStorage<WString>::Result);
+	TEST_PRINT(L"sizeof(Value): " + itow(sizeof(Value)));
+
+	Value point = BoxValue<Point>(Point(1, 2));
+	Value size = point;
+	TEST_ASSERT(point.GetInlineValue<Point>() && size.GetInlineValue<Point>());
+	TEST_ASSERT(!point.GetInlineValue<Size>());
+	TEST_ASSERT(UnboxValue<Point>(size) == Point(1, 2));
+
+	// the non-const GetBoxedValue moves the value to a boxed value that could be changed
+	auto boxed = point.GetBoxedValue().Cast<IValueType::TypedBox<Point>>();
+	TEST_ASSERT(boxed && !point.GetInlineValue<Point>());
+	boxed->value = Point(3, 4);
+	TEST_ASSERT(UnboxValue<Point>(point) == Point(3, 4));
+	TEST_ASSERT(UnboxValue<Point>(size) == Point(1, 2));
+}
+
+namespace value_boxing_test
+{
+	// a value stored inline by another module has a different Value::InlineTypeOf<T>::Instance
+	class ForeignModuleValue : public Value
+	{
+	public:
+		static const InlineType		ForeignPoint;
+
+		ForeignModuleValue(const Value& value)
+			:Value(value)
+		{
+			if (inlineType == &InlineTypeOf<Point>::Instance)
+			{
+				inlineType = &ForeignPoint;
+			}
+		}
+	};
+	const Value::InlineType ForeignModuleValue::ForeignPoint = { &typeid(Point), &Value::BoxInline<Point> };
+}
+
+TEST_CASE(TestValueBoxing_InlineTypeAcrossModules)
+{
+	Value point = ForeignModuleValue(BoxValue<Point>(Point(1, 2)));
+	TEST_ASSERT(point.GetInlineValue<Point>());
+	TEST_ASSERT(!point.GetInlineValue<Size>());
+	TEST_ASSERT(UnboxValue<Point>(point) == Point(1, 2));
+	TEST_ASSERT(point.GetBoxedValue().Cast<IValueType::TypedBox<Point>>()->value == Point(1, 2));
+}
+
+TEST_CASE(TestValueBoxing_BoxUnbox)
+{
+	Point point(1, 2);
+	Size size(3, 4);
+
+	auto inlineBoxing = Measure([&](vint i)
+	{
+		Value a = BoxValue<vint>(i);
+		Value b = BoxValue<Point>(point);
+		Value c = BoxValue<Size>(size);
+		Value d = b;
+		point = UnboxValue<Point>(d);
+		size = UnboxValue<Size>(c);
+		UnboxValue<vint>(a);
+	});
+
+	auto heapBoxing = Measure([&](vint i)
+	{
+		Value a = HeapBox<vint>(i);
+		Value b = HeapBox<Point>(point);
+		Value c = HeapBox<Size>(size);
+		Value d = b;
+		point = UnboxValue<Point>(d);
+		size = UnboxValue<Size>(c);
+		UnboxValue<vint>(a);
+	});
+
+	TEST_PRINT(L"Box and unbox vint, Point and Size, " + itow(Rounds) + L" rounds");
+	PrintMeasurement(L"Inline", inlineBoxing);
+	PrintMeasurement(L"Heap", heapBoxing);
+	TEST_ASSERT(point == Point(1, 2) && size == Size(3, 4));
+	if (CanCountAllocations())
+	{
+		TEST_ASSERT(inlineBoxing.allocations == 0);
+		TEST_ASSERT(heapBoxing.allocations >= Rounds * 3);
+	}
+}
+
+TEST_CASE(TestValueBoxing_PropertyGetSet)
+{
+	auto composition = new GuiBoundsComposition;
+	Value thisObject = Value::From(composition);
+
+	auto td = GetTypeDescriptor<GuiBoundsComposition>();
+	auto sizeProp = td->GetPropertyByName(L"PreferredMinSize", true);
+	auto limitationProp = td->GetPropertyByName(L"MinSizeLimitation", true);
+	TEST_ASSERT(sizeProp && limitationProp);
+
+	auto inlineProperties = Measure([&](vint i)
+	{
+		auto size = UnboxValue<Size>(sizeProp->GetValue(thisObject));
+		sizeProp->SetValue(thisObject, BoxValue<Size>(Size(i, size.y)));
+		auto limitation = UnboxValue<GuiGraphicsComposition::MinSizeLimitation>(limitationProp->GetValue(thisObject));
+		limitationProp->SetValue(thisObject, BoxValue<GuiGraphicsComposition::MinSizeLimitation>(limitation));
+	});
+
+	auto heapProperties = Measure([&](vint i)
+	{
+		auto size = UnboxValue<Size>(sizeProp->GetValue(thisObject));
+		sizeProp->SetValue(thisObject, HeapBox<Size>(Size(i, size.y)));
+		auto limitation = UnboxValue<GuiGraphicsComposition::MinSizeLimitation>(limitationProp->GetValue(thisObject));
+		limitationProp->SetValue(thisObject, HeapBox<GuiGraphicsComposition::MinSizeLimitation>(limitation));
+	});
+
+	TEST_PRINT(L"Get and set GuiBoundsComposition::PreferredMinSize and MinSizeLimitation through IPropertyInfo, " + itow(Rounds) + L" rounds");
+	PrintMeasurement(L"Inline arguments", inlineProperties);
+	PrintMeasurement(L"Heap arguments", heapProperties);
+	TEST_ASSERT(composition->GetPreferredMinSize() == Size(Rounds - 1, 0));
+	if (CanCountAllocations())
+	{
+		TEST_ASSERT(inlineProperties.allocations < heapProperties.allocations);
+	}
+
+	thisObject = Value();
+	SafeDeleteComposition(composition);
+}
+
+TEST_CASE(TestValueBoxing_TypeDescriptorLookup)
+{
+	const vint Operations = 100;
+	WString typeName = TypeInfo<Rect>::content.typeName;
+	auto expected = GetTypeDescriptor(typeName);
+	TEST_ASSERT(expected && GetTypeDescriptor<Rect>() == expected);
+
+	ITypeDescriptor* found = nullptr;
+	auto cachedLookup = Measure([&](vint i)
+	{
+		for (vint j = 0; j < Operations; j++)
+		{
+			found = GetTypeDescriptor<Rect>();
+		}
+	});
+	TEST_ASSERT(found == expected);
+
+	found = nullptr;
+	auto nameLookup = Measure([&](vint i)
+	{
+		for (vint j = 0; j < Operations; j++)
+		{
+			found = GetTypeDescriptor(typeName);
+		}
+	});
+	TEST_ASSERT(found == expected);
+
+	Rect rect(1, 2, 3, 4);
+	auto boxing = Measure([&](vint i)
+	{
+		for (vint j = 0; j < Operations; j++)
+		{
+			rect = UnboxValue<Rect>(BoxValue<Rect>(rect));
+		}
+	});
+	TEST_ASSERT(rect == Rect(1, 2, 3, 4));
+
+	TEST_PRINT(L"Type descriptor of Rect, " + itow(Operations) + L" operations per round, " + itow(Rounds) + L" rounds");
+	PrintMeasurement(L"GetTypeDescriptor<Rect>()", cachedLookup);
+	PrintMeasurement(L"GetTypeDescriptor(name)", nameLookup);
+	PrintMeasurement(L"UnboxValue<Rect>(BoxValue<Rect>())", boxing);
+	if (CanCountAllocations())
+	{
+		TEST_ASSERT(cachedLookup.allocations == 0);
+		TEST_ASSERT(nameLookup.allocations == 0);
+	}
+}
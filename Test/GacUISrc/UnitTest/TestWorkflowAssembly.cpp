@@ -0,0 +1,190 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Import/VlppWorkflowCompiler.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::reflection::description;
+using namespace vl::workflow;
+using namespace vl::workflow::analyzer;
+using namespace vl::workflow::runtime;
+
+namespace workflow_assembly_test
+{
+	// classes are not used here, because several copies of the assembly are loaded at the same time and their types would have the same names
+	const wchar_t* AssemblyModule =
+		L"module assemblytest;\r\n"
+		L"using system::*;\r\n"
+		L"var g = 0;\r\n"
+		L"var names : string[] = {\"a\" \"b\"};\r\n"
+		L"func Fib(n : int) : int { if (n < 2) { return n; } return Fib(n - 1) + Fib(n - 2); }\r\n"
+		L"func Join(n : int) : string\r\n"
+		L"{\r\n"
+		L"	var s = \"\";\r\n"
+		L"	for (i in range [1, n]) { s = s & names[i % 2] & (i * 1.5); g = g + 1; }\r\n"
+		L"	return s;\r\n"
+		L"}\r\n"
+		L"func Catch(n : int) : string\r\n"
+		L"{\r\n"
+		L"	var s = \"\";\r\n"
+		L"	for (i in range [1, n])\r\n"
+		L"	{\r\n"
+		L"		try { if (i % 2 == 0) { raise \"e\" & i; } s = s & i; }\r\n"
+		L"		catch (ex) { s = s & \"[\" & ex.Message & \"]\"; }\r\n"
+		L"	}\r\n"
+		L"	return s;\r\n"
+		L"}\r\n"
+		L"func Closure(n : int) : int\r\n"
+		L"{\r\n"
+		L"	var c = n;\r\n"
+		L"	var f = func(x : int) : int { return x * c; };\r\n"
+		L"	return f(3) + (cast int \"4\");\r\n"
+		L"}\r\n"
+		L"func Global() : int { return g; }\r\n";
+
+	Ptr<WfAssembly> CompileModule()
+	{
+		List<WString> codes;
+		codes.Add(AssemblyModule);
+		List<Ptr<parsing::ParsingError>> errors;
+		auto assembly = Compile(WfLoadTable(), codes, errors);
+		TEST_ASSERT(errors.Count() == 0);
+		TEST_ASSERT(assembly);
+		return assembly;
+	}
+
+	// Run all functions in order and join their results
+	WString RunModule(Ptr<WfAssembly> assembly)
+	{
+		auto context = MakePtr<WfRuntimeGlobalContext>(assembly);
+		LoadFunction<void()>(context, L"<initialize>")();
+		WString result;
+		result += itow(LoadFunction<vint(vint)>(context, L"Fib")(10)) + L";";
+		result += LoadFunction<WString(vint)>(context, L"Join")(3) + L";";
+		result += LoadFunction<WString(vint)>(context, L"Catch")(4) + L";";
+		result += itow(LoadFunction<vint(vint)>(context, L"Closure")(5)) + L";";
+		result += itow(LoadFunction<vint()>(context, L"Global")());
+		return result;
+	}
+
+	void ToBytes(MemoryStream& stream, Array<vuint8_t>& bytes)
+	{
+		bytes.Resize((vint)stream.Size());
+		stream.SeekFromBegin(0);
+		if (bytes.Count() > 0)
+		{
+			stream.Read(&bytes[0], bytes.Count());
+		}
+		stream.SeekFromBegin(0);
+	}
+
+	bool SameBytes(Array<vuint8_t>& a, Array<vuint8_t>& b)
+	{
+		return a.Count() == b.Count() && (a.Count() == 0 || memcmp(&a[0], &b[0], a.Count()) == 0);
+	}
+
+	// The compact format only writes what an instruction uses, so two assemblies are the same if their compact serializations are the same
+	void SerializeCompact(Ptr<WfAssembly> assembly, bool includeDebugInfo, Array<vuint8_t>& bytes)
+	{
+		MemoryStream stream;
+		assembly->Serialize(stream, includeDebugInfo);
+		ToBytes(stream, bytes);
+	}
+
+	Ptr<WfAssembly> Load(Array<vuint8_t>& bytes)
+	{
+		MemoryWrapperStream stream(&bytes[0], bytes.Count());
+		return new WfAssembly(stream);
+	}
+}
+using namespace workflow_assembly_test;
+
+TEST_CASE(TestWorkflowAssembly_RoundTrip)
+{
+	auto assembly = CompileModule();
+	auto expected = RunModule(assembly);
+	TEST_ASSERT(expected == L"55;b1.5a3b4.5;1[e2]3[e4];19;3");
+
+	Array<vuint8_t> compact, compactWithoutDebugInfo, legacy;
+	SerializeCompact(assembly, true, compact);
+	SerializeCompact(assembly, false, compactWithoutDebugInfo);
+	{
+		MemoryStream stream;
+		assembly->SerializeLegacy(stream);
+		ToBytes(stream, legacy);
+	}
+	TEST_ASSERT(compact.Count() < legacy.Count());
+	TEST_ASSERT(compactWithoutDebugInfo.Count() < compact.Count());
+	TEST_PRINT(L"Assembly with " + itow(assembly->instructions.Count()) + L" instructions:");
+	TEST_PRINT(L"    Legacy: " + itow(legacy.Count()) + L" bytes");
+	TEST_PRINT(L"    Compact: " + itow(compact.Count()) + L" bytes");
+	TEST_PRINT(L"    Compact without debug information: " + itow(compactWithoutDebugInfo.Count()) + L" bytes");
+
+	// every format runs the same, and is written back to the same compact format
+	{
+		auto loaded = Load(compact);
+		TEST_ASSERT(loaded->GetInstructionCount() == assembly->instructions.Count());
+		TEST_ASSERT(RunModule(loaded) == expected);
+		Array<vuint8_t> bytes;
+		SerializeCompact(loaded, true, bytes);
+		TEST_ASSERT(SameBytes(bytes, compact));
+	}
+	{
+		auto loaded = Load(compactWithoutDebugInfo);
+		TEST_ASSERT(loaded->GetInstructionCount() == assembly->instructions.Count());
+		TEST_ASSERT(RunModule(loaded) == expected);
+		Array<vuint8_t> bytes;
+		SerializeCompact(loaded, false, bytes);
+		TEST_ASSERT(SameBytes(bytes, compactWithoutDebugInfo));
+	}
+	{
+		auto loaded = Load(legacy);
+		TEST_ASSERT(loaded->instructions.Count() == assembly->instructions.Count());
+		TEST_ASSERT(RunModule(loaded) == expected);
+		Array<vuint8_t> bytes;
+		SerializeCompact(loaded, true, bytes);
+		TEST_ASSERT(SameBytes(bytes, compact));
+	}
+}
+
+TEST_CASE(TestWorkflowAssembly_LazyDecoding)
+{
+	auto assembly = CompileModule();
+	Array<vuint8_t> compact;
+	SerializeCompact(assembly, false, compact);
+	auto loaded = Load(compact);
+
+	// instructions are not allocated before they are decoded
+	vint count = assembly->instructions.Count();
+	TEST_ASSERT(loaded->instructions.Count() == 0);
+	TEST_ASSERT(loaded->GetInstructionCount() == count);
+	TEST_ASSERT(!loaded->insBeforeCodegen);
+	TEST_ASSERT(!loaded->insAfterCodegen);
+
+	// calling a function decodes it
+	auto context = MakePtr<WfRuntimeGlobalContext>(loaded);
+	LoadFunction<void()>(context, L"<initialize>")();
+	TEST_ASSERT(LoadFunction<vint(vint)>(context, L"Fib")(10) == 55);
+	TEST_ASSERT(loaded->instructions.Count() == 0);
+	auto fib = loaded->functions[loaded->functionByName[L"Fib"][0]];
+	bool same = true;
+	for (vint i = fib->firstInstruction; i <= fib->lastInstruction; i++)
+	{
+		same &= loaded->GetInstruction(i).code == assembly->instructions[i].code;
+		same &= loaded->GetInstruction(i).countParameter == assembly->instructions[i].countParameter;
+	}
+	TEST_ASSERT(same);
+
+	// without debug information every instruction is mapped to no code
+	loaded->LoadDebugInfo();
+	TEST_ASSERT(loaded->insBeforeCodegen->instructionCodeMapping.Count() == count);
+	TEST_ASSERT(loaded->insAfterCodegen->instructionCodeMapping.Count() == count);
+	TEST_ASSERT(loaded->insBeforeCodegen->instructionCodeMapping[0].codeIndex == -1);
+
+	// instructions that are already referenced by the runtime context are still valid after all instructions are decoded
+	loaded->LoadAllInstructions();
+	TEST_ASSERT(loaded->instructions.Count() == count);
+	TEST_ASSERT(loaded->GetInstructionCount() == count);
+	TEST_ASSERT(LoadFunction<vint(vint)>(context, L"Fib")(10) == 55);
+	TEST_ASSERT(LoadFunction<WString(vint)>(context, L"Join")(3) == L"b1.5a3b4.5");
+}
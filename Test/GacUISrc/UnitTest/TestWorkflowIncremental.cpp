@@ -0,0 +1,187 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Import/VlppWorkflowCompiler.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::workflow;
+using namespace vl::workflow::analyzer;
+using namespace vl::workflow::cppcodegen;
+using namespace vl::presentation;
+
+namespace workflow_incremental_test
+{
+	const vint ModuleCount = 24;
+	const vint GroupSize = 6;
+
+	// every class except the first one in a group inherits the previous one, and every function calls the previous one in the same group
+	WString MakeModule(vint index, const WString& extraMember = WString::Empty, const WString& extraCode = WString::Empty)
+	{
+		auto name = itow(index);
+		bool first = index % GroupSize == 0;
+		auto previous = itow(index - 1);
+		return
+			L"module m" + name + L";\r\n"
+			L"using system::*;\r\n"
+			L"namespace demo\r\n"
+			L"{\r\n"
+			L"	class C" + name + (first ? WString::Empty : L" : C" + previous) + L"\r\n"
+			L"	{\r\n"
+			L"		var v" + name + L" : int = " + name + L";\r\n"
+			L"		new(){}\r\n"
+			L"		func Get" + name + L"() : int { return v" + name + (first ? WString::Empty : L" + Get" + previous + L"()") + L"; }\r\n"
+			+ extraMember +
+			L"	}\r\n"
+			L"	func F" + name + L"(x" + name + L" : int) : int { return x" + name + L" + " + name + (first ? WString::Empty : L" + F" + previous + L"(x" + name + L")") + extraCode + L"; }\r\n"
+			L"}\r\n";
+	}
+
+	void Rebuild(WfLexicalScopeManager& manager, List<WString>& codes, bool incremental)
+	{
+		manager.Clear(true, true);
+		FOREACH(WString, code, codes)
+		{
+			manager.AddModule(code);
+		}
+		manager.Rebuild(true, incremental);
+	}
+
+	WString GenerateCpp(WfLexicalScopeManager& manager)
+	{
+		auto input = MakePtr<WfCppInput>(L"Demo");
+		auto output = GenerateCppFiles(input, &manager);
+		WString cpp;
+		for (vint i = 0; i < output->cppFiles.Count(); i++)
+		{
+			cpp += L"// " + output->cppFiles.Keys()[i] + L"\r\n" + output->cppFiles.Values()[i];
+		}
+		return cpp;
+	}
+
+	// An incremental rebuild reports the same errors and generates the same C++ code as a full rebuild
+	// assemblies are not compared, because types are ordered differently in different managers
+	bool SameAsFullRebuild(WfLexicalScopeManager& incremental, List<WString>& codes)
+	{
+		WfLexicalScopeManager full(incremental.parsingTable);
+		Rebuild(full, codes, false);
+
+		if (incremental.errors.Count() != full.errors.Count()) return false;
+		for (vint i = 0; i < full.errors.Count(); i++)
+		{
+			if (incremental.errors[i]->errorMessage != full.errors[i]->errorMessage) return false;
+			if (incremental.errors[i]->codeRange != full.errors[i]->codeRange) return false;
+		}
+		if (full.errors.Count() > 0) return true;
+
+		return GenerateCpp(incremental) == GenerateCpp(full);
+	}
+
+	void CopyModules(WfLexicalScopeManager& manager, List<Ptr<WfModule>>& modules)
+	{
+		CopyFrom(modules, manager.GetModules());
+	}
+
+	// Indices of modules that are analyzed again, kept modules reuse their syntax trees
+	WString AnalyzedModules(WfLexicalScopeManager& manager, List<Ptr<WfModule>>& previousModules)
+	{
+		WString analyzed;
+		for (vint i = 0; i < manager.GetModules().Count(); i++)
+		{
+			if (i >= previousModules.Count() || manager.GetModules()[i] != previousModules[i])
+			{
+				analyzed += L"[" + itow(i) + L"]";
+			}
+		}
+		return analyzed;
+	}
+}
+using namespace workflow_incremental_test;
+
+TEST_CASE(TestWorkflowIncremental_SameAsFullRebuild)
+{
+	WfLexicalScopeManager manager(WfLoadTable());
+	List<WString> codes;
+	for (vint i = 0; i < ModuleCount; i++)
+	{
+		codes.Add(MakeModule(i));
+	}
+	List<Ptr<WfModule>> previousModules;
+
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(manager.errors.Count() == 0);
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// nothing is analyzed again if nothing changes
+	CopyModules(manager, previousModules);
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(AnalyzedModules(manager, previousModules) == L"");
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// a function body is changed in the last module of a group, which no module depends on
+	codes[11] = MakeModule(11, WString::Empty, L" + 100");
+	CopyModules(manager, previousModules);
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(AnalyzedModules(manager, previousModules) == L"[11]");
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// a member is added to the first class in a group, so all modules in this group are analyzed again
+	codes[12] = MakeModule(12, L"		func Extra() : int { return 1; }\r\n");
+	CopyModules(manager, previousModules);
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(AnalyzedModules(manager, previousModules) == L"[12][13][14][15][16][17]");
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// the previous function is used with a wrong type, errors are the same as a full rebuild
+	codes[14] = MakeModule(14, WString::Empty, L" + F13(\"x\")");
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(manager.errors.Count() > 0);
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// results after errors are not reused, and the next rebuild is still correct
+	codes[14] = MakeModule(14);
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(manager.errors.Count() == 0);
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// the last module is removed, no module depends on it and namespaces declared in it still exist in other modules
+	codes.RemoveAt(ModuleCount - 1);
+	CopyModules(manager, previousModules);
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(manager.errors.Count() == 0);
+	TEST_ASSERT(AnalyzedModules(manager, previousModules) == L"");
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+
+	// a module is removed, modules depending on it report errors
+	codes.RemoveAt(ModuleCount - 3);
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(manager.errors.Count() > 0);
+	TEST_ASSERT(SameAsFullRebuild(manager, codes));
+}
+
+TEST_CASE(TestWorkflowIncremental_Benchmark)
+{
+	auto table = WfLoadTable();
+	WfLexicalScopeManager manager(table);
+	List<WString> codes;
+	for (vint i = 0; i < ModuleCount * 4; i++)
+	{
+		codes.Add(MakeModule(i));
+	}
+	Rebuild(manager, codes, true);
+	TEST_ASSERT(manager.errors.Count() == 0);
+
+	codes[GroupSize - 1] = MakeModule(GroupSize - 1, WString::Empty, L" + 100");
+	vint64_t start = GuiStartupTrace::GetMicroseconds();
+	Rebuild(manager, codes, true);
+	vint64_t incrementalTime = GuiStartupTrace::GetMicroseconds() - start;
+	TEST_ASSERT(manager.errors.Count() == 0);
+
+	WfLexicalScopeManager full(table);
+	start = GuiStartupTrace::GetMicroseconds();
+	Rebuild(full, codes, false);
+	vint64_t fullTime = GuiStartupTrace::GetMicroseconds() - start;
+	TEST_ASSERT(full.errors.Count() == 0);
+
+	TEST_PRINT(L"Rebuild " + itow(codes.Count()) + L" modules after one module is changed, including parsing:");
+	TEST_PRINT(L"    Incremental: " + i64tow(incrementalTime / 1000) + L" ms");
+	TEST_PRINT(L"    Full: " + i64tow(fullTime / 1000) + L" ms");
+}
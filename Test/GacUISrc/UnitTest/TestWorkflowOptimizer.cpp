@@ -0,0 +1,149 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Import/VlppWorkflowCompiler.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::reflection::description;
+using namespace vl::workflow;
+using namespace vl::workflow::analyzer;
+using namespace vl::workflow::runtime;
+using namespace vl::presentation;
+
+namespace workflow_optimizer_test
+{
+	// classes are not used here, because both assemblies are loaded at the same time and their types would have the same names
+	const wchar_t* OptimizerModule =
+		L"module optimizertest;\r\n"
+		L"using system::*;\r\n"
+		L"var g = 0;\r\n"
+		L"func Fib(n : int) : int { if (n < 2) { return n; } return Fib(n - 1) + Fib(n - 2); }\r\n"
+		L"func Loop(n : int) : int\r\n"
+		L"{\r\n"
+		L"	var sum = 0;\r\n"
+		L"	var i = 0;\r\n"
+		L"	while (i < n) { sum = sum + i % 7; i = i + 1; g = g + 1; }\r\n"
+		L"	return sum;\r\n"
+		L"}\r\n"
+		L"func Consts() : int\r\n"
+		L"{\r\n"
+		L"	var a = 1 + 2 * 3;\r\n"
+		L"	if (true) { a = a + 1; } else { a = a - 1; }\r\n"
+		L"	while (false) { a = 0; }\r\n"
+		L"	var b = not false;\r\n"
+		L"	if (b and (true or false)) { a = a + 10; }\r\n"
+		L"	return a - -4;\r\n"
+		L"}\r\n"
+		L"func Breaks(n : int) : int\r\n"
+		L"{\r\n"
+		L"	var s = 0;\r\n"
+		L"	for (i in range [1, n])\r\n"
+		L"	{\r\n"
+		L"		if (i % 3 == 0) { continue; }\r\n"
+		L"		if (i > 50) { break; }\r\n"
+		L"		s = s + i;\r\n"
+		L"	}\r\n"
+		L"	var j = 0;\r\n"
+		L"	while (true) { j = j + 1; if (j == 5) { break; } }\r\n"
+		L"	return s + j + (n > 10 ? 1000 : 2000);\r\n"
+		L"}\r\n"
+		L"func Closure(n : int) : int\r\n"
+		L"{\r\n"
+		L"	var c = 2;\r\n"
+		L"	var s = 0;\r\n"
+		L"	var f = func(x : int) : int { return x + c; };\r\n"
+		L"	for (i in range [1, n]) { s = f(s); }\r\n"
+		L"	return s;\r\n"
+		L"}\r\n"
+		L"func Catch(n : int) : string\r\n"
+		L"{\r\n"
+		L"	var s = \"\";\r\n"
+		L"	for (i in range [1, n])\r\n"
+		L"	{\r\n"
+		L"		try { if (i % 2 == 0) { raise \"e\" & i; } s = s & i; }\r\n"
+		L"		catch (ex) { s = s & \"[\" & ex.Message & \"]\"; }\r\n"
+		L"	}\r\n"
+		L"	return s;\r\n"
+		L"}\r\n"
+		L"func Global() : int { return g; }\r\n";
+
+	Ptr<WfAssembly> CompileModule()
+	{
+		List<WString> codes;
+		codes.Add(OptimizerModule);
+		List<Ptr<parsing::ParsingError>> errors;
+		auto assembly = Compile(WfLoadTable(), codes, errors);
+		TEST_ASSERT(errors.Count() == 0);
+		TEST_ASSERT(assembly);
+		return assembly;
+	}
+
+	// Run all functions in order and join their results
+	WString RunModule(Ptr<WfRuntimeGlobalContext> context)
+	{
+		LoadFunction<void()>(context, L"<initialize>")();
+		WString result;
+		result += itow(LoadFunction<vint(vint)>(context, L"Fib")(15)) + L";";
+		result += itow(LoadFunction<vint(vint)>(context, L"Loop")(1000)) + L";";
+		result += itow(LoadFunction<vint()>(context, L"Consts")()) + L";";
+		result += itow(LoadFunction<vint(vint)>(context, L"Breaks")(100)) + L";";
+		result += itow(LoadFunction<vint(vint)>(context, L"Breaks")(5)) + L";";
+		result += itow(LoadFunction<vint(vint)>(context, L"Closure")(100)) + L";";
+		result += LoadFunction<WString(vint)>(context, L"Catch")(5) + L";";
+		result += itow(LoadFunction<vint()>(context, L"Global")());
+		return result;
+	}
+
+	// Time to run Loop in milliseconds
+	vint64_t MeasureLoop(Ptr<WfRuntimeGlobalContext> context)
+	{
+		auto loop = LoadFunction<vint(vint)>(context, L"Loop");
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		loop(1000000);
+		return (GuiStartupTrace::GetMicroseconds() - start) / 1000;
+	}
+}
+using namespace workflow_optimizer_test;
+
+TEST_CASE(TestWorkflowOptimizer_SameResults)
+{
+	auto unoptimized = CompileModule();
+	auto optimized = CompileModule();
+	vint count = optimized->instructions.Count();
+	vint removed = OptimizeAssembly(optimized);
+	TEST_ASSERT(removed > 0);
+	TEST_ASSERT(optimized->instructions.Count() == count - removed);
+	TEST_ASSERT(optimized->insBeforeCodegen->instructionCodeMapping.Count() == optimized->instructions.Count());
+	TEST_ASSERT(optimized->insAfterCodegen->instructionCodeMapping.Count() == optimized->instructions.Count());
+	TEST_PRINT(L"Instructions: " + itow(count) + L" unoptimized, " + itow(optimized->instructions.Count()) + L" optimized");
+
+	// an optimized assembly is still an ordinary assembly, it survives serialization
+	MemoryStream stream;
+	optimized->Serialize(stream);
+	stream.SeekFromBegin(0);
+	Ptr<WfAssembly> loaded = new WfAssembly(stream);
+	TEST_ASSERT(loaded->GetInstructionCount() == optimized->instructions.Count());
+
+	auto expected = RunModule(MakePtr<WfRuntimeGlobalContext>(unoptimized));
+	TEST_ASSERT(expected == L"610;2997;22;1872;2017;200;1[e2]3[e4]5;1000");
+	TEST_ASSERT(RunModule(MakePtr<WfRuntimeGlobalContext>(optimized)) == expected);
+	TEST_ASSERT(RunModule(MakePtr<WfRuntimeGlobalContext>(loaded)) == expected);
+}
+
+TEST_CASE(TestWorkflowOptimizer_Benchmark)
+{
+	auto unoptimized = CompileModule();
+	auto optimized = CompileModule();
+	OptimizeAssembly(optimized);
+
+	auto unoptimizedContext = MakePtr<WfRuntimeGlobalContext>(unoptimized);
+	auto optimizedContext = MakePtr<WfRuntimeGlobalContext>(optimized);
+	LoadFunction<void()>(unoptimizedContext, L"<initialize>")();
+	LoadFunction<void()>(optimizedContext, L"<initialize>")();
+
+	auto unoptimizedTime = MeasureLoop(unoptimizedContext);
+	auto optimizedTime = MeasureLoop(optimizedContext);
+	TEST_PRINT(L"Run a Workflow loop 1000000 times:");
+	TEST_PRINT(L"    Unoptimized: " + i64tow(unoptimizedTime) + L" ms");
+	TEST_PRINT(L"    Optimized: " + i64tow(optimizedTime) + L" ms");
+}
@@ -0,0 +1,228 @@
+#include "../../../Source/GacUI.h"
+#include "../../../Import/VlppWorkflowCompiler.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::reflection::description;
+using namespace vl::workflow;
+using namespace vl::workflow::analyzer;
+using namespace vl::workflow::runtime;
+using namespace vl::presentation;
+
+namespace workflow_slots_test
+{
+	const vint Calls = 1000000;
+
+	// Right is not the first base class of Both, so members of Right are not at the same slots as in instances of Right
+	const wchar_t* SlotsModule =
+		L"module slotstest;\r\n"
+		L"using system::*;\r\n"
+		L"namespace slotstest\r\n"
+		L"{\r\n"
+		L"	class Base\r\n"
+		L"	{\r\n"
+		L"		var x : int = 1;\r\n"
+		L"		event BaseChanged(int);\r\n"
+		L"		new(){}\r\n"
+		L"		func FireBase(v : int) : void { BaseChanged(v); }\r\n"
+		L"	}\r\n"
+		L"	class Left : Base\r\n"
+		L"	{\r\n"
+		L"		var l : int = 2;\r\n"
+		L"		event LeftChanged();\r\n"
+		L"		new(){}\r\n"
+		L"	}\r\n"
+		L"	class Right\r\n"
+		L"	{\r\n"
+		L"		var r : string = \"r\";\r\n"
+		L"		new(){}\r\n"
+		L"	}\r\n"
+		L"	class Both : Left, Right\r\n"
+		L"	{\r\n"
+		L"		var b : int = 3;\r\n"
+		L"		new(){}\r\n"
+		L"	}\r\n"
+		L"	interface IObserved\r\n"
+		L"	{\r\n"
+		L"		event Observed(int);\r\n"
+		L"		func Get() : int;\r\n"
+		L"	}\r\n"
+		L"	func Sum(o : Left^) : int { return o.x + o.l; }\r\n"
+		L"	func SumBoth(o : Both^) : string { return (o.x + o.l + o.b) & o.r; }\r\n"
+		L"	func CreateObserved() : IObserved^ { return new IObserved^ { override func Get() : int { return 0; } }; }\r\n"
+		L"}\r\n";
+
+	class SlotsModuleScope : public Object
+	{
+	public:
+		Ptr<WfRuntimeGlobalContext>		context;
+
+		SlotsModuleScope()
+		{
+			List<WString> codes;
+			codes.Add(SlotsModule);
+			List<Ptr<parsing::ParsingError>> errors;
+			auto assembly = Compile(WfLoadTable(), codes, errors);
+			TEST_ASSERT(errors.Count() == 0);
+			context = new WfRuntimeGlobalContext(assembly);
+			LoadFunction<void()>(context, L"<initialize>")();
+		}
+
+		~SlotsModuleScope()
+		{
+			context = nullptr;
+		}
+
+		Value Create(const WString& typeName)
+		{
+			auto td = GetTypeDescriptor(typeName);
+			Array<Value> arguments;
+			return td->GetConstructorGroup()->GetMethod(0)->Invoke(Value(), arguments);
+		}
+	};
+
+	IPropertyInfo* GetProperty(const WString& typeName, const WString& name)
+	{
+		return GetTypeDescriptor(typeName)->GetPropertyByName(name, true);
+	}
+
+	IEventInfo* GetEvent(const WString& typeName, const WString& name)
+	{
+		return GetTypeDescriptor(typeName)->GetEventByName(name, true);
+	}
+
+	Ptr<IValueFunctionProxy> MakeHandler(const Func<void(vint)>& handler)
+	{
+		auto proxy = handler;
+		return UnboxValue<Ptr<IValueFunctionProxy>>(BoxParameter<Func<void(vint)>>(proxy));
+	}
+
+	Ptr<IValueList> MakeArguments(vint value)
+	{
+		auto arguments = IValueList::Create();
+		arguments->Add(BoxValue<vint>(value));
+		return arguments;
+	}
+
+	// Average time of a call in nanoseconds
+	double MeasureCalls(const Func<void(vint)>& call)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < Calls; i++)
+		{
+			call(i);
+		}
+		return (double)(GuiStartupTrace::GetMicroseconds() - start) * 1000 / Calls;
+	}
+}
+using namespace workflow_slots_test;
+
+TEST_CASE(TestWorkflowSlots_Fields)
+{
+	SlotsModuleScope scope;
+	auto left = scope.Create(L"slotstest::Left");
+	auto x = GetProperty(L"slotstest::Left", L"x");
+	auto l = GetProperty(L"slotstest::Left", L"l");
+	TEST_ASSERT(UnboxValue<vint>(x->GetValue(left)) == 1);
+	TEST_ASSERT(UnboxValue<vint>(l->GetValue(left)) == 2);
+
+	// fields set through reflection are seen by Workflow code, and they are not stored in internal properties
+	x->SetValue(left, BoxValue<vint>(10));
+	l->SetValue(left, BoxValue<vint>(20));
+	TEST_ASSERT(LoadFunction<vint(Value)>(scope.context, L"slotstest::Sum")(left) == 30);
+	TEST_ASSERT(!left.GetRawPtr()->GetInternalProperty(L"WfField::FieldRecord"));
+
+	// every object has its own slots
+	auto another = scope.Create(L"slotstest::Left");
+	TEST_ASSERT(UnboxValue<vint>(x->GetValue(another)) == 1);
+	TEST_ASSERT(UnboxValue<vint>(x->GetValue(left)) == 10);
+}
+
+TEST_CASE(TestWorkflowSlots_MultipleInheritance)
+{
+	SlotsModuleScope scope;
+	auto both = scope.Create(L"slotstest::Both");
+	auto x = GetProperty(L"slotstest::Base", L"x");
+	auto l = GetProperty(L"slotstest::Left", L"l");
+	auto r = GetProperty(L"slotstest::Right", L"r");
+	auto b = GetProperty(L"slotstest::Both", L"b");
+	TEST_ASSERT(LoadFunction<WString(Value)>(scope.context, L"slotstest::SumBoth")(both) == L"6r");
+
+	// Both inherits Base and Left through Left, and Right after them
+	x->SetValue(both, BoxValue<vint>(100));
+	l->SetValue(both, BoxValue<vint>(200));
+	r->SetValue(both, BoxValue<WString>(L"!"));
+	b->SetValue(both, BoxValue<vint>(300));
+	TEST_ASSERT(UnboxValue<vint>(x->GetValue(both)) == 100);
+	TEST_ASSERT(UnboxValue<vint>(l->GetValue(both)) == 200);
+	TEST_ASSERT(UnboxValue<WString>(r->GetValue(both)) == L"!");
+	TEST_ASSERT(UnboxValue<vint>(b->GetValue(both)) == 300);
+	TEST_ASSERT(LoadFunction<WString(Value)>(scope.context, L"slotstest::SumBoth")(both) == L"600!");
+}
+
+TEST_CASE(TestWorkflowSlots_Events)
+{
+	SlotsModuleScope scope;
+	auto both = scope.Create(L"slotstest::Both");
+	auto baseChanged = GetEvent(L"slotstest::Base", L"BaseChanged");
+	auto fireBase = GetTypeDescriptor(L"slotstest::Base")->GetMethodGroupByName(L"FireBase", true)->GetMethod(0);
+
+	vint received = 0;
+	auto handler = baseChanged->Attach(both, MakeHandler([&](vint value) { received += value; }));
+	baseChanged->Invoke(both, MakeArguments(1));
+	Array<Value> arguments(1);
+	arguments[0] = BoxValue<vint>(10);
+	fireBase->Invoke(both, arguments);
+	TEST_ASSERT(received == 11);
+	TEST_ASSERT(!both.GetRawPtr()->GetInternalProperty(L"WfEvent::EventRecord"));
+
+	// handlers are attached to one object
+	auto another = scope.Create(L"slotstest::Both");
+	baseChanged->Invoke(another, MakeArguments(100));
+	TEST_ASSERT(received == 11);
+
+	TEST_ASSERT(baseChanged->Detach(both, handler));
+	TEST_ASSERT(!handler->IsAttached());
+	TEST_ASSERT(!baseChanged->Detach(both, handler));
+	baseChanged->Invoke(both, MakeArguments(1000));
+	TEST_ASSERT(received == 11);
+
+	// events of interfaces are still stored in internal properties
+	auto observedObject = LoadFunction<Value()>(scope.context, L"slotstest::CreateObserved")();
+	auto observed = GetEvent(L"slotstest::IObserved", L"Observed");
+	observed->Attach(observedObject, MakeHandler([&](vint value) { received += value; }));
+	observed->Invoke(observedObject, MakeArguments(5));
+	TEST_ASSERT(received == 16);
+}
+
+TEST_CASE(TestWorkflowSlots_Benchmark)
+{
+	SlotsModuleScope scope;
+	auto left = scope.Create(L"slotstest::Left");
+	auto both = scope.Create(L"slotstest::Both");
+	auto x = GetProperty(L"slotstest::Base", L"x");
+	auto l = GetProperty(L"slotstest::Left", L"l");
+	auto baseChanged = GetEvent(L"slotstest::Base", L"BaseChanged");
+	auto observedObject = LoadFunction<Value()>(scope.context, L"slotstest::CreateObserved")();
+	auto observed = GetEvent(L"slotstest::IObserved", L"Observed");
+
+	vint received = 0;
+	baseChanged->Attach(left, MakeHandler([&](vint value) { received += value; }));
+	observed->Attach(observedObject, MakeHandler([&](vint value) { received += value; }));
+	auto arguments = MakeArguments(1);
+	Value value = BoxValue<vint>(1);
+
+	auto ownField = MeasureCalls([&](vint) { l->SetValue(left, value); l->GetValue(left); });
+	auto baseField = MeasureCalls([&](vint) { x->SetValue(left, value); x->GetValue(left); });
+	auto multipleBaseField = MeasureCalls([&](vint) { x->SetValue(both, value); x->GetValue(both); });
+	auto classEvent = MeasureCalls([&](vint) { baseChanged->Invoke(left, arguments); });
+	auto interfaceEvent = MeasureCalls([&](vint) { observed->Invoke(observedObject, arguments); });
+	TEST_ASSERT(received == Calls * 2);
+
+	TEST_PRINT(L"Workflow members through reflection, nanoseconds per call:");
+	TEST_PRINT(L"    IPropertyInfo set and get, own field: " + ftow(ownField));
+	TEST_PRINT(L"    IPropertyInfo set and get, base class field: " + ftow(baseField));
+	TEST_PRINT(L"    IPropertyInfo set and get, base class field with multiple inheritance: " + ftow(multipleBaseField));
+	TEST_PRINT(L"    IEventInfo invoke, class event in a slot: " + ftow(classEvent));
+	TEST_PRINT(L"    IEventInfo invoke, interface event in internal properties: " + ftow(interfaceEvent));
+}
@@ -0,0 +1,160 @@
+#include "../../../Source/GacUI.h"
+
+using namespace vl;
+using namespace vl::collections;
+using namespace vl::stream;
+using namespace vl::parsing;
+using namespace vl::parsing::xml;
+using namespace vl::presentation;
+
+namespace xml_reader_test
+{
+	const vint Rounds = 5;
+
+	void WriteUtf8(const WString& input, MemoryStream& stream)
+	{
+		{
+			Utf8Encoder encoder;
+			EncoderStream encoderStream(stream, encoder);
+			StreamWriter writer(encoderStream);
+			writer.WriteString(input);
+		}
+		stream.SeekFromBegin(0);
+	}
+
+	Ptr<XmlDocument> ParseWithReader(const WString& input, List<Ptr<ParsingError>>& errors)
+	{
+		return XmlParseDocument(input, errors);
+	}
+
+	bool HasError(List<Ptr<ParsingError>>& errors, const WString& message)
+	{
+		FOREACH(Ptr<ParsingError>, error, errors)
+		{
+			if (INVLOC.FindFirst(error->errorMessage, message, Locale::None).key != -1)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// A resource-like document with the given number of folders, every folder contains ten items
+	WString GenerateDocument(vint folders)
+	{
+		WString xml = L"<?xml version=\"1.0\" encoding=\"utf-8\"?>\r\n<!--generated-->\r\n<Resource>\r\n";
+		for (vint i = 0; i < folders; i++)
+		{
+			xml += L"  <Folder name=\"Folder" + itow(i) + L"\">\r\n";
+			for (vint j = 0; j < 10; j++)
+			{
+				xml += L"    <Text name=\"Item" + itow(j) + L"\" kind=\"&quot;text&quot;\">Item &lt;" + itow(i * 10 + j) + L"&gt;</Text>\r\n";
+			}
+			xml += L"    <Script><![CDATA[func F" + itow(i) + L"() : int { return 1 < 2 ? 1 : 0; }]]></Script>\r\n";
+			xml += L"  </Folder>\r\n";
+		}
+		xml += L"</Resource>\r\n";
+		return xml;
+	}
+
+	// Average time to run a parser in milliseconds
+	vint64_t Measure(const Func<void()>& parser)
+	{
+		vint64_t start = GuiStartupTrace::GetMicroseconds();
+		for (vint i = 0; i < Rounds; i++)
+		{
+			parser();
+		}
+		return (GuiStartupTrace::GetMicroseconds() - start) / Rounds / 1000;
+	}
+}
+using namespace xml_reader_test;
+
+TEST_CASE(TestXmlReader_SameDocument)
+{
+	auto input = GenerateDocument(20);
+	auto expected = XmlParseDocument(input, XmlLoadTable());
+	TEST_ASSERT(expected);
+
+	List<Ptr<ParsingError>> errors;
+	auto fromString = ParseWithReader(input, errors);
+	TEST_ASSERT(errors.Count() == 0);
+	TEST_ASSERT(XmlToString(fromString) == XmlToString(expected));
+	TEST_ASSERT(fromString->codeRange == expected->codeRange);
+	TEST_ASSERT(fromString->rootElement->codeRange == expected->rootElement->codeRange);
+
+	MemoryStream stream;
+	WriteUtf8(input, stream);
+	auto fromStream = XmlParseDocument(stream, errors);
+	TEST_ASSERT(errors.Count() == 0);
+	TEST_ASSERT(XmlToString(fromStream) == XmlToString(expected));
+	TEST_ASSERT(fromStream->rootElement->codeRange == expected->rootElement->codeRange);
+}
+
+TEST_CASE(TestXmlReader_Regressions)
+{
+	// a closing tag must match the element
+	{
+		List<Ptr<ParsingError>> errors;
+		TEST_ASSERT(!ParseWithReader(L"<a><b></a></b>", errors));
+		TEST_ASSERT(HasError(errors, L"does not match"));
+	}
+
+	// ">" is accepted in texts and attribute values
+	{
+		List<Ptr<ParsingError>> errors;
+		auto document = ParseWithReader(L"<a x=\"1>0\">2 > 1</a>", errors);
+		TEST_ASSERT(errors.Count() == 0);
+		TEST_ASSERT(document->rootElement->attributes[0]->value.value == L"1>0");
+		auto text = document->rootElement->subNodes[0].Cast<XmlText>();
+		TEST_ASSERT(text);
+		TEST_ASSERT(text->content.value == L"2 > 1");
+	}
+
+	// comments after the root element are accepted but not kept
+	{
+		List<Ptr<ParsingError>> errors;
+		auto document = ParseWithReader(L"<!--before--><a/><!--after-->", errors);
+		TEST_ASSERT(errors.Count() == 0);
+		TEST_ASSERT(document->prologs.Count() == 1);
+		TEST_ASSERT(document->rootElement->name.value == L"a");
+		TEST_ASSERT(document->rootElement->subNodes.Count() == 0);
+		TEST_ASSERT(INVLOC.FindFirst(XmlToString(document), L"after", Locale::None).key == -1);
+	}
+
+	// a document without a root element is an error
+	{
+		List<Ptr<ParsingError>> errors;
+		TEST_ASSERT(!ParseWithReader(L"<!--only a comment-->", errors));
+		TEST_ASSERT(errors.Count() > 0);
+	}
+}
+
+TEST_CASE(TestXmlReader_Benchmark)
+{
+	auto input = GenerateDocument(2000);
+	MemoryStream stream;
+	WriteUtf8(input, stream);
+	auto table = XmlLoadTable();
+
+	auto tableTime = Measure([&]()
+	{
+		XmlParseDocument(input, table);
+	});
+	auto stringTime = Measure([&]()
+	{
+		List<Ptr<ParsingError>> errors;
+		ParseWithReader(input, errors);
+	});
+	auto streamTime = Measure([&]()
+	{
+		List<Ptr<ParsingError>> errors;
+		stream.SeekFromBegin(0);
+		XmlParseDocument(stream, errors);
+	});
+
+	TEST_PRINT(L"Parse an XML document of " + itow(input.Length()) + L" characters, average of " + itow(Rounds) + L" rounds:");
+	TEST_PRINT(L"    Parsing table: " + i64tow(tableTime) + L" ms");
+	TEST_PRINT(L"    XmlReader on a string: " + i64tow(stringTime) + L" ms");
+	TEST_PRINT(L"    XmlReader on a UTF-8 stream: " + i64tow(streamTime) + L" ms");
+}
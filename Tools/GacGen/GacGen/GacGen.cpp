@@ -1,5 +1,7 @@
 #include "GacGen.h"
 
+using namespace vl::filesystem;
+
 void PrintErrorMessage(const WString& message)
 {
 	Console::SetColor(true, false, false, true);
@@ -64,6 +66,13 @@ Ptr<CodegenConfig> CodegenConfig::LoadConfig(Ptr<GuiResource> resource)
 	Ptr<CodegenConfig> config = new CodegenConfig;
 	config->resource = resource;
 
+	if (auto folder = resource->GetFolderByPath(L"GacGenConfig/"))
+	{
+		WString scheduleBindings;
+		LoadConfigString(folder, L"ScheduleBindings", scheduleBindings);
+		config->scheduleBindings = scheduleBindings == L"true";
+	}
+
 	if (auto folder = resource->GetFolderByPath(L"GacGenConfig/Cpp/"))
 	{
 		auto out = MakePtr<CodegenConfig::CppOutput>();
@@ -88,8 +97,228 @@ Ptr<CodegenConfig> CodegenConfig::LoadConfig(Ptr<GuiResource> resource)
 		LoadConfigString(folder, L"Resource", out->resource);
 		LoadConfigString(folder, L"Compressed", out->compressed);
 
+		WString optimizeWorkflow;
+		LoadConfigString(folder, L"OptimizeWorkflow", optimizeWorkflow);
+		out->optimizeWorkflow = optimizeWorkflow == L"true";
+
 		config->resOutput = out;
 	}
 
 	return config;
-}
\ No newline at end of file
+}
+
+/***********************************************************************
+CodegenCache
+***********************************************************************/
+
+namespace codegen_cache
+{
+	const vuint64_t FnvOffsetBasis = 14695981039346656037ULL;
+	const vuint64_t FnvPrime = 1099511628211ULL;
+
+	void UpdateHash(vuint64_t& hash, const void* buffer, vint size)
+	{
+		auto bytes = (const vuint8_t*)buffer;
+		for (vint i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= FnvPrime;
+		}
+	}
+
+	WString FormatHash(vuint64_t hash)
+	{
+		wchar_t digits[17];
+		for (vint i = 15; i >= 0; i--)
+		{
+			digits[i] = L"0123456789ABCDEF"[hash & 0xF];
+			hash >>= 4;
+		}
+		digits[16] = 0;
+		return digits;
+	}
+}
+using namespace codegen_cache;
+
+WString CodegenCache::HashBuffer(const void* buffer, vint size)
+{
+	vuint64_t hash = FnvOffsetBasis;
+	UpdateHash(hash, buffer, size);
+	return FormatHash(hash);
+}
+
+WString CodegenCache::HashText(const WString& text)
+{
+	return HashBuffer(text.Buffer(), text.Length() * sizeof(wchar_t));
+}
+
+WString CodegenCache::HashFile(const WString& filePath)
+{
+	FileStream fileStream(filePath, FileStream::ReadOnly);
+	if (!fileStream.IsAvailable())
+	{
+		return L"";
+	}
+
+	vuint64_t hash = FnvOffsetBasis;
+	char buffer[65536];
+	while (vint size = fileStream.Read(buffer, sizeof(buffer)))
+	{
+		UpdateHash(hash, buffer, size);
+	}
+	return FormatHash(hash);
+}
+
+WString CodegenCache::HashItem(Ptr<GuiResourceItem> item)
+{
+	auto resolver = GetResourceResolverManager()->GetTypeResolver(item->GetTypeName());
+	if (resolver && resolver->StreamSerializable())
+	{
+		IGuiResourceTypeResolver_DirectLoadStream* directLoad = nullptr;
+		Ptr<DescriptableObject> content = item->GetContent();
+
+		if (!(directLoad = resolver->DirectLoadStream()))
+		{
+			if (auto indirectLoad = resolver->IndirectLoad())
+			{
+				if (auto preloadResolver = GetResourceResolverManager()->GetTypeResolver(indirectLoad->GetPreloadType()))
+				{
+					directLoad = preloadResolver->DirectLoadStream();
+					content = indirectLoad->Serialize(content);
+				}
+			}
+		}
+
+		if (directLoad && content)
+		{
+			MemoryStream memoryStream;
+			directLoad->SerializePrecompiled(content, memoryStream);
+			return item->GetTypeName() + L":" + HashBuffer(memoryStream.GetInternalBuffer(), (vint)memoryStream.Size());
+		}
+	}
+
+	if (resolver && resolver->XmlSerializable())
+	{
+		if (auto directLoad = resolver->DirectLoadXml())
+		{
+			if (auto xml = directLoad->Serialize(item->GetContent()))
+			{
+				return item->GetTypeName() + L":" + HashText(XmlToString(xml));
+			}
+		}
+	}
+
+	// The content cannot be serialized, it is always treated as changed
+	return L"";
+}
+
+WString CodegenCache::HashTool()
+{
+	// A different build of GacGen may generate different code, so it invalidates the whole cache
+	return HashFile(controls::GetApplication()->GetExecutablePath());
+}
+
+void CodegenCache::CollectItemHashes(Ptr<GuiResourceFolder> folder, HashMap& hashes)
+{
+	FOREACH(Ptr<GuiResourceItem>, item, folder->GetItems())
+	{
+		hashes.Add(item->GetResourcePath(), HashItem(item));
+	}
+	FOREACH(Ptr<GuiResourceFolder>, subFolder, folder->GetFolders())
+	{
+		CollectItemHashes(subFolder, hashes);
+	}
+}
+
+bool CodegenCache::Load(const WString& cachePath)
+{
+	toolHash = L"";
+	itemHashes.Clear();
+	outputHashes.Clear();
+
+	List<WString> lines;
+	if (!File(cachePath).ReadAllLines(lines))
+	{
+		return false;
+	}
+
+	FOREACH(WString, line, lines)
+	{
+		// <kind>\t<hash>\t<path>
+		auto first = wcschr(line.Buffer(), L'\t');
+		if (!first) continue;
+		auto second = wcschr(first + 1, L'\t');
+		if (!second) continue;
+
+		WString kind = line.Left(first - line.Buffer());
+		WString hash(first + 1, second - first - 1);
+		WString path = second + 1;
+
+		if (kind == L"Tool")
+		{
+			toolHash = hash;
+		}
+		else if (kind == L"Item")
+		{
+			itemHashes.Set(path, hash);
+		}
+		else if (kind == L"Output")
+		{
+			outputHashes.Set(path, hash);
+		}
+	}
+	return true;
+}
+
+bool CodegenCache::Save(const WString& cachePath)
+{
+	List<WString> lines;
+	lines.Add(L"Tool\t" + toolHash + L"\t" + controls::GetApplication()->GetExecutablePath());
+	FOREACH_INDEXER(WString, path, index, itemHashes.Keys())
+	{
+		lines.Add(L"Item\t" + itemHashes.Values()[index] + L"\t" + path);
+	}
+	FOREACH_INDEXER(WString, path, index, outputHashes.Keys())
+	{
+		lines.Add(L"Output\t" + outputHashes.Values()[index] + L"\t" + path);
+	}
+	return File(cachePath).WriteAllLines(lines, false, BomEncoder::Utf8);
+}
+
+bool CodegenCache::IsOutputUpToDate()
+{
+	if (outputHashes.Count() == 0)
+	{
+		return false;
+	}
+
+	FOREACH_INDEXER(WString, path, index, outputHashes.Keys())
+	{
+		if (HashFile(path) != outputHashes.Values()[index])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void CodegenCache::GetChangedItems(CodegenCache& previous, List<WString>& changed, List<WString>& removed)
+{
+	FOREACH_INDEXER(WString, path, index, itemHashes.Keys())
+	{
+		auto hash = itemHashes.Values()[index];
+		vint previousIndex = previous.itemHashes.Keys().IndexOf(path);
+		if (hash == L"" || previousIndex == -1 || previous.itemHashes.Values()[previousIndex] != hash)
+		{
+			changed.Add(path);
+		}
+	}
+
+	FOREACH(WString, path, previous.itemHashes.Keys())
+	{
+		if (!itemHashes.Keys().Contains(path))
+		{
+			removed.Add(path);
+		}
+	}
+}
@@ -38,6 +38,7 @@ public:
 	public:
 		WString									resource;
 		WString									compressed;
+		bool									optimizeWorkflow = false;
 	};
 
 	class CppOutput : public ResOutput
@@ -52,6 +53,7 @@ public:
 	Ptr<GuiResource>							resource;
 	Ptr<ParsingTable>							workflowTable;
 	Ptr<WfLexicalScopeManager>					workflowManager;
+	bool										scheduleBindings = false;
 
 	Ptr<CppOutput>								cppOutput;
 	Ptr<ResOutput>								resOutput;
@@ -61,4 +63,30 @@ public:
 	static Ptr<CodegenConfig>					LoadConfig(Ptr<GuiResource> resource);
 };
 
+/***********************************************************************
+Cache
+***********************************************************************/
+
+class CodegenCache
+{
+public:
+	typedef Dictionary<WString, WString>		HashMap;
+
+	WString										toolHash;
+	HashMap										itemHashes;
+	HashMap										outputHashes;
+
+	static WString								HashBuffer(const void* buffer, vint size);
+	static WString								HashText(const WString& text);
+	static WString								HashFile(const WString& filePath);
+	static WString								HashItem(Ptr<GuiResourceItem> item);
+	static WString								HashTool();
+	static void									CollectItemHashes(Ptr<GuiResourceFolder> folder, HashMap& hashes);
+
+	bool										Load(const WString& cachePath);
+	bool										Save(const WString& cachePath);
+	bool										IsOutputUpToDate();
+	void										GetChangedItems(CodegenCache& previous, List<WString>& changed, List<WString>& removed);
+};
+
 #endif
\ No newline at end of file
@@ -147,10 +147,50 @@ void GuiMain()
 		}
 	}
 
+	WString cacheFilePath = inputPath + L".cache";
+	CodegenCache cache;
+	{
+		CodegenCache previousCache;
+		bool cacheAvailable = previousCache.Load(cacheFilePath);
+		cache.toolHash = CodegenCache::HashTool();
+		CodegenCache::CollectItemHashes(resource, cache.itemHashes);
+
+		if (cacheAvailable && (cache.toolHash == L"" || cache.toolHash != previousCache.toolHash))
+		{
+			PrintInformationMessage(L"gacgen> GacGen is changed, rebuilding everything");
+			cacheAvailable = false;
+		}
+
+		List<WString> changed, removed;
+		cache.GetChangedItems(previousCache, changed, removed);
+		if (cacheAvailable && changed.Count() == 0 && removed.Count() == 0 && previousCache.IsOutputUpToDate())
+		{
+			PrintSuccessMessage(L"gacgen> Up to date : " + inputPath);
+			return;
+		}
+
+		if (cacheAvailable)
+		{
+			FOREACH(WString, path, changed)
+			{
+				PrintInformationMessage(L"gacgen> Changed : " + path);
+			}
+			FOREACH(WString, path, removed)
+			{
+				PrintInformationMessage(L"gacgen> Removed : " + path);
+			}
+			PrintInformationMessage(L"gacgen> Resource is changed, rebuilding everything");
+		}
+		File(cacheFilePath).Delete();
+	}
+
 	PrintSuccessMessage(L"gacgen> Compiling...");
 	List<WString> errors;
 	Callback callback;
-	resource->Precompile(&callback, errors);
+	// bind expressions only call system::SubscriptionScheduler::Schedule when the resource asks for it
+	Workflow_GetSharedManager()->scheduleBindings = config->scheduleBindings;
+	// assemblies are optimized right after they are generated, before any runtime context is created for them
+	resource->Precompile(&callback, errors, config->resOutput && config->resOutput->optimizeWorkflow);
 	if (errors.Count() > 0)
 	{
 		SaveErrors(errorFilePath, errors);
@@ -190,21 +230,33 @@ void GuiMain()
 			auto output = GenerateCppFiles(input, compiled->metadata.Obj());
 			FOREACH_INDEXER(WString, fileName, index, output->cppFiles.Keys())
 			{
-				PrintSuccessMessage(L"gacgen> Generating " + fileName);
 				WString code = output->cppFiles.Values()[index];
 				File file(sourceFolder / fileName);
 
 				if (file.Exists())
 				{
-					code = MergeCppFileContent(file.ReadAllText(), code);
+					WString existingCode = file.ReadAllText();
+					code = MergeCppFileContent(existingCode, code);
+					if (code == existingCode)
+					{
+						// Keep the timestamp so that the C++ build does not recompile unchanged files
+						PrintInformationMessage(L"gacgen> Unchanged " + fileName);
+						cache.outputHashes.Add(file.GetFilePath().GetFullPath(), CodegenCache::HashFile(file.GetFilePath().GetFullPath()));
+						continue;
+					}
 				}
+				PrintSuccessMessage(L"gacgen> Generating " + fileName);
 				file.WriteAllText(code, false, BomEncoder::Utf8);
+				cache.outputHashes.Add(file.GetFilePath().GetFullPath(), CodegenCache::HashFile(file.GetFilePath().GetFullPath()));
 			}
 		}
 	}
 
+	List<WString> binaryFileNames;
+
 #define OPEN_BINARY_FILE(NAME, FILENAME) \
 			WString fileName = config->resource->GetWorkingDirectory() + FILENAME; \
+			binaryFileNames.Add(FilePath(fileName).GetFullPath()); \
 			Folder(FilePath(fileName).GetFolder()).Create(true); \
 			FileStream fileStream(fileName, FileStream::WriteOnly); \
 			if (!fileStream.IsAvailable()) \
@@ -246,4 +298,13 @@ void GuiMain()
 			resource->SavePrecompiledBinary(encoderStream);
 		}
 	}
+
+	FOREACH(WString, fileName, binaryFileNames)
+	{
+		cache.outputHashes.Set(fileName, CodegenCache::HashFile(fileName));
+	}
+	if (!cache.Save(cacheFilePath))
+	{
+		PrintErrorMessage(L"gacgen> Unable to write : " + cacheFilePath);
+	}
 }
\ No newline at end of file